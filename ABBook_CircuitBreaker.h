@@ -0,0 +1,215 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Circuit Breaker                  |
+//| Scoring service health held in atomics; recovery is probed     |
+//| from a background thread, never by a trade                     |
+//+------------------------------------------------------------------+
+//
+// CLOSED: trades send scoring requests. FailureThreshold consecutive failed
+// requests (connect or protocol errors - an exhausted latency budget is not
+// a failure) trip the breaker OPEN: every trade takes the fallback score
+// without touching a socket. The trade thread that wins the CLOSED -> OPEN
+// exchange wakes the probe thread.
+//
+// OPEN: after ProbeIntervalMs the probe thread moves the breaker HALF_OPEN
+// and sends one synthetic ScoringRequest. Trades still take the fallback
+// while the probe is out. A valid answer closes the breaker; a failure
+// reopens it and doubles the interval up to MaxProbeIntervalMs.
+//
+// The trade path reads one atomic (AllowRequest) and, on an answer, writes
+// the failure count only when it is not already zero. Time spent away from
+// CLOSED is summed for the metrics exporter.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+
+enum BreakerState {
+    BREAKER_CLOSED = 0,                // Requests flow
+    BREAKER_OPEN,                      // Fallback for every trade until the next probe
+    BREAKER_HALF_OPEN                  // Probe in flight; trades still take the fallback
+};
+
+inline const char* BreakerStateName(BreakerState state) {
+    switch (state) {
+        case BREAKER_CLOSED: return "CLOSED";
+        case BREAKER_OPEN: return "OPEN";
+        case BREAKER_HALF_OPEN: return "HALF_OPEN";
+    }
+    return "UNKNOWN";
+}
+
+// Sends one synthetic request; true when the service answered with a valid score
+typedef std::function<bool()> BreakerProbe;
+// Called on the thread that made the transition, outside any breaker lock
+typedef std::function<void(BreakerState from, BreakerState to)> BreakerListener;
+
+class CircuitBreaker {
+    BreakerProbe probe;
+    BreakerListener listener;
+    int failure_threshold;
+    int probe_interval_ms;
+    int max_probe_interval_ms;
+
+    std::atomic<int> state;
+    std::atomic<int> failures;                   // Consecutive failed requests while CLOSED
+    std::atomic<long long> opened_at_ms;         // Start of the current outage
+    std::atomic<long long> open_ms;              // Finished outages
+    std::atomic<unsigned long long> opened;      // Transitions into OPEN (trips and failed probes)
+    std::atomic<unsigned long long> half_opened;
+    std::atomic<unsigned long long> closed;
+    std::atomic<unsigned long long> failed_probes;
+
+    std::mutex probe_mutex;
+    std::condition_variable probe_cv;
+    bool running;
+    bool stopping;
+    std::thread prober;
+
+    static long long NowMs() {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    bool Transition(BreakerState from, BreakerState to) {
+        int expected = from;
+        if (!state.compare_exchange_strong(expected, to)) return false;
+        if (to == BREAKER_OPEN) {
+            opened.fetch_add(1, std::memory_order_relaxed);
+            if (from == BREAKER_CLOSED) opened_at_ms.store(NowMs());
+        } else if (to == BREAKER_HALF_OPEN) {
+            half_opened.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            open_ms.fetch_add(NowMs() - opened_at_ms.load());
+            closed.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (listener) listener(from, to);
+        return true;
+    }
+
+    void ProbeLoop() {
+        int interval_ms = probe_interval_ms;
+        std::unique_lock<std::mutex> lock(probe_mutex);
+        while (!stopping) {
+            if (State() == BREAKER_CLOSED) {
+                interval_ms = probe_interval_ms;
+                probe_cv.wait(lock);
+                continue;
+            }
+            std::chrono::steady_clock::time_point probe_at = std::chrono::steady_clock::now() + std::chrono::milliseconds(interval_ms);
+            if (probe_cv.wait_until(lock, probe_at, [this]() { return stopping; })) break;
+            if (!Transition(BREAKER_OPEN, BREAKER_HALF_OPEN)) continue;
+            lock.unlock();
+
+            bool ok = false;
+            try {
+                ok = probe();
+            } catch (...) {
+                ok = false;                // Never let the probe thread die
+            }
+
+            if (ok) {
+                failures.store(0);
+                Transition(BREAKER_HALF_OPEN, BREAKER_CLOSED);
+            } else {
+                failed_probes.fetch_add(1, std::memory_order_relaxed);
+                Transition(BREAKER_HALF_OPEN, BREAKER_OPEN);
+                interval_ms = std::min(interval_ms * 2, max_probe_interval_ms);
+            }
+            lock.lock();
+        }
+    }
+
+public:
+    explicit CircuitBreaker(BreakerProbe probe_service)
+        : probe(probe_service), failure_threshold(3), probe_interval_ms(1000), max_probe_interval_ms(30000),
+          state(BREAKER_CLOSED), failures(0), opened_at_ms(0), open_ms(0),
+          opened(0), half_opened(0), closed(0), failed_probes(0), running(false), stopping(false) {}
+
+    ~CircuitBreaker() {
+        // Never join under the loader lock (DLL_PROCESS_DETACH) - MtSrvCleanup does the orderly Stop()
+        if (prober.joinable()) {
+            prober.detach();
+        }
+    }
+
+    // Call before Start()
+    void Configure(int threshold, int interval_ms, int max_interval_ms) {
+        failure_threshold = threshold > 0 ? threshold : 1;
+        probe_interval_ms = interval_ms > 0 ? interval_ms : 1;
+        max_probe_interval_ms = std::max(max_interval_ms, probe_interval_ms);
+    }
+
+    // Call before Start()
+    void SetListener(BreakerListener on_transition) {
+        listener = on_transition;
+    }
+
+    void Start() {
+        std::lock_guard<std::mutex> lock(probe_mutex);
+        if (running) return;
+        stopping = false;
+        running = true;
+        prober = std::thread(&CircuitBreaker::ProbeLoop, this);
+    }
+
+    // A probe in flight is finished first; the state is left as it is
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(probe_mutex);
+            if (!running) return;
+            stopping = true;
+            running = false;
+        }
+        probe_cv.notify_all();
+        if (prober.joinable()) {
+            prober.join();
+        }
+    }
+
+    // Trade path: false while OPEN or HALF_OPEN - take the fallback score
+    bool AllowRequest() const {
+        return state.load(std::memory_order_acquire) == BREAKER_CLOSED;
+    }
+
+    // Trade path: the service answered
+    void RecordSuccess() {
+        if (failures.load(std::memory_order_relaxed) != 0) {
+            failures.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // Trade path: the request failed. Answers to requests sent before the
+    // breaker opened are ignored; only the probe closes it again.
+    void RecordFailure() {
+        if (State() != BREAKER_CLOSED) return;
+        if (failures.fetch_add(1) + 1 < failure_threshold) return;
+        if (Transition(BREAKER_CLOSED, BREAKER_OPEN)) {
+            // Under the mutex, so the probe thread cannot miss it between its check and its wait
+            std::lock_guard<std::mutex> lock(probe_mutex);
+            probe_cv.notify_all();
+        }
+    }
+
+    BreakerState State() const { return (BreakerState)state.load(std::memory_order_acquire); }
+    int Failures() const { return failures.load(std::memory_order_relaxed); }
+
+    // Total time away from CLOSED, including the current outage
+    unsigned long long OpenMs() const {
+        long long total = open_ms.load();
+        long long since = opened_at_ms.load();
+        if (State() != BREAKER_CLOSED && since > 0) total += std::max(NowMs() - since, 0LL);
+        return total > 0 ? (unsigned long long)total : 0;
+    }
+
+    unsigned long long Opened() const { return opened.load(std::memory_order_relaxed); }
+    unsigned long long HalfOpened() const { return half_opened.load(std::memory_order_relaxed); }
+    unsigned long long Closed() const { return closed.load(std::memory_order_relaxed); }
+    unsigned long long FailedProbes() const { return failed_probes.load(std::memory_order_relaxed); }
+};
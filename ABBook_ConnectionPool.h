@@ -0,0 +1,360 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - ML Service Connection Pool       |
+//| Keeps warm TCP connections to the scoring service so a trade   |
+//| only pays one request/response round trip                      |
+//+------------------------------------------------------------------+
+
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+
+#include "ABBook_Platform.h"
+#include "ABBook_PluginConfig.h"
+#include "ABBook_PluginLogger.h"
+#include "ABBook_SocketIO.h"
+#include "ABBook_FrameReader.h"
+
+// A connection checked out of the pool. slot == -1 marks an overflow
+// connection (pool exhausted) which is closed instead of being returned.
+struct PooledConnection {
+    SOCKET sock = INVALID_SOCKET;
+    int slot = -1;
+    bool from_pool = false;   // true if the socket was already open before this checkout
+    FrameReader* reader = nullptr; // Receive buffer that lives as long as the connection
+};
+
+class ScoringConnectionPool {
+private:
+    struct Slot {
+        SOCKET sock = INVALID_SOCKET;   // Only valid while the slot is idle
+        bool in_use = false;
+        FrameReader reader;             // Reused by every checkout of this slot
+    };
+
+    PluginConfig* config;
+    PluginLogger* logger;
+
+    std::mutex pool_mutex;
+    std::vector<Slot> slots;
+
+    std::mutex winsock_mutex;
+    std::atomic<bool> winsock_ready;
+
+    std::thread health_thread;
+    std::mutex health_mutex;
+    std::condition_variable health_cv;
+    bool stopping;
+    bool last_dial_failed;
+
+    // Overflow connections never outlive the thread that dialled them
+    static FrameReader& OverflowReader() {
+        static thread_local FrameReader reader;
+        return reader;
+    }
+
+    void EnsureSlots() {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        if (slots.empty()) {
+            slots.resize(config->connection_pool_size);
+        }
+    }
+
+    // Health-check a single idle slot: drop half-closed sockets and re-dial empty slots.
+    // Returns false if a re-dial failed, so the caller can stop hammering a dead service.
+    bool CheckSlot(size_t index) {
+        SOCKET sock;
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            if (index >= slots.size() || slots[index].in_use) return true;
+            slots[index].in_use = true;
+            sock = slots[index].sock;
+            slots[index].sock = INVALID_SOCKET;
+        }
+
+        if (sock != INVALID_SOCKET && !IsConnectionAlive(sock)) {
+            logger->Log("ML SERVICE POOL: Health check dropped half-closed connection in slot " + std::to_string(index));
+            closesocket(sock);
+            sock = INVALID_SOCKET;
+        }
+
+        bool dial_ok = true;
+        if (sock == INVALID_SOCKET) {
+            int error_code = 0;
+            sock = Dial(error_code, ScoringDeadline::In(config->socket_timeout));
+            dial_ok = (sock != INVALID_SOCKET);
+
+            if (dial_ok && last_dial_failed) {
+                logger->Log("ML SERVICE POOL: Background re-dial succeeded - pool is warming up again");
+            } else if (!dial_ok && !last_dial_failed) {
+                ABBOOK_LOG_WARN(*logger, "ML SERVICE POOL: Background re-dial failed (WSA error: " + std::to_string(error_code) + ") - will keep retrying");
+            }
+            last_dial_failed = !dial_ok;
+        }
+
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        slots[index].sock = sock;
+        slots[index].in_use = false;
+        return dial_ok;
+    }
+
+    void HealthLoop() {
+        std::unique_lock<std::mutex> lock(health_mutex);
+        while (!stopping) {
+            health_cv.wait_for(lock, std::chrono::milliseconds(config->pool_health_check_ms));
+            if (stopping) break;
+
+            lock.unlock();
+            size_t count;
+            {
+                std::lock_guard<std::mutex> pool_lock(pool_mutex);
+                count = slots.size();
+            }
+            for (size_t i = 0; i < count; i++) {
+                if (!CheckSlot(i)) break;
+            }
+            lock.lock();
+        }
+    }
+
+public:
+    ScoringConnectionPool(PluginConfig* cfg, PluginLogger* log)
+        : config(cfg), logger(log), winsock_ready(false), stopping(false), last_dial_failed(false) {}
+
+    ~ScoringConnectionPool() {
+        // Never join under the loader lock (DLL_PROCESS_DETACH) - MtSrvCleanup does the orderly Stop()
+        if (health_thread.joinable()) {
+            health_thread.detach();
+        }
+    }
+
+    // Winsock is initialised once per plugin lifetime, not per trade
+    bool EnsureWinsock() {
+        if (winsock_ready.load(std::memory_order_acquire)) return true;
+
+        std::lock_guard<std::mutex> lock(winsock_mutex);
+        if (winsock_ready.load(std::memory_order_relaxed)) return true;
+
+        WSADATA wsaData;
+        int wsa_result = WSAStartup(MAKEWORD(2, 2), &wsaData);
+        if (wsa_result != 0) {
+            ABBOOK_LOG_WARN(*logger, "ML SERVICE POOL WARNING: WSAStartup failed (code: " + std::to_string(wsa_result) + ")");
+            return false;
+        }
+        winsock_ready.store(true, std::memory_order_release);
+        return true;
+    }
+
+    // Open the pool, warm every slot and start the background health checker.
+    // Returns the number of connections that were successfully warmed.
+    int Start() {
+        if (!EnsureWinsock()) return 0;
+        EnsureSlots();
+
+        int warmed = 0;
+        size_t count = slots.size();
+        for (size_t i = 0; i < count; i++) {
+            if (!CheckSlot(i)) break;
+            warmed++;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(health_mutex);
+            stopping = false;
+        }
+        if (!health_thread.joinable()) {
+            health_thread = std::thread(&ScoringConnectionPool::HealthLoop, this);
+        }
+        return warmed;
+    }
+
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(health_mutex);
+            stopping = true;
+        }
+        health_cv.notify_all();
+        if (health_thread.joinable()) {
+            health_thread.join();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            for (Slot& slot : slots) {
+                if (slot.sock != INVALID_SOCKET) {
+                    closesocket(slot.sock);
+                    slot.sock = INVALID_SOCKET;
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(winsock_mutex);
+        if (winsock_ready.exchange(false)) {
+            WSACleanup();
+        }
+    }
+
+    // Open a new non-blocking TCP connection to the ML service, waiting no longer than
+    // the deadline for the handshake. Returns INVALID_SOCKET and sets error_code (WSA
+    // error, WSAETIMEDOUT when the deadline ran out, WSAEINVAL for a malformed IP) on failure.
+    SOCKET Dial(int& error_code, const ScoringDeadline& deadline) {
+        error_code = 0;
+        SOCKET sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (sock == INVALID_SOCKET) {
+            error_code = WSAGetLastError();
+            return INVALID_SOCKET;
+        }
+
+        // Small request/response frames: never let Nagle hold a request back
+        int nodelay = 1;
+        setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, (const char*)&nodelay, sizeof(nodelay));
+
+        // Keep idle pooled connections alive through NAT/firewall idle timers
+        SetSocketKeepAlive(sock, config->pool_keepalive_idle_ms, 1000);
+
+        sockaddr_in serverAddr;
+        memset(&serverAddr, 0, sizeof(serverAddr));
+        serverAddr.sin_family = AF_INET;
+        serverAddr.sin_port = htons(config->cvm_port);
+        if (inet_pton(AF_INET, config->cvm_ip.c_str(), &serverAddr.sin_addr) != 1) {
+            error_code = WSAEINVAL;
+            closesocket(sock);
+            return INVALID_SOCKET;
+        }
+
+        // Non-blocking connect: a bad network path costs at most the remaining budget,
+        // not the OS SYN retry timeout
+        if (!SetSocketNonBlocking(sock, true)) {
+            error_code = WSAGetLastError();
+            closesocket(sock);
+            return INVALID_SOCKET;
+        }
+        if (connect(sock, (sockaddr*)&serverAddr, sizeof(serverAddr)) == SOCKET_ERROR) {
+            int connect_error = WSAGetLastError();
+            if (!IsWouldBlock(connect_error)) {
+                error_code = connect_error;
+                closesocket(sock);
+                return INVALID_SOCKET;
+            }
+
+            SocketWaitResult wait = WaitSocket(sock, true, deadline);
+            int so_error = SocketError(sock);
+            if (wait != SOCKET_WAIT_READY || so_error != 0) {
+                error_code = (wait == SOCKET_WAIT_TIMEOUT) ? WSAETIMEDOUT : (so_error != 0 ? so_error : WSAGetLastError());
+                closesocket(sock);
+                return INVALID_SOCKET;
+            }
+        }
+        return sock;
+    }
+
+    // An idle request/response connection must have nothing to read. Readable means
+    // the peer closed (recv == 0), reset it (recv < 0), or sent bytes nobody asked for.
+    static bool IsConnectionAlive(SOCKET sock) {
+        return PollSocket(sock, false, 0) == 0;
+    }
+
+    // Check out a connection: an idle warm socket if one is available, otherwise a
+    // freshly dialled one. Returns sock == INVALID_SOCKET with error_code set on failure.
+    // Pooled sockets are non-blocking; all I/O on them goes through ABBook_SocketIO.h.
+    PooledConnection Acquire(int& error_code, const ScoringDeadline& deadline) {
+        PooledConnection conn;
+        error_code = 0;
+
+        if (!EnsureWinsock()) {
+            error_code = WSANOTINITIALISED;
+            return conn;
+        }
+        EnsureSlots();
+
+        {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            for (size_t i = 0; i < slots.size() && conn.slot < 0; i++) {
+                if (!slots[i].in_use && slots[i].sock != INVALID_SOCKET) {
+                    conn.slot = (int)i;
+                }
+            }
+            for (size_t i = 0; i < slots.size() && conn.slot < 0; i++) {
+                if (!slots[i].in_use) {
+                    conn.slot = (int)i;
+                }
+            }
+            if (conn.slot >= 0) {
+                Slot& slot = slots[conn.slot];
+                slot.in_use = true;
+                conn.sock = slot.sock;
+                conn.from_pool = (slot.sock != INVALID_SOCKET);
+                conn.reader = &slot.reader;
+                slot.sock = INVALID_SOCKET;
+            }
+        }
+        if (conn.reader == nullptr) {
+            conn.reader = &OverflowReader();
+        }
+
+        if (conn.from_pool && !IsConnectionAlive(conn.sock)) {
+            ABBOOK_LOG_DEBUG(*logger, "ML SERVICE POOL: Discarding half-closed connection in slot " + std::to_string(conn.slot));
+            closesocket(conn.sock);
+            conn.sock = INVALID_SOCKET;
+            conn.from_pool = false;
+        }
+
+        if (conn.sock == INVALID_SOCKET) {
+            conn.reader->Reset();
+            conn.sock = Dial(error_code, deadline);
+            if (conn.sock == INVALID_SOCKET && conn.slot >= 0) {
+                std::lock_guard<std::mutex> lock(pool_mutex);
+                slots[conn.slot].in_use = false;
+                conn.slot = -1;
+                conn.reader = nullptr;
+            }
+        }
+        return conn;
+    }
+
+    // Return a connection. Unhealthy connections (I/O error, unparsed bytes left on
+    // the wire) are closed so the next checkout gets a clean stream.
+    void Release(PooledConnection& conn, bool healthy) {
+        if (conn.sock == INVALID_SOCKET && conn.slot < 0) return;
+
+        if (conn.reader != nullptr && conn.reader->Buffered() != 0) {
+            healthy = false;
+        }
+        if (!healthy || conn.slot < 0) {
+            if (conn.sock != INVALID_SOCKET) {
+                closesocket(conn.sock);
+            }
+            conn.sock = INVALID_SOCKET;
+            if (conn.reader != nullptr) {
+                conn.reader->Reset();
+            }
+        }
+
+        if (conn.slot >= 0) {
+            std::lock_guard<std::mutex> lock(pool_mutex);
+            Slot& slot = slots[conn.slot];
+            slot.sock = conn.sock;
+            slot.in_use = false;
+        }
+
+        conn.sock = INVALID_SOCKET;
+        conn.slot = -1;
+        conn.from_pool = false;
+        conn.reader = nullptr;
+    }
+
+    int IdleConnections() {
+        std::lock_guard<std::mutex> lock(pool_mutex);
+        int idle = 0;
+        for (const Slot& slot : slots) {
+            if (!slot.in_use && slot.sock != INVALID_SOCKET) idle++;
+        }
+        return idle;
+    }
+};
@@ -0,0 +1,597 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Binary Decision Journal          |
+//| One fixed-size record per routing decision, appended to a      |
+//| pre-sized memory-mapped file                                   |
+//+------------------------------------------------------------------+
+//
+// File layout (little-endian): a 128-byte JournalFileHeader followed by
+// `capacity` 128-byte DecisionRecords. The file is created at full size,
+// so unwritten records read back as zeros.
+//
+// Appending claims a slot with one atomic increment and copies the record
+// into the mapping; the `commit` word is stored last, so a reader (or a
+// crash mid-copy) never sees a half-written record as valid. The OS writes
+// the dirty pages back - a plugin crash loses nothing already copied.
+//
+// A file is closed and the next one opened when it fills up or the UTC day
+// changes: <prefix>_<YYYYMMDD>_<n>.abj. journal_decode turns files back
+// into CSV.
+//
+// Creating, sizing and mapping a file takes far longer than a trade may wait,
+// so a preparer thread keeps the next file of the day ready (and, in the last
+// minute of the day, the first file of the next one) and unmaps rotated-out
+// files. A rotation on the trade thread only swaps the spare in; it waits for
+// the preparer only if that has fallen a whole file behind. Spares nobody
+// used are deleted on Close().
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+
+#ifdef _WIN32
+#include "ABBook_Platform.h"             // winsock2.h ahead of windows.h
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+enum JournalDecision {
+    JOURNAL_A_BOOK = 0,
+    JOURNAL_B_BOOK = 1
+};
+
+// Where the score behind a decision came from
+enum JournalScoreSource {
+    SCORE_SOURCE_ML = 0,                 // Valid score from the ML service
+    SCORE_SOURCE_FALLBACK_ERROR,         // Connect/send/receive/decode failure
+    SCORE_SOURCE_FALLBACK_BUDGET,        // Latency budget ran out
+    SCORE_SOURCE_FALLBACK_BACKOFF,       // Not attempted - service marked down, backing off
+    SCORE_SOURCE_FALLBACK_EXCEPTION,     // Exception while scoring
+    SCORE_SOURCE_FALLBACK_INVALID,       // Service answered outside [0, 1]
+    SCORE_SOURCE_CACHE,                  // ML score of an earlier order, from the score cache
+    SCORE_SOURCE_CACHE_STALE,            // Cached ML score past its TTL, used while it is refreshed
+    SCORE_SOURCE_COALESCED,              // ML score of a concurrent identical request (single flight)
+    SCORE_SOURCE_FALLBACK_BUSY,          // Not attempted - every I/O thread request slot in use
+    SCORE_SOURCE_COUNT
+};
+
+// DecisionRecord::flags
+static const uint16_t JOURNAL_FLAG_DATA_CORRUPTED = 0x0001;   // Trade fields were out of range and normalised
+
+static const uint32_t JOURNAL_RECORD_COMMITTED = 0x4A524543u;    // "CERJ"
+
+#pragma pack(push, 1)
+struct DecisionRecord {
+    uint32_t commit;                 // JOURNAL_RECORD_COMMITTED once the record is complete
+    uint32_t reserved0;
+    uint64_t timestamp_us;           // UTC microseconds since the epoch
+    int32_t order;                   // Ticket
+    int32_t login;
+    char symbol[12];                 // Cleaned symbol, NUL padded
+    char group[16];                  // Instrument group, NUL padded
+    int32_t cmd;
+    int32_t volume;
+    uint32_t reserved1;
+    double open_price;
+    uint64_t request_hash;           // FNV-1a of the encoded ScoringRequest (feature vector), 0 if none
+    float score;
+    float threshold;
+    uint32_t latency_us;             // Scoring round trip, 0 if not attempted
+    uint32_t reserved2;
+    uint8_t decision;                // JournalDecision
+    uint8_t score_source;            // JournalScoreSource
+    uint16_t flags;                  // JOURNAL_FLAG_*
+    char reserved3[28];
+};
+
+struct JournalFileHeader {
+    char magic[8];                   // "ABBJRNL1"
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t capacity;               // Records the file was sized for
+    uint64_t created_us;
+    char reserved[96];
+};
+#pragma pack(pop)
+
+static_assert(sizeof(DecisionRecord) == 128, "DecisionRecord is a fixed 128-byte on-disk format");
+static_assert(sizeof(JournalFileHeader) == 128, "JournalFileHeader is a fixed 128-byte on-disk format");
+
+static const char JOURNAL_MAGIC[8] = { 'A', 'B', 'B', 'J', 'R', 'N', 'L', '1' };
+static const uint32_t JOURNAL_VERSION = 1;
+
+inline uint64_t JournalNowUs() {
+#ifdef _WIN32
+    FILETIME now;
+    GetSystemTimeAsFileTime(&now);
+    uint64_t ticks = ((uint64_t)now.dwHighDateTime << 32) | now.dwLowDateTime;   // 100 ns since 1601
+    return ticks / 10 - 11644473600000000ULL;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    return (uint64_t)now.tv_sec * 1000000ULL + (uint64_t)now.tv_nsec / 1000;
+#endif
+}
+
+inline const char* JournalScoreSourceName(uint8_t source) {
+    switch (source) {
+        case SCORE_SOURCE_ML: return "ML";
+        case SCORE_SOURCE_FALLBACK_ERROR: return "FALLBACK_ERROR";
+        case SCORE_SOURCE_FALLBACK_BUDGET: return "FALLBACK_BUDGET";
+        case SCORE_SOURCE_FALLBACK_BACKOFF: return "FALLBACK_BACKOFF";
+        case SCORE_SOURCE_FALLBACK_EXCEPTION: return "FALLBACK_EXCEPTION";
+        case SCORE_SOURCE_FALLBACK_INVALID: return "FALLBACK_INVALID";
+        case SCORE_SOURCE_CACHE: return "CACHE";
+        case SCORE_SOURCE_CACHE_STALE: return "CACHE_STALE";
+        case SCORE_SOURCE_COALESCED: return "COALESCED";
+        case SCORE_SOURCE_FALLBACK_BUSY: return "FALLBACK_BUSY";
+    }
+    return "UNKNOWN";
+}
+
+// Copy a string into a fixed, NUL-padded record field
+inline void JournalCopyField(char* field, size_t field_size, const char* text, size_t length) {
+    if (length > field_size) length = field_size;
+    memcpy(field, text, length);
+    memset(field + length, 0, field_size - length);
+}
+
+//+------------------------------------------------------------------+
+//| One mapped journal file                                        |
+//+------------------------------------------------------------------+
+
+class JournalSegment {
+private:
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#else
+    int fd;
+#endif
+    char* view;
+    size_t view_bytes;
+
+public:
+    DecisionRecord* records;
+    uint64_t capacity;
+    uint32_t day;                        // UTC day number the file belongs to
+    std::atomic<uint64_t> next;          // Next free slot; may run past capacity when full
+    std::string path;
+
+    JournalSegment()
+        :
+#ifdef _WIN32
+          file(INVALID_HANDLE_VALUE), mapping(nullptr),
+#else
+          fd(-1),
+#endif
+          view(nullptr), view_bytes(0), records(nullptr), capacity(0), day(0), next(0) {}
+
+    ~JournalSegment() { Close(); }
+
+    // Create a new file of exactly header + capacity records and map it
+    bool Create(const std::string& file_path, uint64_t record_capacity, uint32_t utc_day) {
+        path = file_path;
+        capacity = record_capacity;
+        day = utc_day;
+        view_bytes = sizeof(JournalFileHeader) + (size_t)(capacity * sizeof(DecisionRecord));
+
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                           CREATE_NEW, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER size;
+        size.QuadPart = (LONGLONG)view_bytes;
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READWRITE, (DWORD)(size.QuadPart >> 32),
+                                     (DWORD)(size.QuadPart & 0xFFFFFFFF), nullptr);
+        if (!mapping) {
+            Close();
+            return false;
+        }
+        view = (char*)MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, view_bytes);
+#else
+        fd = open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+        if (fd < 0) return false;
+        if (ftruncate(fd, (off_t)view_bytes) != 0) {
+            Close();
+            return false;
+        }
+        void* mapped = mmap(nullptr, view_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        view = mapped == MAP_FAILED ? nullptr : (char*)mapped;
+#endif
+        if (!view) {
+            Close();
+            return false;
+        }
+
+        JournalFileHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+        header.version = JOURNAL_VERSION;
+        header.record_size = sizeof(DecisionRecord);
+        header.capacity = capacity;
+        header.created_us = JournalNowUs();
+        memcpy(view, &header, sizeof(header));
+
+        records = (DecisionRecord*)(view + sizeof(JournalFileHeader));
+        next.store(0, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Ask the OS to write the mapped pages back now
+    void Flush() {
+        if (!view) return;
+#ifdef _WIN32
+        FlushViewOfFile(view, 0);
+        FlushFileBuffers(file);
+#else
+        msync(view, view_bytes, MS_ASYNC);
+#endif
+    }
+
+    void Close() {
+        if (view) {
+            Flush();
+#ifdef _WIN32
+            UnmapViewOfFile(view);
+#else
+            munmap(view, view_bytes);
+#endif
+            view = nullptr;
+            records = nullptr;
+        }
+#ifdef _WIN32
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        mapping = nullptr;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (fd >= 0) close(fd);
+        fd = -1;
+#endif
+    }
+};
+
+//+------------------------------------------------------------------+
+//| Journal writer                                                  |
+//+------------------------------------------------------------------+
+
+class DecisionJournal {
+private:
+    // Only ever read by value - a const& parameter (chrono durations) gets int(...) of them
+    static const int SPARE_AHEAD_SEC = 60;         // Next day's first file is prepared this long before midnight
+    static const int SPARE_WAIT_MS = 2000;         // A rotation waits this long for a late preparer
+    static const int MAX_APPEND_ATTEMPTS = 16;
+
+    std::atomic<JournalSegment*> current;
+    std::vector<JournalSegment*> retired;    // Rotated out, unmapped by the preparer once no writer can hold them
+    std::vector<JournalSegment*> spares;     // Created ahead by the preparer, at most one per day
+    std::mutex rotate_mutex;                 // Guards everything below but the counters
+
+    std::thread preparer;
+    std::condition_variable prepare_cv;      // Wakes the preparer: a spare was used or is missing
+    std::condition_variable spare_cv;        // Wakes rotations waiting for the preparer
+    bool preparing;
+    uint32_t wanted_day;                     // Day a rotation found no spare for (0 = none)
+    unsigned long long prepare_failures;
+
+    // Appends between loading `current` and committing their record. A stalled
+    // writer may still hold a rotated-out segment; once this has been seen at
+    // zero after a rotation, none can.
+    std::atomic<int> writers;
+
+    std::string prefix;
+    uint64_t records_per_file;
+    std::atomic<bool> enabled;
+
+    std::atomic<unsigned long long> appended;
+    std::atomic<unsigned long long> lost;
+
+    static uint32_t UtcDay(uint64_t timestamp_us) { return (uint32_t)(timestamp_us / 86400000000ULL); }
+
+    static bool FileExists(const std::string& path) {
+        FILE* f = fopen(path.c_str(), "rb");
+        if (!f) return false;
+        fclose(f);
+        return true;
+    }
+
+    // Open the first unused <prefix>_<YYYYMMDD>_<n>.abj for this day
+    JournalSegment* OpenSegment(uint32_t day) {
+        time_t seconds = (time_t)day * 86400;
+        struct tm utc;
+#ifdef _WIN32
+        gmtime_s(&utc, &seconds);
+#else
+        gmtime_r(&seconds, &utc);
+#endif
+        char date[16];
+        strftime(date, sizeof(date), "%Y%m%d", &utc);
+
+        for (int n = 0; n < 1000; n++) {
+            std::string path = prefix + "_" + date + "_" + std::to_string(n) + ".abj";
+            if (FileExists(path)) continue;
+            JournalSegment* segment = new JournalSegment();
+            if (segment->Create(path, records_per_file, day)) return segment;
+            delete segment;
+            return nullptr;
+        }
+        return nullptr;
+    }
+
+    // Caller holds rotate_mutex
+    void ReleaseRetired() {
+        for (JournalSegment* segment : retired) delete segment;
+        retired.clear();
+    }
+
+    // Caller holds rotate_mutex
+    JournalSegment* FindSpare(uint32_t day) {
+        for (JournalSegment* spare : spares) {
+            if (spare->day == day) return spare;
+        }
+        return nullptr;
+    }
+
+    static void DeleteSpare(JournalSegment* spare) {
+        std::string path = spare->path;
+        delete spare;
+        remove(path.c_str());
+    }
+
+    // Keeps a spare for the current file's day, for a day a rotation is waiting
+    // on and, shortly before midnight, for tomorrow. All file work happens with
+    // rotate_mutex released.
+    void PrepareLoop() {
+        std::unique_lock<std::mutex> lock(rotate_mutex);
+        while (preparing) {
+            uint64_t now_us = JournalNowUs();
+            uint32_t today = UtcDay(now_us);
+            uint64_t to_midnight_ms = (86400000000ULL - now_us % 86400000000ULL) / 1000;
+            JournalSegment* active = current.load();
+            uint32_t base_day = active && active->day > today ? active->day : today;
+
+            // A spare older than the current file can never be swapped in
+            std::vector<JournalSegment*> stale;
+            for (size_t i = 0; i < spares.size();) {
+                if (active && spares[i]->day < active->day) {
+                    stale.push_back(spares[i]);
+                    spares.erase(spares.begin() + i);
+                } else {
+                    i++;
+                }
+            }
+
+            uint32_t need = 0;
+            if (wanted_day != 0 && !FindSpare(wanted_day)) {
+                need = wanted_day;
+            } else if (!FindSpare(base_day)) {
+                need = base_day;
+            } else if (!retired.empty()) {
+                // Unmapping writes a whole file back - only once the next one is ready.
+                // Every writer that loaded a rotated-out file finishes within a memcpy.
+                std::vector<JournalSegment*> unmap;
+                unmap.swap(retired);
+                lock.unlock();
+                while (writers.load() != 0) std::this_thread::yield();
+                for (JournalSegment* segment : unmap) delete segment;
+                lock.lock();
+                continue;
+            } else if (to_midnight_ms <= SPARE_AHEAD_SEC * 1000ULL && !FindSpare(today + 1)) {
+                need = today + 1;
+            }
+
+            if (need != 0 || !stale.empty()) {
+                lock.unlock();
+                for (JournalSegment* spare : stale) DeleteSpare(spare);
+                JournalSegment* fresh = need != 0 ? OpenSegment(need) : nullptr;
+                lock.lock();
+                if (fresh) {
+                    spares.push_back(fresh);
+                } else if (need != 0) {
+                    prepare_failures++;
+                }
+                spare_cv.notify_all();
+                if (need == 0 || fresh) continue;
+                prepare_cv.wait_for(lock, std::chrono::seconds(1));     // Do not spin on a full disk
+                continue;
+            }
+
+            // Nothing to do until a spare is used or tomorrow's is due
+            uint64_t sleep_ms = to_midnight_ms > SPARE_AHEAD_SEC * 1000ULL ? to_midnight_ms - SPARE_AHEAD_SEC * 1000ULL
+                                                                             : to_midnight_ms + 1;
+            if (sleep_ms > 60000) sleep_ms = 60000;
+            prepare_cv.wait_for(lock, std::chrono::milliseconds(sleep_ms));
+        }
+    }
+
+    // Slow path: the current file is full or from an earlier day. Swaps in the
+    // preparer's spare; `seen` is only dereferenced while it is still current.
+    bool Rotate(JournalSegment* seen, uint32_t day) {
+        std::unique_lock<std::mutex> lock(rotate_mutex);
+        JournalSegment* active = current.load();
+        if (active != seen) return active != nullptr;       // Another thread rotated already
+        if (!enabled.load()) return false;
+
+        // Late records of an earlier day go to the next file of the current day
+        uint32_t target_day = day > seen->day ? day : seen->day;
+        JournalSegment* fresh = FindSpare(target_day);
+        if (!fresh) {
+            unsigned long long failures_seen = prepare_failures;
+            if (target_day > wanted_day) wanted_day = target_day;
+            prepare_cv.notify_one();
+            spare_cv.wait_for(lock, std::chrono::milliseconds(int(SPARE_WAIT_MS)), [&]() {
+                return FindSpare(target_day) != nullptr || prepare_failures != failures_seen || !preparing ||
+                       current.load() != seen;
+            });
+            active = current.load();
+            if (active != seen) return active != nullptr;
+            fresh = FindSpare(target_day);
+            if (!fresh) return false;
+        }
+
+        for (size_t i = 0; i < spares.size(); i++) {
+            if (spares[i] == fresh) {
+                spares.erase(spares.begin() + i);
+                break;
+            }
+        }
+        if (wanted_day <= target_day) wanted_day = 0;
+        fresh->next.store(0, std::memory_order_relaxed);
+        current.store(fresh);
+        retired.push_back(seen);
+        prepare_cv.notify_one();
+        return true;
+    }
+
+public:
+    DecisionJournal()
+        : current(nullptr), preparing(false), wanted_day(0), prepare_failures(0), writers(0),
+          records_per_file(1 << 20), enabled(false), appended(0), lost(0) {}
+
+    // The plugin closes the journal in MtSrvCleanup, so only a journal that was
+    // never closed (tests, tools) joins its preparer here
+    ~DecisionJournal() { Close(); }
+
+    // Start journaling into <file_prefix>_<YYYYMMDD>_<n>.abj files. Only call
+    // while no trade is being processed (startup).
+    bool Open(const std::string& file_prefix, uint64_t capacity) {
+        Close();
+        std::lock_guard<std::mutex> lock(rotate_mutex);
+        prefix = file_prefix;
+        records_per_file = capacity ? capacity : 1;
+        JournalSegment* first = OpenSegment(UtcDay(JournalNowUs()));
+        current.store(first);
+        enabled.store(first != nullptr);
+        if (first) {
+            preparing = true;
+            preparer = std::thread(&DecisionJournal::PrepareLoop, this);
+        }
+        return first != nullptr;
+    }
+
+    // Stop journaling, wait for appends in progress, unmap every file and
+    // delete the spares that were never used
+    void Close() {
+        std::unique_lock<std::mutex> lock(rotate_mutex);
+        enabled.store(false);
+        preparing = false;
+        prepare_cv.notify_all();
+        spare_cv.notify_all();
+        if (preparer.joinable()) {
+            lock.unlock();
+            preparer.join();
+            lock.lock();
+        }
+        JournalSegment* last = current.exchange(nullptr);
+        while (writers.load() != 0) std::this_thread::yield();
+        delete last;
+        ReleaseRetired();
+        for (JournalSegment* spare : spares) DeleteSpare(spare);
+        spares.clear();
+        wanted_day = 0;
+    }
+
+    bool Enabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Append one decision. The caller fills everything but commit; the
+    // timestamp picks the file. Returns false if the record was lost.
+    bool Append(const DecisionRecord& record) {
+        uint32_t day = UtcDay(record.timestamp_us);
+
+        // Every retry follows a rotation, but a small file can fill up again
+        // before this thread gets back to it
+        for (int attempt = 0; attempt < MAX_APPEND_ATTEMPTS; attempt++) {
+            writers.fetch_add(1);
+            JournalSegment* segment = current.load();
+            if (!segment) {
+                writers.fetch_sub(1);
+                break;
+            }
+
+            // Late records of the previous day go to the current file
+            if (segment->day >= day) {
+                uint64_t slot = segment->next.fetch_add(1, std::memory_order_relaxed);
+                if (slot < segment->capacity) {
+                    DecisionRecord* target = &segment->records[slot];
+                    memcpy((char*)target + sizeof(uint32_t), (const char*)&record + sizeof(uint32_t),
+                           sizeof(DecisionRecord) - sizeof(uint32_t));
+                    reinterpret_cast<std::atomic<uint32_t>*>(&target->commit)->store(JOURNAL_RECORD_COMMITTED,
+                                                                                      std::memory_order_release);
+                    writers.fetch_sub(1);
+                    appended.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            }
+            writers.fetch_sub(1);
+            if (!Rotate(segment, day)) break;
+        }
+        if (enabled.load(std::memory_order_relaxed)) lost.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void Flush() {
+        std::lock_guard<std::mutex> lock(rotate_mutex);
+        JournalSegment* segment = current.load();
+        if (segment) segment->Flush();
+    }
+
+    std::string CurrentPath() {
+        std::lock_guard<std::mutex> lock(rotate_mutex);
+        JournalSegment* segment = current.load();
+        return segment ? segment->path : std::string();
+    }
+
+    unsigned long long Appended() const { return appended.load(std::memory_order_relaxed); }
+    unsigned long long Lost() const { return lost.load(std::memory_order_relaxed); }
+};
+
+//+------------------------------------------------------------------+
+//| Reader (journal_decode, tests)                                  |
+//+------------------------------------------------------------------+
+
+// Read every committed record of one journal file. Uncommitted slots (the
+// unused tail, or a record torn by a crash) are skipped. Returns false if the
+// file is missing or not a journal.
+inline bool ReadJournalFile(const std::string& path, std::vector<DecisionRecord>& out, std::string& error) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) {
+        error = "cannot open " + path;
+        return false;
+    }
+
+    JournalFileHeader header;
+    if (fread(&header, sizeof(header), 1, f) != 1 || memcmp(header.magic, JOURNAL_MAGIC, sizeof(header.magic)) != 0) {
+        error = path + " is not a decision journal";
+        fclose(f);
+        return false;
+    }
+    if (header.version != JOURNAL_VERSION || header.record_size != sizeof(DecisionRecord)) {
+        error = path + ": unsupported journal version " + std::to_string(header.version);
+        fclose(f);
+        return false;
+    }
+
+    DecisionRecord chunk[512];
+    size_t count;
+    while ((count = fread(chunk, sizeof(DecisionRecord), 512, f)) > 0) {
+        for (size_t i = 0; i < count; i++) {
+            if (chunk[i].commit == JOURNAL_RECORD_COMMITTED) out.push_back(chunk[i]);
+        }
+    }
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,144 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Streaming Frame Reader            |
+//| Reassembles [4-byte big-endian length][body] frames that arrive |
+//| split across TCP segments, in a buffer reused per connection    |
+//+------------------------------------------------------------------+
+//
+// The buffer is a byte ring that is linearised on demand: data lives in
+// [head, tail), and when a frame would run past the end the unread bytes are
+// moved to the front. Frames therefore always sit contiguously in the buffer
+// and can be handed to the protobuf parser as a pointer/length view with no
+// copy. A view stays valid until the next call into the reader.
+//
+// The buffer is never zeroed - only bytes recv() wrote are ever read back.
+
+#pragma once
+
+#include <cstring>
+#include <vector>
+
+#include "ABBook_Platform.h"
+#include "ABBook_SocketIO.h"
+
+enum FrameReadStatus {
+    FRAME_OK = 0,
+    FRAME_CLOSED,          // Peer closed the connection before a whole frame arrived
+    FRAME_IO_ERROR,        // recv() failed; error_code holds the WSA error
+    FRAME_TIMEOUT,         // Deadline ran out mid-frame
+    FRAME_TOO_LARGE        // Length prefix above max_frame_bytes - the stream is unusable
+};
+
+class FrameReader {
+private:
+    static const size_t INITIAL_CAPACITY = 4096;
+
+    std::vector<char> buffer;
+    size_t head;              // First unread byte
+    size_t tail;              // One past the last received byte
+    size_t consume_on_next;   // Bytes of the frame last handed out, dropped on the next call
+    uint32_t max_frame_bytes;
+
+    static uint32_t ReadBE32(const char* p) {
+        return ((uint32_t)(unsigned char)p[0] << 24) |
+               ((uint32_t)(unsigned char)p[1] << 16) |
+               ((uint32_t)(unsigned char)p[2] << 8) |
+               ((uint32_t)(unsigned char)p[3]);
+    }
+
+    void ReleaseLastFrame() {
+        head += consume_on_next;
+        consume_on_next = 0;
+        if (head == tail) {
+            head = tail = 0;   // Common case: buffer fully drained, restart at the front for free
+        }
+    }
+
+public:
+    explicit FrameReader(uint32_t max_frame = 1 << 20)
+        : buffer(INITIAL_CAPACITY), head(0), tail(0), consume_on_next(0), max_frame_bytes(max_frame) {}
+
+    // Forget any buffered bytes (new socket, or the stream was abandoned mid-frame)
+    void Reset() {
+        head = tail = consume_on_next = 0;
+    }
+
+    // Unread bytes beyond the frame last returned. Non-zero after a request/response
+    // exchange means the server sent something nobody asked for.
+    size_t Buffered() const {
+        return tail - head - consume_on_next;
+    }
+
+    // Return the next complete frame already in the buffer, without any I/O.
+    // Returns false if more bytes are needed (status FRAME_OK) or the stream is
+    // corrupt (status FRAME_TOO_LARGE).
+    bool NextFrame(const char*& body, uint32_t& length, FrameReadStatus& status) {
+        ReleaseLastFrame();
+        status = FRAME_OK;
+        if (tail - head < 4) return false;
+
+        uint32_t frame_length = ReadBE32(&buffer[head]);
+        if (frame_length > max_frame_bytes) {
+            status = FRAME_TOO_LARGE;
+            return false;
+        }
+        if (tail - head < 4 + (size_t)frame_length) return false;
+
+        body = &buffer[head + 4];
+        length = frame_length;
+        consume_on_next = 4 + (size_t)frame_length;
+        return true;
+    }
+
+    // Free space for the next recv(). Makes room for at least the rest of the
+    // frame being assembled by sliding unread bytes to the front, and only grows
+    // the buffer for a frame larger than anything seen before.
+    char* WriteSpace(size_t& capacity) {
+        ReleaseLastFrame();
+        size_t unread = tail - head;
+        size_t wanted = INITIAL_CAPACITY;
+        if (unread >= 4) {
+            uint32_t frame_length = ReadBE32(&buffer[head]);
+            if (frame_length <= max_frame_bytes && 4 + (size_t)frame_length > wanted) {
+                wanted = 4 + (size_t)frame_length;
+            }
+        }
+
+        size_t needed = wanted > unread ? wanted - unread : 1;
+        if (buffer.size() - tail < needed) {
+            if (head > 0) {
+                memmove(&buffer[0], &buffer[head], unread);
+                head = 0;
+                tail = unread;
+            }
+            if (buffer.size() - tail < needed) {
+                buffer.resize(tail + needed);
+            }
+        }
+        capacity = buffer.size() - tail;
+        return &buffer[tail];
+    }
+
+    void Commit(size_t received) {
+        tail += received;
+    }
+
+    // Read exactly one frame from a non-blocking socket, looping over partial
+    // segments until it is complete or the deadline passes. Surplus bytes that
+    // arrive with the frame stay buffered for the next call.
+    FrameReadStatus ReadFrame(SOCKET sock, const ScoringDeadline& deadline,
+                              const char*& body, uint32_t& length, int& error_code) {
+        error_code = 0;
+        for (;;) {
+            FrameReadStatus status;
+            if (NextFrame(body, length, status)) return FRAME_OK;
+            if (status != FRAME_OK) return status;
+
+            size_t capacity = 0;
+            char* space = WriteSpace(capacity);
+            int received = RecvSomeUntil(sock, space, (int)capacity, deadline, error_code);
+            if (received == 0) return FRAME_CLOSED;
+            if (received < 0) return error_code == WSAETIMEDOUT ? FRAME_TIMEOUT : FRAME_IO_ERROR;
+            Commit((size_t)received);
+        }
+    }
+};
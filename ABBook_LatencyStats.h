@@ -0,0 +1,435 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Per-Stage Latency Histograms     |
+//| Where the time of one routing decision goes, per stage and     |
+//| per instrument group                                           |
+//+------------------------------------------------------------------+
+//
+// Each trade carries a StageTimer on its stack. Mark(stage) charges the time
+// since the previous mark to that stage; the per-stage tick sums stay in the
+// timer until Commit(), which adds one sample per stage to the histograms of
+// the trade's instrument group. The trade path reads the clock about ten
+// times and does relaxed atomic increments - no locks, no allocation.
+//
+// The clock is the TSC on x86 (calibrated against steady_clock once, in
+// Configure) and steady_clock elsewhere.
+//
+// Histograms are log-linear like HdrHistogram: 32 linear sub-buckets per
+// power of two, so any reported value is within ~3% of the true one, from
+// 1 ns to ~68 s. The reporter thread logs the percentiles of the last
+// interval; Query() and Report() give the totals since startup.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#define ABBOOK_STAGE_CLOCK_TSC 1
+#elif defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#include <x86intrin.h>
+#define ABBOOK_STAGE_CLOCK_TSC 1
+#endif
+
+#include "ABBook_PluginLogger.h"
+
+enum LatencyStage {
+    STAGE_SYMBOL = 0,      // Trade entry -> symbol resolved (registry lookup / first-sight cleaning)
+    STAGE_VALIDATE,        // Range checks, normalisation, order filter, threshold lookup
+    STAGE_CACHE,           // Score cache lookup
+    STAGE_ENCODE,          // ScoringRequest encoding
+    STAGE_CONNECT,         // Pool checkout, including a dial when no warm connection is idle
+    STAGE_SEND,            // Request write
+    STAGE_WAIT,            // Until the response frame is complete (multiplexed/batched: whole round trip)
+    STAGE_PARSE,           // ScoringResponse decoding and validation
+    STAGE_DECISION,        // Threshold compare, journal, metrics, decision log lines
+    STAGE_TOTAL,           // MtSrvTradeTransaction entry -> return
+    STAGE_COUNT
+};
+
+inline const char* LatencyStageName(int stage) {
+    static const char* const names[STAGE_COUNT] = {
+        "symbol", "validate", "cache", "encode", "connect", "send", "wait", "parse", "decision", "total"
+    };
+    return stage >= 0 && stage < STAGE_COUNT ? names[stage] : "unknown";
+}
+
+// Raw clock ticks; LatencyStats converts them to nanoseconds
+inline uint64_t StageClockTicks() {
+#ifdef ABBOOK_STAGE_CLOCK_TSC
+    return __rdtsc();
+#else
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+//+------------------------------------------------------------------+
+//| Log-linear histogram of nanosecond values                      |
+//+------------------------------------------------------------------+
+
+class LatencyHistogram {
+public:
+    static const int SUB_BUCKET_BITS = 5;
+    static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const int MAX_EXPONENT = 36;                      // Values >= 2^36 ns (~68 s) share the top bucket
+    static const int BUCKETS = SUB_BUCKETS * (MAX_EXPONENT - SUB_BUCKET_BITS + 2);
+
+    static int HighestBit(uint64_t value) {
+#if defined(_MSC_VER)
+        unsigned long index;
+#if defined(_M_X64)
+        _BitScanReverse64(&index, value);
+        return (int)index;
+#else
+        if (value >> 32) {
+            _BitScanReverse(&index, (unsigned long)(value >> 32));
+            return (int)index + 32;
+        }
+        _BitScanReverse(&index, (unsigned long)value);
+        return (int)index;
+#endif
+#else
+        return 63 - __builtin_clzll(value);
+#endif
+    }
+
+    static int BucketOf(uint64_t ns) {
+        if (ns < (uint64_t)SUB_BUCKETS) return (int)ns;
+        int exponent = HighestBit(ns);
+        if (exponent > MAX_EXPONENT) return BUCKETS - 1;
+        int shift = exponent - SUB_BUCKET_BITS;
+        return SUB_BUCKETS * (shift + 1) + (int)(ns >> shift) - SUB_BUCKETS;
+    }
+
+    // Largest value that lands in the bucket
+    static uint64_t BucketUpper(int bucket) {
+        if (bucket < SUB_BUCKETS) return (uint64_t)bucket;
+        int shift = bucket / SUB_BUCKETS - 1;
+        uint64_t lower = (uint64_t)(SUB_BUCKETS + bucket % SUB_BUCKETS) << shift;
+        return lower + (1ULL << shift) - 1;
+    }
+
+    std::atomic<uint64_t> counts[BUCKETS];
+    std::atomic<uint64_t> total;
+    std::atomic<uint64_t> sum_ns;
+    std::atomic<uint64_t> max_ns;
+
+    LatencyHistogram() {
+        for (auto& count : counts) count.store(0, std::memory_order_relaxed);
+        total.store(0, std::memory_order_relaxed);
+        sum_ns.store(0, std::memory_order_relaxed);
+        max_ns.store(0, std::memory_order_relaxed);
+    }
+
+    void Record(uint64_t ns) {
+        counts[BucketOf(ns)].fetch_add(1, std::memory_order_relaxed);
+        total.fetch_add(1, std::memory_order_relaxed);
+        sum_ns.fetch_add(ns, std::memory_order_relaxed);
+        uint64_t seen = max_ns.load(std::memory_order_relaxed);
+        while (ns > seen && !max_ns.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {
+        }
+    }
+};
+
+// Percentiles of one stage, in nanoseconds
+struct LatencySummary {
+    uint64_t count = 0;
+    uint64_t mean_ns = 0;
+    uint64_t p50_ns = 0;
+    uint64_t p99_ns = 0;
+    uint64_t p999_ns = 0;
+    uint64_t max_ns = 0;
+};
+
+// Plain copy of a histogram's buckets; also used to diff two points in time
+struct LatencyCounts {
+    uint64_t counts[LatencyHistogram::BUCKETS];
+    uint64_t sum_ns;
+    uint64_t max_ns;                  // 0 when unknown (interval diffs): the top bucket's edge is used
+
+    LatencyCounts() { Clear(); }
+
+    void Clear() {
+        memset(counts, 0, sizeof(counts));
+        sum_ns = 0;
+        max_ns = 0;
+    }
+
+    void Add(const LatencyHistogram& histogram) {
+        for (int b = 0; b < LatencyHistogram::BUCKETS; b++) counts[b] += histogram.counts[b].load(std::memory_order_relaxed);
+        sum_ns += histogram.sum_ns.load(std::memory_order_relaxed);
+        uint64_t max = histogram.max_ns.load(std::memory_order_relaxed);
+        if (max > max_ns) max_ns = max;
+    }
+
+    LatencySummary Summarize() const {
+        LatencySummary s;
+        int top = -1;
+        for (int b = 0; b < LatencyHistogram::BUCKETS; b++) {
+            s.count += counts[b];
+            if (counts[b]) top = b;
+        }
+        if (s.count == 0) return s;
+        s.mean_ns = sum_ns / s.count;
+        s.max_ns = max_ns ? max_ns : LatencyHistogram::BucketUpper(top);
+
+        const double quantiles[3] = { 0.50, 0.99, 0.999 };
+        uint64_t* targets[3] = { &s.p50_ns, &s.p99_ns, &s.p999_ns };
+        uint64_t seen = 0;
+        int q = 0;
+        for (int b = 0; b < LatencyHistogram::BUCKETS && q < 3; b++) {
+            seen += counts[b];
+            while (q < 3 && (double)seen >= quantiles[q] * (double)s.count) {
+                uint64_t upper = LatencyHistogram::BucketUpper(b);
+                *targets[q++] = upper < s.max_ns ? upper : s.max_ns;
+            }
+        }
+        return s;
+    }
+};
+
+class LatencyStats;
+
+//+------------------------------------------------------------------+
+//| Per-trade stage timer (stack object, one thread)                |
+//+------------------------------------------------------------------+
+
+class StageTimer {
+private:
+    uint64_t start;
+    uint64_t last;
+    uint64_t ticks[STAGE_COUNT];
+    bool seen[STAGE_COUNT];
+
+public:
+    StageTimer() : start(StageClockTicks()), last(start) {
+        memset(ticks, 0, sizeof(ticks));
+        memset(seen, 0, sizeof(seen));
+    }
+
+    // Charge the time since the previous mark to `stage` (repeat marks add up)
+    void Mark(LatencyStage stage) {
+        uint64_t now = StageClockTicks();
+        ticks[stage] += now - last;
+        seen[stage] = true;
+        last = now;
+    }
+
+    // Restart the interval without charging it to any stage
+    void Skip() { last = StageClockTicks(); }
+
+    friend class LatencyStats;
+};
+
+//+------------------------------------------------------------------+
+//| Histograms per stage and instrument group, periodic log report |
+//+------------------------------------------------------------------+
+
+class LatencyStats {
+public:
+    static const size_t ALL_GROUPS = (size_t)-1;
+
+private:
+    PluginLogger* logger;
+    std::unique_ptr<LatencyHistogram[]> histograms;      // [stage * group_count + group]
+    std::vector<std::string> group_names;
+    std::atomic<bool> enabled;
+    double ns_per_tick;
+
+    std::vector<LatencyCounts> previous;                 // Reporter's last snapshot, same layout
+    int report_interval_sec;
+    std::thread report_thread;
+    std::mutex report_mutex;
+    std::condition_variable report_cv;
+    bool stopping;
+
+    LatencyHistogram& At(int stage, size_t group) {
+        return histograms[(size_t)stage * group_names.size() + group];
+    }
+
+    static double CalibrateNsPerTick() {
+#ifdef ABBOOK_STAGE_CLOCK_TSC
+        auto wall_start = std::chrono::steady_clock::now();
+        uint64_t tick_start = StageClockTicks();
+        while (std::chrono::steady_clock::now() - wall_start < std::chrono::milliseconds(20)) {
+        }
+        uint64_t ticks = StageClockTicks() - tick_start;
+        double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - wall_start).count();
+        return ticks ? ns / (double)ticks : 1.0;
+#else
+        return 1.0;
+#endif
+    }
+
+    static std::string Micros(uint64_t ns) {
+        char text[32];
+        snprintf(text, sizeof(text), "%.1f", (double)ns / 1000.0);
+        return text;
+    }
+
+    static std::string Row(const std::string& label, const LatencySummary& s) {
+        char line[160];
+        snprintf(line, sizeof(line), "  %-22s %9llu %9s %9s %9s %9s %9s", label.c_str(), (unsigned long long)s.count,
+                 Micros(s.mean_ns).c_str(), Micros(s.p50_ns).c_str(), Micros(s.p99_ns).c_str(), Micros(s.p999_ns).c_str(),
+                 Micros(s.max_ns).c_str());
+        return line;
+    }
+
+    static std::string Header() {
+        char line[160];
+        snprintf(line, sizeof(line), "  %-22s %9s %9s %9s %9s %9s %9s", "stage [group] (us)", "count", "mean", "p50", "p99",
+                 "p99.9", "max");
+        return line;
+    }
+
+    // Table of the counts per stage (all groups) and per stage and group
+    std::string Format(const std::vector<LatencyCounts>& counts) const {
+        size_t groups = group_names.size();
+        std::string out = Header() + "\n";
+        std::string per_group;
+        for (int stage = 0; stage < STAGE_COUNT; stage++) {
+            LatencyCounts merged;
+            for (size_t g = 0; g < groups; g++) {
+                const LatencyCounts& c = counts[(size_t)stage * groups + g];
+                for (int b = 0; b < LatencyHistogram::BUCKETS; b++) merged.counts[b] += c.counts[b];
+                merged.sum_ns += c.sum_ns;
+                if (c.max_ns > merged.max_ns) merged.max_ns = c.max_ns;
+            }
+            LatencySummary all = merged.Summarize();
+            if (all.count == 0) continue;
+            out += Row(LatencyStageName(stage), all) + "\n";
+            if (groups > 1) {
+                for (size_t g = 0; g < groups; g++) {
+                    LatencySummary s = counts[(size_t)stage * groups + g].Summarize();
+                    if (s.count) per_group += Row(std::string(LatencyStageName(stage)) + " [" + group_names[g] + "]", s) + "\n";
+                }
+            }
+        }
+        return out + per_group;
+    }
+
+    std::vector<LatencyCounts> Snapshot() {
+        std::vector<LatencyCounts> counts((size_t)STAGE_COUNT * group_names.size());
+        for (size_t i = 0; i < counts.size(); i++) counts[i].Add(histograms[i]);
+        return counts;
+    }
+
+    void ReportLoop() {
+        std::unique_lock<std::mutex> lock(report_mutex);
+        while (!stopping) {
+            report_cv.wait_for(lock, std::chrono::seconds(report_interval_sec));
+            if (stopping) break;
+
+            // Interval = current totals minus the previous snapshot
+            std::vector<LatencyCounts> current = Snapshot();
+            std::vector<LatencyCounts> interval = current;
+            bool any = false;
+            for (size_t i = 0; i < interval.size(); i++) {
+                for (int b = 0; b < LatencyHistogram::BUCKETS; b++) {
+                    interval[i].counts[b] -= previous[i].counts[b];
+                    any = any || interval[i].counts[b] != 0;
+                }
+                interval[i].sum_ns -= previous[i].sum_ns;
+                interval[i].max_ns = 0;
+            }
+            previous.swap(current);
+            if (!any) continue;
+
+            std::string table = Format(interval);
+            logger->Log("LATENCY: stage percentiles for the last " + std::to_string(report_interval_sec) + " s");
+            size_t begin = 0;
+            while (begin < table.size()) {
+                size_t end = table.find('\n', begin);
+                logger->Log("LATENCY:" + table.substr(begin, end - begin));
+                begin = end + 1;
+            }
+        }
+    }
+
+public:
+    explicit LatencyStats(PluginLogger* log)
+        : logger(log), enabled(false), ns_per_tick(1.0), report_interval_sec(60), stopping(false) {}
+
+    ~LatencyStats() {
+        // Never join under the loader lock (DLL_PROCESS_DETACH) - MtSrvCleanup does the orderly Stop()
+        if (report_thread.joinable()) {
+            report_thread.detach();
+        }
+    }
+
+    // Size the histograms for the instrument groups (index = position in
+    // SymbolRegistry::Groups()) and calibrate the clock (~20 ms). Only call
+    // while no trade is being processed (startup).
+    void Configure(const std::vector<std::string>& groups, int interval_sec) {
+        enabled = false;
+        group_names = groups;
+        if (group_names.empty()) group_names.push_back("default");
+        histograms.reset(new LatencyHistogram[(size_t)STAGE_COUNT * group_names.size()]);
+        previous.assign((size_t)STAGE_COUNT * group_names.size(), LatencyCounts());
+        report_interval_sec = interval_sec;
+        ns_per_tick = CalibrateNsPerTick();
+        enabled = true;
+    }
+
+    // Start the periodic log report (interval 0 = never)
+    void Start() {
+        {
+            std::lock_guard<std::mutex> lock(report_mutex);
+            stopping = false;
+        }
+        if (report_interval_sec > 0 && !report_thread.joinable()) {
+            report_thread = std::thread(&LatencyStats::ReportLoop, this);
+        }
+    }
+
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(report_mutex);
+            stopping = true;
+        }
+        report_cv.notify_all();
+        if (report_thread.joinable()) {
+            report_thread.join();
+        }
+    }
+
+    bool Enabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Trade path: one sample per marked stage plus the total since the timer started
+    void Commit(StageTimer& timer, size_t group) {
+        if (!Enabled()) return;
+        if (group >= group_names.size()) group = group_names.size() - 1;
+        for (int stage = 0; stage < STAGE_TOTAL; stage++) {
+            if (timer.seen[stage]) At(stage, group).Record((uint64_t)((double)timer.ticks[stage] * ns_per_tick));
+        }
+        At(STAGE_TOTAL, group).Record((uint64_t)((double)(StageClockTicks() - timer.start) * ns_per_tick));
+    }
+
+    // Totals since startup for one stage, one group or ALL_GROUPS
+    LatencySummary Query(LatencyStage stage, size_t group = ALL_GROUPS) {
+        LatencyCounts counts;
+        if (!Enabled() || stage < 0 || stage >= STAGE_COUNT) return counts.Summarize();
+        for (size_t g = 0; g < group_names.size(); g++) {
+            if (group == ALL_GROUPS || group == g) counts.Add(At(stage, g));
+        }
+        return counts.Summarize();
+    }
+
+    // Totals since startup as a text table
+    std::string Report() {
+        if (!Enabled()) return "Stage timers disabled\n";
+        return Format(Snapshot());
+    }
+
+    const std::vector<std::string>& Groups() const { return group_names; }
+};
@@ -0,0 +1,136 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - MT4 Server API Structures        |
+//| TradeRecord and UserInfo as the MT4 server passes them in,     |
+//| from the official MT4ManagerAPI.h                              |
+//+------------------------------------------------------------------+
+//
+// The server passes these by pointer: never reorder or add members. The
+// helpers at the end classify a trade the way the router needs it.
+
+#pragma once
+
+#include <ctime>
+#include <string>
+
+// Time type from official API
+#ifndef __time32_t
+#define __time32_t time_t
+#endif
+
+// Order states from official API
+enum { ORDER_OPENED=0, ORDER_CLOSED, ORDER_DELETED, ORDER_CANCELED };
+
+// Order commands from official API  
+enum { OP_BUY=0, OP_SELL, OP_BUYLIMIT, OP_SELLLIMIT, OP_BUYSTOP, OP_SELLSTOP };
+
+//--- Official MT4 Trade Record structure
+struct TradeRecord
+{
+    int            order;              // order ticket
+    int            login;              // user login
+    char           symbol[12];         // currency
+    int            digits;             // digits  
+    int            cmd;               // command
+    int            volume;            // volume (in lots*100)
+    __time32_t     open_time;         // open time
+    int            state;             // reserved  
+    double         open_price;        // open price
+    double         sl, tp;           // stop loss & take profit
+    double         close_price;       // close price
+    __time32_t     close_time;        // close time
+    int            reason;            // close reason
+    double         commission;        // commission
+    double         commission_agent;  // agent commission  
+    double         storage;           // order swaps
+    double         profit;            // floating profit
+    double         taxes;             // taxes
+    char           comment[32];       // order comment
+    int            margin_rate;       // margin rate
+    __time32_t     timestamp;         // timestamp
+    int            api_data[4];       // for API usage
+};
+
+//--- Official MT4 User Info structure  
+struct UserInfo
+{
+    int            login;             // login
+    char           group[16];         // group
+    char           password[16];      // password  
+    int            enable;            // enable
+    int            enable_change_password; // allow to change password
+    int            enable_readonly;   // allow to open/positions (first bit-buy,second bit-sell)
+    int            password_investor[16]; // investor password
+    char           password_phone[16]; // phone password
+    char           name[128];         // name
+    char           country[32];       // country
+    char           city[32];          // city
+    char           state[32];         // state
+    char           zipcode[16];       // zipcode
+    char           address[128];      // address
+    char           phone[32];         // phone
+    char           email[48];         // email
+    char           comment[64];       // comment
+    char           id[32];           // SSN (IRD)
+    char           status[16];       // status
+    __time32_t     regdate;          // registration date
+    __time32_t     lastdate;         // last coonection time
+    int            leverage;         // leverage
+    int            agent_account;    // agent account
+    __time32_t     timestamp;        // timestamp
+    double         balance;          // balance
+    double         prevmonthbalance; // previous month balance  
+    double         prevbalance;      // previous day balance
+    double         credit;           // credit
+    double         interestrate;     // accumulated interest rate
+    double         taxes;            // taxes
+    double         prevmonthequity;  // previous month equity
+    double         prevequity;       // previous day equity
+    char           reserved[104];    // reserved
+    int            margin_mode;      // margin calculation mode
+    double         margin_so_mode;   // margin stop out mode
+    double         margin_free_mode; // margin free mode (0-don't use,1-use)
+    double         margin_call;      // margin call level  
+    double         margin_stopout;   // stop out level
+    char           reserved2[104];   // reserved  
+    char           publickey[270];   // RSA public key
+    int            reserved3[4];     // reserved
+};
+
+//+------------------------------------------------------------------+
+//| Trade classification                                           |
+//+------------------------------------------------------------------+
+
+inline std::string GetCommandName(int cmd) {
+    switch (cmd) {
+        case OP_BUY: return "BUY";
+        case OP_SELL: return "SELL";
+        case OP_BUYLIMIT: return "BUYLIMIT";
+        case OP_SELLLIMIT: return "SELLLIMIT";
+        case OP_BUYSTOP: return "BUYSTOP";
+        case OP_SELLSTOP: return "SELLSTOP";
+        default: return "UNKNOWN";
+    }
+}
+
+inline bool ShouldProcessTrade(const TradeRecord* trade) {
+    // Only process new market orders (BUY/SELL)
+    if (trade->cmd != OP_BUY && trade->cmd != OP_SELL) {
+        return false;
+    }
+    
+    // Only process opening trades
+    if (trade->state != ORDER_OPENED) {
+        return false;
+    }
+    
+    return true;
+}
+
+// New pending orders and closed market positions - account activity that is
+// often followed by a market order on the same symbol
+inline bool IsPrescoreSignal(const TradeRecord* trade) {
+    if (trade->cmd >= OP_BUYLIMIT && trade->cmd <= OP_SELLSTOP) {
+        return trade->state == ORDER_OPENED;
+    }
+    return (trade->cmd == OP_BUY || trade->cmd == OP_SELL) && trade->state == ORDER_CLOSED;
+}
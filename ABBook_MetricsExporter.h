@@ -0,0 +1,491 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - InfluxDB Metrics Exporter        |
+//| Counters and latency histograms aggregated in memory, flushed  |
+//| as batched line-protocol POSTs from a background thread        |
+//+------------------------------------------------------------------+
+//
+// The trade path only increments relaxed atomics: a decision counter per
+// (instrument group, decision, score source) and a log2 latency histogram
+// per group. It never formats text, allocates or touches a socket.
+//
+// Every FlushIntervalMs the exporter thread swaps the counters to zero,
+// writes one line per non-zero series (deltas for the interval) and POSTs
+// the batch to InfluxURL (InfluxDB 1.x /write or any line-protocol
+// endpoint). A failed POST keeps the batch and retries it with the next
+// interval; past MAX_PENDING_BYTES the oldest lines are dropped.
+//
+//   abbook_decisions,group=FXMajors,decision=A_BOOK,source=ML count=42i 1760000000000000000
+//   abbook_scoring_latency,group=FXMajors count=42i,sum_us=61000i,max_us=4100i,p50_us=2048i,p90_us=4096i,p99_us=4100i ...
+//   abbook_prescore queued=12i,dropped=0i,stored=11i,hits=7i,hit_rate=0.6364 ...
+//   abbook_breaker state=0i,opened=1i,half_opened=3i,closed=1i,open_ms=4021i ...
+//   abbook_exporter pending_bytes=0i,dropped_lines=0i,failed_posts=0i ...
+//
+// The prescore line is read from a counter source the plugin installs
+// (SetPrescoreSource); its counts are interval deltas, hit_rate is hits per
+// stored pre-score since startup. The breaker line likewise comes from
+// SetBreakerSource: state is the circuit breaker's state at flush time
+// (0 closed, 1 open, 2 half-open), the transition counts and open_ms (time
+// the breaker spent away from closed) are interval deltas.
+//
+// Only plain http:// is supported.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <condition_variable>
+
+#include "ABBook_Platform.h"
+#include "ABBook_PluginLogger.h"
+#include "ABBook_SocketIO.h"
+#include "ABBook_DecisionJournal.h"
+
+// http://host[:port]/path[?query]
+struct HttpEndpoint {
+    std::string host;
+    int port = 80;
+    std::string target = "/";              // Path and query sent in the request line
+
+    bool Parse(const std::string& url) {
+        const std::string scheme = "http://";
+        if (url.compare(0, scheme.size(), scheme) != 0) return false;
+        size_t host_begin = scheme.size();
+        size_t slash = url.find('/', host_begin);
+        std::string authority = url.substr(host_begin, slash == std::string::npos ? std::string::npos : slash - host_begin);
+        target = slash == std::string::npos ? "/" : url.substr(slash);
+
+        size_t colon = authority.rfind(':');
+        if (colon != std::string::npos) {
+            port = atoi(authority.c_str() + colon + 1);
+            authority.resize(colon);
+        }
+        host = authority;
+        return !host.empty() && port > 0 && port < 65536;
+    }
+};
+
+// Cumulative speculative pre-scoring counters
+struct PrescoreCounters {
+    unsigned long long queued = 0;             // Requests handed to the pre-scorer
+    unsigned long long dropped = 0;            // Queue full
+    unsigned long long stored = 0;             // Scores stored in the cache
+    unsigned long long hits = 0;               // Pre-scores served to a market order
+};
+
+// Cumulative scoring service circuit breaker counters
+struct BreakerCounters {
+    int state = 0;                             // BreakerState at the time of reading
+    unsigned long long opened = 0;             // Transitions into OPEN
+    unsigned long long half_opened = 0;        // Probes sent
+    unsigned long long closed = 0;             // Successful probes
+    unsigned long long open_ms = 0;            // Time spent OPEN or HALF_OPEN
+};
+
+class MetricsExporter {
+public:
+    static const size_t MAX_GROUPS = 16;             // With more groups, the last slot is shared and tagged `other`
+    static const int LATENCY_BUCKETS = 24;           // Bucket b holds [2^b, 2^(b+1)) us; bucket 0 also holds 0
+    static const size_t MAX_PENDING_BYTES = 1 << 20; // Unsent line protocol kept while InfluxDB is down
+
+private:
+    struct alignas(64) GroupMetrics {
+        std::atomic<uint64_t> decisions[2][SCORE_SOURCE_COUNT];
+        std::atomic<uint64_t> latency_buckets[LATENCY_BUCKETS];
+        std::atomic<uint64_t> latency_sum_us;
+        std::atomic<uint64_t> latency_max_us;
+    };
+
+    struct GroupSnapshot {
+        uint64_t decisions[2][SCORE_SOURCE_COUNT];
+        uint64_t latency_buckets[LATENCY_BUCKETS];
+        uint64_t latency_count;
+        uint64_t latency_sum_us;
+        uint64_t latency_max_us;
+    };
+
+    PluginLogger* logger;
+    GroupMetrics groups[MAX_GROUPS];
+    std::vector<std::string> group_tags;             // Escaped group names, index = symbol.group slot
+
+    HttpEndpoint endpoint;
+    int timeout_ms;
+    int flush_interval_ms;
+
+    std::mutex flush_mutex;                          // One Flush() at a time
+    std::string pending;                             // Line protocol not yet accepted by the server
+    unsigned long long dropped_lines;
+    unsigned long long failed_posts;
+    unsigned long long posted_batches;
+    bool last_post_failed;
+
+    std::function<PrescoreCounters()> prescore_source;
+    PrescoreCounters prescore_reported;              // Totals as of the previous interval
+    std::function<BreakerCounters()> breaker_source;
+    BreakerCounters breaker_reported;
+
+    std::thread flush_thread;
+    std::mutex thread_mutex;
+    std::condition_variable thread_cv;
+    bool stopping;
+    bool winsock_started;
+
+    static int LatencyBucket(uint32_t latency_us) {
+        int bucket = 0;
+        while (latency_us > 1 && bucket < LATENCY_BUCKETS - 1) {
+            latency_us >>= 1;
+            bucket++;
+        }
+        return bucket;
+    }
+
+    // Upper edge of the bucket holding the q-th fraction of samples, capped at the observed max
+    static uint64_t Percentile(const GroupSnapshot& s, double q) {
+        uint64_t rank = (uint64_t)(q * (double)s.latency_count + 0.5);
+        if (rank < 1) rank = 1;
+        uint64_t seen = 0;
+        for (int b = 0; b < LATENCY_BUCKETS; b++) {
+            seen += s.latency_buckets[b];
+            if (seen >= rank) {
+                uint64_t upper = (2ULL << b) - 1;
+                return upper < s.latency_max_us ? upper : s.latency_max_us;
+            }
+        }
+        return s.latency_max_us;
+    }
+
+    // Tag values escape commas, spaces and equals signs
+    static std::string EscapeTag(const std::string& value) {
+        std::string out;
+        for (char c : value) {
+            if (c == ',' || c == ' ' || c == '=') out += '\\';
+            out += c;
+        }
+        return out;
+    }
+
+    static uint64_t NowNs() {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    // Swap every counter of the interval to zero and append its lines to `out`
+    void Collect(std::string& out) {
+        char line[512];
+        std::string timestamp = std::to_string(NowNs());
+        size_t backlog = out.size();                 // Left over from failed POSTs
+
+        for (size_t g = 0; g < group_tags.size(); g++) {
+            GroupMetrics& metrics = groups[g];
+            GroupSnapshot s;
+            for (int d = 0; d < 2; d++) {
+                for (int src = 0; src < SCORE_SOURCE_COUNT; src++) {
+                    s.decisions[d][src] = metrics.decisions[d][src].exchange(0, std::memory_order_relaxed);
+                }
+            }
+            for (int b = 0; b < LATENCY_BUCKETS; b++) {
+                s.latency_buckets[b] = metrics.latency_buckets[b].exchange(0, std::memory_order_relaxed);
+            }
+            s.latency_sum_us = metrics.latency_sum_us.exchange(0, std::memory_order_relaxed);
+            s.latency_max_us = metrics.latency_max_us.exchange(0, std::memory_order_relaxed);
+
+            for (int d = 0; d < 2; d++) {
+                for (int src = 0; src < SCORE_SOURCE_COUNT; src++) {
+                    if (s.decisions[d][src] == 0) continue;
+                    snprintf(line, sizeof(line), "abbook_decisions,group=%s,decision=%s,source=%s count=%llui %s\n",
+                             group_tags[g].c_str(), d ? "B_BOOK" : "A_BOOK", JournalScoreSourceName((uint8_t)src),
+                             (unsigned long long)s.decisions[d][src], timestamp.c_str());
+                    out += line;
+                }
+            }
+
+            // The count is the bucket total; sum and max are swapped separately,
+            // so a trade recorded mid-swap may split across two intervals
+            s.latency_count = 0;
+            for (int b = 0; b < LATENCY_BUCKETS; b++) s.latency_count += s.latency_buckets[b];
+            if (s.latency_count == 0) continue;
+            snprintf(line, sizeof(line),
+                     "abbook_scoring_latency,group=%s count=%llui,sum_us=%llui,max_us=%llui,p50_us=%llui,p90_us=%llui,p99_us=%llui %s\n",
+                     group_tags[g].c_str(), (unsigned long long)s.latency_count, (unsigned long long)s.latency_sum_us,
+                     (unsigned long long)s.latency_max_us, (unsigned long long)Percentile(s, 0.50),
+                     (unsigned long long)Percentile(s, 0.90), (unsigned long long)Percentile(s, 0.99), timestamp.c_str());
+            out += line;
+        }
+
+        if (prescore_source) {
+            PrescoreCounters now = prescore_source();
+            PrescoreCounters& was = prescore_reported;
+            if (now.queued != was.queued || now.dropped != was.dropped || now.stored != was.stored || now.hits != was.hits) {
+                snprintf(line, sizeof(line), "abbook_prescore queued=%llui,dropped=%llui,stored=%llui,hits=%llui,hit_rate=%.4f %s\n",
+                         now.queued - was.queued, now.dropped - was.dropped, now.stored - was.stored, now.hits - was.hits,
+                         now.stored ? (double)now.hits / (double)now.stored : 0.0, timestamp.c_str());
+                out += line;
+                was = now;
+            }
+        }
+
+        if (breaker_source) {
+            BreakerCounters now = breaker_source();
+            BreakerCounters& was = breaker_reported;
+            snprintf(line, sizeof(line), "abbook_breaker state=%di,opened=%llui,half_opened=%llui,closed=%llui,open_ms=%llui %s\n",
+                     now.state, now.opened - was.opened, now.half_opened - was.half_opened, now.closed - was.closed,
+                     now.open_ms - was.open_ms, timestamp.c_str());
+            out += line;
+            was = now;
+        }
+
+        snprintf(line, sizeof(line), "abbook_exporter pending_bytes=%llui,dropped_lines=%llui,failed_posts=%llui %s\n",
+                 (unsigned long long)backlog, dropped_lines, failed_posts, timestamp.c_str());
+        out += line;
+    }
+
+    // Keep the newest MAX_PENDING_BYTES, cutting at a line boundary
+    void TrimPending() {
+        if (pending.size() <= MAX_PENDING_BYTES) return;
+        size_t cut = pending.find('\n', pending.size() - MAX_PENDING_BYTES);
+        cut = cut == std::string::npos ? pending.size() : cut + 1;
+        for (size_t i = 0; i < cut; i++) {
+            if (pending[i] == '\n') dropped_lines++;
+        }
+        pending.erase(0, cut);
+    }
+
+    // One POST on a fresh connection. Returns true on a 2xx status.
+    bool Post(const std::string& body, std::string& error) {
+        ScoringDeadline deadline = ScoringDeadline::In(timeout_ms);
+
+        addrinfo hints;
+        memset(&hints, 0, sizeof(hints));
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* resolved = nullptr;
+        if (getaddrinfo(endpoint.host.c_str(), std::to_string(endpoint.port).c_str(), &hints, &resolved) != 0 || !resolved) {
+            error = "cannot resolve " + endpoint.host;
+            return false;
+        }
+        sockaddr_in address;
+        memcpy(&address, resolved->ai_addr, sizeof(address));
+        freeaddrinfo(resolved);
+
+        SOCKET sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        if (sock == INVALID_SOCKET) {
+            error = "socket() failed (WSA error: " + std::to_string(WSAGetLastError()) + ")";
+            return false;
+        }
+        int error_code = 0;
+        bool ok = SetSocketNonBlocking(sock, true);
+        if (ok && connect(sock, (sockaddr*)&address, sizeof(address)) == SOCKET_ERROR) {
+            error_code = WSAGetLastError();
+            ok = IsWouldBlock(error_code) && WaitSocket(sock, true, deadline) == SOCKET_WAIT_READY;
+            int so_error = SocketError(sock);
+            if (so_error != 0) {
+                error_code = so_error;
+                ok = false;
+            }
+        }
+        if (!ok) {
+            error = "connect failed (WSA error: " + std::to_string(error_code) + ")";
+            closesocket(sock);
+            return false;
+        }
+
+        std::string request = "POST " + endpoint.target + " HTTP/1.1\r\n"
+                              "Host: " + endpoint.host + ":" + std::to_string(endpoint.port) + "\r\n"
+                              "Content-Type: text/plain; charset=utf-8\r\n"
+                              "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                              "Connection: close\r\n\r\n";
+        if (!SendAllUntil(sock, request.data(), (int)request.size(), deadline, error_code) ||
+            !SendAllUntil(sock, body.data(), (int)body.size(), deadline, error_code)) {
+            error = "send failed (WSA error: " + std::to_string(error_code) + ")";
+            closesocket(sock);
+            return false;
+        }
+
+        // The status line is all we need
+        std::string response;
+        char buffer[512];
+        while (response.find("\r\n") == std::string::npos && response.size() < 4096) {
+            int received = RecvSomeUntil(sock, buffer, sizeof(buffer), deadline, error_code);
+            if (received <= 0) break;
+            response.append(buffer, received);
+        }
+        closesocket(sock);
+
+        int status = 0;
+        if (sscanf(response.c_str(), "HTTP/%*d.%*d %d", &status) != 1) {
+            error = response.empty() ? "no response (WSA error: " + std::to_string(error_code) + ")" : "malformed response";
+            return false;
+        }
+        if (status < 200 || status > 299) {
+            error = "HTTP " + std::to_string(status);
+            return false;
+        }
+        return true;
+    }
+
+    void FlushLoop() {
+        std::unique_lock<std::mutex> lock(thread_mutex);
+        while (!stopping) {
+            thread_cv.wait_for(lock, std::chrono::milliseconds(flush_interval_ms));
+            if (stopping) break;
+            lock.unlock();
+            Flush();
+            lock.lock();
+        }
+    }
+
+public:
+    explicit MetricsExporter(PluginLogger* log)
+        : logger(log), timeout_ms(2000), flush_interval_ms(10000), dropped_lines(0), failed_posts(0),
+          posted_batches(0), last_post_failed(false), stopping(false), winsock_started(false) {
+        for (GroupMetrics& metrics : groups) {
+            for (auto& row : metrics.decisions) {
+                for (auto& counter : row) counter.store(0, std::memory_order_relaxed);
+            }
+            for (auto& bucket : metrics.latency_buckets) bucket.store(0, std::memory_order_relaxed);
+            metrics.latency_sum_us.store(0, std::memory_order_relaxed);
+            metrics.latency_max_us.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    ~MetricsExporter() {
+        // Never join under the loader lock (DLL_PROCESS_DETACH) - MtSrvCleanup does the orderly Stop()
+        if (flush_thread.joinable()) {
+            flush_thread.detach();
+        }
+    }
+
+    // Name the group slots (index = position in SymbolRegistry::Groups()) and
+    // set the endpoint. Returns false for a URL that is not http://host[:port]/...
+    // Only call while no trade is being processed (startup).
+    bool Configure(const std::vector<std::string>& group_names, const std::string& url, int timeout, int interval_ms) {
+        group_tags.clear();
+        size_t named = group_names.size() > MAX_GROUPS ? MAX_GROUPS - 1 : group_names.size();
+        for (size_t g = 0; g < named; g++) {
+            group_tags.push_back(EscapeTag(group_names[g]));
+        }
+        if (named < group_names.size()) {
+            // Record() folds every later group into the last slot: never report it under one group's name
+            group_tags.push_back("other");
+            ABBOOK_LOG_WARN(*logger, "METRICS: " + std::to_string(group_names.size()) + " instrument groups - only the first " +
+                            std::to_string(named) + " are exported by name, '" + group_names[named] + "' and later as group=other");
+        }
+        if (group_tags.empty()) group_tags.push_back("default");
+        timeout_ms = timeout > 0 ? timeout : 2000;
+        flush_interval_ms = interval_ms > 0 ? interval_ms : 10000;
+        return endpoint.Parse(url);
+    }
+
+    // Report pre-scoring from `source` (called on the flush thread). Call before Start().
+    void SetPrescoreSource(std::function<PrescoreCounters()> source) {
+        std::lock_guard<std::mutex> lock(flush_mutex);
+        prescore_source = source;
+        prescore_reported = PrescoreCounters();
+    }
+
+    // Report the circuit breaker from `source` (called on the flush thread). Call before Start().
+    void SetBreakerSource(std::function<BreakerCounters()> source) {
+        std::lock_guard<std::mutex> lock(flush_mutex);
+        breaker_source = source;
+        breaker_reported = BreakerCounters();
+    }
+
+    // Start the background flush thread
+    void Start() {
+        if (!winsock_started) {
+            WSADATA wsaData;
+            winsock_started = WSAStartup(MAKEWORD(2, 2), &wsaData) == 0;
+        }
+        {
+            std::lock_guard<std::mutex> lock(thread_mutex);
+            stopping = false;
+        }
+        if (!flush_thread.joinable()) {
+            flush_thread = std::thread(&MetricsExporter::FlushLoop, this);
+        }
+    }
+
+    // Stop the thread and make one last attempt to deliver everything collected
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(thread_mutex);
+            stopping = true;
+        }
+        thread_cv.notify_all();
+        if (flush_thread.joinable()) {
+            flush_thread.join();
+            Flush();
+        }
+        if (winsock_started) {
+            WSACleanup();
+            winsock_started = false;
+        }
+    }
+
+    // Trade path: count one routing decision. latency_us is the scoring round
+    // trip; it is left out of the histogram when no request was attempted
+    // (backoff, cache hit).
+    void Record(size_t group, bool b_book, JournalScoreSource source, uint32_t latency_us) {
+        if (group >= MAX_GROUPS) group = MAX_GROUPS - 1;
+        if ((int)source < 0 || source >= SCORE_SOURCE_COUNT) source = SCORE_SOURCE_FALLBACK_ERROR;
+        GroupMetrics& metrics = groups[group];
+        metrics.decisions[b_book ? 1 : 0][source].fetch_add(1, std::memory_order_relaxed);
+        if (source == SCORE_SOURCE_FALLBACK_BACKOFF || source == SCORE_SOURCE_FALLBACK_BUSY ||
+            source == SCORE_SOURCE_CACHE || source == SCORE_SOURCE_CACHE_STALE) return;
+
+        metrics.latency_buckets[LatencyBucket(latency_us)].fetch_add(1, std::memory_order_relaxed);
+        metrics.latency_sum_us.fetch_add(latency_us, std::memory_order_relaxed);
+        uint64_t seen = metrics.latency_max_us.load(std::memory_order_relaxed);
+        while (latency_us > seen &&
+               !metrics.latency_max_us.compare_exchange_weak(seen, latency_us, std::memory_order_relaxed)) {
+        }
+    }
+
+    // Collect the current interval and POST everything pending. Called by the
+    // flush thread; tests call it directly. Returns true once the server accepted it.
+    bool Flush() {
+        std::lock_guard<std::mutex> lock(flush_mutex);
+        Collect(pending);
+        TrimPending();
+
+        std::string error;
+        if (Post(pending, error)) {
+            pending.clear();
+            posted_batches++;
+            if (last_post_failed) logger->Log("METRICS: InfluxDB reachable again - backlog delivered");
+            last_post_failed = false;
+            return true;
+        }
+        failed_posts++;
+        if (!last_post_failed) {
+            ABBOOK_LOG_WARN(*logger, "METRICS: POST to " + endpoint.host + ":" + std::to_string(endpoint.port) + " failed (" + error +
+                            ") - keeping metrics and retrying every " + std::to_string(flush_interval_ms) + " ms");
+        }
+        last_post_failed = true;
+        return false;
+    }
+
+    const HttpEndpoint& Endpoint() const { return endpoint; }
+
+    size_t PendingBytes() {
+        std::lock_guard<std::mutex> lock(flush_mutex);
+        return pending.size();
+    }
+
+    unsigned long long DroppedLines() {
+        std::lock_guard<std::mutex> lock(flush_mutex);
+        return dropped_lines;
+    }
+
+    unsigned long long PostedBatches() {
+        std::lock_guard<std::mutex> lock(flush_mutex);
+        return posted_batches;
+    }
+};
@@ -0,0 +1,380 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Multiplexed Scoring Channel      |
+//| Many trade threads share one connection; responses are matched |
+//| by request ID and may arrive out of order                      |
+//+------------------------------------------------------------------+
+//
+// Frame format (EnableMultiplexing=true), identical in both directions:
+//
+//   [4-byte big-endian length][4-byte big-endian request_id][protobuf body]
+//
+// The outer length is the same prefix CreateLengthPrefixedMessage writes; it
+// counts the request_id plus the body. The scoring service must echo the
+// request_id of the ScoringRequest in front of the matching ScoringResponse.
+//
+// Call() blocks the caller until its response. CallAsync() returns once the
+// frame is sent and hands the outcome to a callback on the reader thread;
+// the scoring I/O threads use it so that requests in flight are not capped
+// by the number of I/O threads. The reader also expires asynchronous calls
+// that pass their deadline unanswered.
+
+#pragma once
+
+#include <string>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <unordered_map>
+#include <functional>
+#include <vector>
+
+#include "ABBook_Platform.h"
+#include "ABBook_PluginLogger.h"
+#include "ABBook_ConnectionPool.h"
+#include "ABBook_SocketIO.h"
+#include "ABBook_FrameReader.h"
+
+enum ChannelStatus {
+    CHANNEL_OK = 0,
+    CHANNEL_CONNECT_FAILED,
+    CHANNEL_SEND_FAILED,
+    CHANNEL_TIMEOUT,
+    CHANNEL_DISCONNECTED
+};
+
+// Outcome of a CallAsync(): the response body with CHANNEL_OK, otherwise
+// CHANNEL_TIMEOUT or CHANNEL_DISCONNECTED. Runs on the channel's reader thread.
+typedef std::function<void(ChannelStatus status, const char* body, uint32_t length)> ChannelCallback;
+
+class MultiplexedScoringChannel {
+private:
+    static const uint32_t MAX_FRAME_BYTES = 1 << 20;
+    // In-class constants have no out-of-line definition: pass copies (int(X)), never bind them to a reference
+    static const int SWEEP_INTERVAL_MS = 1;          // Expiry check of asynchronous calls
+    static const int IDLE_WAIT_MS = 10;              // Longest idle wait: a CallAsync() made meanwhile is seen this late at worst
+
+    // A Call() waiter on the caller's stack, or a heap-allocated CallAsync()
+    // entry (callback set) that whoever removes it from `pending` completes
+    struct PendingRequest {
+        std::string response;
+        bool done = false;
+        bool failed = false;
+        std::condition_variable cv;
+        ChannelCallback callback;
+        std::chrono::steady_clock::time_point expires;
+    };
+
+    PluginLogger* logger;
+    ScoringConnectionPool* dialer;     // Reuses the pool's socket setup (NODELAY, keepalive)
+
+    std::mutex connect_mutex;          // Serialises (re)connects
+    std::mutex send_mutex;             // One whole frame on the wire at a time
+    SOCKET sock;
+    std::thread reader_thread;
+    std::atomic<bool> connected;
+
+    std::mutex pending_mutex;
+    std::unordered_map<uint32_t, PendingRequest*> pending;
+    std::atomic<uint32_t> next_request_id;
+    std::atomic<size_t> async_pending;
+
+    static uint32_t ReadBE32(const char* p) {
+        return ((uint32_t)(unsigned char)p[0] << 24) |
+               ((uint32_t)(unsigned char)p[1] << 16) |
+               ((uint32_t)(unsigned char)p[2] << 8) |
+               ((uint32_t)(unsigned char)p[3]);
+    }
+
+    static void WriteBE32(char* p, uint32_t value) {
+        p[0] = (char)((value >> 24) & 0xFF);
+        p[1] = (char)((value >> 16) & 0xFF);
+        p[2] = (char)((value >> 8) & 0xFF);
+        p[3] = (char)(value & 0xFF);
+    }
+
+    // Callbacks run outside pending_mutex; the entry belongs to the caller here
+    void FinishAsync(PendingRequest* req, ChannelStatus status, const char* body, uint32_t length) {
+        async_pending.fetch_sub(1, std::memory_order_relaxed);
+        req->callback(status, body, length);
+        delete req;
+    }
+
+    void Complete(uint32_t request_id, const char* body, uint32_t length) {
+        PendingRequest* async_req = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            auto it = pending.find(request_id);
+            if (it == pending.end()) {
+                return; // Caller already timed out - late response is dropped
+            }
+            PendingRequest* req = it->second;
+            pending.erase(it);
+            if (req->callback) {
+                async_req = req;
+            } else {
+                req->response.assign(body, length);
+                req->done = true;
+                req->cv.notify_one();
+            }
+        }
+        if (async_req) FinishAsync(async_req, CHANNEL_OK, body, length);
+    }
+
+    void FailAllPending() {
+        std::vector<PendingRequest*> failed_async;
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            for (auto& entry : pending) {
+                if (entry.second->callback) {
+                    failed_async.push_back(entry.second);
+                    continue;
+                }
+                entry.second->done = true;
+                entry.second->failed = true;
+                entry.second->cv.notify_one();
+            }
+            pending.clear();
+        }
+        for (PendingRequest* req : failed_async) FinishAsync(req, CHANNEL_DISCONNECTED, nullptr, 0);
+    }
+
+    // Asynchronous calls past their deadline get CHANNEL_TIMEOUT; their late responses are dropped
+    void ExpireAsync() {
+        if (async_pending.load(std::memory_order_relaxed) == 0) return;
+        std::vector<PendingRequest*> expired;
+        auto now = std::chrono::steady_clock::now();
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            for (auto it = pending.begin(); it != pending.end();) {
+                if (it->second->callback && it->second->expires <= now) {
+                    expired.push_back(it->second);
+                    it = pending.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+        for (PendingRequest* req : expired) FinishAsync(req, CHANNEL_TIMEOUT, nullptr, 0);
+    }
+
+    // Owns the receive side of the connection. On any error it marks the channel
+    // broken and wakes every waiter; the socket itself is closed by the next
+    // EnsureConnected() so a sender can never write to a recycled handle.
+    void ReaderLoop(SOCKET s) {
+        FrameReader reader(MAX_FRAME_BYTES);
+        auto next_sweep = std::chrono::steady_clock::now();
+
+        for (;;) {
+            auto now = std::chrono::steady_clock::now();
+            if (now >= next_sweep) {
+                ExpireAsync();
+                next_sweep = now + std::chrono::milliseconds(int(SWEEP_INTERVAL_MS));
+            }
+
+            const char* frame = nullptr;
+            uint32_t length = 0;
+            FrameReadStatus status;
+            if (reader.NextFrame(frame, length, status)) {
+                if (length < 4) {
+                    ABBOOK_LOG_WARN(*logger, "ML SERVICE CHANNEL: Invalid frame length " + std::to_string(length) + " - resetting connection");
+                    break;
+                }
+                Complete(ReadBE32(frame), frame + 4, length - 4);
+                continue;
+            }
+            if (status != FRAME_OK) {
+                ABBOOK_LOG_WARN(*logger, "ML SERVICE CHANNEL: Oversized frame - resetting connection");
+                break;
+            }
+
+            size_t capacity = 0;
+            char* space = reader.WriteSpace(capacity);
+            int bytes_received = recv(s, space, (int)capacity, 0);
+            if (bytes_received == SOCKET_ERROR && IsWouldBlock(WSAGetLastError())) {
+                // Idle: wait for the next frame (or shutdown() from Stop/a failed send), waking
+                // for the expiry sweep. Never wait unbounded - a CallAsync() made while we sit
+                // here does not wake us, and its deadline must still be swept if no reply comes.
+                bool sweeping = async_pending.load(std::memory_order_relaxed) > 0;
+                long long wait_us = (long long)(sweeping ? SWEEP_INTERVAL_MS : IDLE_WAIT_MS) * 1000;
+                if (PollSocket(s, false, wait_us) < 0) break;
+                continue;
+            }
+            if (bytes_received <= 0) break;
+            reader.Commit((size_t)bytes_received);
+        }
+
+        connected.store(false, std::memory_order_release);
+        FailAllPending();
+    }
+
+    bool EnsureConnected(int& error_code, const ScoringDeadline& deadline) {
+        error_code = 0;
+        if (connected.load(std::memory_order_acquire)) return true;
+
+        std::lock_guard<std::mutex> lock(connect_mutex);
+        if (connected.load(std::memory_order_acquire)) return true;
+
+        if (reader_thread.joinable()) {
+            reader_thread.join();
+        }
+        {
+            std::lock_guard<std::mutex> send_lock(send_mutex);
+            if (sock != INVALID_SOCKET) {
+                closesocket(sock);
+                sock = INVALID_SOCKET;
+            }
+        }
+
+        if (!dialer->EnsureWinsock()) {
+            error_code = WSANOTINITIALISED;
+            return false;
+        }
+        SOCKET s = dialer->Dial(error_code, deadline);
+        if (s == INVALID_SOCKET) return false;
+
+        {
+            std::lock_guard<std::mutex> send_lock(send_mutex);
+            sock = s;
+        }
+        connected.store(true, std::memory_order_release);
+        reader_thread = std::thread(&MultiplexedScoringChannel::ReaderLoop, this, s);
+        logger->Log("ML SERVICE CHANNEL: Multiplexed connection established");
+        return true;
+    }
+
+public:
+    MultiplexedScoringChannel(PluginLogger* log, ScoringConnectionPool* pool)
+        : logger(log), dialer(pool), sock(INVALID_SOCKET),
+          connected(false), next_request_id(1), async_pending(0) {}
+
+    ~MultiplexedScoringChannel() {
+        if (reader_thread.joinable()) {
+            reader_thread.detach();
+        }
+    }
+
+    // Send one request without waiting for its response. CHANNEL_OK means the
+    // frame is on the wire and `done` will be called exactly once, on the reader
+    // thread, with the response, CHANNEL_TIMEOUT once the deadline has passed, or
+    // CHANNEL_DISCONNECTED. Any other status is final and `done` is never called.
+    ChannelStatus CallAsync(const char* body, size_t body_length, const ScoringDeadline& deadline, int& error_code,
+                            ChannelCallback done) {
+        if (!EnsureConnected(error_code, deadline)) return CHANNEL_CONNECT_FAILED;
+
+        uint32_t request_id = next_request_id.fetch_add(1, std::memory_order_relaxed);
+        if (request_id == 0) {
+            request_id = next_request_id.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        std::string frame(8 + body_length, '\0');
+        WriteBE32(&frame[0], (uint32_t)(4 + body_length));
+        WriteBE32(&frame[4], request_id);
+        memcpy(&frame[8], body, body_length);
+
+        PendingRequest* req = new PendingRequest();
+        req->callback = std::move(done);
+        req->expires = deadline.expires;
+        async_pending.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            pending[request_id] = req;
+        }
+
+        bool sent = false;
+        {
+            std::lock_guard<std::mutex> send_lock(send_mutex);
+            if (connected.load(std::memory_order_acquire) && sock != INVALID_SOCKET) {
+                sent = SendAllUntil(sock, frame.data(), (int)frame.length(), deadline, error_code);
+                if (!sent) {
+                    shutdown(sock, SD_BOTH); // A partial frame poisons the stream - reset the channel
+                }
+            }
+        }
+        if (!sent) {
+            // Unless the reader already failed it (and called back), the call ends here
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            auto it = pending.find(request_id);
+            if (it != pending.end()) {
+                pending.erase(it);
+                async_pending.fetch_sub(1, std::memory_order_relaxed);
+                delete req;
+                return CHANNEL_SEND_FAILED;
+            }
+        }
+        return CHANNEL_OK;
+    }
+
+    // Send one request and wait for the response carrying the same request ID.
+    ChannelStatus Call(const char* body, size_t body_length, std::string& response, const ScoringDeadline& deadline, int& error_code) {
+        if (!EnsureConnected(error_code, deadline)) return CHANNEL_CONNECT_FAILED;
+
+        uint32_t request_id = next_request_id.fetch_add(1, std::memory_order_relaxed);
+        if (request_id == 0) {
+            request_id = next_request_id.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        std::string frame(8 + body_length, '\0');
+        WriteBE32(&frame[0], (uint32_t)(4 + body_length));
+        WriteBE32(&frame[4], request_id);
+        memcpy(&frame[8], body, body_length);
+
+        PendingRequest req;
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            pending[request_id] = &req;
+        }
+
+        bool sent = false;
+        {
+            std::lock_guard<std::mutex> send_lock(send_mutex);
+            if (connected.load(std::memory_order_acquire) && sock != INVALID_SOCKET) {
+                sent = SendAllUntil(sock, frame.data(), (int)frame.length(), deadline, error_code);
+                if (!sent) {
+                    shutdown(sock, SD_BOTH); // A partial frame poisons the stream - reset the channel
+                }
+            }
+        }
+        if (!sent) {
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            pending.erase(request_id);
+            return CHANNEL_SEND_FAILED;
+        }
+
+        std::unique_lock<std::mutex> lock(pending_mutex);
+        bool completed = req.cv.wait_until(lock, deadline.expires, [&req] { return req.done; });
+        if (!completed) {
+            pending.erase(request_id);
+            return CHANNEL_TIMEOUT;
+        }
+        if (req.failed) return CHANNEL_DISCONNECTED;
+
+        response.swap(req.response);
+        return CHANNEL_OK;
+    }
+
+    void Stop() {
+        std::lock_guard<std::mutex> lock(connect_mutex);
+        {
+            std::lock_guard<std::mutex> send_lock(send_mutex);
+            if (sock != INVALID_SOCKET) {
+                shutdown(sock, SD_BOTH);
+            }
+        }
+        if (reader_thread.joinable()) {
+            reader_thread.join();
+        }
+        std::lock_guard<std::mutex> send_lock(send_mutex);
+        if (sock != INVALID_SOCKET) {
+            closesocket(sock);
+            sock = INVALID_SOCKET;
+        }
+        connected.store(false, std::memory_order_release);
+    }
+
+    size_t InFlight() {
+        std::lock_guard<std::mutex> lock(pending_mutex);
+        return pending.size();
+    }
+};
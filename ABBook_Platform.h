@@ -0,0 +1,269 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Platform Layer                   |
+//| Winsock on Windows, BSD sockets and futexes elsewhere, behind  |
+//| the names the rest of the plugin is written against           |
+//+------------------------------------------------------------------+
+//
+// The plugin ships as a 32-bit Windows DLL, but everything except the MT4
+// export shim (MT4_ABBook_Plugin_Official.cpp) also builds on Linux, so the
+// core library, its tests and benchmarks can run on a build box. The socket
+// code is written against Winsock; on POSIX this header supplies the few
+// Winsock names it uses: SOCKET is a file descriptor, WSAGetLastError() is
+// errno, the WSAE* codes are the matching errno values, closesocket() is
+// close(), and WSAStartup/WSACleanup succeed without doing anything.
+//
+// Calls whose signatures differ between the two are wrapped instead:
+// SetSocketNonBlocking, SetSocketKeepAlive, SocketError and PollSocket. send() must be
+// given MSG_NOSIGNAL so a peer reset is an error code, not a SIGPIPE; the
+// flag is 0 where the platform has no such signal.
+//
+// PlatformEvent is the one-shot wake-up the scoring engine sleeps on: a Win32
+// auto-reset event, a futex word on Linux, a condition variable elsewhere.
+//
+// Include this header (or one that includes it) instead of winsock2.h or
+// windows.h, so winsock2.h always comes first.
+
+#pragma once
+
+#ifdef _WIN32
+
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#include <mstcpip.h>
+#include <windows.h>
+
+#else
+
+#include <cerrno>
+#include <ctime>
+#include <unistd.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <sys/types.h>
+#include <sys/time.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#else
+#include <mutex>
+#include <condition_variable>
+#endif
+
+typedef int SOCKET;
+
+#define INVALID_SOCKET      (-1)
+#define SOCKET_ERROR        (-1)
+
+#define SD_RECEIVE          SHUT_RD
+#define SD_SEND             SHUT_WR
+#define SD_BOTH             SHUT_RDWR
+
+#define WSAEWOULDBLOCK      EWOULDBLOCK
+#define WSAEINPROGRESS      EINPROGRESS
+#define WSAETIMEDOUT        ETIMEDOUT
+#define WSAECONNRESET       ECONNRESET
+#define WSAECONNREFUSED     ECONNREFUSED
+#define WSAENETUNREACH      ENETUNREACH
+#define WSAEHOSTUNREACH     EHOSTUNREACH
+#define WSAEINVAL           EINVAL
+#define WSANOTINITIALISED   10093          // No errno equivalent; the Winsock value
+
+#define MAKEWORD(low, high) ((unsigned short)(((unsigned char)(low)) | (((unsigned short)(unsigned char)(high)) << 8)))
+
+struct WSADATA {
+    unsigned short wVersion;
+};
+
+inline int WSAStartup(unsigned short version, WSADATA* data) {
+    if (data) data->wVersion = version;
+    return 0;
+}
+
+inline int WSACleanup() { return 0; }
+inline int WSAGetLastError() { return errno; }
+inline int closesocket(SOCKET sock) { return close(sock); }
+
+#endif
+
+#include <atomic>
+#include <chrono>
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+inline bool SetSocketNonBlocking(SOCKET sock, bool non_blocking) {
+#ifdef _WIN32
+    u_long mode = non_blocking ? 1 : 0;
+    return ioctlsocket(sock, FIONBIO, &mode) == 0;
+#else
+    int flags = fcntl(sock, F_GETFL, 0);
+    if (flags < 0) return false;
+    flags = non_blocking ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+    return fcntl(sock, F_SETFL, flags) == 0;
+#endif
+}
+
+// SO_KEEPALIVE with the first probe after idle_ms and one every interval_ms after that
+inline void SetSocketKeepAlive(SOCKET sock, int idle_ms, int interval_ms) {
+    int keepalive = 1;
+    setsockopt(sock, SOL_SOCKET, SO_KEEPALIVE, (const char*)&keepalive, sizeof(keepalive));
+#ifdef _WIN32
+    tcp_keepalive keepalive_vals;
+    keepalive_vals.onoff = 1;
+    keepalive_vals.keepalivetime = (ULONG)idle_ms;
+    keepalive_vals.keepaliveinterval = (ULONG)interval_ms;
+    DWORD bytes_returned = 0;
+    WSAIoctl(sock, SIO_KEEPALIVE_VALS, &keepalive_vals, sizeof(keepalive_vals),
+             nullptr, 0, &bytes_returned, nullptr, nullptr);
+#else
+    int idle_sec = idle_ms >= 1000 ? idle_ms / 1000 : 1;
+    int interval_sec = interval_ms >= 1000 ? interval_ms / 1000 : 1;
+#ifdef TCP_KEEPIDLE
+    setsockopt(sock, IPPROTO_TCP, TCP_KEEPIDLE, &idle_sec, sizeof(idle_sec));
+#elif defined(TCP_KEEPALIVE)
+    setsockopt(sock, IPPROTO_TCP, TCP_KEEPALIVE, &idle_sec, sizeof(idle_sec));
+#endif
+#ifdef TCP_KEEPINTVL
+    setsockopt(sock, IPPROTO_TCP, TCP_KEEPINTVL, &interval_sec, sizeof(interval_sec));
+#endif
+#endif
+}
+
+// Pending error of a socket (SO_ERROR), e.g. the outcome of a non-blocking connect
+inline int SocketError(SOCKET sock) {
+    int so_error = 0;
+    socklen_t so_error_len = sizeof(so_error);
+    if (getsockopt(sock, SOL_SOCKET, SO_ERROR, (char*)&so_error, &so_error_len) != 0) {
+        return WSAGetLastError();
+    }
+    return so_error;
+}
+
+// Wait up to timeout_us for the socket to become readable (or writable): 1 ready,
+// 0 timed out, -1 failed. POSIX uses poll() - select() on a descriptor at or past
+// FD_SETSIZE is undefined behaviour, and a busy server reaches that. Winsock's
+// fd_set is a list of handles with no such limit, and its except set is where a
+// failed non-blocking connect is reported, so Windows keeps select().
+inline int PollSocket(SOCKET sock, bool for_write, long long timeout_us) {
+    if (timeout_us < 0) timeout_us = 0;
+#ifdef _WIN32
+    fd_set fds, except_fds;
+    FD_ZERO(&fds);
+    FD_ZERO(&except_fds);
+    FD_SET(sock, &fds);
+    FD_SET(sock, &except_fds);
+
+    timeval tv;
+    tv.tv_sec = (long)(timeout_us / 1000000);
+    tv.tv_usec = (long)(timeout_us % 1000000);
+
+    int ready = select(0, for_write ? nullptr : &fds, for_write ? &fds : nullptr, &except_fds, &tv);
+    if (ready < 0 || FD_ISSET(sock, &except_fds)) return -1;
+    return ready > 0 ? 1 : 0;
+#else
+    pollfd entry;
+    entry.fd = sock;
+    entry.events = for_write ? POLLOUT : POLLIN;
+    entry.revents = 0;
+
+    // Round up: a sub-millisecond remainder must not become a busy zero-timeout poll
+    long long timeout_ms = (timeout_us + 999) / 1000;
+    if (timeout_ms > 0x7fffffff) timeout_ms = 0x7fffffff;
+
+    // POLLERR/POLLHUP count as ready, as select() reports them: the following
+    // recv/send or SO_ERROR read carries the actual error
+    int ready = poll(&entry, 1, (int)timeout_ms);
+    if (ready < 0 || (entry.revents & POLLNVAL)) return -1;
+    return ready > 0 ? 1 : 0;
+#endif
+}
+
+// One-shot wake-up, reset by the waiter that consumes it
+class PlatformEvent {
+#ifdef _WIN32
+    HANDLE event;
+
+public:
+    PlatformEvent() : event(CreateEventA(nullptr, FALSE, FALSE, nullptr)) {}
+    ~PlatformEvent() { if (event) CloseHandle(event); }
+
+    void Set() { SetEvent(event); }
+    void Reset() { ResetEvent(event); }
+
+    // True if set within timeout_ms (consumes the signal)
+    bool Wait(int timeout_ms) {
+        return WaitForSingleObject(event, timeout_ms > 0 ? (DWORD)timeout_ms : 0) == WAIT_OBJECT_0;
+    }
+#elif defined(__linux__)
+    std::atomic<int> word;
+
+public:
+    PlatformEvent() : word(0) {}
+
+    void Set() {
+        word.store(1, std::memory_order_release);
+        syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+    }
+
+    void Reset() { word.store(0, std::memory_order_relaxed); }
+
+    bool Wait(int timeout_ms) {
+        if (word.exchange(0, std::memory_order_acquire)) return true;
+        if (timeout_ms <= 0) return false;
+        timespec timeout;
+        timeout.tv_sec = timeout_ms / 1000;
+        timeout.tv_nsec = (long)(timeout_ms % 1000) * 1000000L;
+        syscall(SYS_futex, reinterpret_cast<int*>(&word), FUTEX_WAIT_PRIVATE, 0, &timeout, nullptr, 0);
+        return word.exchange(0, std::memory_order_acquire) != 0;
+    }
+#else
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool signalled;
+
+public:
+    PlatformEvent() : signalled(false) {}
+
+    void Set() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            signalled = true;
+        }
+        cv.notify_one();
+    }
+
+    void Reset() {
+        std::lock_guard<std::mutex> lock(mutex);
+        signalled = false;
+    }
+
+    bool Wait(int timeout_ms) {
+        std::unique_lock<std::mutex> lock(mutex);
+        if (!signalled && timeout_ms > 0) {
+            cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), [this]() { return signalled; });
+        }
+        bool was_set = signalled;
+        signalled = false;
+        return was_set;
+    }
+#endif
+
+    // Wait until set or `deadline` passes; spurious wake-ups are retried
+    bool WaitUntil(std::chrono::steady_clock::time_point deadline) {
+        for (;;) {
+            long long remaining_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (Wait(remaining_us > 0 ? (int)((remaining_us + 999) / 1000) : 0)) return true;
+            if (std::chrono::steady_clock::now() >= deadline) return false;
+        }
+    }
+};
@@ -0,0 +1,351 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Configuration                    |
+//| PluginConfig defaults plus the ABBook_Config.ini loader        |
+//+------------------------------------------------------------------+
+
+#pragma once
+
+#include <string>
+#include <fstream>
+#include <cstdlib>
+#include <unordered_map>
+#include <vector>
+
+// One [Instrument_Groups] entry: a symbol belongs to the first group with a
+// pattern that occurs in its cleaned name
+struct InstrumentGroupConfig {
+    std::string name;                      // e.g. "FXMajors"; also the suffix of Threshold_/Budget_ keys
+    std::vector<std::string> patterns;     // Upper-case substrings of the cleaned symbol
+    double threshold;                      // B-book if score >= threshold
+    int budget_ms;                         // End-to-end scoring budget per trade
+    double contract_size;                  // Units per lot
+};
+
+struct PluginConfig {
+    std::string cvm_ip = "188.245.254.12";
+    int cvm_port = 50051;
+    double fallback_score = 0.05;          // Conservative fallback (routes to A-book by default)
+    double fx_majors_threshold = 0.08;
+    double fx_minors_threshold = 0.12;
+    double crypto_threshold = 0.15;
+    bool enable_logging = true;
+    std::string log_level = "INFO";        // TRACE, DEBUG, INFO, WARN or ERROR (TRACE/DEBUG need a diagnostics build)
+    int socket_timeout = 5000;             // 5 seconds socket timeout
+    bool fail_safe_mode = true;            // Always use fallback if ML service fails
+    int max_connection_attempts = 3;        // Max attempts before backing off
+    bool log_ml_service_status = true;     // Log ML service connectivity status
+    std::string fallback_routing = "A-BOOK"; // Default routing when ML service is down
+
+    // Persistent connection pool to the ML service
+    int connection_pool_size = 4;          // Warm connections kept open to the ML service
+    int pool_keepalive_idle_ms = 30000;    // TCP keepalive idle time on pooled sockets
+    int pool_health_check_ms = 5000;       // Background health check / re-dial interval
+    bool enable_multiplexing = false;      // Request-ID framing over one shared connection (service must support it)
+    bool enable_batching = false;          // Send ScoringBatchRequest frames (service must support it)
+    int batch_window_us = 100;             // Max time the batch leader waits for more requests
+    int batch_max_items = 32;              // Batch is sent as soon as it holds this many requests
+
+    // Hard end-to-end scoring budget per trade; the fallback score is used once it runs out
+    int fx_majors_budget_ms = 8;
+    int fx_minors_budget_ms = 8;
+    int crypto_budget_ms = 8;
+
+    // Symbol -> instrument group. Empty means the built-in FX majors / crypto lists.
+    std::vector<InstrumentGroupConfig> instrument_groups;
+    std::string default_instrument_group = "FXMinors";
+    double default_contract_size = 100000.0;
+
+    // ScoringRequest encoding
+    bool send_account_fields = false;      // Append account fields 8, 14-32, 49, 51 (cached per login)
+    int account_template_cache_size = 4096; // Logins whose encoded account fields are kept
+
+    // In-process cache of ML scores per login, symbol and trade shape
+    bool enable_score_cache = true;
+    int cache_ttl_ms = 300;                // Age after which a cached score is no longer used
+    int max_cache_size = 1000;             // Entries (rounded up to whole cache sets)
+    bool stale_while_revalidate = false;   // Route on an expired score and refresh it in the background
+    int max_staleness_ms = 2000;           // Oldest score used that way (must exceed cache_ttl_ms)
+
+    // Speculative pre-scoring of the market order account activity suggests
+    bool enable_prescoring = false;        // Needs the score cache
+    int max_prescores_per_sec = 50;        // Background requests per second, all accounts together
+    int prescore_ttl_ms = 5000;            // How long a pre-score waits for its order
+
+    // Concurrent requests for the same login, symbol and trade shape share one round trip
+    bool coalesce_requests = true;
+
+    // Dedicated scoring I/O threads; 0 = each trade thread does its own socket I/O
+    int io_threads = 0;
+
+    // Circuit breaker: trips after consecutive failed requests, recovery is probed in the background
+    int breaker_failure_threshold = 3;
+    int breaker_probe_interval_ms = 1000;   // First probe after the breaker opens; doubles per failed probe
+    int breaker_max_probe_interval_ms = 30000;
+
+    // Binary decision journal (one 128-byte record per routed trade)
+    bool enable_journal = true;
+    std::string journal_path = "ABBook_Decisions"; // File prefix; _<YYYYMMDD>_<n>.abj is appended
+    int journal_records = 1048576;         // Records per file (128 MB); a full file rolls over to the next
+
+    // Trade tape: the TradeRecord/UserInfo of every hook call, for tape_replay
+    bool enable_trade_tape = false;
+    std::string tape_path = "ABBook_Tape";  // File prefix; _<YYYYMMDD>_<n>.abt is appended
+    int tape_max_records = 2000000;        // Per startup (384 bytes each, ~730 MB); later calls are not recorded
+
+    // InfluxDB line-protocol metrics, POSTed from a background thread
+    bool enable_influx_logging = false;
+    std::string influx_url = "http://localhost:8086/write?db=trading";
+    int influx_flush_interval_ms = 10000;  // Aggregation interval; one POST per interval
+    int influx_timeout_ms = 2000;          // Connect + send + status line, per POST
+
+    // Per-stage latency histograms of MtSrvTradeTransaction
+    bool enable_stage_timers = true;
+    int latency_report_interval_sec = 60;  // Percentiles of the interval written to the log; 0 = never
+};
+
+//+------------------------------------------------------------------+
+//| Minimal INI reader for ABBook_Config.ini                        |
+//+------------------------------------------------------------------+
+
+class IniFile {
+private:
+    std::unordered_map<std::string, std::string> values; // "Section.Key" -> value
+    std::vector<std::pair<std::string, std::string>> order; // (section, key) in file order
+
+    static std::string Trim(const std::string& s) {
+        size_t begin = s.find_first_not_of(" \t\r\n");
+        if (begin == std::string::npos) return "";
+        size_t end = s.find_last_not_of(" \t\r\n");
+        return s.substr(begin, end - begin + 1);
+    }
+
+public:
+    bool Load(const std::string& path) {
+        std::ifstream file(path);
+        if (!file.is_open()) return false;
+
+        std::string line, section;
+        while (std::getline(file, line)) {
+            line = Trim(line);
+            if (line.empty() || line[0] == '#' || line[0] == ';') continue;
+
+            if (line[0] == '[') {
+                size_t close = line.find(']');
+                section = Trim(line.substr(1, close == std::string::npos ? std::string::npos : close - 1));
+                continue;
+            }
+
+            size_t eq = line.find('=');
+            if (eq == std::string::npos) continue;
+            std::string key = Trim(line.substr(0, eq));
+            if (!values.count(section + "." + key)) order.push_back(std::make_pair(section, key));
+            values[section + "." + key] = Trim(line.substr(eq + 1));
+        }
+        return true;
+    }
+
+    // Keys of one section in the order they appear in the file
+    std::vector<std::string> Keys(const std::string& section) const {
+        std::vector<std::string> keys;
+        for (const auto& entry : order) {
+            if (entry.first == section) keys.push_back(entry.second);
+        }
+        return keys;
+    }
+
+    bool Has(const std::string& section, const std::string& key) const {
+        return values.count(section + "." + key) != 0;
+    }
+
+    std::string GetString(const std::string& section, const std::string& key, const std::string& def) const {
+        auto it = values.find(section + "." + key);
+        return it == values.end() ? def : it->second;
+    }
+
+    int GetInt(const std::string& section, const std::string& key, int def) const {
+        auto it = values.find(section + "." + key);
+        return it == values.end() ? def : atoi(it->second.c_str());
+    }
+
+    double GetDouble(const std::string& section, const std::string& key, double def) const {
+        auto it = values.find(section + "." + key);
+        return it == values.end() ? def : atof(it->second.c_str());
+    }
+
+    bool GetBool(const std::string& section, const std::string& key, bool def) const {
+        auto it = values.find(section + "." + key);
+        if (it == values.end()) return def;
+        return it->second == "true" || it->second == "1" || it->second == "yes";
+    }
+};
+
+// Threshold and budget of the three groups PluginConfig has dedicated fields for
+inline void BuiltInGroupLimits(const PluginConfig& cfg, const std::string& name, double& threshold, int& budget_ms) {
+    if (name == "FXMajors") {
+        threshold = cfg.fx_majors_threshold;
+        budget_ms = cfg.fx_majors_budget_ms;
+    } else if (name == "Crypto") {
+        threshold = cfg.crypto_threshold;
+        budget_ms = cfg.crypto_budget_ms;
+    } else {
+        threshold = cfg.fx_minors_threshold;
+        budget_ms = cfg.fx_minors_budget_ms;
+    }
+}
+
+// Configured groups in match order, always ending with the default group
+// (no patterns). Falls back to the historical hard-coded lists.
+inline std::vector<InstrumentGroupConfig> EffectiveInstrumentGroups(const PluginConfig& cfg) {
+    std::vector<InstrumentGroupConfig> groups = cfg.instrument_groups;
+    if (groups.empty()) {
+        InstrumentGroupConfig majors;
+        majors.name = "FXMajors";
+        majors.patterns = { "EURUSD", "GBPUSD", "USDJPY", "USDCHF", "AUDUSD", "USDCAD", "NZDUSD" };
+        majors.contract_size = cfg.default_contract_size;
+        BuiltInGroupLimits(cfg, majors.name, majors.threshold, majors.budget_ms);
+        groups.push_back(majors);
+
+        InstrumentGroupConfig crypto;
+        crypto.name = "Crypto";
+        crypto.patterns = { "BTC", "ETH" };
+        crypto.contract_size = 1.0;
+        BuiltInGroupLimits(cfg, crypto.name, crypto.threshold, crypto.budget_ms);
+        groups.push_back(crypto);
+    }
+
+    InstrumentGroupConfig fallback;
+    fallback.name = cfg.default_instrument_group;
+    fallback.contract_size = cfg.default_contract_size;
+    BuiltInGroupLimits(cfg, fallback.name, fallback.threshold, fallback.budget_ms);
+    for (const InstrumentGroupConfig& group : groups) {
+        if (group.name == fallback.name) {
+            if (group.patterns.empty() && &group == &groups.back()) return groups;
+            fallback = group;               // Reuse the declared limits
+            fallback.patterns.clear();
+        }
+    }
+    groups.push_back(fallback);
+    return groups;
+}
+
+// Overlay ABBook_Config.ini values on top of the compiled-in defaults.
+// Returns false (and leaves the defaults untouched) if the file is missing.
+inline bool LoadPluginConfig(PluginConfig& cfg, const std::string& path) {
+    IniFile ini;
+    if (!ini.Load(path)) return false;
+
+    cfg.cvm_ip = ini.GetString("CVM_Connection", "CVM_IP", cfg.cvm_ip);
+    cfg.cvm_port = ini.GetInt("CVM_Connection", "CVM_Port", cfg.cvm_port);
+    cfg.socket_timeout = ini.GetInt("CVM_Connection", "ConnectionTimeout", cfg.socket_timeout);
+    cfg.fallback_score = ini.GetDouble("CVM_Connection", "FallbackScore", cfg.fallback_score);
+
+    cfg.connection_pool_size = ini.GetInt("CVM_Connection", "ConnectionPoolSize", cfg.connection_pool_size);
+    cfg.pool_keepalive_idle_ms = ini.GetInt("CVM_Connection", "PoolKeepAliveIdleMs", cfg.pool_keepalive_idle_ms);
+    cfg.pool_health_check_ms = ini.GetInt("CVM_Connection", "PoolHealthCheckMs", cfg.pool_health_check_ms);
+    cfg.enable_multiplexing = ini.GetBool("CVM_Connection", "EnableMultiplexing", cfg.enable_multiplexing);
+    cfg.enable_batching = ini.GetBool("CVM_Connection", "EnableBatching", cfg.enable_batching);
+    cfg.batch_window_us = ini.GetInt("CVM_Connection", "BatchWindowUs", cfg.batch_window_us);
+    cfg.batch_max_items = ini.GetInt("CVM_Connection", "BatchMaxItems", cfg.batch_max_items);
+    cfg.fx_majors_budget_ms = ini.GetInt("Latency_Budget", "Budget_FXMajors", cfg.fx_majors_budget_ms);
+    cfg.fx_minors_budget_ms = ini.GetInt("Latency_Budget", "Budget_FXMinors", cfg.fx_minors_budget_ms);
+    cfg.crypto_budget_ms = ini.GetInt("Latency_Budget", "Budget_Crypto", cfg.crypto_budget_ms);
+    cfg.log_level = ini.GetString("Logging", "LogLevel", cfg.log_level);
+    cfg.send_account_fields = ini.GetBool("Request_Encoding", "SendAccountFields", cfg.send_account_fields);
+    cfg.account_template_cache_size = ini.GetInt("Request_Encoding", "AccountTemplateCacheSize", cfg.account_template_cache_size);
+    cfg.enable_score_cache = ini.GetBool("Score_Cache", "EnableCache", cfg.enable_score_cache);
+    cfg.cache_ttl_ms = ini.GetInt("Score_Cache", "CacheTTL", cfg.cache_ttl_ms);
+    cfg.max_cache_size = ini.GetInt("Score_Cache", "MaxCacheSize", cfg.max_cache_size);
+    cfg.stale_while_revalidate = ini.GetBool("Score_Cache", "StaleWhileRevalidate", cfg.stale_while_revalidate);
+    cfg.max_staleness_ms = ini.GetInt("Score_Cache", "MaxStalenessMs", cfg.max_staleness_ms);
+    cfg.enable_prescoring = ini.GetBool("Prescoring", "EnablePrescoring", cfg.enable_prescoring);
+    cfg.max_prescores_per_sec = ini.GetInt("Prescoring", "MaxPrescoresPerSec", cfg.max_prescores_per_sec);
+    cfg.prescore_ttl_ms = ini.GetInt("Prescoring", "PrescoreTTLMs", cfg.prescore_ttl_ms);
+    cfg.coalesce_requests = ini.GetBool("CVM_Connection", "CoalesceRequests", cfg.coalesce_requests);
+    cfg.io_threads = ini.GetInt("CVM_Connection", "IoThreads", cfg.io_threads);
+    cfg.breaker_failure_threshold = ini.GetInt("Circuit_Breaker", "FailureThreshold", cfg.breaker_failure_threshold);
+    cfg.breaker_probe_interval_ms = ini.GetInt("Circuit_Breaker", "ProbeIntervalMs", cfg.breaker_probe_interval_ms);
+    cfg.breaker_max_probe_interval_ms = ini.GetInt("Circuit_Breaker", "MaxProbeIntervalMs", cfg.breaker_max_probe_interval_ms);
+    cfg.enable_journal = ini.GetBool("Decision_Journal", "EnableJournal", cfg.enable_journal);
+    cfg.journal_path = ini.GetString("Decision_Journal", "JournalPath", cfg.journal_path);
+    cfg.journal_records = ini.GetInt("Decision_Journal", "JournalRecords", cfg.journal_records);
+    if (cfg.journal_records < 1) cfg.journal_records = 1;
+    cfg.enable_trade_tape = ini.GetBool("Trade_Tape", "EnableTradeTape", cfg.enable_trade_tape);
+    cfg.tape_path = ini.GetString("Trade_Tape", "TapePath", cfg.tape_path);
+    cfg.tape_max_records = ini.GetInt("Trade_Tape", "TapeMaxRecords", cfg.tape_max_records);
+    if (cfg.tape_max_records < 1) cfg.tape_max_records = 1;
+    cfg.enable_influx_logging = ini.GetBool("Logging", "EnableInfluxLogging", cfg.enable_influx_logging);
+    cfg.influx_url = ini.GetString("Logging", "InfluxURL", cfg.influx_url);
+    cfg.influx_flush_interval_ms = ini.GetInt("Logging", "InfluxFlushIntervalMs", cfg.influx_flush_interval_ms);
+    cfg.influx_timeout_ms = ini.GetInt("Logging", "InfluxTimeoutMs", cfg.influx_timeout_ms);
+    cfg.enable_stage_timers = ini.GetBool("Latency_Stats", "EnableStageTimers", cfg.enable_stage_timers);
+    cfg.latency_report_interval_sec = ini.GetInt("Latency_Stats", "ReportIntervalSec", cfg.latency_report_interval_sec);
+
+    // [Thresholds] Threshold_<Group>
+    cfg.fx_majors_threshold = ini.GetDouble("Thresholds", "Threshold_FXMajors", cfg.fx_majors_threshold);
+    cfg.fx_minors_threshold = ini.GetDouble("Thresholds", "Threshold_FXMinors", cfg.fx_minors_threshold);
+    cfg.crypto_threshold = ini.GetDouble("Thresholds", "Threshold_Crypto", cfg.crypto_threshold);
+
+    // [Instrument_Groups] Group_<Name>=PATTERN,PATTERN,... in match order
+    cfg.default_instrument_group = ini.GetString("Instrument_Groups", "DefaultGroup", cfg.default_instrument_group);
+    cfg.default_contract_size = ini.GetDouble("Instrument_Groups", "ContractSize_" + cfg.default_instrument_group, cfg.default_contract_size);
+    auto read_group_limits = [&](InstrumentGroupConfig& group) {
+        double threshold;
+        int budget_ms;
+        BuiltInGroupLimits(cfg, group.name, threshold, budget_ms);
+        group.threshold = ini.GetDouble("Thresholds", "Threshold_" + group.name, threshold);
+        group.budget_ms = ini.GetInt("Latency_Budget", "Budget_" + group.name, budget_ms);
+        group.contract_size = ini.GetDouble("Instrument_Groups", "ContractSize_" + group.name, cfg.default_contract_size);
+        if (group.budget_ms < 1) group.budget_ms = 1;
+    };
+
+    cfg.instrument_groups.clear();
+    bool default_declared = false;
+    for (const std::string& key : ini.Keys("Instrument_Groups")) {
+        if (key.compare(0, 6, "Group_") != 0 || key.size() == 6) continue;
+
+        InstrumentGroupConfig group;
+        group.name = key.substr(6);
+        if (group.name == cfg.default_instrument_group) default_declared = true;
+        std::string list = ini.GetString("Instrument_Groups", key, "");
+        size_t begin = 0;
+        while (begin <= list.size()) {
+            size_t comma = list.find(',', begin);
+            if (comma == std::string::npos) comma = list.size();
+            std::string pattern;
+            for (size_t i = begin; i < comma; i++) {
+                char c = list[i];
+                if (c == ' ' || c == '\t') continue;
+                pattern += (c >= 'a' && c <= 'z') ? (char)(c - 32) : c;
+            }
+            if (!pattern.empty()) group.patterns.push_back(pattern);
+            begin = comma + 1;
+        }
+
+        read_group_limits(group);
+        cfg.instrument_groups.push_back(group);
+    }
+    if (!cfg.instrument_groups.empty() && !default_declared) {
+        InstrumentGroupConfig fallback;
+        fallback.name = cfg.default_instrument_group;
+        read_group_limits(fallback);
+        cfg.instrument_groups.push_back(fallback);
+    }
+
+    if (cfg.connection_pool_size < 1) cfg.connection_pool_size = 1;
+    if (cfg.pool_health_check_ms < 100) cfg.pool_health_check_ms = 100;
+    if (cfg.batch_window_us < 0) cfg.batch_window_us = 0;
+    if (cfg.batch_max_items < 1) cfg.batch_max_items = 1;
+    if (cfg.io_threads < 0) cfg.io_threads = 0;
+    if (cfg.io_threads > 16) cfg.io_threads = 16;
+    if (cfg.breaker_failure_threshold < 1) cfg.breaker_failure_threshold = 1;
+    if (cfg.breaker_probe_interval_ms < 100) cfg.breaker_probe_interval_ms = 100;
+    if (cfg.breaker_max_probe_interval_ms < cfg.breaker_probe_interval_ms) cfg.breaker_max_probe_interval_ms = cfg.breaker_probe_interval_ms;
+    if (cfg.fx_majors_budget_ms < 1) cfg.fx_majors_budget_ms = 1;
+    if (cfg.fx_minors_budget_ms < 1) cfg.fx_minors_budget_ms = 1;
+    if (cfg.crypto_budget_ms < 1) cfg.crypto_budget_ms = 1;
+    if (cfg.account_template_cache_size < 1) cfg.account_template_cache_size = 1;
+    if (cfg.cache_ttl_ms < 0) cfg.cache_ttl_ms = 0;
+    if (cfg.max_cache_size < 1) cfg.max_cache_size = 1;
+
+    return true;
+}
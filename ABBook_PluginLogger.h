@@ -0,0 +1,363 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Logger                           |
+//| Shared by the plugin DLL and its standalone test programs      |
+//+------------------------------------------------------------------+
+//
+// Log() never touches the file. It copies the message into a fixed-size
+// record of a bounded lock-free ring (multi-producer, single consumer) and
+// returns; a background writer thread owns the one open log file and does
+// the timestamp formatting and all writes. A trade thread pays for one
+// atomic increment, one clock read and a memcpy.
+//
+// If the ring is full the message is dropped rather than blocking the trade
+// thread; the writer reports how many were lost. Messages longer than a
+// record are truncated.
+//
+// The writer starts on the first Log() (or Start()). Stop() drains and joins
+// it; after that Log() writes synchronously so shutdown messages are kept.
+//
+// Severity: ABBOOK_LOG_TRACE/DEBUG/INFO/WARN/ERROR check the runtime level
+// before the message expression is evaluated, and levels below the compile-
+// time ABBOOK_MIN_LOG_LEVEL (INFO unless the build overrides it) expand to
+// nothing, arguments included. Plain Log(message) is INFO.
+
+#pragma once
+
+#include <iostream>
+#include <string>
+#include <fstream>
+#include <ctime>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+#include <cstdio>
+
+enum LogLevel {
+    LOG_LEVEL_TRACE = 0,    // Per-trade checkpoints and raw field dumps
+    LOG_LEVEL_DEBUG,        // Per-trade detail, wire-level diagnostics
+    LOG_LEVEL_INFO,         // Startup configuration, routing decisions
+    LOG_LEVEL_WARN,         // Fallback scoring, suspicious input
+    LOG_LEVEL_ERROR         // Exceptions
+};
+
+// Compile-time floor; /DABBOOK_MIN_LOG_LEVEL=0 keeps TRACE and DEBUG
+#ifndef ABBOOK_MIN_LOG_LEVEL
+#define ABBOOK_MIN_LOG_LEVEL 2
+#endif
+
+inline const char* LogLevelName(LogLevel level) {
+    switch (level) {
+        case LOG_LEVEL_TRACE: return "TRACE";
+        case LOG_LEVEL_DEBUG: return "DEBUG";
+        case LOG_LEVEL_INFO: return "INFO";
+        case LOG_LEVEL_WARN: return "WARN";
+        case LOG_LEVEL_ERROR: return "ERROR";
+    }
+    return "UNKNOWN";
+}
+
+// Case-insensitive level name (TRACE, DEBUG, INFO, WARN/WARNING, ERROR)
+inline bool ParseLogLevel(const std::string& name, LogLevel& level) {
+    std::string upper;
+    for (char c : name) upper += (c >= 'a' && c <= 'z') ? (char)(c - 32) : c;
+    if (upper == "TRACE") level = LOG_LEVEL_TRACE;
+    else if (upper == "DEBUG") level = LOG_LEVEL_DEBUG;
+    else if (upper == "INFO") level = LOG_LEVEL_INFO;
+    else if (upper == "WARN" || upper == "WARNING") level = LOG_LEVEL_WARN;
+    else if (upper == "ERROR") level = LOG_LEVEL_ERROR;
+    else return false;
+    return true;
+}
+
+class PluginLogger {
+public:
+    static const size_t RING_RECORDS = 8192;       // Power of two
+    static const size_t MAX_MESSAGE = 238;         // Longer messages are truncated
+
+private:
+    struct Record {
+        std::atomic<size_t> sequence;              // Slot state, see Log()
+        time_t timestamp;
+        uint16_t length;
+        char text[MAX_MESSAGE];
+    };
+
+    static const size_t RING_MASK = RING_RECORDS - 1;
+
+    // Everything the writer thread touches. The logger and a running writer
+    // share ownership, so a writer still running when the logger is destroyed
+    // (see ~PluginLogger) reads live memory and frees it when it exits.
+    // Heap-allocated, so padding rather than alignas keeps the producer and
+    // consumer positions on separate cache lines.
+    struct Shared {
+        std::unique_ptr<Record[]> ring;
+        char pad_before[64];
+        std::atomic<size_t> enqueue_pos;
+        char pad_after[64];
+        size_t dequeue_pos;                        // Writer thread only
+        std::atomic<size_t> dequeued;              // Published copy of dequeue_pos for Flush()
+        std::atomic<unsigned long long> dropped;
+
+        bool console_output;
+        std::string log_path;
+
+        std::mutex wake_mutex;
+        std::condition_variable wake;
+        std::atomic<bool> stop_requested;
+
+        Shared(bool console, const std::string& path)
+            : ring(new Record[RING_RECORDS]), enqueue_pos(0), dequeue_pos(0), dequeued(0), dropped(0),
+              console_output(console), log_path(path), stop_requested(false) {
+            for (size_t i = 0; i < RING_RECORDS; i++) {
+                ring[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    std::shared_ptr<Shared> shared;
+
+    bool logging_enabled;
+    std::atomic<int> runtime_level;
+
+    std::thread writer_thread;
+    std::mutex control_mutex;                      // Start/Stop and the synchronous path
+    std::atomic<bool> writer_running;
+    std::atomic<bool> synchronous;                 // After Stop(): write in the caller
+
+    static void FormatTimestamp(time_t rawtime, char* timestamp, size_t size) {
+        struct tm timeinfo;
+#ifdef _WIN32
+        localtime_s(&timeinfo, &rawtime);
+#else
+        localtime_r(&rawtime, &timeinfo);
+#endif
+        strftime(timestamp, size, "%Y-%m-%d %H:%M:%S", &timeinfo);
+    }
+
+    static void WriteLine(const Shared& state, std::ofstream& logfile, const char* timestamp, const char* text, size_t length) {
+        if (logfile.is_open()) {
+            logfile << "[" << timestamp << "] ";
+            logfile.write(text, length);
+            logfile << '\n';
+        }
+        if (state.console_output) {
+            std::cout << "[" << timestamp << "] ";
+            std::cout.write(text, length);
+            std::cout << '\n';
+        }
+    }
+
+    void WriteSynchronous(const char* text, size_t length) {
+        std::lock_guard<std::mutex> lock(control_mutex);
+        char timestamp[64];
+        FormatTimestamp(time(nullptr), timestamp, sizeof(timestamp));
+        std::ofstream logfile(shared->log_path, std::ios::app);
+        WriteLine(*shared, logfile, timestamp, text, length);
+        if (shared->console_output) std::cout.flush();
+    }
+
+    // Drain everything that is ready. Returns the number of records written.
+    static size_t Drain(Shared& state, std::ofstream& logfile, time_t& cached_second, char* timestamp, size_t timestamp_size) {
+        size_t written = 0;
+        for (;;) {
+            Record& record = state.ring[state.dequeue_pos & RING_MASK];
+            if (record.sequence.load(std::memory_order_acquire) != state.dequeue_pos + 1) break;
+
+            if (record.timestamp != cached_second) {
+                cached_second = record.timestamp;
+                FormatTimestamp(cached_second, timestamp, timestamp_size);
+            }
+            WriteLine(state, logfile, timestamp, record.text, record.length);
+
+            record.sequence.store(state.dequeue_pos + RING_RECORDS, std::memory_order_release);
+            state.dequeue_pos++;
+            written++;
+        }
+        state.dequeued.store(state.dequeue_pos, std::memory_order_release);
+        return written;
+    }
+
+    // Runs on the writer thread, which holds its own reference to the state
+    static void WriterLoop(std::shared_ptr<Shared> owner) {
+        Shared& state = *owner;
+        std::ofstream logfile(state.log_path, std::ios::app);
+        time_t cached_second = (time_t)-1;
+        char timestamp[64] = "";
+        unsigned long long reported_drops = 0;
+
+        for (;;) {
+            bool stopping = state.stop_requested.load(std::memory_order_acquire);
+            size_t written = Drain(state, logfile, cached_second, timestamp, sizeof(timestamp));
+
+            unsigned long long drops = state.dropped.load(std::memory_order_relaxed);
+            if (drops != reported_drops) {
+                char notice[96];
+                int length = snprintf(notice, sizeof(notice), "LOGGER: %llu message(s) dropped - log queue full",
+                                      drops - reported_drops);
+                FormatTimestamp(time(nullptr), timestamp, sizeof(timestamp));
+                cached_second = (time_t)-1;
+                WriteLine(state, logfile, timestamp, notice, (size_t)length);
+                reported_drops = drops;
+                written++;
+            }
+            if (written > 0) {
+                logfile.flush();
+                if (state.console_output) std::cout.flush();
+            }
+            if (stopping) break;
+            if (written == 0) {
+                // Producers never signal; a short poll keeps Log() free of syscalls
+                std::unique_lock<std::mutex> lock(state.wake_mutex);
+                state.wake.wait_for(lock, std::chrono::milliseconds(5));
+            }
+        }
+    }
+
+    void StartWriter() {
+        std::lock_guard<std::mutex> lock(control_mutex);
+        if (writer_running.load(std::memory_order_relaxed) || synchronous.load(std::memory_order_relaxed)) return;
+        shared->stop_requested.store(false, std::memory_order_relaxed);
+        writer_thread = std::thread(&PluginLogger::WriterLoop, shared);
+        writer_running.store(true, std::memory_order_release);
+    }
+
+public:
+    PluginLogger(bool enabled = true, const std::string& path = "ABBook_Plugin_Official.log", bool console = true)
+        : shared(std::make_shared<Shared>(console, path)), logging_enabled(enabled), runtime_level(LOG_LEVEL_INFO),
+          writer_running(false), synchronous(false) {}
+
+    ~PluginLogger() {
+        // Never join under the loader lock (DLL_PROCESS_DETACH) - MtSrvCleanup does the orderly Stop().
+        // Only reached without it: the writer is told to stop and left to finish on its own; its
+        // reference keeps the shared state alive until it has.
+        if (writer_thread.joinable()) {
+            shared->stop_requested.store(true, std::memory_order_release);
+            shared->wake.notify_one();
+            writer_thread.detach();
+        }
+    }
+
+    PluginLogger(const PluginLogger&) = delete;
+    PluginLogger& operator=(const PluginLogger&) = delete;
+
+    // Start (or restart after Stop) the background writer
+    void Start() {
+        synchronous.store(false, std::memory_order_release);
+        StartWriter();
+    }
+
+    // Write out everything queued so far, then switch Log() to synchronous writes
+    void Stop() {
+        std::lock_guard<std::mutex> lock(control_mutex);
+        synchronous.store(true, std::memory_order_release);
+        if (!writer_running.load(std::memory_order_relaxed)) return;
+        shared->stop_requested.store(true, std::memory_order_release);
+        shared->wake.notify_one();
+        writer_thread.join();
+        writer_running.store(false, std::memory_order_release);
+    }
+
+    // Wait until every message logged before this call has been written
+    void Flush() {
+        size_t target = shared->enqueue_pos.load(std::memory_order_acquire);
+        while (writer_running.load(std::memory_order_acquire) &&
+               shared->dequeued.load(std::memory_order_acquire) < target) {
+            shared->wake.notify_one();
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+        }
+    }
+
+    unsigned long long Dropped() const { return shared->dropped.load(std::memory_order_relaxed); }
+
+    // Runtime floor for the levels the build kept
+    void SetLevel(LogLevel level) { runtime_level.store(level, std::memory_order_relaxed); }
+    LogLevel Level() const { return (LogLevel)runtime_level.load(std::memory_order_relaxed); }
+
+    bool Enabled(LogLevel level) const {
+        return logging_enabled && (int)level >= runtime_level.load(std::memory_order_relaxed);
+    }
+
+    void Log(const char* text, size_t length) {
+        if (!logging_enabled) return;
+        if (synchronous.load(std::memory_order_acquire)) {
+            WriteSynchronous(text, length);
+            return;
+        }
+        if (!writer_running.load(std::memory_order_acquire)) StartWriter();
+
+        // Bounded MPMC ring (Vyukov): slot i is free for ticket pos when its
+        // sequence equals pos, and holds a message once it is pos + 1
+        Shared& state = *shared;
+        size_t pos = state.enqueue_pos.load(std::memory_order_relaxed);
+        Record* record;
+        for (;;) {
+            record = &state.ring[pos & RING_MASK];
+            size_t sequence = record->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)sequence - (intptr_t)pos;
+            if (diff == 0) {
+                if (state.enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                state.dropped.fetch_add(1, std::memory_order_relaxed);    // Full
+                return;
+            } else {
+                pos = state.enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+
+        if (length > MAX_MESSAGE) {
+            memcpy(record->text, text, MAX_MESSAGE - 3);
+            memcpy(record->text + MAX_MESSAGE - 3, "...", 3);
+            length = MAX_MESSAGE;
+        } else {
+            memcpy(record->text, text, length);
+        }
+        record->length = (uint16_t)length;
+        record->timestamp = time(nullptr);
+        record->sequence.store(pos + 1, std::memory_order_release);
+    }
+
+    void Log(const char* text) {
+        Log(LOG_LEVEL_INFO, text);
+    }
+
+    void Log(const std::string& message) {
+        Log(LOG_LEVEL_INFO, message);
+    }
+
+    void Log(LogLevel level, const char* text) {
+        if (Enabled(level)) Log(text, strlen(text));
+    }
+
+    void Log(LogLevel level, const std::string& message) {
+        if (Enabled(level)) Log(message.data(), message.size());
+    }
+};
+
+// Levelled logging; the message is only built if the level is enabled
+#define ABBOOK_LOG_AT(logger, level, message) \
+    do { if ((logger).Enabled(level)) (logger).Log(level, message); } while (0)
+
+// Below ABBOOK_MIN_LOG_LEVEL: still type-checked, never evaluated, no code emitted
+#define ABBOOK_LOG_STRIPPED(logger, level, message) \
+    do { if (0) (logger).Log(level, message); } while (0)
+
+#if ABBOOK_MIN_LOG_LEVEL <= 0
+#define ABBOOK_LOG_TRACE(logger, message) ABBOOK_LOG_AT(logger, LOG_LEVEL_TRACE, message)
+#else
+#define ABBOOK_LOG_TRACE(logger, message) ABBOOK_LOG_STRIPPED(logger, LOG_LEVEL_TRACE, message)
+#endif
+
+#if ABBOOK_MIN_LOG_LEVEL <= 1
+#define ABBOOK_LOG_DEBUG(logger, message) ABBOOK_LOG_AT(logger, LOG_LEVEL_DEBUG, message)
+#else
+#define ABBOOK_LOG_DEBUG(logger, message) ABBOOK_LOG_STRIPPED(logger, LOG_LEVEL_DEBUG, message)
+#endif
+
+#define ABBOOK_LOG_INFO(logger, message) ABBOOK_LOG_AT(logger, LOG_LEVEL_INFO, message)
+#define ABBOOK_LOG_WARN(logger, message) ABBOOK_LOG_AT(logger, LOG_LEVEL_WARN, message)
+#define ABBOOK_LOG_ERROR(logger, message) ABBOOK_LOG_AT(logger, LOG_LEVEL_ERROR, message)
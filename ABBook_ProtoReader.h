@@ -0,0 +1,180 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Bounds-Checked Protobuf Reader   |
+//| Single-pass, wire-type-aware decoding of ScoringResponse       |
+//+------------------------------------------------------------------+
+//
+// ProtoReader walks tag/value pairs and skips anything it does not need by
+// wire type, so varint payloads, string bytes and length prefixes can never be
+// mistaken for a tag. Every read is checked against the end of the buffer;
+// malformed input stops decoding with a status, it never reads past the end.
+//
+// Decoded strings are views into the caller's buffer (normally the
+// connection's FrameReader) and are only valid as long as that buffer is.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "scoring_schema.h"
+
+// Non-owning view of bytes inside a decoded message (the plugin builds as C++14,
+// so no std::string_view)
+struct ProtoBytes {
+    const char* data;
+    size_t length;
+};
+
+enum ProtoDecodeStatus {
+    PROTO_DECODE_OK = 0,
+    PROTO_DECODE_TRUNCATED,          // A value runs past the end of the buffer
+    PROTO_DECODE_BAD_VARINT,         // Varint longer than 10 bytes
+    PROTO_DECODE_BAD_WIRE_TYPE,      // Wire type 3/4 (groups), 6 or 7
+    PROTO_DECODE_BAD_FIELD           // Field number 0, or a known field with the wrong wire type
+};
+
+class ProtoReader {
+private:
+    const unsigned char* pos;
+    const unsigned char* end;
+    ProtoDecodeStatus status;
+
+    bool Fail(ProtoDecodeStatus reason) {
+        status = reason;
+        pos = end;
+        return false;
+    }
+
+public:
+    ProtoReader(const char* data, size_t length)
+        : pos((const unsigned char*)data), end((const unsigned char*)data + length), status(PROTO_DECODE_OK) {}
+
+    bool AtEnd() const { return pos == end; }
+    ProtoDecodeStatus Status() const { return status; }
+    size_t Remaining() const { return (size_t)(end - pos); }
+
+    bool ReadVarint(uint64_t& value) {
+        value = 0;
+        for (int shift = 0; shift < 70; shift += 7) {
+            if (pos == end) return Fail(PROTO_DECODE_TRUNCATED);
+            unsigned char byte = *pos++;
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return Fail(PROTO_DECODE_BAD_VARINT);
+    }
+
+    // Next field header. Returns false at the end of the message or on error.
+    bool ReadTag(uint32_t& field_number, int& wire_type) {
+        if (pos == end || status != PROTO_DECODE_OK) return false;
+        uint64_t tag;
+        if (!ReadVarint(tag)) return false;
+        field_number = (uint32_t)(tag >> 3);
+        wire_type = (int)(tag & 7);
+        if (field_number == 0 || (tag >> 3) > 0x1FFFFFFF) return Fail(PROTO_DECODE_BAD_FIELD);
+        if (wire_type != 0 && wire_type != 1 && wire_type != 2 && wire_type != 5) return Fail(PROTO_DECODE_BAD_WIRE_TYPE);
+        return true;
+    }
+
+    bool ReadFixed32(float& value) {
+        if (Remaining() < 4) return Fail(PROTO_DECODE_TRUNCATED);
+        memcpy(&value, pos, 4);
+        pos += 4;
+        return true;
+    }
+
+    bool ReadLengthDelimited(ProtoBytes& bytes) {
+        uint64_t length;
+        if (!ReadVarint(length)) return false;
+        if (length > Remaining()) return Fail(PROTO_DECODE_TRUNCATED);
+        bytes.data = (const char*)pos;
+        bytes.length = (size_t)length;
+        pos += length;
+        return true;
+    }
+
+    // Skip the value of a field we do not decode
+    bool Skip(int wire_type) {
+        uint64_t ignored;
+        ProtoBytes ignored_bytes;
+        switch (wire_type) {
+            case 0: return ReadVarint(ignored);
+            case 1:
+                if (Remaining() < 8) return Fail(PROTO_DECODE_TRUNCATED);
+                pos += 8;
+                return true;
+            case 2: return ReadLengthDelimited(ignored_bytes);
+            case 5:
+                if (Remaining() < 4) return Fail(PROTO_DECODE_TRUNCATED);
+                pos += 4;
+                return true;
+            default: return Fail(PROTO_DECODE_BAD_WIRE_TYPE);
+        }
+    }
+
+    bool Reject(ProtoDecodeStatus reason) { return Fail(reason); }
+};
+
+//+------------------------------------------------------------------+
+//| ScoringResponse { float score = 1; repeated string warnings = 2; }
+//+------------------------------------------------------------------+
+
+struct ScoringResponseView {
+    static const size_t MAX_WARNINGS = 8;
+
+    bool has_score;                      // False also for a proto3 default 0.0, which is never sent
+    float score;                         // 0.0f unless a score field was decoded
+    ProtoBytes warnings[MAX_WARNINGS];   // First MAX_WARNINGS warnings
+    size_t warning_count;                // All warnings seen, may exceed MAX_WARNINGS
+};
+
+// The deployed scoring service predates scoring.proto and sends the score as a
+// fixed32 in field 2 (see decode_ml_response.cpp). Field 2 is a string in the
+// schema, so the wire type tells the two apart unambiguously.
+static const uint32_t LEGACY_SCORE_FIELD = 2;
+
+inline ProtoDecodeStatus DecodeScoringResponse(const char* data, size_t length, ScoringResponseView& view) {
+    namespace field = scoring::ScoringResponse;
+
+    view.has_score = false;
+    view.score = 0.0f;
+    view.warning_count = 0;
+
+    ProtoReader reader(data, length);
+    uint32_t field_number;
+    int wire_type;
+    while (reader.ReadTag(field_number, wire_type)) {
+        if (field_number == (uint32_t)field::score_field) {
+            if (wire_type != field::score_wire_type) {
+                reader.Reject(PROTO_DECODE_BAD_FIELD);
+                break;
+            }
+            if (reader.ReadFixed32(view.score)) view.has_score = true;    // Last one wins, as in protobuf
+        } else if (field_number == (uint32_t)field::warnings_field && wire_type == field::warnings_wire_type) {
+            ProtoBytes warning;
+            if (reader.ReadLengthDelimited(warning)) {
+                if (view.warning_count < ScoringResponseView::MAX_WARNINGS) {
+                    view.warnings[view.warning_count] = warning;
+                }
+                view.warning_count++;
+            }
+        } else if (field_number == LEGACY_SCORE_FIELD && wire_type == 5) {
+            if (reader.ReadFixed32(view.score)) view.has_score = true;
+        } else {
+            reader.Skip(wire_type);
+        }
+    }
+    return reader.Status();
+}
+
+inline const char* DescribeProtoDecodeStatus(ProtoDecodeStatus status) {
+    switch (status) {
+        case PROTO_DECODE_OK: return "ok";
+        case PROTO_DECODE_TRUNCATED: return "truncated field";
+        case PROTO_DECODE_BAD_VARINT: return "malformed varint";
+        case PROTO_DECODE_BAD_WIRE_TYPE: return "unsupported wire type";
+        case PROTO_DECODE_BAD_FIELD: return "invalid field";
+    }
+    return "unknown";
+}
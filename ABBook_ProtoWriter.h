@@ -0,0 +1,282 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Zero-Allocation Protobuf Writer  |
+//| Encodes straight into a caller-provided fixed buffer           |
+//+------------------------------------------------------------------+
+//
+// Replaces the EncodeVarint/EncodeFloat/EncodeString helpers, each of which
+// returned a fresh std::string. Nested messages and the 4-byte frame prefix
+// are written by reserving their length up front and back-filling it once
+// the body is known, so nothing is built twice or copied into a second buffer.
+//
+// Running out of space never writes past the buffer: the writer stops,
+// Ok() turns false and the caller falls back.
+//
+// Build with /DABBOOK_ASSERT_NO_ALLOC (plus ABBOOK_DEFINE_ALLOC_COUNTER in
+// exactly one translation unit) to count heap allocations per thread and
+// abort if a NoAllocScope region performs any - in release builds too.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// A field tag pre-encoded as varint bytes. proto_schema_gen emits one constexpr
+// ProtoTag per field of scoring.proto, so no tag is computed at run time.
+struct ProtoTag {
+    unsigned char bytes[3];   // Field numbers up to 2^18 - 1
+    unsigned char size;
+};
+
+class ProtoWriter {
+private:
+    char* begin;
+    char* pos;
+    char* end;
+    bool overflow;
+
+    bool Reserve(size_t bytes) {
+        if (overflow || (size_t)(end - pos) < bytes) {
+            overflow = true;
+            return false;
+        }
+        return true;
+    }
+
+    static size_t VarintSize(uint64_t value) {
+        size_t size = 1;
+        while (value >= 0x80) {
+            value >>= 7;
+            size++;
+        }
+        return size;
+    }
+
+public:
+    enum WireType { WIRE_VARINT = 0, WIRE_FIXED64 = 1, WIRE_LENGTH_DELIMITED = 2, WIRE_FIXED32 = 5 };
+
+    ProtoWriter(char* buffer, size_t capacity)
+        : begin(buffer), pos(buffer), end(buffer + capacity), overflow(false) {}
+
+    void Clear() {
+        pos = begin;
+        overflow = false;
+    }
+
+    bool Ok() const { return !overflow; }
+    size_t Size() const { return (size_t)(pos - begin); }
+    const char* Data() const { return begin; }
+
+    void Varint(uint64_t value) {
+        if (!Reserve(VarintSize(value))) return;
+        while (value >= 0x80) {
+            *pos++ = (char)((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        *pos++ = (char)(value & 0x7F);
+    }
+
+    void Tag(int field_number, WireType wire_type) {
+        Varint(((uint32_t)field_number << 3) | (uint32_t)wire_type);
+    }
+
+    void Tag(const ProtoTag& tag) {
+        if (!Reserve(tag.size)) return;
+        memcpy(pos, tag.bytes, tag.size);
+        pos += tag.size;
+    }
+
+    // Untagged values, written after Tag(const ProtoTag&)
+    void Fixed32(float value) {
+        if (!Reserve(4)) return;
+        memcpy(pos, &value, 4);   // Little-endian on every MT4 server target
+        pos += 4;
+    }
+
+    void Fixed64(double value) {
+        if (!Reserve(8)) return;
+        memcpy(pos, &value, 8);
+        pos += 8;
+    }
+
+    // Already-encoded protobuf bytes (e.g. a cached sub-sequence of fields)
+    void Raw(const char* data, size_t length) {
+        if (!Reserve(length)) return;
+        memcpy(pos, data, length);
+        pos += length;
+    }
+
+    void LengthDelimited(const char* data, size_t length) {
+        Varint(length);
+        if (!Reserve(length)) return;
+        memcpy(pos, data, length);
+        pos += length;
+    }
+
+    void Float(int field_number, float value) {
+        Tag(field_number, WIRE_FIXED32);
+        Fixed32(value);
+    }
+
+    void Int64(int field_number, int64_t value) {
+        Tag(field_number, WIRE_VARINT);
+        Varint((uint64_t)value);
+    }
+
+    void Int32(int field_number, int32_t value) {
+        Tag(field_number, WIRE_VARINT);
+        Varint((uint64_t)(int64_t)value);   // Negative int32 is sign-extended to 10 bytes, as protobuf requires
+    }
+
+    void UInt32(int field_number, uint32_t value) {
+        Tag(field_number, WIRE_VARINT);
+        Varint(value);
+    }
+
+    void String(int field_number, const char* data, size_t length) {
+        Tag(field_number, WIRE_LENGTH_DELIMITED);
+        LengthDelimited(data, length);
+    }
+
+    void String(int field_number, const char* text) {
+        String(field_number, text, strlen(text));
+    }
+
+    // Start a length-delimited sub-message. One length byte is reserved, which
+    // covers every body under 128 bytes; EndMessage() slides longer bodies up.
+    size_t BeginMessage(int field_number) {
+        Tag(field_number, WIRE_LENGTH_DELIMITED);
+        return BeginLength();
+    }
+
+    // Reserve the length of a sub-message whose tag has already been written
+    size_t BeginLength() {
+        size_t mark = Size();
+        if (Reserve(1)) pos++;
+        return mark;
+    }
+
+    void EndMessage(size_t mark) {
+        if (overflow) return;
+        size_t body_length = Size() - mark - 1;
+        size_t prefix = VarintSize(body_length);
+        if (prefix > 1) {
+            if (!Reserve(prefix - 1)) return;
+            memmove(begin + mark + prefix, begin + mark + 1, body_length);
+            pos += prefix - 1;
+        }
+        char* out = begin + mark;
+        uint64_t value = body_length;
+        while (value >= 0x80) {
+            *out++ = (char)((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        *out = (char)(value & 0x7F);
+    }
+
+    // Reserve the 4-byte big-endian length prefix the scoring service reads
+    // ahead of every message.
+    size_t BeginFrame() {
+        size_t mark = Size();
+        if (Reserve(4)) pos += 4;
+        return mark;
+    }
+
+    void EndFrame(size_t mark) {
+        if (overflow) return;
+        uint32_t length = (uint32_t)(Size() - mark - 4);
+        char* out = begin + mark;
+        out[0] = (char)((length >> 24) & 0xFF);
+        out[1] = (char)((length >> 16) & 0xFF);
+        out[2] = (char)((length >> 8) & 0xFF);
+        out[3] = (char)(length & 0xFF);
+    }
+};
+
+//+------------------------------------------------------------------+
+//| ABBOOK_ASSERT_NO_ALLOC: per-thread heap allocation counter     |
+//+------------------------------------------------------------------+
+
+#ifdef ABBOOK_ASSERT_NO_ALLOC
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Reaction to a NoAllocScope that saw heap allocations
+typedef void (*NoAllocViolationHandler)(const char* file, int line, unsigned long long allocations);
+
+inline void AbortOnAllocation(const char* file, int line, unsigned long long allocations) {
+    fprintf(stderr, "ABBOOK_ASSERT_NO_ALLOC: %llu heap allocation(s) inside NoAllocScope at %s:%d\n",
+            allocations, file, line);
+    fflush(stderr);
+    abort();
+}
+
+unsigned long long& AllocationCount();
+NoAllocViolationHandler& NoAllocViolation();   // AbortOnAllocation unless a test swaps it
+
+#ifdef ABBOOK_DEFINE_ALLOC_COUNTER
+unsigned long long& AllocationCount() {
+    static thread_local unsigned long long count = 0;
+    return count;
+}
+
+NoAllocViolationHandler& NoAllocViolation() {
+    static NoAllocViolationHandler handler = AbortOnAllocation;
+    return handler;
+}
+
+// GCC pairs the malloc/free inside these with the new/delete expressions they
+// replace and warns about a mismatch that cannot happen
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+
+void* operator new(size_t size) {
+    AllocationCount()++;
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 11
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+// Fails loudly (NoAllocViolation) if a heap allocation happens on this thread
+// between construction and Check()/destruction. Not an assert: NDEBUG builds
+// check too.
+class NoAllocScope {
+private:
+    unsigned long long start;
+    const char* file;
+    int line;
+public:
+    NoAllocScope(const char* where_file, int where_line)
+        : start(AllocationCount()), file(where_file), line(where_line) {}
+    ~NoAllocScope() { Check(); }
+    unsigned long long Allocations() const { return AllocationCount() - start; }
+    void Check() {
+        unsigned long long allocations = Allocations();
+        if (allocations != 0) {
+            start = AllocationCount();     // Report each allocation once
+            NoAllocViolation()(file, line, allocations);
+        }
+    }
+};
+
+#define ABBOOK_NO_ALLOC_SCOPE(name) NoAllocScope name(__FILE__, __LINE__)
+#else
+#define ABBOOK_NO_ALLOC_SCOPE(name) ((void)0)
+#endif
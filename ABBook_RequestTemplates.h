@@ -0,0 +1,103 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Per-Account Request Templates    |
+//| Caches the pre-encoded, account-dependent part of each         |
+//| ScoringRequest so the trade path only encodes trade fields     |
+//+------------------------------------------------------------------+
+//
+// Protobuf fields may appear in any order, so a request is the trade fields
+// followed by the account template bytes, copied verbatim. A template is keyed
+// by login and tagged with a fingerprint of the account data it was built
+// from; a lookup with a different fingerprint is a miss, which is how a
+// changed UserInfo (balance, group, ...) invalidates it.
+//
+// Lookups copy into the caller's ProtoWriter under the lock and never
+// allocate. Store() may allocate and is kept off the no-allocation path.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <atomic>
+#include <unordered_map>
+
+#include "ABBook_ProtoWriter.h"
+
+class AccountTemplateCache {
+public:
+    static const size_t MAX_TEMPLATE_BYTES = 512;
+
+private:
+    struct Template {
+        uint64_t fingerprint;
+        uint32_t length;
+        char bytes[MAX_TEMPLATE_BYTES];
+    };
+
+    mutable std::mutex cache_mutex;
+    std::unordered_map<int, Template> templates;
+    size_t max_accounts;
+
+    std::atomic<unsigned long long> hits;
+    std::atomic<unsigned long long> misses;
+
+public:
+    explicit AccountTemplateCache(size_t capacity = 4096)
+        : max_accounts(capacity ? capacity : 1), hits(0), misses(0) {}
+
+    void SetCapacity(size_t capacity) {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        max_accounts = capacity ? capacity : 1;
+    }
+
+    // Append the cached template for login to out. Returns false (out untouched)
+    // if there is none or it was built from different account data.
+    bool AppendTo(int login, uint64_t fingerprint, ProtoWriter& out) {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto it = templates.find(login);
+        if (it == templates.end() || it->second.fingerprint != fingerprint) {
+            misses.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        out.Raw(it->second.bytes, it->second.length);
+        hits.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Remember freshly encoded template bytes. Oversized templates are not cached.
+    void Store(int login, uint64_t fingerprint, const char* bytes, size_t length) {
+        if (length > MAX_TEMPLATE_BYTES) return;
+
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        if (templates.size() >= max_accounts && templates.find(login) == templates.end()) {
+            templates.erase(templates.begin());   // Any victim will do - a miss only costs one encode
+        }
+        Template& entry = templates[login];
+        entry.fingerprint = fingerprint;
+        entry.length = (uint32_t)length;
+        memcpy(entry.bytes, bytes, length);
+    }
+
+    void Invalidate(int login) {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        templates.erase(login);
+    }
+
+    size_t Accounts() const {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        return templates.size();
+    }
+
+    unsigned long long Hits() const { return hits.load(std::memory_order_relaxed); }
+    unsigned long long Misses() const { return misses.load(std::memory_order_relaxed); }
+};
+
+// FNV-1a, used to fingerprint the account data a template was built from
+inline uint64_t Fnv1a(const void* data, size_t length, uint64_t hash = 14695981039346656037ULL) {
+    const unsigned char* p = (const unsigned char*)data;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= p[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
@@ -0,0 +1,286 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Score Cache                      |
+//| Recent ML scores per login, symbol and trade shape, so repeat  |
+//| orders of active traders skip the round trip to the service    |
+//+------------------------------------------------------------------+
+//
+// The key is login + registry symbol ID + a coarse feature bucket (direction
+// and power-of-two volume class), so a scalper re-entering EURUSD at a
+// similar size hits the entry of the previous order. Price is deliberately
+// not part of the key; CacheTTL bounds how old a reused score can be.
+//
+// The table is split into 16 shards, each a set-associative array of 8-way
+// sets with CLOCK eviction inside the set; the total size is MaxCacheSize
+// rounded up to whole sets. Every slot is a seqlock: Lookup() reads the
+// slot's atomics and retries nothing - a slot being rewritten just reads as
+// a miss - so hits take no lock and never write shared state except the
+// CLOCK reference bit. Store() takes the shard's mutex.
+//
+// With a staleness limit above the TTL, an entry past its TTL but younger
+// than the limit is returned as SCORE_CACHE_STALE: still usable, but the
+// caller should refresh it (stale-while-revalidate).
+//
+// Entries stored by speculative pre-scoring carry a flag that the first
+// lookup serving them clears. Until then they live for the pre-score TTL
+// (the order they anticipate may come seconds later), afterwards for the
+// normal TTL. PrescoreHits() / PrescoresStored() is the share of pre-scores
+// a market order actually used.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <chrono>
+
+inline uint64_t ScoreCacheNowMs() {
+    return (uint64_t)std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// login (32 bits) | symbol ID (16 bits) | 1, direction, volume class (16 bits).
+// Never 0, which marks an empty slot.
+inline uint64_t ScoreCacheKey(int login, uint32_t symbol_id, int cmd, int volume) {
+    uint32_t volume_class = 0;                     // 0.01 lot -> 1, 0.02-0.03 -> 2, 0.04-0.07 -> 3, ...
+    for (uint32_t v = volume > 0 ? (uint32_t)volume : 0; v != 0 && volume_class < 31; v >>= 1) volume_class++;
+    uint32_t bucket = 0x8000u | ((uint32_t)(cmd & 1) << 7) | volume_class;
+    return ((uint64_t)(uint32_t)login << 32) | ((uint64_t)(symbol_id & 0xFFFFu) << 16) | bucket;
+}
+
+enum ScoreCacheResult {
+    SCORE_CACHE_MISS = 0,
+    SCORE_CACHE_HIT,                   // Younger than the TTL
+    SCORE_CACHE_STALE                  // Past the TTL, within the staleness limit
+};
+
+class ScoreCache {
+public:
+    static const size_t SHARDS = 16;
+    static const size_t WAYS = 8;
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> seq;         // Odd while a writer is rewriting the slot
+        std::atomic<uint32_t> referenced;  // CLOCK bit, set by hits
+        std::atomic<uint64_t> key;
+        std::atomic<uint64_t> score_bits;  // double
+        std::atomic<uint64_t> stored_ms;
+        std::atomic<uint32_t> prescored;   // Stored by pre-scoring and not served yet
+
+        Slot() : seq(0), referenced(0), key(0), score_bits(0), stored_ms(0), prescored(0) {}
+    };
+
+    struct Shard {
+        std::mutex write_mutex;
+        std::unique_ptr<Slot[]> slots;                 // sets * WAYS
+        std::unique_ptr<uint8_t[]> hands;              // CLOCK hand per set, under write_mutex
+        std::atomic<unsigned long long> hits;
+        std::atomic<unsigned long long> stale_hits;
+        std::atomic<unsigned long long> misses;
+        std::atomic<unsigned long long> evictions;
+        std::atomic<unsigned long long> prescores_stored;
+        std::atomic<unsigned long long> prescore_hits;
+        char padding[64];                              // Keep the next shard's counters off this cache line
+
+        Shard() : hits(0), stale_hits(0), misses(0), evictions(0), prescores_stored(0), prescore_hits(0) {}
+    };
+
+    Shard shards[SHARDS];
+    size_t sets_per_shard;                             // Power of two
+    uint64_t ttl_ms;
+    uint64_t max_age_ms;                               // TTL or staleness limit, whichever is larger
+    uint64_t prescore_ttl_ms;                          // Age up to which an unused pre-score is a HIT
+    std::atomic<bool> enabled;
+
+    static uint64_t Mix(uint64_t key) {
+        key ^= key >> 33;
+        key *= 0xFF51AFD7ED558CCDULL;
+        key ^= key >> 33;
+        return key;
+    }
+
+    static uint64_t ToBits(double value) {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        return bits;
+    }
+
+    static double FromBits(uint64_t bits) {
+        double value;
+        memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+
+    static void Write(Slot& slot, uint64_t key, double score, uint64_t now_ms, bool prescored) {
+        uint32_t seq = slot.seq.load(std::memory_order_relaxed);
+        slot.seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.key.store(key, std::memory_order_relaxed);
+        slot.score_bits.store(ToBits(score), std::memory_order_relaxed);
+        slot.stored_ms.store(now_ms, std::memory_order_relaxed);
+        slot.referenced.store(0, std::memory_order_relaxed);
+        slot.prescored.store(prescored ? 1 : 0, std::memory_order_relaxed);
+        slot.seq.store(seq + 2, std::memory_order_release);
+    }
+
+    // Another thread may have stored the entry with a later clock reading than
+    // ours; that entry is brand new, not 2^64 ms old
+    static uint64_t Age(uint64_t stored_ms, uint64_t now_ms) {
+        return stored_ms > now_ms ? 0 : now_ms - stored_ms;
+    }
+
+    // Too old to be returned at all, even as stale
+    bool Dead(uint64_t stored_ms, uint64_t now_ms, bool prescored) const {
+        uint64_t age = Age(stored_ms, now_ms);
+        return age > max_age_ms && !(prescored && age <= prescore_ttl_ms);
+    }
+
+public:
+    ScoreCache() : sets_per_shard(0), ttl_ms(0), max_age_ms(0), prescore_ttl_ms(0), enabled(false) {}
+
+    // Size the table and set the TTL and staleness limit (0 or <= ttl: never
+    // serve stale). Only call while no trade is being processed (startup);
+    // previous entries are dropped.
+    void Configure(size_t max_entries, int ttl, int max_stale_ms = 0) {
+        enabled = false;
+        size_t wanted = (max_entries + SHARDS * WAYS - 1) / (SHARDS * WAYS);
+        sets_per_shard = 1;
+        while (sets_per_shard < wanted) sets_per_shard <<= 1;
+        for (Shard& shard : shards) {
+            shard.slots.reset(new Slot[sets_per_shard * WAYS]);
+            shard.hands.reset(new uint8_t[sets_per_shard]());
+            shard.hits = 0;
+            shard.stale_hits = 0;
+            shard.misses = 0;
+            shard.evictions = 0;
+            shard.prescores_stored = 0;
+            shard.prescore_hits = 0;
+        }
+        ttl_ms = ttl > 0 ? (uint64_t)ttl : 0;
+        max_age_ms = max_stale_ms > ttl ? (uint64_t)max_stale_ms : ttl_ms;
+        prescore_ttl_ms = ttl_ms;
+        enabled = true;
+    }
+
+    // How long a pre-score waits for its first order (never below the TTL)
+    void SetPrescoreTtl(int ms) {
+        prescore_ttl_ms = ms > 0 && (uint64_t)ms > ttl_ms ? (uint64_t)ms : ttl_ms;
+    }
+
+    bool Enabled() const { return enabled.load(std::memory_order_relaxed); }
+    bool ServesStale() const { return max_age_ms > ttl_ms; }
+
+private:
+    ScoreCacheResult Find(uint64_t key, uint64_t now_ms, double& score, bool count) {
+        if (!Enabled()) return SCORE_CACHE_MISS;
+        uint64_t hash = Mix(key);
+        Shard& shard = shards[hash & (SHARDS - 1)];
+        Slot* set = &shard.slots[((hash >> 4) & (sets_per_shard - 1)) * WAYS];
+
+        for (size_t way = 0; way < WAYS; way++) {
+            Slot& slot = set[way];
+            uint32_t seq = slot.seq.load(std::memory_order_acquire);
+            if (seq & 1) continue;
+            if (slot.key.load(std::memory_order_relaxed) != key) continue;
+            uint64_t bits = slot.score_bits.load(std::memory_order_relaxed);
+            uint64_t stored_ms = slot.stored_ms.load(std::memory_order_relaxed);
+            bool prescored = slot.prescored.load(std::memory_order_relaxed) != 0;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) != seq) continue;
+
+            if (Dead(stored_ms, now_ms, prescored)) break;
+            score = FromBits(bits);
+            uint64_t age = Age(stored_ms, now_ms);
+            bool stale = age > ttl_ms && !(prescored && age <= prescore_ttl_ms);
+            if (!count) return stale ? SCORE_CACHE_STALE : SCORE_CACHE_HIT;
+
+            if (!slot.referenced.load(std::memory_order_relaxed)) slot.referenced.store(1, std::memory_order_relaxed);
+            // Outside the seqlock: a rewrite racing this hit can at worst credit one pre-score too many
+            if (prescored && slot.prescored.exchange(0, std::memory_order_relaxed)) {
+                shard.prescore_hits.fetch_add(1, std::memory_order_relaxed);
+            }
+            (stale ? shard.stale_hits : shard.hits).fetch_add(1, std::memory_order_relaxed);
+            return stale ? SCORE_CACHE_STALE : SCORE_CACHE_HIT;
+        }
+        if (count) shard.misses.fetch_add(1, std::memory_order_relaxed);
+        return SCORE_CACHE_MISS;
+    }
+
+public:
+    // Trade path, no lock: the score stored under key, if it is younger than the
+    // TTL (HIT) or than the staleness limit (STALE)
+    ScoreCacheResult Lookup(uint64_t key, uint64_t now_ms, double& score) {
+        return Find(key, now_ms, score, true);
+    }
+
+    // Same answer as Lookup() without counting it or touching the entry
+    ScoreCacheResult Peek(uint64_t key, uint64_t now_ms) {
+        double score;
+        return Find(key, now_ms, score, false);
+    }
+
+    // Remember a fresh ML score. Replaces, in order of preference: the same key,
+    // an empty way or one too old to be served, or the CLOCK victim of the set.
+    // prescored marks a speculative score no order has asked for yet.
+    void Store(uint64_t key, double score, uint64_t now_ms, bool prescored = false) {
+        if (!Enabled()) return;
+        uint64_t hash = Mix(key);
+        Shard& shard = shards[hash & (SHARDS - 1)];
+        size_t set_index = (hash >> 4) & (sets_per_shard - 1);
+        Slot* set = &shard.slots[set_index * WAYS];
+
+        std::lock_guard<std::mutex> lock(shard.write_mutex);
+        Slot* target = nullptr;
+        for (size_t way = 0; way < WAYS && !target; way++) {
+            if (set[way].key.load(std::memory_order_relaxed) == key) target = &set[way];
+        }
+        for (size_t way = 0; way < WAYS && !target; way++) {
+            if (set[way].key.load(std::memory_order_relaxed) == 0 ||
+                Dead(set[way].stored_ms.load(std::memory_order_relaxed), now_ms,
+                     set[way].prescored.load(std::memory_order_relaxed) != 0)) {
+                target = &set[way];
+            }
+        }
+        if (!target) {
+            uint8_t& hand = shard.hands[set_index];
+            while (set[hand].referenced.load(std::memory_order_relaxed)) {
+                set[hand].referenced.store(0, std::memory_order_relaxed);
+                hand = (uint8_t)((hand + 1) % WAYS);
+            }
+            target = &set[hand];
+            hand = (uint8_t)((hand + 1) % WAYS);
+            shard.evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+        Write(*target, key, score, now_ms, prescored);
+        if (prescored) shard.prescores_stored.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    size_t Capacity() const { return SHARDS * sets_per_shard * WAYS; }
+
+    size_t Entries() {
+        size_t entries = 0;
+        for (Shard& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.write_mutex);
+            for (size_t i = 0; i < sets_per_shard * WAYS; i++) {
+                if (shard.slots[i].key.load(std::memory_order_relaxed) != 0) entries++;
+            }
+        }
+        return entries;
+    }
+
+    unsigned long long Hits() const { return Sum(&Shard::hits); }
+    unsigned long long StaleHits() const { return Sum(&Shard::stale_hits); }
+    unsigned long long Misses() const { return Sum(&Shard::misses); }
+    unsigned long long Evictions() const { return Sum(&Shard::evictions); }
+    unsigned long long PrescoresStored() const { return Sum(&Shard::prescores_stored); }
+    unsigned long long PrescoreHits() const { return Sum(&Shard::prescore_hits); }
+
+private:
+    unsigned long long Sum(std::atomic<unsigned long long> Shard::*counter) const {
+        unsigned long long total = 0;
+        for (const Shard& shard : shards) total += (shard.*counter).load(std::memory_order_relaxed);
+        return total;
+    }
+};
@@ -0,0 +1,214 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Score Revalidator                |
+//| Refreshes stale score cache entries from a background thread   |
+//| while trades keep routing on the stale score                   |
+//+------------------------------------------------------------------+
+//
+// When the score cache returns SCORE_CACHE_STALE the trade thread encodes
+// the request it would have sent and queues it here together with the
+// cache key; it does not wait. A single worker sends the queued frames one
+// at a time and stores each valid score back into the cache, so the next
+// order of that login and shape gets a fresh hit.
+//
+// A key that is already queued or being refreshed is not queued again, so a
+// burst of stale hits costs one round trip. The queue is bounded; when it is
+// full the refresh is dropped and the entry simply ages out.
+//
+// Speculative pre-scoring runs a second instance that stores its scores
+// flagged as pre-scores and paces itself with a token bucket, so account
+// activity cannot turn into a flood of requests to the service.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+
+#include "ABBook_ScoreCache.h"
+
+// Sends one length-prefixed ScoringRequest frame; true with a score in [0, 1] on success
+typedef std::function<bool(const char* frame, size_t length, double& score)> RevalidateFetch;
+
+class ScoreRevalidator {
+public:
+    static const size_t MAX_QUEUED = 64;
+    static const size_t MAX_FRAME_BYTES = 1024;
+
+private:
+    struct Job {
+        uint64_t key;
+        size_t length;
+        char frame[MAX_FRAME_BYTES];
+    };
+
+    ScoreCache* cache;
+    RevalidateFetch fetch;
+    bool prescoring;                       // Store results as pre-scores
+
+    // Token bucket, worker thread only once started
+    int rate_per_sec;                      // 0 = unlimited
+    double tokens;
+    std::chrono::steady_clock::time_point refilled_at;
+
+    std::mutex queue_mutex;
+    std::condition_variable queue_cv;
+    Job jobs[MAX_QUEUED];                  // Ring buffer
+    size_t head;
+    size_t count;
+    uint64_t in_flight;                    // Key the worker is refreshing, 0 if idle
+    bool running;
+    bool stopping;
+    std::thread worker;
+
+    std::atomic<unsigned long long> queued;
+    std::atomic<unsigned long long> dropped;
+    std::atomic<unsigned long long> refreshed;
+    std::atomic<unsigned long long> failed;
+
+    bool PendingLocked(uint64_t key) const {
+        if (in_flight == key) return true;
+        for (size_t i = 0; i < count; i++) {
+            if (jobs[(head + i) % MAX_QUEUED].key == key) return true;
+        }
+        return false;
+    }
+
+    // Seconds until the next request may go out; takes a token when it is 0
+    double Throttle() {
+        if (rate_per_sec <= 0) return 0.0;
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        tokens = std::min((double)rate_per_sec,
+                          tokens + std::chrono::duration<double>(now - refilled_at).count() * rate_per_sec);
+        refilled_at = now;
+        if (tokens < 1.0) return (1.0 - tokens) / rate_per_sec;
+        tokens -= 1.0;
+        return 0.0;
+    }
+
+    void WorkLoop() {
+        Job job;
+        std::unique_lock<std::mutex> lock(queue_mutex);
+        while (!stopping) {
+            if (count == 0) {
+                queue_cv.wait(lock);
+                continue;
+            }
+            double wait_sec = Throttle();
+            if (wait_sec > 0.0) {
+                queue_cv.wait_for(lock, std::chrono::duration<double>(wait_sec));
+                continue;
+            }
+            const Job& next = jobs[head];
+            job.key = next.key;
+            job.length = next.length;
+            memcpy(job.frame, next.frame, next.length);
+            head = (head + 1) % MAX_QUEUED;
+            count--;
+            in_flight = job.key;
+            lock.unlock();
+
+            double score = 0.0;
+            bool ok = false;
+            try {
+                ok = fetch(job.frame, job.length, score);
+            } catch (...) {
+                ok = false;                // Same contract as the trade path: never let the worker die
+            }
+            if (ok) {
+                cache->Store(job.key, score, ScoreCacheNowMs(), prescoring);
+                refreshed.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                failed.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            lock.lock();
+            in_flight = 0;
+        }
+    }
+
+public:
+    ScoreRevalidator(ScoreCache* score_cache, RevalidateFetch fetch_score, bool store_as_prescores = false)
+        : cache(score_cache), fetch(fetch_score), prescoring(store_as_prescores), rate_per_sec(0), tokens(0.0),
+          head(0), count(0), in_flight(0), running(false), stopping(false),
+          queued(0), dropped(0), refreshed(0), failed(0) {}
+
+    ~ScoreRevalidator() {
+        // Never join under the loader lock (DLL_PROCESS_DETACH) - MtSrvCleanup does the orderly Stop()
+        if (worker.joinable()) {
+            worker.detach();
+        }
+    }
+
+    // At most per_second requests, bursts of up to one second's worth; 0 = unlimited.
+    // Call before Start().
+    void SetRateLimit(int per_second) {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if (running) return;
+        rate_per_sec = per_second > 0 ? per_second : 0;
+    }
+
+    void Start() {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        if (running) return;
+        tokens = (double)rate_per_sec;
+        refilled_at = std::chrono::steady_clock::now();
+        head = 0;
+        count = 0;
+        stopping = false;
+        running = true;
+        worker = std::thread(&ScoreRevalidator::WorkLoop, this);
+    }
+
+    // Queued refreshes are discarded; one in flight is finished first
+    void Stop() {
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            if (!running) return;
+            stopping = true;
+            running = false;
+        }
+        queue_cv.notify_all();
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    // Lets the trade thread skip encoding a request that would not be queued
+    bool Pending(uint64_t key) {
+        std::lock_guard<std::mutex> lock(queue_mutex);
+        return PendingLocked(key);
+    }
+
+    // Trade path: hand a request frame to the worker. False if the key is
+    // already pending, the queue is full or the revalidator is not running.
+    bool Queue(uint64_t key, const char* frame, size_t length) {
+        if (length > MAX_FRAME_BYTES) return false;
+        {
+            std::lock_guard<std::mutex> lock(queue_mutex);
+            if (!running || PendingLocked(key)) return false;
+            if (count == MAX_QUEUED) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            Job& job = jobs[(head + count) % MAX_QUEUED];
+            job.key = key;
+            job.length = length;
+            memcpy(job.frame, frame, length);
+            count++;
+        }
+        queued.fetch_add(1, std::memory_order_relaxed);
+        queue_cv.notify_one();
+        return true;
+    }
+
+    unsigned long long Queued() const { return queued.load(std::memory_order_relaxed); }
+    unsigned long long Dropped() const { return dropped.load(std::memory_order_relaxed); }
+    unsigned long long Refreshed() const { return refreshed.load(std::memory_order_relaxed); }
+    unsigned long long Failed() const { return failed.load(std::memory_order_relaxed); }
+};
@@ -0,0 +1,316 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Scoring Request Micro-Batcher    |
+//| Collects requests arriving within a short window into one      |
+//| ScoringBatchRequest frame (see scoring.proto)                  |
+//+------------------------------------------------------------------+
+//
+// The first trade thread to arrive becomes the batch leader: it spins for at
+// most batch_window_us (or until batch_max_items requests have joined), seals
+// the batch, performs the round trip through the supplied transport and hands
+// each follower its own ScoringResponse. Followers just block on the result.
+// Window 0 disables the wait, so a batch only contains requests that raced in
+// while the leader was sealing it.
+//
+// Every request carries its own per-trade deadline. The leader never waits past
+// its own deadline, and a follower whose deadline runs out detaches from the
+// batch and falls back immediately; its response, if it arrives, is dropped.
+//
+// SubmitAsync() is the scoring I/O threads' way in: a request joining an open
+// batch returns at once and is called back by the thread that sends the batch.
+// Only the I/O thread leading a batch is held up, and it spends its window in
+// the window hook (running requests queued behind it) rather than yielding, so
+// a batch can fill to batch_max_items however few I/O threads there are. A
+// request the hook submits after other threads filled the batch is sent right
+// after that batch; it never opens a nested batch for the full one to wait on.
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+
+#include "ABBook_PluginConfig.h"
+#include "ABBook_SocketIO.h"
+#include "ABBook_ProtoReader.h"
+
+// Sends one ScoringBatchRequest body and returns the ScoringBatchResponse body before the deadline.
+typedef std::function<bool(const std::string& batch_request, std::string& batch_response,
+                           const ScoringDeadline& deadline)> BatchTransport;
+
+enum BatchStatus {
+    BATCH_OK = 0,
+    BATCH_TRANSPORT_FAILED,
+    BATCH_MALFORMED_RESPONSE,
+    BATCH_DEADLINE_EXPIRED
+};
+
+// Outcome of a SubmitAsync(); the response is only meaningful with BATCH_OK
+typedef std::function<void(BatchStatus status, const std::string& response)> BatchCallback;
+
+class ScoringBatcher {
+private:
+    struct Batch;
+
+    struct BatchSlot {
+        const char* request = nullptr;  // ScoringRequest body, owned by the submitting thread
+        size_t request_length = 0;
+        std::string response;
+        BatchStatus status = BATCH_OK;
+        bool done = false;
+        Batch* batch = nullptr;       // Valid until done; lets a timed-out follower detach
+        size_t index = 0;
+        BatchCallback callback;       // SubmitAsync() slot: heap-allocated, freed once called
+    };
+
+    // items[i] is nulled (under batch_mutex) when its follower gives up waiting.
+    // The leader only reads items under batch_mutex.
+    struct Batch {
+        std::vector<BatchSlot*> items;
+        std::atomic<int> count;
+        Batch() : count(0) {}
+    };
+
+    PluginConfig* config;             // batch_window_us / batch_max_items are read per batch
+    BatchTransport transport;
+    std::function<bool()> window_hook;   // Run by a leader instead of yielding; false = nothing to do
+
+    std::mutex batch_mutex;
+    std::condition_variable batch_cv;
+    Batch* open_batch;                // Batch currently accepting requests (owned by its leader)
+
+    std::atomic<unsigned long long> batches_sent;
+    std::atomic<unsigned long long> requests_sent;
+
+    static void AppendVarint(std::string& out, uint64_t value) {
+        while (value >= 0x80) {
+            out += (char)((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        out += (char)(value & 0x7F);
+    }
+
+    // ScoringBatchRequest { repeated ScoringRequest requests = 1; }
+    // Called under batch_mutex; detached followers are left out of the batch.
+    static std::string EncodeBatch(Batch& batch) {
+        size_t total = 0;
+        for (const BatchSlot* item : batch.items) {
+            if (item) total += item->request_length + 6;
+        }
+
+        std::string body;
+        body.reserve(total);
+        size_t kept = 0;
+        for (BatchSlot* item : batch.items) {
+            if (!item) continue;
+            body += (char)0x0A; // field 1, wire type 2
+            AppendVarint(body, item->request_length);
+            body.append(item->request, item->request_length);
+            item->index = kept;
+            batch.items[kept++] = item;
+        }
+        batch.items.resize(kept);
+        return body;
+    }
+
+    // ScoringBatchResponse { repeated ScoringResponse responses = 1; } - same order as the request
+    static bool DecodeBatch(const std::string& body, std::vector<std::string>& responses) {
+        ProtoReader reader(body.data(), body.size());
+        uint32_t field_number;
+        int wire_type;
+        while (reader.ReadTag(field_number, wire_type)) {
+            if (field_number == (uint32_t)scoring::ScoringBatchResponse::responses_field && wire_type == 2) {
+                ProtoBytes response;
+                if (reader.ReadLengthDelimited(response)) {
+                    responses.push_back(std::string(response.data, response.length));
+                }
+            } else {
+                reader.Skip(wire_type);
+            }
+        }
+        return reader.Status() == PROTO_DECODE_OK;
+    }
+
+    void FlushBatch(Batch& batch, const ScoringDeadline& deadline) {
+        std::string batch_request;
+        size_t batch_size;
+        {
+            std::lock_guard<std::mutex> lock(batch_mutex);
+            batch_request = EncodeBatch(batch);
+            batch_size = batch.items.size();
+        }
+
+        std::string batch_response;
+        std::vector<std::string> responses;
+        responses.reserve(batch_size);
+        BatchStatus status = BATCH_OK;
+
+        bool delivered = false;
+        try {
+            delivered = transport(batch_request, batch_response, deadline);
+        } catch (...) {
+            delivered = false;                 // SubmitAsync() slots have no timeout: every slot gets an answer
+        }
+        if (!delivered) {
+            status = BATCH_TRANSPORT_FAILED;
+        } else if (!DecodeBatch(batch_response, responses) || responses.size() != batch_size) {
+            status = BATCH_MALFORMED_RESPONSE;
+        }
+
+        batches_sent.fetch_add(1, std::memory_order_relaxed);
+        requests_sent.fetch_add(batch_size, std::memory_order_relaxed);
+
+        std::vector<BatchSlot*> callbacks;
+        {
+            std::lock_guard<std::mutex> lock(batch_mutex);
+            for (size_t i = 0; i < batch.items.size(); i++) {
+                BatchSlot* item = batch.items[i];
+                if (!item) continue; // Follower timed out while the batch was in flight
+                if (status == BATCH_OK) item->response.swap(responses[i]);
+                item->status = status;
+                item->done = true;
+                item->batch = nullptr;
+                if (item->callback) callbacks.push_back(item);
+            }
+            batch_cv.notify_all();
+        }
+        for (BatchSlot* item : callbacks) {
+            item->callback(item->status, item->response);
+            delete item;
+        }
+    }
+
+    // SubmitAsync() calls made from the window hook of the batch this thread leads,
+    // once that batch has filled up; null when the thread is not leading
+    static std::vector<std::function<void()>>*& LeaderDeferred() {
+        static thread_local std::vector<std::function<void()>>* deferred = nullptr;
+        return deferred;
+    }
+
+    int MaxItems() const {
+        return config->batch_max_items < 1 ? 1 : config->batch_max_items;
+    }
+
+    // Called with `lock` held and no batch open: opens one around `slot`, waits out
+    // the window and sends it. Returns with `lock` released and `slot` answered.
+    void Lead(BatchSlot& slot, int max_items, const ScoringDeadline& deadline, std::unique_lock<std::mutex>& lock) {
+        Batch batch;
+        batch.items.reserve(max_items);
+        batch.items.push_back(&slot);
+        slot.batch = &batch;
+        batch.count.store(1, std::memory_order_relaxed);
+        open_batch = &batch;
+        lock.unlock();
+
+        // Spin rather than sleep - the window is far below the OS timer resolution
+        auto window_end = std::chrono::steady_clock::now() + std::chrono::microseconds(config->batch_window_us);
+        if (window_end > deadline.expires) {
+            window_end = deadline.expires;
+        }
+        std::vector<std::function<void()>> deferred;
+        LeaderDeferred() = &deferred;
+        while (batch.count.load(std::memory_order_acquire) < max_items &&
+               std::chrono::steady_clock::now() < window_end) {
+            if (!window_hook || !window_hook()) {
+                std::this_thread::yield();
+            }
+        }
+        LeaderDeferred() = nullptr;
+
+        lock.lock();
+        if (open_batch == &batch) {
+            open_batch = nullptr;
+        }
+        lock.unlock();
+
+        FlushBatch(batch, deadline);
+        for (std::function<void()>& submit : deferred) {
+            submit();
+        }
+    }
+
+    // Called with `lock` held and a batch open
+    void Join(BatchSlot& slot, int max_items) {
+        Batch* batch = open_batch;
+        slot.batch = batch;
+        slot.index = batch->items.size();
+        batch->items.push_back(&slot);
+        if (batch->count.fetch_add(1, std::memory_order_acq_rel) + 1 >= max_items) {
+            open_batch = nullptr; // Full - the next request starts a new batch
+        }
+    }
+
+public:
+    ScoringBatcher(PluginConfig* cfg, BatchTransport batch_transport)
+        : config(cfg), transport(batch_transport), open_batch(nullptr),
+          batches_sent(0), requests_sent(0) {}
+
+    // Run by a batch leader while its window is open, in place of a yield; returns
+    // false when it found nothing to do. Set before the first Submit.
+    void SetWindowHook(std::function<bool()> hook) {
+        window_hook = hook;
+    }
+
+    // Score one request as part of the current batch. Blocks until the batch round trip
+    // completes or the caller's deadline expires.
+    BatchStatus Submit(const char* request_body, size_t request_length, std::string& response_body, const ScoringDeadline& deadline) {
+        BatchSlot slot;
+        slot.request = request_body;
+        slot.request_length = request_length;
+        int max_items = MaxItems();
+
+        std::unique_lock<std::mutex> lock(batch_mutex);
+        if (open_batch == nullptr) {
+            Lead(slot, max_items, deadline, lock);
+        } else {
+            Join(slot, max_items);
+            if (!batch_cv.wait_until(lock, deadline.expires, [&slot] { return slot.done; })) {
+                slot.batch->items[slot.index] = nullptr; // Leader must not touch this slot any more
+                return BATCH_DEADLINE_EXPIRED;
+            }
+        }
+
+        response_body.swap(slot.response);
+        return slot.status;
+    }
+
+    // Score one request as part of the current batch and call `done` with the outcome,
+    // exactly once. Joining an open batch returns at once and `done` runs on the thread
+    // that sends it; with no batch open the caller leads one, and `done` has run by the
+    // time this returns - unless the caller is a window hook, whose request then waits
+    // for the leader's batch to be sent. `request_body` must stay valid until then. The round trip is
+    // bounded by the leader's deadline, so `done` always comes.
+    void SubmitAsync(const char* request_body, size_t request_length, const ScoringDeadline& deadline, BatchCallback done) {
+        int max_items = MaxItems();
+        std::unique_lock<std::mutex> lock(batch_mutex);
+        if (open_batch == nullptr && LeaderDeferred()) {
+            // From the window hook, and a concurrent Join filled the batch between the
+            // leader's check and this call: leading here would hold the full batch for a
+            // whole window plus a round trip. Run it once that batch is sent instead.
+            LeaderDeferred()->push_back([this, request_body, request_length, deadline, done]() {
+                SubmitAsync(request_body, request_length, deadline, done);
+            });
+            return;
+        }
+        if (open_batch == nullptr) {
+            BatchSlot slot;
+            slot.request = request_body;
+            slot.request_length = request_length;
+            Lead(slot, max_items, deadline, lock);
+            done(slot.status, slot.response);
+            return;
+        }
+        BatchSlot* slot = new BatchSlot();
+        slot->request = request_body;
+        slot->request_length = request_length;
+        slot->callback = std::move(done);
+        Join(*slot, max_items);
+    }
+
+    unsigned long long BatchesSent() const { return batches_sent.load(std::memory_order_relaxed); }
+    unsigned long long RequestsSent() const { return requests_sent.load(std::memory_order_relaxed); }
+};
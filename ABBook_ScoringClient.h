@@ -0,0 +1,926 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Scoring Client                   |
+//| Turns a trade into a score: cache, request coalescing, circuit |
+//| breaker, encoding and the configured transport                 |
+//+------------------------------------------------------------------+
+//
+// CVMClient encodes ScoringRequests into stack buffers, sends them through
+// the connection pool, the multiplexed channel, the micro-batcher or the
+// I/O threads of the scoring engine, validates the ScoringResponse and
+// always hands back a usable score: the ML score, a cached one, or
+// PluginConfig::fallback_score together with the reason (ScoreDetails).
+// It owns the background scorers (revalidator, pre-scorer) and the circuit
+// breaker; the pool and the channel are shared with the rest of the plugin.
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <exception>
+#include <unordered_map>
+
+#include "ABBook_Platform.h"
+#include "ABBook_MT4Types.h"
+#include "ABBook_PluginConfig.h"
+#include "ABBook_PluginLogger.h"
+#include "ABBook_SocketIO.h"
+#include "ABBook_ConnectionPool.h"
+#include "ABBook_MultiplexedChannel.h"
+#include "ABBook_ScoringBatcher.h"
+#include "ABBook_ProtoWriter.h"
+#include "scoring_schema.h"     // Generated from scoring.proto by proto_schema_gen (see CMakeLists.txt / build_official_plugin.bat)
+#include "ABBook_ProtoReader.h"
+#include "ABBook_RequestTemplates.h"
+#include "ABBook_SymbolRegistry.h"
+#include "ABBook_DecisionJournal.h"
+#include "ABBook_MetricsExporter.h"
+#include "ABBook_LatencyStats.h"
+#include "ABBook_ScoreCache.h"
+#include "ABBook_ScoreRevalidator.h"
+#include "ABBook_SingleFlight.h"
+#include "ABBook_ScoringEngine.h"
+#include "ABBook_CircuitBreaker.h"
+
+// Outcome of one scoring attempt. An exhausted latency budget is reported
+// separately because it must not be mistaken for the service being down.
+enum ScoreAttempt { ATTEMPT_OK = 0, ATTEMPT_FAILED, ATTEMPT_BUDGET_EXPIRED, ATTEMPT_BUSY };
+
+// What GetScore did, for the decision journal
+struct ScoreDetails {
+    JournalScoreSource source;
+    uint64_t request_hash;                 // FNV-1a of the encoded request frame, 0 if none was built
+};
+
+class CVMClient {
+private:
+    // Largest length-prefixed ScoringRequest: all 60 fields of scoring.proto with
+    // short strings fit in well under half of this
+    static const size_t REQUEST_BUFFER_BYTES = 1024;
+    // Logins whose last market order is kept for pre-scoring at login
+    static const size_t MAX_REMEMBERED_ORDERS = 4096;
+    
+    PluginConfig* config;
+    PluginLogger* logger;
+    ScoringConnectionPool* pool;
+    MultiplexedScoringChannel* channel;
+    ScoringBatcher batcher;
+    AccountTemplateCache account_templates;
+    ScoreCache score_cache;
+    ScoreRevalidator revalidator;          // Refreshes stale cache entries in the background
+    ScoreRevalidator prescorer;            // Scores anticipated orders in the background, rate limited
+    SingleFlight flights;                  // Outstanding requests that concurrent identical trades wait on
+    ScoringEngine engine;                  // I/O threads that send trade requests when IoThreads > 0
+    std::atomic<bool> prescoring;
+    std::mutex last_orders_mutex;
+    std::unordered_map<int, TradeRecord> last_orders; // Last market order per login
+    CircuitBreaker breaker;                // Service health; probes recovery off the trade path
+    
+    void RecordConnectionResult(bool success) {
+        if (success) {
+            breaker.RecordSuccess();
+        } else {
+            breaker.RecordFailure();
+        }
+    }
+    
+    void LogBreakerTransition(BreakerState from, BreakerState to) {
+        if (from == BREAKER_CLOSED) {
+            ABBOOK_LOG_WARN(*logger, "ML SERVICE: Connection lost - using fallback scores for all trades (circuit breaker open, probing every " +
+                            std::to_string(config->breaker_probe_interval_ms) + " ms or more)");
+        } else if (to == BREAKER_CLOSED) {
+            logger->Log("ML SERVICE: Connection restored - switching back to ML scoring (circuit breaker closed after " +
+                        std::to_string(breaker.OpenMs()) + " ms open in total)");
+        } else if (to == BREAKER_HALF_OPEN) {
+            ABBOOK_LOG_DEBUG(*logger, "ML SERVICE: Circuit breaker half-open - probing the service");
+        } else {
+            ABBOOK_LOG_DEBUG(*logger, "ML SERVICE: Probe failed - circuit breaker stays open");
+        }
+    }
+    
+    // Encode the ScoringRequest body into the writer without touching the heap.
+    // Field numbers, wire types and value types come from scoring_schema.h, which
+    // proto_schema_gen generates from scoring.proto at build time.
+    void EncodeScoringRequest(const TradeRecord& trade, const SymbolInfo& symbol, ProtoWriter& request) {
+        namespace field = scoring::ScoringRequest;
+        
+        // Core trade data (fields 1-5)
+        field::open_price(request, (float)trade.open_price);
+        field::sl(request, (float)trade.sl);
+        field::tp(request, (float)trade.tp);
+        field::deal_type(request, (int64_t)trade.cmd);              // 0 = buy, 1 = sell
+        field::lot_volume(request, (float)(trade.volume / 100.0));
+        
+        // Symbol (CRITICAL - must be UTF-8 encoded!) - cleaned once by the symbol registry
+        field::symbol(request, symbol.name, symbol.name_length);  // e.g. "NZDUSD" (UTF-8 safe)
+        
+        // Client ID for external service queries
+        char user_id[16];
+        int user_id_length = snprintf(user_id, sizeof(user_id), "%d", trade.login);
+        field::user_id(request, user_id, (size_t)user_id_length);
+        
+    }
+    
+    // Printable-ASCII copy of a fixed-size MT4 string field (out must hold length + 1)
+    static size_t CopyAsciiField(const char* field, size_t field_size, char* out) {
+        size_t length = 0;
+        for (size_t i = 0; i < field_size && field[i] != '\0'; i++) {
+            if (field[i] >= 32 && field[i] <= 126) out[length++] = field[i];
+        }
+        out[length] = '\0';
+        return length;
+    }
+    
+    // Everything EncodeAccountFields reads from UserInfo. A template built from a
+    // different fingerprint is stale.
+    static uint64_t AccountFingerprint(const UserInfo& user) {
+        uint64_t hash = Fnv1a(&user.login, sizeof(user.login));
+        hash = Fnv1a(&user.balance, sizeof(user.balance), hash);
+        hash = Fnv1a(user.group, strnlen(user.group, sizeof(user.group)), hash);
+        return hash;
+    }
+    
+    // Account-dependent ScoringRequest fields. These only change with the account,
+    // so they are encoded once per login and replayed from AccountTemplateCache.
+    void EncodeAccountFields(const UserInfo& user, ProtoWriter& request) {
+        namespace field = scoring::ScoringRequest;
+        
+        field::opening_balance(request, (float)user.balance);
+        
+        // Trading performance metrics (use defaults for unavailable data)
+        field::profitable_ratio(request, 0.6f);
+        field::num_open_trades(request, (int64_t)3);
+        field::num_closed_trades(request, (int64_t)50);
+        field::age(request, (int64_t)35);                           // years
+        field::days_since_reg(request, (int64_t)90);
+        field::deposit_lifetime(request, (float)user.balance * 1.5f);
+        field::deposit_count(request, (int64_t)5);
+        field::withdraw_lifetime(request, (float)user.balance * 0.2f);
+        field::withdraw_count(request, (int64_t)2);
+        field::vip(request, (int64_t)0);                            // 0 = regular
+        field::holding_time_sec(request, (int64_t)3600);            // 1 hour avg
+        field::lot_usd_value(request, 100000.0f);
+        field::max_drawdown(request, -500.0f);
+        field::max_runup(request, 800.0f);
+        field::volume_24h(request, 5.0f);
+        field::trader_tenure_days(request, 90.0f);
+        field::deposit_to_withdraw_ratio(request, 7.5f);
+        field::education_known(request, (int64_t)1);
+        field::occupation_known(request, (int64_t)1);
+        
+        // Context & metadata
+        char group[sizeof(user.group) + 1];
+        size_t group_length = CopyAsciiField(user.group, sizeof(user.group), group);
+        if (group_length > 0) {
+            field::trading_group(request, group, group_length);
+        }
+        field::platform(request, "MT4");
+    }
+    
+    // Write one length-prefixed ScoringRequest frame into the caller's buffer.
+    // Returns false if the request did not fit.
+    bool CreateScoringRequest(const TradeRecord& trade, const UserInfo& user, const SymbolInfo& symbol, ProtoWriter& frame) {
+        uint64_t fingerprint = 0;
+        size_t account_mark = 0;
+        bool template_miss = false;
+        {
+            ABBOOK_NO_ALLOC_SCOPE(no_alloc);
+            frame.Clear();
+            size_t mark = frame.BeginFrame();
+            EncodeScoringRequest(trade, symbol, frame);
+            
+            // Account part: replay the cached template, or encode it once and cache it below
+            if (config->send_account_fields) {
+                fingerprint = AccountFingerprint(user);
+                account_mark = frame.Size();
+                if (!account_templates.AppendTo(user.login, fingerprint, frame)) {
+                    EncodeAccountFields(user, frame);
+                    template_miss = true;
+                }
+            }
+            frame.EndFrame(mark);
+        }
+        if (template_miss && frame.Ok()) {
+            account_templates.Store(user.login, fingerprint, frame.Data() + account_mark, frame.Size() - account_mark);
+        }
+        
+        if (!frame.Ok()) {
+            // Request does not fit - send user_id only
+            ABBOOK_LOG_WARN(*logger, "ML SERVICE WARNING: ScoringRequest exceeds request buffer - sending minimal request");
+            char user_id[16];
+            int user_id_length = snprintf(user_id, sizeof(user_id), "%d", trade.login);
+            frame.Clear();
+            size_t mark = frame.BeginFrame();
+            scoring::ScoringRequest::user_id(frame, user_id, (size_t)user_id_length);
+            frame.EndFrame(mark);
+        }
+        
+        // Diagnostics are logged after encoding so they stay out of the no-allocation region
+        ABBOOK_LOG_DEBUG(*logger, "UTF-8 DIAGNOSTIC: Final UTF-8 safe symbol: [" + std::string(symbol.name, symbol.name_length) +
+                    "] (symbol ID " + std::to_string(symbol.id) + ")");
+        ABBOOK_LOG_DEBUG(*logger, "ML SERVICE: Encoded ScoringRequest (" + std::to_string(frame.Size()) + " bytes incl. length prefix)");
+        return frame.Ok();
+    }
+    
+    std::string CreateLengthPrefixedMessage(const std::string& protobuf_body) {
+        std::string message;
+        uint32_t length = protobuf_body.length();
+        
+        // Length prefix (4 bytes, network byte order)
+        message += (char)((length >> 24) & 0xFF);
+        message += (char)((length >> 16) & 0xFF);
+        message += (char)((length >> 8) & 0xFF);
+        message += (char)(length & 0xFF);
+        
+        // Protobuf body
+        message += protobuf_body;
+        
+        return message;
+    }
+    
+    // Cold path only: hex dump of a response we could not use
+    void LogResponseHex(const char* protobuf_data, size_t length) {
+        static const char hex_digits[] = "0123456789ABCDEF";
+        std::string hex_debug = "Response hex: ";
+        for (size_t i = 0; i < length && i < 16; i++) {
+            hex_debug += hex_digits[(unsigned char)protobuf_data[i] >> 4];
+            hex_debug += hex_digits[(unsigned char)protobuf_data[i] & 0x0F];
+            hex_debug += ' ';
+        }
+        ABBOOK_LOG_DEBUG(*logger, "ML SERVICE: " + hex_debug);
+    }
+    
+    // Decode a ScoringResponse in place. Returns the score, or -1.0f if the response is
+    // malformed. proto3 never puts a field at its default value on the wire, so a
+    // well-formed response without a score field is a score of 0.0.
+    float ParseScoreFromProtobuf(const char* protobuf_data, int length) {
+        ScoringResponseView response;
+        ProtoDecodeStatus status = DecodeScoringResponse(protobuf_data, (size_t)length, response);
+        
+        if (status != PROTO_DECODE_OK) {
+            ABBOOK_LOG_WARN(*logger, "ML SERVICE WARNING: Malformed protobuf response (" + std::string(DescribeProtoDecodeStatus(status)) +
+                        ", " + std::to_string(length) + " bytes)");
+            LogResponseHex(protobuf_data, (size_t)length);
+            return -1.0f;
+        }
+        
+        for (size_t i = 0; i < response.warning_count && i < ScoringResponseView::MAX_WARNINGS; i++) {
+            ABBOOK_LOG_WARN(*logger, "ML SERVICE: Scoring warning: " + std::string(response.warnings[i].data, response.warnings[i].length));
+        }
+        
+        if (!response.has_score) {
+            ABBOOK_LOG_DEBUG(*logger, "ML SERVICE: Response has no score field - proto3 default 0.0");
+        }
+        return response.score;
+    }
+    
+    // Validate a ScoringResponse body and extract the score. Returns false (score untouched)
+    // if the body carries no usable score.
+    bool AcceptResponseBody(const char* body, uint32_t length, double& score) {
+        float parsed_score = ParseScoreFromProtobuf(body, (int)length);
+        
+        if (parsed_score >= 0.0f && parsed_score <= 1.0f) {
+            score = (double)parsed_score;
+            ABBOOK_LOG_DEBUG(*logger, "ML SERVICE: Received valid score: " + std::to_string(score));
+            return true;
+        } else if (parsed_score == -1.0f) {
+            ABBOOK_LOG_WARN(*logger, "ML SERVICE WARNING: Undecodable protobuf response - using fallback");
+        } else {
+            ABBOOK_LOG_WARN(*logger, "ML SERVICE WARNING: Score out of valid range [0.0-1.0]: " + std::to_string(parsed_score) + " - using fallback");
+        }
+        return false;
+    }
+    
+    // Outcome of a multiplexed call, blocking or not
+    ScoreAttempt AcceptChannelResult(ChannelStatus status, int error_code, const char* body, uint32_t length, double& score) {
+        switch (status) {
+            case CHANNEL_OK:
+                ABBOOK_LOG_DEBUG(*logger, "ML SERVICE: Received multiplexed response (" + std::to_string(length) + " bytes)");
+                return AcceptResponseBody(body, length, score) ? ATTEMPT_OK : ATTEMPT_FAILED;
+            case CHANNEL_CONNECT_FAILED:
+                ABBOOK_LOG_WARN(*logger, "ML SERVICE: " + DescribeConnectError(error_code) + " - using fallback score");
+                break;
+            case CHANNEL_SEND_FAILED:
+                ABBOOK_LOG_WARN(*logger, "ML SERVICE: Failed to send request (WSA error: " + std::to_string(error_code) + ") - using fallback score");
+                break;
+            case CHANNEL_TIMEOUT:
+                ABBOOK_LOG_WARN(*logger, "ML SERVICE WARNING: Latency budget exhausted waiting for multiplexed response - using fallback score");
+                return ATTEMPT_BUDGET_EXPIRED;
+            case CHANNEL_DISCONNECTED:
+                ABBOOK_LOG_WARN(*logger, "ML SERVICE WARNING: Multiplexed connection lost before response - using fallback score");
+                break;
+        }
+        return ATTEMPT_FAILED;
+    }
+    
+    // Multiplexed mode: share one connection across all trade threads
+    ScoreAttempt GetScoreViaChannel(const ProtoWriter& request_frame, double& score, const ScoringDeadline& deadline, StageTimer& stages) {
+        std::string response;
+        int error_code = 0;
+        
+        ABBOOK_LOG_DEBUG(*logger, "ML SERVICE: Sending multiplexed request (" + std::to_string(request_frame.Size() - 4) + " bytes body, " +
+                    std::to_string(channel->InFlight()) + " in flight)");
+        
+        ChannelStatus status = channel->Call(request_frame.Data() + 4, request_frame.Size() - 4, response, deadline, error_code);
+        stages.Mark(STAGE_WAIT);
+        ScoreAttempt result = AcceptChannelResult(status, error_code, response.data(), (uint32_t)response.length(), score);
+        if (status == CHANNEL_OK) stages.Mark(STAGE_PARSE);
+        return result;
+    }
+    
+    // One length-prefixed request/response exchange on a pooled connection (batch transport).
+    bool PooledRoundTrip(const std::string& body, std::string& response_body, const ScoringDeadline& deadline) {
+        std::string message = CreateLengthPrefixedMessage(body);
+        
+        for (int attempt = 0; attempt < 2; attempt++) {
+            int error_code = 0;
+            PooledConnection conn = pool->Acquire(error_code, deadline);
+            if (conn.sock == INVALID_SOCKET) {
+                ABBOOK_LOG_WARN(*logger, "ML SERVICE: " + DescribeConnectError(error_code) + " - batch uses fallback scores");
+                return false;
+            }
+            bool from_pool = conn.from_pool;
+            
+            bool ok = SendAllUntil(conn.sock, message.data(), (int)message.length(), deadline, error_code);
+            FrameReadStatus status = FRAME_IO_ERROR;
+            if (ok) {
+                const char* body = nullptr;
+                uint32_t length = 0;
+                status = conn.reader->ReadFrame(conn.sock, deadline, body, length, error_code);
+                if (status == FRAME_OK) {
+                    response_body.assign(body, length);
+                    pool->Release(conn, true);
+                    return true;
+                }
+            }
+            if (ok && status != FRAME_CLOSED) {
+                pool->Release(conn, false);
+                ABBOOK_LOG_WARN(*logger, "ML SERVICE WARNING: Incomplete batch response received (WSA error: " + std::to_string(error_code) + ") - using fallback scores");
+                return false;
+            }
+            
+            pool->Release(conn, false);
+            if (from_pool && attempt == 0 && error_code != WSAETIMEDOUT) {
+                ABBOOK_LOG_DEBUG(*logger, "ML SERVICE POOL: Stale pooled connection - retrying batch on a fresh connection");
+                continue;
+            }
+            ABBOOK_LOG_WARN(*logger, "ML SERVICE: Batch round trip failed (WSA error: " + std::to_string(error_code) + ") - using fallback scores");
+            return false;
+        }
+        return false;
+    }
+    
+    // Outcome of a batched request, blocking or not
+    ScoreAttempt AcceptBatchResult(BatchStatus status, const std::string& response, double& score, const ScoringDeadline& deadline) {
+        switch (status) {
+            case BATCH_OK:
+                return AcceptResponseBody(response.data(), (uint32_t)response.length(), score) ? ATTEMPT_OK : ATTEMPT_FAILED;
+            case BATCH_TRANSPORT_FAILED:
+                ABBOOK_LOG_WARN(*logger, "ML SERVICE WARNING: Batch round trip failed - using fallback score");
+                return deadline.Expired() ? ATTEMPT_BUDGET_EXPIRED : ATTEMPT_FAILED;
+            case BATCH_MALFORMED_RESPONSE:
+                ABBOOK_LOG_WARN(*logger, "ML SERVICE WARNING: Malformed ScoringBatchResponse - using fallback score");
+                break;
+            case BATCH_DEADLINE_EXPIRED:
+                ABBOOK_LOG_WARN(*logger, "ML SERVICE WARNING: Latency budget exhausted waiting for batch - using fallback score");
+                return ATTEMPT_BUDGET_EXPIRED;
+        }
+        return ATTEMPT_FAILED;
+    }
+    
+    // Batching mode: join the current micro-batch and wait for its round trip
+    ScoreAttempt GetScoreViaBatch(const ProtoWriter& request_frame, double& score, const ScoringDeadline& deadline, StageTimer& stages) {
+        std::string response;
+        BatchStatus status = batcher.Submit(request_frame.Data() + 4, request_frame.Size() - 4, response, deadline);
+        stages.Mark(STAGE_WAIT);
+        ScoreAttempt result = AcceptBatchResult(status, response, score, deadline);
+        if (status == BATCH_OK) stages.Mark(STAGE_PARSE);
+        return result;
+    }
+    
+    // Direct mode: one request/response on a pooled connection
+    ScoreAttempt GetScoreViaPool(const ProtoWriter& request_frame, double& score, const ScoringDeadline& deadline, StageTimer& stages) {
+        PooledConnection conn;
+        
+        try {
+            // A pooled socket may have been closed by the server while idle; that only
+            // shows up on first use, so allow exactly one retry on a fresh connection.
+            for (int attempt = 0; attempt < 2; attempt++) {
+                int error_code = 0;
+                conn = pool->Acquire(error_code, deadline);
+                stages.Mark(STAGE_CONNECT);
+                if (conn.sock == INVALID_SOCKET) {
+                    ABBOOK_LOG_WARN(*logger, "ML SERVICE: " + DescribeConnectError(error_code) + " - using fallback score");
+                    return ATTEMPT_FAILED;
+                }
+                bool from_pool = conn.from_pool;
+                bool stale_connection = false;
+                bool accepted = false;
+                
+                ABBOOK_LOG_DEBUG(*logger, "ML SERVICE: Sending protobuf request (" + std::to_string(request_frame.Size()) + " bytes)" +
+                            (from_pool ? " on pooled connection" : " on new connection"));
+                
+                // Send request with error handling
+                bool sent = SendAllUntil(conn.sock, request_frame.Data(), (int)request_frame.Size(), deadline, error_code);
+                stages.Mark(STAGE_SEND);
+                if (!sent) {
+                    ABBOOK_LOG_WARN(*logger, "ML SERVICE: Failed to send request (WSA error: " + std::to_string(error_code) + ") - using fallback score");
+                    pool->Release(conn, false);
+                    if (error_code == WSAETIMEDOUT) {
+                        return ATTEMPT_BUDGET_EXPIRED;
+                    }
+                    if (from_pool && attempt == 0) {
+                        ABBOOK_LOG_DEBUG(*logger, "ML SERVICE POOL: Stale pooled connection - retrying on a fresh connection");
+                        continue;
+                    }
+                    return ATTEMPT_FAILED;
+                }
+                
+                // Receive one complete length-prefixed frame within the remaining budget,
+                // however many TCP segments it arrives in
+                const char* response_body = nullptr;
+                uint32_t response_length = 0;
+                FrameReadStatus status = conn.reader->ReadFrame(conn.sock, deadline, response_body, response_length, error_code);
+                stages.Mark(STAGE_WAIT);
+                
+                if (status == FRAME_OK) {
+                    ABBOOK_LOG_DEBUG(*logger, "ML SERVICE: Received response (" + std::to_string(4 + response_length) + " bytes, length prefix " +
+                                std::to_string(response_length) + ")");
+                    
+                    // Parse score from protobuf response in place (field 1, wire type 5 for float)
+                    accepted = AcceptResponseBody(response_body, response_length, score);
+                    stages.Mark(STAGE_PARSE);
+                } else if (status == FRAME_CLOSED) {
+                    ABBOOK_LOG_WARN(*logger, "ML SERVICE WARNING: Connection closed by server - using fallback score");
+                    stale_connection = true;
+                } else if (status == FRAME_TIMEOUT) {
+                    // The response is still in flight - this socket can never be reused
+                    ABBOOK_LOG_WARN(*logger, "ML SERVICE WARNING: Latency budget exhausted waiting for response - using fallback score");
+                    pool->Release(conn, false);
+                    return ATTEMPT_BUDGET_EXPIRED;
+                } else if (status == FRAME_TOO_LARGE) {
+                    ABBOOK_LOG_WARN(*logger, "ML SERVICE WARNING: Invalid response length prefix - using fallback score");
+                } else {
+                    ABBOOK_LOG_WARN(*logger, "ML SERVICE: Failed to receive response (WSA error: " + std::to_string(error_code) + ") - using fallback score");
+                    stale_connection = (error_code == WSAECONNRESET);
+                }
+                
+                // Only a connection that delivered exactly one clean frame goes back to the pool
+                pool->Release(conn, accepted);
+                
+                if (stale_connection && from_pool && attempt == 0) {
+                    ABBOOK_LOG_DEBUG(*logger, "ML SERVICE POOL: Stale pooled connection - retrying on a fresh connection");
+                    continue;
+                }
+                return accepted ? ATTEMPT_OK : ATTEMPT_FAILED;
+            }
+        } catch (...) {
+            pool->Release(conn, false);
+            throw;
+        }
+        return ATTEMPT_FAILED;
+    }
+    
+    // One request over the configured transport
+    ScoreAttempt SendScoringRequest(const ProtoWriter& request_frame, double& score, const ScoringDeadline& deadline, StageTimer& stages) {
+        if (config->enable_batching) {
+            return GetScoreViaBatch(request_frame, score, deadline, stages);
+        } else if (config->enable_multiplexing) {
+            return GetScoreViaChannel(request_frame, score, deadline, stages);
+        }
+        return GetScoreViaPool(request_frame, score, deadline, stages);
+    }
+    
+    // I/O thread: send a frame a trade thread queued on the engine, within the trade's deadline.
+    // Batched and multiplexed requests are handed over and completed from their callbacks,
+    // so the thread moves on to the next request instead of waiting for this one.
+    int SendQueuedRequest(const char* frame, size_t length, double& score, const ScoringDeadline& deadline, EngineTicket ticket) {
+        double fallback = score;
+        if (config->enable_batching) {
+            batcher.SubmitAsync(frame + 4, length - 4, deadline,
+                                [this, ticket, fallback, deadline](BatchStatus status, const std::string& response) {
+                double batch_score = fallback;
+                ScoreAttempt result = AcceptBatchResult(status, response, batch_score, deadline);
+                engine.Complete(ticket, (int)result, batch_score);
+            });
+            return ENGINE_WORK_PENDING;
+        }
+        if (config->enable_multiplexing) {
+            int error_code = 0;
+            ChannelStatus status = channel->CallAsync(frame + 4, length - 4, deadline, error_code,
+                                                      [this, ticket, fallback](ChannelStatus call_status, const char* body, uint32_t body_length) {
+                double channel_score = fallback;
+                ScoreAttempt result = AcceptChannelResult(call_status, 0, body, body_length, channel_score);
+                engine.Complete(ticket, (int)result, channel_score);
+            });
+            if (status == CHANNEL_OK) return ENGINE_WORK_PENDING;
+            return (int)AcceptChannelResult(status, error_code, nullptr, 0, score);
+        }
+        
+        char request_buffer[REQUEST_BUFFER_BYTES];
+        ProtoWriter request_frame(request_buffer, sizeof(request_buffer));
+        request_frame.Raw(frame, length);
+        StageTimer unused_stages;
+        return (int)GetScoreViaPool(request_frame, score, deadline, unused_stages);
+    }
+    
+    // Trade thread: hand the request to an I/O thread and sleep until it is answered.
+    // The trade's stages see the whole round trip as `wait`.
+    ScoreAttempt GetScoreViaEngine(const ProtoWriter& request_frame, double& score, const ScoringDeadline& deadline, StageTimer& stages) {
+        int result = ATTEMPT_FAILED;
+        EngineStatus status = engine.Submit(request_frame.Data(), request_frame.Size(), deadline, result, score);
+        stages.Mark(STAGE_WAIT);
+        switch (status) {
+            case ENGINE_OK:
+                return (ScoreAttempt)result;
+            case ENGINE_EXPIRED:
+                return ATTEMPT_BUDGET_EXPIRED;
+            case ENGINE_BUSY:
+                ABBOOK_LOG_WARN(*logger, "ML SERVICE: All " + std::to_string(ScoringEngine::MAX_REQUESTS) +
+                                " I/O requests in use - using fallback score");
+                return ATTEMPT_BUSY;
+            default:
+                return ATTEMPT_FAILED;
+        }
+    }
+    
+    // Revalidator worker: re-send a request queued by a stale cache hit. No trade
+    // waits on it, so it gets the full socket timeout instead of a latency budget.
+    bool RefreshScore(const char* frame, size_t length, double& score) {
+        if (!breaker.AllowRequest()) {
+            return false;
+        }
+        char request_buffer[REQUEST_BUFFER_BYTES];
+        ProtoWriter request_frame(request_buffer, sizeof(request_buffer));
+        request_frame.Raw(frame, length);
+        StageTimer unused_stages;
+        ScoreAttempt result = SendScoringRequest(request_frame, score, ScoringDeadline::In(config->socket_timeout), unused_stages);
+        if (result != ATTEMPT_BUDGET_EXPIRED) {
+            RecordConnectionResult(result == ATTEMPT_OK);
+        }
+        return result == ATTEMPT_OK && score >= 0.0 && score <= 1.0;
+    }
+    
+    // Breaker probe thread: one synthetic ScoringRequest (no account fields, login 0)
+    // with the full socket timeout. Its result is not cached and never routes a trade.
+    bool ProbeService() {
+        TradeRecord probe_trade = {};
+        probe_trade.cmd = OP_BUY;
+        probe_trade.volume = 100;
+        probe_trade.open_price = 1.0;
+        SymbolInfo probe_symbol = {};
+        probe_symbol.id = SymbolInfo::UNREGISTERED;
+        memcpy(probe_symbol.name, "EURUSD", 7);
+        probe_symbol.name_length = 6;
+        
+        char request_buffer[REQUEST_BUFFER_BYTES];
+        ProtoWriter request_frame(request_buffer, sizeof(request_buffer));
+        size_t mark = request_frame.BeginFrame();
+        EncodeScoringRequest(probe_trade, probe_symbol, request_frame);
+        request_frame.EndFrame(mark);
+        
+        double score = -1.0;
+        StageTimer unused_stages;
+        ScoreAttempt result = SendScoringRequest(request_frame, score, ScoringDeadline::In(config->socket_timeout), unused_stages);
+        return result == ATTEMPT_OK && score >= 0.0 && score <= 1.0;
+    }
+    
+    std::string DescribeConnectError(int error_code) {
+        switch (error_code) {
+            case WSAECONNREFUSED:
+                return "Connection refused (service not running or port closed)";
+            case WSAENETUNREACH:
+                return "Network unreachable";
+            case WSAETIMEDOUT:
+                return "Connection timed out";
+            case WSAEHOSTUNREACH:
+                return "Host unreachable";
+            case WSAEINVAL:
+                return "Invalid IP address format";
+            default:
+                return "Connection failed (WSA error: " + std::to_string(error_code) + ")";
+        }
+    }
+    
+public:
+    CVMClient(PluginConfig* cfg, PluginLogger* log, ScoringConnectionPool* connection_pool,
+              MultiplexedScoringChannel* scoring_channel) 
+        : config(cfg), logger(log), pool(connection_pool), channel(scoring_channel),
+          batcher(cfg, [this](const std::string& batch_request, std::string& batch_response, const ScoringDeadline& deadline) {
+              return PooledRoundTrip(batch_request, batch_response, deadline);
+          }),
+          revalidator(&score_cache, [this](const char* frame, size_t length, double& score) {
+              return RefreshScore(frame, length, score);
+          }),
+          prescorer(&score_cache, [this](const char* frame, size_t length, double& score) {
+              return RefreshScore(frame, length, score);
+          }, true),
+          engine([this](const char* frame, size_t length, double& score, const ScoringDeadline& deadline, EngineTicket ticket) {
+              return SendQueuedRequest(frame, length, score, deadline, ticket);
+          }),
+          prescoring(false),
+          breaker([this]() { return ProbeService(); }) {
+        breaker.SetListener([this](BreakerState from, BreakerState to) { LogBreakerTransition(from, to); });
+        // A leading I/O thread feeds its own batch with the requests queued behind it
+        batcher.SetWindowHook([this]() { return engine.RunQueued(); });
+    }
+    
+    // Score one trade within its end-to-end latency budget (connect + send + receive).
+    // When the budget runs out the fallback score is returned immediately.
+    double GetScore(const TradeRecord* trade, const UserInfo* user, const SymbolInfo& symbol, const ScoringDeadline& deadline,
+                    ScoreDetails* details = nullptr, StageTimer* stages = nullptr) {
+        ScoreDetails ignored;
+        if (!details) details = &ignored;
+        StageTimer unused_stages;
+        if (!stages) stages = &unused_stages;
+        details->source = SCORE_SOURCE_FALLBACK_BACKOFF;
+        details->request_hash = 0;
+        
+        // A recent ML score for the same login, symbol and trade shape is used as is,
+        // also while the service is backed off. Unregistered symbols share an ID and are not cached.
+        uint64_t cache_key = 0;
+        if (score_cache.Enabled() && symbol.id != SymbolInfo::UNREGISTERED) {
+            cache_key = ScoreCacheKey(trade->login, symbol.id, trade->cmd, trade->volume);
+            double cached_score;
+            ScoreCacheResult cached = score_cache.Lookup(cache_key, ScoreCacheNowMs(), cached_score);
+            stages->Mark(STAGE_CACHE);
+            if (cached == SCORE_CACHE_HIT) {
+                details->source = SCORE_SOURCE_CACHE;
+                return cached_score;
+            }
+            if (cached == SCORE_CACHE_STALE) {
+                // Stale-while-revalidate: route on the stale score now, refresh it in the background
+                if (!revalidator.Pending(cache_key)) {
+                    char request_buffer[REQUEST_BUFFER_BYTES];
+                    ProtoWriter request_frame(request_buffer, sizeof(request_buffer));
+                    if (CreateScoringRequest(*trade, *user, symbol, request_frame)) {
+                        details->request_hash = Fnv1a(request_frame.Data(), request_frame.Size());
+                        revalidator.Queue(cache_key, request_frame.Data(), request_frame.Size());
+                    }
+                    stages->Mark(STAGE_ENCODE);
+                }
+                details->source = SCORE_SOURCE_CACHE_STALE;
+                return cached_score;
+            }
+        }
+        
+        // CRITICAL: Always return fallback score while the circuit breaker is open -
+        // recovery is probed by the breaker's thread, never by a trade
+        if (!breaker.AllowRequest()) {
+            return config->fallback_score;
+        }
+        
+        // Single flight: an identical request already on its way answers this trade too
+        int flight = -1;
+        if (flights.Enabled() && symbol.id != SymbolInfo::UNREGISTERED) {
+            uint64_t flight_key = cache_key != 0 ? cache_key : ScoreCacheKey(trade->login, symbol.id, trade->cmd, trade->volume);
+            double shared_score;
+            int shared_source;
+            FlightRole role = flights.Board(flight_key, deadline.expires, flight, shared_score, shared_source);
+            if (role == FLIGHT_FOLLOWER || role == FLIGHT_EXPIRED) {
+                stages->Mark(STAGE_WAIT);
+                if (role == FLIGHT_EXPIRED) {
+                    details->source = SCORE_SOURCE_FALLBACK_BUDGET;
+                    return config->fallback_score;
+                }
+                details->source = shared_source == SCORE_SOURCE_ML ? SCORE_SOURCE_COALESCED : (JournalScoreSource)shared_source;
+                return shared_score;
+            }
+            if (role != FLIGHT_LEADER) flight = -1;
+        }
+        
+        double score;
+        try {
+            score = RequestScore(trade, user, symbol, deadline, details, stages, cache_key);
+        } catch (...) {
+            // Followers must never wait on a flight that will not land
+            if (flight >= 0) flights.Land(flight, config->fallback_score, SCORE_SOURCE_FALLBACK_EXCEPTION);
+            throw;
+        }
+        if (flight >= 0) {
+            flights.Land(flight, score, details->source);
+        }
+        return score;
+    }
+    
+private:
+    // Encode, send and validate one ScoringRequest; the cache miss path of GetScore()
+    double RequestScore(const TradeRecord* trade, const UserInfo* user, const SymbolInfo& symbol, const ScoringDeadline& deadline,
+                        ScoreDetails* details, StageTimer* stages, uint64_t cache_key) {
+        double score = config->fallback_score;
+        ScoreAttempt result = ATTEMPT_FAILED;
+        details->source = SCORE_SOURCE_FALLBACK_ERROR;
+        
+        // BULLETPROOF: Wrap everything in try-catch to prevent plugin unloading
+        try {
+            // Create scoring request (length-prefixed protobuf format)
+            // Encode into a fixed stack buffer - no heap work on the trade path
+            char request_buffer[REQUEST_BUFFER_BYTES];
+            ProtoWriter request_frame(request_buffer, sizeof(request_buffer));
+            CreateScoringRequest(*trade, *user, symbol, request_frame);
+            details->request_hash = Fnv1a(request_frame.Data(), request_frame.Size());
+            stages->Mark(STAGE_ENCODE);
+            
+            result = engine.Running() ? GetScoreViaEngine(request_frame, score, deadline, *stages)
+                                      : SendScoringRequest(request_frame, score, deadline, *stages);
+            
+        } catch (const std::exception& e) {
+            ABBOOK_LOG_ERROR(*logger, "ML SERVICE EXCEPTION: " + std::string(e.what()) + " - using fallback score (plugin remains stable)");
+            ABBOOK_LOG_ERROR(*logger, "CRASH DIAGNOSTIC: ML service exception caught: " + std::string(e.what()));
+            ABBOOK_LOG_ERROR(*logger, "CRASH DIAGNOSTIC: Connection discarded after exception");
+            result = ATTEMPT_FAILED;
+            details->source = SCORE_SOURCE_FALLBACK_EXCEPTION;
+        } catch (...) {
+            ABBOOK_LOG_ERROR(*logger, "ML SERVICE: Unknown exception occurred - using fallback score (plugin remains stable)");
+            ABBOOK_LOG_ERROR(*logger, "CRASH DIAGNOSTIC: Unknown ML service exception caught");
+            ABBOOK_LOG_ERROR(*logger, "CRASH DIAGNOSTIC: Could be network stack corruption or invalid memory access");
+            ABBOOK_LOG_ERROR(*logger, "CRASH DIAGNOSTIC: Connection discarded after unknown exception");
+            result = ATTEMPT_FAILED;
+            details->source = SCORE_SOURCE_FALLBACK_EXCEPTION;
+        }
+        
+        // Record connection result for retry logic. A slow answer on a working
+        // connection is not an outage, so an exhausted budget does not back off;
+        // neither does a full I/O request table, which never reached the service.
+        if (result != ATTEMPT_BUDGET_EXPIRED && result != ATTEMPT_BUSY) {
+            RecordConnectionResult(result == ATTEMPT_OK);
+        }
+        if (result == ATTEMPT_BUDGET_EXPIRED) {
+            details->source = SCORE_SOURCE_FALLBACK_BUDGET;
+        } else if (result == ATTEMPT_BUSY) {
+            details->source = SCORE_SOURCE_FALLBACK_BUSY;
+        }
+        if (result != ATTEMPT_OK) {
+            return config->fallback_score;
+        }
+        
+        // GUARANTEE: Always return a valid score
+        if (score < 0.0 || score > 1.0) {
+            ABBOOK_LOG_WARN(*logger, "ML SERVICE: Normalizing invalid score to fallback value");
+            details->source = SCORE_SOURCE_FALLBACK_INVALID;
+            return config->fallback_score;
+        }
+        
+        details->source = SCORE_SOURCE_ML;
+        if (cache_key != 0) {
+            score_cache.Store(cache_key, score, ScoreCacheNowMs());
+        }
+        return score;
+    }
+    
+public:
+    // Apply [Request_Encoding] once the config file has been loaded
+    void ConfigureAccountTemplates() {
+        account_templates.SetCapacity((size_t)config->account_template_cache_size);
+    }
+    
+    const AccountTemplateCache& GetAccountTemplates() const {
+        return account_templates;
+    }
+    
+    // Apply [CVM_Connection] CoalesceRequests once the config file has been loaded
+    void ConfigureSingleFlight() {
+        flights.SetEnabled(config->coalesce_requests);
+    }
+    
+    const SingleFlight& GetSingleFlight() const {
+        return flights;
+    }
+    
+    // Apply [CVM_Connection] IoThreads once the connection pool is warm
+    void ConfigureScoringEngine() {
+        engine.Start(config->io_threads);
+    }
+    
+    const ScoringEngine& GetScoringEngine() const {
+        return engine;
+    }
+    
+    // Apply [Score_Cache] once the config file has been loaded
+    void ConfigureScoreCache() {
+        if (config->enable_score_cache) {
+            score_cache.Configure((size_t)config->max_cache_size, config->cache_ttl_ms,
+                                  config->stale_while_revalidate ? config->max_staleness_ms : 0);
+            if (score_cache.ServesStale()) {
+                revalidator.Start();
+            }
+            if (config->enable_prescoring) {
+                score_cache.SetPrescoreTtl(config->prescore_ttl_ms);
+                prescorer.SetRateLimit(config->max_prescores_per_sec);
+                prescorer.Start();
+                prescoring = true;
+            }
+        }
+    }
+    
+    // Apply [Circuit_Breaker] and start the probe thread once the connection pool is warm
+    void StartCircuitBreaker() {
+        breaker.Configure(config->breaker_failure_threshold, config->breaker_probe_interval_ms,
+                          config->breaker_max_probe_interval_ms);
+        breaker.Start();
+    }
+    
+    const CircuitBreaker& GetCircuitBreaker() const {
+        return breaker;
+    }
+    
+    BreakerCounters GetBreakerCounters() const {
+        BreakerCounters counters;
+        counters.state = breaker.State();
+        counters.opened = breaker.Opened();
+        counters.half_opened = breaker.HalfOpened();
+        counters.closed = breaker.Closed();
+        counters.open_ms = breaker.OpenMs();
+        return counters;
+    }
+    
+    // Before the connection pool stops - the I/O threads, both background scorers
+    // and the breaker's probes send through it
+    void StopBackgroundScoring() {
+        prescoring = false;
+        breaker.Stop();
+        prescorer.Stop();
+        revalidator.Stop();
+        engine.Stop();
+    }
+    
+    // Queue a background score for the market order `activity` points to (a pending
+    // order's direction, or a closed position's symbol and direction again), unless
+    // the cache already holds a fresh score for it or one is on its way
+    void Prescore(const TradeRecord& activity, const UserInfo& user, const SymbolInfo& symbol) {
+        if (!prescoring || symbol.id == SymbolInfo::UNREGISTERED) return;
+        TradeRecord order = activity;
+        order.cmd = activity.cmd & 1;      // BUYLIMIT/BUYSTOP -> BUY, SELLLIMIT/SELLSTOP -> SELL
+        order.state = ORDER_OPENED;
+        uint64_t cache_key = ScoreCacheKey(order.login, symbol.id, order.cmd, order.volume);
+        if (score_cache.Peek(cache_key, ScoreCacheNowMs()) == SCORE_CACHE_HIT ||
+            prescorer.Pending(cache_key) || revalidator.Pending(cache_key)) {
+            return;
+        }
+        char request_buffer[REQUEST_BUFFER_BYTES];
+        ProtoWriter request_frame(request_buffer, sizeof(request_buffer));
+        if (CreateScoringRequest(order, user, symbol, request_frame)) {
+            prescorer.Queue(cache_key, request_frame.Data(), request_frame.Size());
+        }
+    }
+    
+    // Keep the login's latest market order so its next login can pre-score it
+    void RememberOrder(const TradeRecord& trade) {
+        if (!prescoring) return;
+        std::lock_guard<std::mutex> lock(last_orders_mutex);
+        if (last_orders.size() >= MAX_REMEMBERED_ORDERS && last_orders.find(trade.login) == last_orders.end()) {
+            last_orders.erase(last_orders.begin());
+        }
+        last_orders[trade.login] = trade;
+    }
+    
+    bool LastOrder(int login, TradeRecord& order) {
+        std::lock_guard<std::mutex> lock(last_orders_mutex);
+        auto it = last_orders.find(login);
+        if (it == last_orders.end()) return false;
+        order = it->second;
+        return true;
+    }
+    
+    bool PrescoringEnabled() const {
+        return prescoring;
+    }
+    
+    // The length-prefixed ScoringRequest GetScore would send for this trade (benchmarks)
+    bool EncodeRequest(const TradeRecord& trade, const UserInfo& user, const SymbolInfo& symbol, ProtoWriter& frame) {
+        return CreateScoringRequest(trade, user, symbol, frame);
+    }
+    
+    PrescoreCounters GetPrescoreCounters() const {
+        PrescoreCounters counters;
+        counters.queued = prescorer.Queued();
+        counters.dropped = prescorer.Dropped();
+        counters.stored = score_cache.PrescoresStored();
+        counters.hits = score_cache.PrescoreHits();
+        return counters;
+    }
+    
+    const ScoreCache& GetScoreCache() const {
+        return score_cache;
+    }
+    
+    const ScoreRevalidator& GetRevalidator() const {
+        return revalidator;
+    }
+    
+    const ScoreRevalidator& GetPrescorer() const {
+        return prescorer;
+    }
+    
+    // Public method to check ML service status
+    bool IsMLServiceAvailable() const {
+        return breaker.AllowRequest();
+    }
+    
+    int GetConsecutiveFailures() const {
+        return breaker.Failures();
+    }
+};
@@ -0,0 +1,377 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Scoring Engine                   |
+//| Dedicated I/O threads own the sockets; trade threads queue a   |
+//| request descriptor and sleep until its answer or deadline      |
+//+------------------------------------------------------------------+
+//
+// With IoThreads > 0 the MT4 threads calling MtSrvTradeTransaction never
+// touch a socket. A trade thread takes a descriptor from a fixed pool,
+// copies its encoded frame into it and pushes it onto the lock-free MPSC
+// queue of one I/O thread (an idle one if any), then waits on the
+// descriptor's event until the I/O thread has run the frame through the
+// configured transport (pool, multiplexed channel or batcher, including
+// their retries) or its deadline passes. Connections in use are bounded by the number of
+// I/O threads, however many trade threads call in.
+//
+// Work may also finish later on another thread: it returns
+// ENGINE_WORK_PENDING and whoever gets the answer calls Complete() with the
+// ticket. The multiplexed channel and the batcher work this way, so an I/O
+// thread hands a request over and goes back to its queue; requests in
+// flight are bounded by MAX_REQUESTS, not by the number of I/O threads. A
+// batch leader's window drains its own queue through RunQueued(), so a batch
+// fills up even with a single I/O thread.
+//
+// Each queue is an intrusive Vyukov MPSC list: a push is one atomic
+// exchange, only the owning I/O thread pops. Idle I/O threads sleep on an
+// event that producers set only when the thread announced it was going to
+// sleep. Descriptors move QUEUED -> RUNNING -> DONE; a trade thread that
+// gives up at its deadline marks its descriptor ABANDONED and the I/O thread
+// returns it to the pool when it is done with it, so nothing on the trade
+// thread's stack is ever touched after it returned.
+//
+// Waits use PlatformEvent: a Win32 auto-reset event, or a futex word on Linux.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <memory>
+#include <functional>
+
+#include "ABBook_Platform.h"              // PlatformEvent
+#include "ABBook_SocketIO.h"
+
+enum EngineStatus {
+    ENGINE_OK = 0,                     // An I/O thread ran the request; result and score are filled in
+    ENGINE_EXPIRED,                    // Deadline passed before the request completed
+    ENGINE_BUSY,                       // Every descriptor is in use
+    ENGINE_STOPPED,                    // Engine not running
+    ENGINE_FAILED                      // The transport threw, or the frame is too large
+};
+
+// Identifies a request whose work finishes later; see ScoringEngine::Complete
+typedef void* EngineTicket;
+
+// Returned by EngineWork that will call ScoringEngine::Complete instead
+static const int ENGINE_WORK_PENDING = -1;
+
+// Runs one length-prefixed frame through the transport on an I/O thread; the
+// return value is handed back to the trade thread unchanged. Work returning
+// ENGINE_WORK_PENDING must call Complete(ticket, ...) exactly once, from any
+// thread, and must not touch `score` or the frame afterwards.
+typedef std::function<int(const char* frame, size_t length, double& score, const ScoringDeadline& deadline,
+                          EngineTicket ticket)> EngineWork;
+
+class ScoringEngine {
+public:
+    static const size_t MAX_REQUESTS = 256;            // Descriptors, i.e. trades waiting at once
+    static const size_t MAX_FRAME_BYTES = 1024;
+    static const int MAX_IO_THREADS = 16;
+
+private:
+    enum RequestState : uint32_t {
+        REQUEST_FREE = 0,
+        REQUEST_QUEUED,
+        REQUEST_RUNNING,
+        REQUEST_DONE,
+        REQUEST_ABANDONED                              // Trade thread left; the I/O thread frees it
+    };
+
+    struct Request {
+        std::atomic<Request*> next;                    // MPSC queue link
+        std::atomic<uint32_t> next_free;               // Free list link (index + 1, 0 = end)
+        std::atomic<uint32_t> state;
+        ScoringDeadline deadline;
+        size_t length;
+        EngineStatus status;
+        int result;
+        double score;
+        PlatformEvent done;
+        char frame[MAX_FRAME_BYTES];
+
+        Request() : next(nullptr), next_free(0), state(REQUEST_FREE), length(0), status(ENGINE_OK), result(0), score(0.0) {}
+    };
+
+    // Intrusive Vyukov MPSC queue
+    struct IoThread {
+        std::atomic<Request*> head;                    // Producers exchange here
+        Request* tail;                                 // Consumer only
+        Request stub;
+        std::atomic<bool> sleeping;
+        PlatformEvent wake;
+        std::thread thread;
+
+        IoThread() : head(&stub), tail(&stub), sleeping(false) {}
+
+        void Push(Request* request) {
+            request->next.store(nullptr, std::memory_order_relaxed);
+            Request* previous = head.exchange(request, std::memory_order_acq_rel);
+            previous->next.store(request, std::memory_order_release);
+        }
+
+        // Null when empty or when a push is half done (its producer wakes us afterwards)
+        Request* Pop() {
+            Request* first = tail;
+            Request* next = first->next.load(std::memory_order_acquire);
+            if (first == &stub) {
+                if (!next) return nullptr;
+                tail = next;
+                first = next;
+                next = next->next.load(std::memory_order_acquire);
+            }
+            if (next) {
+                tail = next;
+                return first;
+            }
+            if (first != head.load(std::memory_order_acquire)) return nullptr;
+            Push(&stub);
+            next = first->next.load(std::memory_order_acquire);
+            if (next) {
+                tail = next;
+                return first;
+            }
+            return nullptr;
+        }
+    };
+
+    EngineWork work;
+    std::unique_ptr<Request[]> requests;
+    std::atomic<uint64_t> free_head;                   // (ABA tag << 32) | (index + 1)
+    std::unique_ptr<IoThread[]> io_threads;
+    int thread_count;
+    std::atomic<uint32_t> next_thread;
+    std::atomic<bool> running;
+    std::atomic<bool> stopping;
+
+    std::atomic<unsigned long long> submitted;
+    std::atomic<unsigned long long> expired;
+    std::atomic<unsigned long long> busy;
+
+    Request* AcquireRequest() {
+        uint64_t head = free_head.load(std::memory_order_acquire);
+        for (;;) {
+            uint32_t index = (uint32_t)head;
+            if (index == 0) return nullptr;
+            uint32_t next = requests[index - 1].next_free.load(std::memory_order_relaxed);
+            uint64_t replacement = (((head >> 32) + 1) << 32) | next;
+            if (free_head.compare_exchange_weak(head, replacement, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                return &requests[index - 1];
+            }
+        }
+    }
+
+    void ReleaseRequest(Request* request) {
+        request->state.store(REQUEST_FREE, std::memory_order_relaxed);
+        uint32_t index = (uint32_t)(request - requests.get()) + 1;
+        uint64_t head = free_head.load(std::memory_order_relaxed);
+        for (;;) {
+            request->next_free.store((uint32_t)head, std::memory_order_relaxed);
+            uint64_t replacement = (((head >> 32) + 1) << 32) | index;
+            if (free_head.compare_exchange_weak(head, replacement, std::memory_order_release, std::memory_order_relaxed)) return;
+        }
+    }
+
+    // I/O thread: publish the outcome, or recycle the descriptor if its trade left
+    void Finish(Request* request, EngineStatus status) {
+        request->status = status;
+        uint32_t expected = REQUEST_RUNNING;
+        if (request->state.compare_exchange_strong(expected, REQUEST_DONE, std::memory_order_acq_rel)) {
+            request->done.Set();
+        } else {
+            ReleaseRequest(request);
+        }
+    }
+
+    void Run(Request* request) {
+        uint32_t expected = REQUEST_QUEUED;
+        if (!request->state.compare_exchange_strong(expected, REQUEST_RUNNING, std::memory_order_acq_rel)) {
+            ReleaseRequest(request);                   // Abandoned while queued
+            return;
+        }
+        if (request->deadline.Expired()) {
+            Finish(request, ENGINE_EXPIRED);
+            return;
+        }
+        EngineStatus status = ENGINE_OK;
+        try {
+            int result = work(request->frame, request->length, request->score, request->deadline, request);
+            if (result == ENGINE_WORK_PENDING) return;     // Complete() may already have recycled it
+            request->result = result;
+        } catch (...) {
+            status = ENGINE_FAILED;                    // Same contract as the trade path: never let the thread die
+        }
+        Finish(request, status);
+    }
+
+    // The I/O thread the calling thread is, if any
+    static IoThread*& CurrentIoThread() {
+        static thread_local IoThread* current = nullptr;
+        return current;
+    }
+
+    void IoLoop(IoThread* self) {
+        CurrentIoThread() = self;
+        while (!stopping.load(std::memory_order_acquire)) {
+            Request* request = self->Pop();
+            if (request) {
+                Run(request);
+                continue;
+            }
+            // Announce the sleep, then look once more: a producer that pushed
+            // before seeing the flag has its request visible by now
+            self->sleeping.store(true, std::memory_order_seq_cst);
+            request = self->Pop();
+            if (request) {
+                self->sleeping.store(false, std::memory_order_relaxed);
+                Run(request);
+                continue;
+            }
+            self->wake.Wait(1000);
+            self->sleeping.store(false, std::memory_order_relaxed);
+        }
+        // Stopping: answer whatever is still queued so no trade waits for its deadline
+        while (Request* request = self->Pop()) {
+            uint32_t expected = REQUEST_QUEUED;
+            if (request->state.compare_exchange_strong(expected, REQUEST_RUNNING, std::memory_order_acq_rel)) {
+                Finish(request, ENGINE_STOPPED);
+            } else {
+                ReleaseRequest(request);
+            }
+        }
+    }
+
+public:
+    explicit ScoringEngine(EngineWork engine_work)
+        : work(engine_work), free_head(0), thread_count(0), next_thread(0), running(false), stopping(false),
+          submitted(0), expired(0), busy(0) {}
+
+    ~ScoringEngine() {
+        // Never join under the loader lock (DLL_PROCESS_DETACH) - MtSrvCleanup does the orderly Stop().
+        // Threads still running keep the descriptors and queues alive.
+        if (running.load()) {
+            for (int i = 0; i < thread_count; i++) {
+                if (io_threads[i].thread.joinable()) io_threads[i].thread.detach();
+            }
+            requests.release();
+            io_threads.release();
+        }
+    }
+
+    // Start `threads` I/O threads (at most MAX_IO_THREADS). Call while no trade is being processed.
+    void Start(int threads) {
+        if (running.load() || threads <= 0) return;
+        thread_count = threads < MAX_IO_THREADS ? threads : MAX_IO_THREADS;
+        requests.reset(new Request[MAX_REQUESTS]);
+        for (size_t i = 0; i < MAX_REQUESTS; i++) {
+            requests[i].next_free.store(i + 1 < MAX_REQUESTS ? (uint32_t)(i + 2) : 0, std::memory_order_relaxed);
+        }
+        free_head.store(1, std::memory_order_relaxed);
+        io_threads.reset(new IoThread[thread_count]);
+        stopping.store(false);
+        running.store(true);
+        for (int i = 0; i < thread_count; i++) {
+            io_threads[i].thread = std::thread(&ScoringEngine::IoLoop, this, &io_threads[i]);
+        }
+    }
+
+    // Only once trades have stopped (MtSrvCleanup): queued requests are answered ENGINE_STOPPED
+    void Stop() {
+        if (!running.exchange(false)) return;
+        stopping.store(true, std::memory_order_release);
+        for (int i = 0; i < thread_count; i++) {
+            io_threads[i].wake.Set();
+        }
+        for (int i = 0; i < thread_count; i++) {
+            if (io_threads[i].thread.joinable()) io_threads[i].thread.join();
+        }
+    }
+
+    bool Running() const { return running.load(std::memory_order_relaxed); }
+
+    // Finish a request whose work returned ENGINE_WORK_PENDING. Any thread, once per request.
+    void Complete(EngineTicket ticket, int result, double score) {
+        Request* request = static_cast<Request*>(ticket);
+        request->result = result;
+        request->score = score;
+        Finish(request, ENGINE_OK);
+    }
+
+    // On an I/O thread, inside its work: run the next request queued for this
+    // thread, if there is one. Not re-entrant - a nested call returns false.
+    bool RunQueued() {
+        static thread_local bool nested = false;
+        IoThread* self = CurrentIoThread();
+        if (!self || nested) return false;
+        Request* request = self->Pop();
+        if (!request) return false;
+        nested = true;
+        Run(request);
+        nested = false;
+        return true;
+    }
+    int Threads() const { return thread_count; }
+
+    // Trade thread: queue the frame and sleep until an I/O thread has run it or
+    // the deadline passes. result and score are only valid with ENGINE_OK.
+    EngineStatus Submit(const char* frame, size_t length, const ScoringDeadline& deadline, int& result, double& score) {
+        if (!Running()) return ENGINE_STOPPED;
+        if (length > MAX_FRAME_BYTES) return ENGINE_FAILED;
+        Request* request = AcquireRequest();
+        if (!request) {
+            busy.fetch_add(1, std::memory_order_relaxed);
+            return ENGINE_BUSY;
+        }
+        memcpy(request->frame, frame, length);
+        request->length = length;
+        request->deadline = deadline;
+        request->done.Reset();
+        request->state.store(REQUEST_QUEUED, std::memory_order_relaxed);
+
+        // Prefer an idle I/O thread, otherwise round robin
+        uint32_t first = next_thread.fetch_add(1, std::memory_order_relaxed);
+        IoThread* target = &io_threads[first % (uint32_t)thread_count];
+        for (int i = 0; i < thread_count; i++) {
+            IoThread& candidate = io_threads[(first + (uint32_t)i) % (uint32_t)thread_count];
+            if (candidate.sleeping.load(std::memory_order_relaxed)) {
+                target = &candidate;
+                break;
+            }
+        }
+        IoThread& io = *target;
+        io.Push(request);
+        if (io.sleeping.exchange(false, std::memory_order_seq_cst)) {
+            io.wake.Set();
+        }
+        submitted.fetch_add(1, std::memory_order_relaxed);
+
+        // Only DONE or the deadline ends the wait. Any other wake is a stale Set():
+        // Finish() publishes DONE before it sets the event, so the descriptor's
+        // previous trade may have seen DONE at its deadline and recycled it first.
+        uint32_t state = request->state.load(std::memory_order_acquire);
+        while (state != REQUEST_DONE && !deadline.Expired()) {
+            request->done.WaitUntil(deadline.expires);
+            state = request->state.load(std::memory_order_acquire);
+        }
+        while (state != REQUEST_DONE) {
+            if (request->state.compare_exchange_weak(state, REQUEST_ABANDONED, std::memory_order_acq_rel)) {
+                expired.fetch_add(1, std::memory_order_relaxed);
+                return ENGINE_EXPIRED;                 // The I/O thread frees the descriptor
+            }
+        }
+        EngineStatus status = request->status;
+        if (status == ENGINE_OK) {
+            result = request->result;
+            score = request->score;
+        }
+        if (status == ENGINE_EXPIRED) expired.fetch_add(1, std::memory_order_relaxed);
+        ReleaseRequest(request);
+        return status;
+    }
+
+    unsigned long long Submitted() const { return submitted.load(std::memory_order_relaxed); }
+    unsigned long long Expired() const { return expired.load(std::memory_order_relaxed); }
+    unsigned long long Busy() const { return busy.load(std::memory_order_relaxed); }
+};
@@ -0,0 +1,136 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Single-Flight Scoring            |
+//| Concurrent requests for the same login and symbol share one    |
+//| round trip to the scoring service                              |
+//+------------------------------------------------------------------+
+//
+// An EA firing a burst of orders on one login misses the score cache on
+// every order, because none of the responses has arrived yet. The first
+// caller for a key boards as the leader and sends the request; callers
+// arriving while it is outstanding board as followers and sleep on the
+// flight's condition variable until the leader lands it with its result.
+// The plugin keys flights like the score cache (login, symbol, direction and
+// lot class), so only orders that would share a cached score share a flight.
+//
+// Flights live in a fixed table: 16 shards of 8 slots, each slot with its
+// own condition variable under the shard mutex. A slot is reused only when
+// no follower is still reading the previous result. With every slot of a
+// shard busy the caller flies solo (scores on its own), so the table never
+// blocks a trade. A follower waits no longer than its own deadline.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+
+enum FlightRole {
+    FLIGHT_SOLO = 0,                   // Not coalesced: score alone, do not Land()
+    FLIGHT_LEADER,                     // Score, then Land() the handle with the result
+    FLIGHT_FOLLOWER,                   // Result of the leader's request is filled in
+    FLIGHT_EXPIRED                     // Leader did not land before the follower's deadline
+};
+
+class SingleFlight {
+public:
+    static const size_t SHARDS = 16;
+    static const size_t SLOTS = 8;                     // Distinct keys in flight per shard
+
+private:
+    struct Flight {
+        uint64_t key;                                  // 0 = not boarding
+        int passengers;                                // Followers that have not read the result yet
+        bool landed;
+        double score;
+        int source;
+        std::condition_variable cv;
+
+        Flight() : key(0), passengers(0), landed(false), score(0.0), source(0) {}
+    };
+
+    struct Shard {
+        std::mutex mutex;
+        Flight flights[SLOTS];
+        char padding[64];
+    };
+
+    Shard shards[SHARDS];
+    std::atomic<bool> enabled;
+    std::atomic<unsigned long long> led;
+    std::atomic<unsigned long long> followed;
+    std::atomic<unsigned long long> expired;
+    std::atomic<unsigned long long> solo;
+
+    static size_t ShardOf(uint64_t key) {
+        key ^= key >> 33;
+        key *= 0xFF51AFD7ED558CCDULL;
+        key ^= key >> 33;
+        return (size_t)(key & (SHARDS - 1));
+    }
+
+public:
+    SingleFlight() : enabled(false), led(0), followed(0), expired(0), solo(0) {}
+
+    void SetEnabled(bool enable) { enabled.store(enable, std::memory_order_relaxed); }
+    bool Enabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // Join the flight for key (never 0) or start one. handle is set for the
+    // leader; a follower gets the leader's score and source.
+    FlightRole Board(uint64_t key, const std::chrono::steady_clock::time_point& deadline,
+                     int& handle, double& score, int& source) {
+        if (!Enabled() || key == 0) return FLIGHT_SOLO;
+        size_t shard_index = ShardOf(key);
+        Shard& shard = shards[shard_index];
+        std::unique_lock<std::mutex> lock(shard.mutex);
+
+        Flight* free_slot = nullptr;
+        for (size_t i = 0; i < SLOTS; i++) {
+            Flight& flight = shard.flights[i];
+            if (flight.key == key) {
+                flight.passengers++;
+                bool landed = flight.cv.wait_until(lock, deadline, [&flight]() { return flight.landed; });
+                flight.passengers--;
+                if (!landed) {
+                    expired.fetch_add(1, std::memory_order_relaxed);
+                    return FLIGHT_EXPIRED;
+                }
+                score = flight.score;
+                source = flight.source;
+                followed.fetch_add(1, std::memory_order_relaxed);
+                return FLIGHT_FOLLOWER;
+            }
+            if (!free_slot && flight.key == 0 && flight.passengers == 0) free_slot = &flight;
+        }
+        if (!free_slot) {
+            solo.fetch_add(1, std::memory_order_relaxed);
+            return FLIGHT_SOLO;
+        }
+        free_slot->key = key;
+        free_slot->landed = false;
+        handle = (int)(shard_index * SLOTS + (size_t)(free_slot - shard.flights));
+        led.fetch_add(1, std::memory_order_relaxed);
+        return FLIGHT_LEADER;
+    }
+
+    // Leader only, exactly once per FLIGHT_LEADER: publish the result and wake
+    // the followers. Callers arriving afterwards start a new flight.
+    void Land(int handle, double score, int source) {
+        Shard& shard = shards[(size_t)handle / SLOTS];
+        Flight& flight = shard.flights[(size_t)handle % SLOTS];
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            flight.score = score;
+            flight.source = source;
+            flight.landed = true;
+            flight.key = 0;
+        }
+        flight.cv.notify_all();
+    }
+
+    unsigned long long Led() const { return led.load(std::memory_order_relaxed); }
+    unsigned long long Followed() const { return followed.load(std::memory_order_relaxed); }
+    unsigned long long Expired() const { return expired.load(std::memory_order_relaxed); }
+    unsigned long long Solo() const { return solo.load(std::memory_order_relaxed); }
+};
@@ -0,0 +1,116 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Deadline-Driven Socket I/O       |
+//| Every connect/send/recv on the trade path is bounded by one    |
+//| end-to-end per-trade budget instead of per-call timeouts       |
+//+------------------------------------------------------------------+
+
+#pragma once
+
+#include <chrono>
+
+#include "ABBook_Platform.h"
+
+// Absolute point in time by which a scoring round trip must be finished
+struct ScoringDeadline {
+    std::chrono::steady_clock::time_point expires;
+
+    static ScoringDeadline In(int milliseconds) {
+        ScoringDeadline deadline;
+        deadline.expires = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+        return deadline;
+    }
+
+    long long RemainingUs() const {
+        long long remaining = std::chrono::duration_cast<std::chrono::microseconds>(
+            expires - std::chrono::steady_clock::now()).count();
+        return remaining > 0 ? remaining : 0;
+    }
+
+    int RemainingMs() const {
+        return (int)((RemainingUs() + 999) / 1000);
+    }
+
+    bool Expired() const {
+        return std::chrono::steady_clock::now() >= expires;
+    }
+};
+
+enum SocketWaitResult {
+    SOCKET_WAIT_READY = 1,
+    SOCKET_WAIT_TIMEOUT = 0,
+    SOCKET_WAIT_ERROR = -1
+};
+
+// Wait until the socket is readable (or writable) or the deadline passes.
+// A failed non-blocking connect is reported through the except set on Windows.
+inline SocketWaitResult WaitSocket(SOCKET sock, bool for_write, const ScoringDeadline& deadline) {
+    long long remaining_us = deadline.RemainingUs();
+    if (remaining_us <= 0) return SOCKET_WAIT_TIMEOUT;
+
+    int ready = PollSocket(sock, for_write, remaining_us);
+    if (ready == 0) return SOCKET_WAIT_TIMEOUT;
+    if (ready < 0) return SOCKET_WAIT_ERROR;
+    return SOCKET_WAIT_READY;
+}
+
+inline bool IsWouldBlock(int error_code) {
+    return error_code == WSAEWOULDBLOCK || error_code == WSAEINPROGRESS;
+}
+
+// Send the whole buffer on a non-blocking socket. On failure error_code is a WSA
+// error, or WSAETIMEDOUT if the deadline ran out first.
+inline bool SendAllUntil(SOCKET sock, const char* data, int length, const ScoringDeadline& deadline, int& error_code) {
+    error_code = 0;
+    while (length > 0) {
+        int sent = send(sock, data, length, MSG_NOSIGNAL);
+        if (sent > 0) {
+            data += sent;
+            length -= sent;
+            continue;
+        }
+        int last_error = WSAGetLastError();
+        if (sent == SOCKET_ERROR && IsWouldBlock(last_error)) {
+            SocketWaitResult wait = WaitSocket(sock, true, deadline);
+            if (wait == SOCKET_WAIT_READY) continue;
+            error_code = (wait == SOCKET_WAIT_TIMEOUT) ? WSAETIMEDOUT : WSAGetLastError();
+            return false;
+        }
+        error_code = last_error;
+        return false;
+    }
+    return true;
+}
+
+// Receive whatever is available (at least one byte) before the deadline.
+// Returns bytes received, 0 if the peer closed, or SOCKET_ERROR with error_code set.
+inline int RecvSomeUntil(SOCKET sock, char* data, int capacity, const ScoringDeadline& deadline, int& error_code) {
+    error_code = 0;
+    for (;;) {
+        int received = recv(sock, data, capacity, 0);
+        if (received >= 0) return received;
+
+        int last_error = WSAGetLastError();
+        if (!IsWouldBlock(last_error)) {
+            error_code = last_error;
+            return SOCKET_ERROR;
+        }
+        SocketWaitResult wait = WaitSocket(sock, false, deadline);
+        if (wait != SOCKET_WAIT_READY) {
+            error_code = (wait == SOCKET_WAIT_TIMEOUT) ? WSAETIMEDOUT : WSAGetLastError();
+            return SOCKET_ERROR;
+        }
+    }
+}
+
+inline bool RecvExactUntil(SOCKET sock, char* data, int length, const ScoringDeadline& deadline, int& error_code) {
+    while (length > 0) {
+        int received = RecvSomeUntil(sock, data, length, deadline, error_code);
+        if (received <= 0) {
+            if (received == 0) error_code = WSAECONNRESET;
+            return false;
+        }
+        data += received;
+        length -= received;
+    }
+    return true;
+}
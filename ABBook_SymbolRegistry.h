@@ -0,0 +1,213 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Symbol Registry                  |
+//| Interns raw MT4 symbols once; later trades resolve them with   |
+//| one hash of the 12 symbol bytes                                |
+//+------------------------------------------------------------------+
+//
+// The first trade on a symbol cleans it (garbage-prefix skipping, upper-
+// casing), classifies it into an instrument group from [Instrument_Groups]
+// and stores the result under a dense symbol ID. Every later trade hashes
+// the raw char[12], probes an open-addressed table and gets the same
+// SymbolInfo back - cleaned name, group, threshold, budget and contract size.
+//
+// Lookups of known symbols take no lock and never allocate. Registration
+// of a new symbol is serialised by a mutex and allocates once.
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <atomic>
+
+#include "ABBook_PluginConfig.h"
+
+// UTF-8 safe symbol cleaning into a fixed buffer (out must hold 13 bytes).
+// Returns the cleaned length; 0 means nothing usable was found.
+inline size_t CleanSymbolUtf8(const char* raw_symbol, size_t raw_length, char* out, bool* currency_pattern = nullptr) {
+    static const char* const currency_prefixes[] = {
+        "USD", "EUR", "GBP", "AUD", "NZD", "CAD", "CHF", "JPY", "XPT", "XAU", "GER", "UK1", "FRA", "JPN"
+    };
+    size_t clean_length = 0;
+
+    // UTF-8 SAFE SYMBOL CLEANING - Remove ALL non-UTF-8 characters
+    bool found_currency_start = false;
+    for (size_t i = 0; i < raw_length && i < 12; i++) {
+        char c = raw_symbol[i];
+
+        // Skip garbage bytes at start, look for valid 3-letter currency codes
+        if (!found_currency_start) {
+            if (i + 2 < raw_length) {
+                for (const char* prefix : currency_prefixes) {
+                    if (memcmp(raw_symbol + i, prefix, 3) == 0) {
+                        found_currency_start = true;
+                        break;
+                    }
+                }
+                if (found_currency_start) {
+                    memcpy(out, raw_symbol + i, 3);
+                    clean_length = 3;
+                    i += 2; // Skip next 2 chars as they're part of this currency
+                    continue;
+                }
+            }
+        } else {
+            // After finding currency start, add only valid UTF-8 ASCII characters
+            if (c >= 'A' && c <= 'Z') {
+                out[clean_length++] = c;
+            } else if (c >= 'a' && c <= 'z') {
+                out[clean_length++] = (char)(c - 32); // Convert to uppercase
+            } else if (c >= '0' && c <= '9') {
+                out[clean_length++] = c;
+            } else if (c == '\0' || c == ' ') {
+                break; // End of symbol
+            }
+            // Skip any non-ASCII or invalid UTF-8 characters
+        }
+    }
+
+    // If no currency found, fall back to safe alphanumeric extraction
+    if (clean_length == 0) {
+        for (size_t i = 0; i < raw_length && i < 12; i++) {
+            char c = raw_symbol[i];
+            if (c >= 'A' && c <= 'Z') {
+                out[clean_length++] = c;
+            } else if (c >= 'a' && c <= 'z') {
+                out[clean_length++] = (char)(c - 32); // Convert to uppercase
+            } else if (c >= '0' && c <= '9') {
+                out[clean_length++] = c;
+            } else if (c == '\0') {
+                break;
+            }
+            // Skip any non-ASCII characters that could cause UTF-8 errors
+        }
+    }
+
+    if (currency_pattern) *currency_pattern = found_currency_start;
+    out[clean_length] = '\0';
+    return clean_length;
+}
+
+struct SymbolInfo {
+    static const uint32_t UNREGISTERED = 0xFFFFFFFFu;   // Registry full; resolved but not interned
+
+    uint32_t id;
+    char raw[12];                          // Key: raw bytes up to the first NUL, zero padded
+    char name[13];                         // Cleaned symbol, "UNKNOWN" if nothing usable
+    size_t name_length;
+    bool currency_pattern;                 // Cleaned by currency-prefix detection, not the fallback
+    const InstrumentGroupConfig* group;
+};
+
+class SymbolRegistry {
+public:
+    static const size_t TABLE_SLOTS = 4096;   // Power of two, kept at most half full
+    static const size_t MAX_SYMBOLS = TABLE_SLOTS / 2;
+
+private:
+    std::atomic<const SymbolInfo*> slots[TABLE_SLOTS];
+    std::deque<SymbolInfo> symbols;           // Stable addresses for the slot pointers
+    std::vector<InstrumentGroupConfig> groups;
+    std::mutex register_mutex;
+
+    static void MakeKey(const char* raw_symbol, char* key) {
+        size_t length = strnlen(raw_symbol, 12);
+        memcpy(key, raw_symbol, length);
+        memset(key + length, 0, 12 - length);
+    }
+
+    static size_t Hash(const char* key) {
+        uint64_t low, high = 0;
+        memcpy(&low, key, 8);
+        memcpy(&high, key + 8, 4);
+        uint64_t h = (low ^ (high << 32 | high)) * 0x9E3779B97F4A7C15ULL;
+        return (size_t)(h >> 40) & (TABLE_SLOTS - 1);
+    }
+
+    void Resolve(const char* key, SymbolInfo& info) const {
+        memcpy(info.raw, key, 12);
+        info.name_length = CleanSymbolUtf8(key, strnlen(key, 12), info.name, &info.currency_pattern);
+        if (info.name_length == 0) {
+            info.name_length = 7;
+            memcpy(info.name, "UNKNOWN", 8);
+        }
+        info.group = Classify(info.name);
+    }
+
+public:
+    SymbolRegistry() {
+        for (auto& slot : slots) slot.store(nullptr, std::memory_order_relaxed);
+        groups = EffectiveInstrumentGroups(PluginConfig());
+    }
+
+    // Load the instrument groups and forget every interned symbol. Only call
+    // while no trade is being processed (startup).
+    void Configure(const PluginConfig& config) {
+        std::lock_guard<std::mutex> lock(register_mutex);
+        for (auto& slot : slots) slot.store(nullptr, std::memory_order_relaxed);
+        symbols.clear();
+        groups = EffectiveInstrumentGroups(config);
+    }
+
+    // Resolve a raw MT4 symbol (char[12], not necessarily NUL terminated)
+    const SymbolInfo& Lookup(const char* raw_symbol) {
+        char key[12];
+        MakeKey(raw_symbol, key);
+        size_t start = Hash(key);
+
+        for (size_t i = start; ; i = (i + 1) & (TABLE_SLOTS - 1)) {
+            const SymbolInfo* info = slots[i].load(std::memory_order_acquire);
+            if (!info) break;
+            if (memcmp(info->raw, key, 12) == 0) return *info;
+        }
+        return Register(key, start);
+    }
+
+    size_t Count() {
+        std::lock_guard<std::mutex> lock(register_mutex);
+        return symbols.size();
+    }
+
+    // Instrument group of a cleaned symbol, as a new symbol is registered with.
+    // Groups are checked in configuration order; the last one is the default.
+    const InstrumentGroupConfig* Classify(const char* name) const {
+        for (const InstrumentGroupConfig& group : groups) {
+            for (const std::string& pattern : group.patterns) {
+                if (strstr(name, pattern.c_str())) return &group;
+            }
+        }
+        return &groups.back();
+    }
+
+    const std::vector<InstrumentGroupConfig>& Groups() const { return groups; }
+
+private:
+    const SymbolInfo& Register(const char* key, size_t start) {
+        std::lock_guard<std::mutex> lock(register_mutex);
+
+        size_t i = start;
+        for (; ; i = (i + 1) & (TABLE_SLOTS - 1)) {
+            const SymbolInfo* info = slots[i].load(std::memory_order_relaxed);
+            if (!info) break;
+            if (memcmp(info->raw, key, 12) == 0) return *info;   // Registered by another thread meanwhile
+        }
+
+        if (symbols.size() >= MAX_SYMBOLS) {
+            // Corrupted symbol bytes can mint endless keys; stop interning and resolve per call
+            static thread_local SymbolInfo scratch;
+            Resolve(key, scratch);
+            scratch.id = SymbolInfo::UNREGISTERED;
+            return scratch;
+        }
+
+        symbols.emplace_back();
+        SymbolInfo& info = symbols.back();
+        Resolve(key, info);
+        info.id = (uint32_t)(symbols.size() - 1);
+        slots[i].store(&info, std::memory_order_release);
+        return info;
+    }
+};
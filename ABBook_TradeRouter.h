@@ -0,0 +1,73 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Trade Router                     |
+//| Plugin lifecycle and the per-trade routing decision, without   |
+//| anything that ties it to the MT4 server or to Windows          |
+//+------------------------------------------------------------------+
+//
+// Owns everything the plugin keeps for its lifetime: configuration, logger,
+// connection pool, multiplexed channel, scoring client, symbol registry,
+// decision journal, trade tape, metrics exporter and stage latency stats. Startup() and
+// Cleanup() are MtSrvStartup/MtSrvCleanup, TradeTransaction() and
+// UserLogin() the per-event hooks with the same return codes.
+//
+// MT4_ABBook_Plugin_Official.cpp is a thin adapter: DllMain plus exports
+// that forward to one global TradeRouter. The router and everything below
+// it form the abbook_core library, which also builds on Linux for the unit
+// tests and benchmarks (see CMakeLists.txt).
+
+#pragma once
+
+#include <string>
+
+#include "ABBook_Platform.h"
+#include "ABBook_MT4Types.h"
+#include "ABBook_PluginConfig.h"
+#include "ABBook_PluginLogger.h"
+#include "ABBook_ConnectionPool.h"
+#include "ABBook_MultiplexedChannel.h"
+#include "ABBook_ScoringClient.h"
+#include "ABBook_SymbolRegistry.h"
+#include "ABBook_DecisionJournal.h"
+#include "ABBook_TradeTape.h"
+#include "ABBook_MetricsExporter.h"
+#include "ABBook_LatencyStats.h"
+
+class TradeRouter {
+private:
+    PluginConfig config;
+    PluginLogger logger;
+    ScoringConnectionPool connection_pool;
+    MultiplexedScoringChannel scoring_channel;
+    CVMClient cvm_client;
+    SymbolRegistry symbol_registry;
+    DecisionJournal decision_journal;
+    TradeTape trade_tape;
+    MetricsExporter metrics;
+    LatencyStats latency_stats;
+
+public:
+    explicit TradeRouter(const std::string& log_path = "ABBook_Plugin_Official.log", bool console = true);
+
+    TradeRouter(const TradeRouter&) = delete;
+    TradeRouter& operator=(const TradeRouter&) = delete;
+
+    // Load config_path (built-in defaults if it is missing) and start every
+    // background component. Returns 1, as MtSrvStartup does.
+    int Startup(const std::string& config_path);
+
+    // Stop the background threads, log the totals and close the journal and log
+    void Cleanup();
+
+    // Score and route one trade. Never throws; returns 0 for a routed (or safely
+    // rejected) market order and 1 for a trade that is not a new market order.
+    int TradeTransaction(TradeRecord* trade, UserInfo* user);
+
+    // Pre-score the login's last market order (no-op unless pre-scoring is on)
+    void UserLogin(UserInfo* user);
+
+    // Stage latency percentiles since startup
+    std::string LatencyReport();
+
+    PluginLogger& Logger() { return logger; }
+    const PluginConfig& Config() const { return config; }
+};
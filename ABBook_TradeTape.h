@@ -0,0 +1,404 @@
+//+------------------------------------------------------------------+
+//| MT4 A/B-book Routing Plugin - Trade Tape                       |
+//| Records the TradeRecord/UserInfo of every hook call, for       |
+//| replay as load and regression input (tape_replay)              |
+//+------------------------------------------------------------------+
+//
+// File layout (little-endian): a 64-byte TapeFileHeader followed by 384-byte
+// TapeRecords in call order. Each record holds one MtSrvTradeTransaction
+// (trade + account) or MtSrvUserLogin (account only) exactly as the server
+// passed it, before the router looks at it, stamped with steady-clock
+// nanoseconds since the tape was opened. Stamps are taken under the write
+// lock, so they never go backwards through the file.
+//
+// Struct members are written with fixed widths (times as 64-bit), so a tape
+// recorded by the 32-bit DLL replays on a 64-bit build box. Of UserInfo only
+// the account fields are kept: passwords, personal details, the ID number and
+// the public key never reach the disk, and the router reads none of them.
+//
+// Recording is a diagnostic mode, off by default: appending takes a mutex
+// and copies 384 bytes into a 1 MB stdio buffer. Buffers are written on
+// Close() (MtSrvCleanup) or when full, so a crash loses at most the last
+// ~2700 calls. A tape stops growing at its record limit; later calls are
+// counted as lost.
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <ctime>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+
+#include "ABBook_MT4Types.h"
+#include "ABBook_DecisionJournal.h"      // JournalNowUs
+
+enum TapeEvent {
+    TAPE_EVENT_TRADE = 0,            // MtSrvTradeTransaction: trade and account
+    TAPE_EVENT_LOGIN = 1             // MtSrvUserLogin: account only
+};
+
+#pragma pack(push, 1)
+struct TapeTrade {
+    int32_t order;
+    int32_t login;
+    char symbol[12];
+    int32_t digits;
+    int32_t cmd;
+    int32_t volume;
+    int64_t open_time;
+    int32_t state;
+    double open_price;
+    double sl, tp;
+    double close_price;
+    int64_t close_time;
+    int32_t reason;
+    double commission;
+    double commission_agent;
+    double storage;
+    double profit;
+    double taxes;
+    char comment[32];
+    int32_t margin_rate;
+    int64_t timestamp;
+    int32_t api_data[4];
+};
+
+// UserInfo minus passwords, personal details, ID number and public key
+struct TapeAccount {
+    int32_t login;
+    char group[16];
+    int32_t enable;
+    int32_t enable_readonly;
+    int32_t leverage;
+    int32_t agent_account;
+    int64_t regdate;
+    int64_t lastdate;
+    int64_t timestamp;
+    double balance;
+    double prevmonthbalance;
+    double prevbalance;
+    double credit;
+    double interestrate;
+    double taxes;
+    double prevmonthequity;
+    double prevequity;
+    int32_t margin_mode;
+    double margin_so_mode;
+    double margin_free_mode;
+    double margin_call;
+    double margin_stopout;
+};
+
+struct TapeRecord {
+    uint64_t offset_ns;              // Steady clock since the tape was opened
+    uint8_t event;                   // TapeEvent
+    uint8_t reserved0[7];
+    TapeTrade trade;                 // Zero for TAPE_EVENT_LOGIN
+    TapeAccount account;
+    char reserved1[20];
+};
+
+struct TapeFileHeader {
+    char magic[8];                   // "ABBTAPE1"
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t created_us;             // UTC microseconds since the epoch at offset 0
+    char reserved[40];
+};
+#pragma pack(pop)
+
+static_assert(sizeof(TapeTrade) == 188, "TapeTrade is part of a fixed on-disk format");
+static_assert(sizeof(TapeAccount) == 160, "TapeAccount is part of a fixed on-disk format");
+static_assert(sizeof(TapeRecord) == 384, "TapeRecord is a fixed 384-byte on-disk format");
+static_assert(sizeof(TapeFileHeader) == 64, "TapeFileHeader is a fixed 64-byte on-disk format");
+
+static const char TAPE_MAGIC[8] = { 'A', 'B', 'B', 'T', 'A', 'P', 'E', '1' };
+static const uint32_t TAPE_VERSION = 1;
+
+//+------------------------------------------------------------------+
+//| MT4 structs <-> tape records                                    |
+//+------------------------------------------------------------------+
+
+inline void TapeFromTrade(const TradeRecord& in, TapeTrade& out) {
+    out.order = in.order;
+    out.login = in.login;
+    memcpy(out.symbol, in.symbol, sizeof(out.symbol));
+    out.digits = in.digits;
+    out.cmd = in.cmd;
+    out.volume = in.volume;
+    out.open_time = (int64_t)in.open_time;
+    out.state = in.state;
+    out.open_price = in.open_price;
+    out.sl = in.sl;
+    out.tp = in.tp;
+    out.close_price = in.close_price;
+    out.close_time = (int64_t)in.close_time;
+    out.reason = in.reason;
+    out.commission = in.commission;
+    out.commission_agent = in.commission_agent;
+    out.storage = in.storage;
+    out.profit = in.profit;
+    out.taxes = in.taxes;
+    memcpy(out.comment, in.comment, sizeof(out.comment));
+    out.margin_rate = in.margin_rate;
+    out.timestamp = (int64_t)in.timestamp;
+    memcpy(out.api_data, in.api_data, sizeof(out.api_data));
+}
+
+inline void TapeToTrade(const TapeTrade& in, TradeRecord& out) {
+    memset(&out, 0, sizeof(out));
+    out.order = in.order;
+    out.login = in.login;
+    memcpy(out.symbol, in.symbol, sizeof(out.symbol));
+    out.digits = in.digits;
+    out.cmd = in.cmd;
+    out.volume = in.volume;
+    out.open_time = (__time32_t)in.open_time;
+    out.state = in.state;
+    out.open_price = in.open_price;
+    out.sl = in.sl;
+    out.tp = in.tp;
+    out.close_price = in.close_price;
+    out.close_time = (__time32_t)in.close_time;
+    out.reason = in.reason;
+    out.commission = in.commission;
+    out.commission_agent = in.commission_agent;
+    out.storage = in.storage;
+    out.profit = in.profit;
+    out.taxes = in.taxes;
+    memcpy(out.comment, in.comment, sizeof(out.comment));
+    out.margin_rate = in.margin_rate;
+    out.timestamp = (__time32_t)in.timestamp;
+    memcpy(out.api_data, in.api_data, sizeof(out.api_data));
+}
+
+inline void TapeFromAccount(const UserInfo& in, TapeAccount& out) {
+    out.login = in.login;
+    memcpy(out.group, in.group, sizeof(out.group));
+    out.enable = in.enable;
+    out.enable_readonly = in.enable_readonly;
+    out.leverage = in.leverage;
+    out.agent_account = in.agent_account;
+    out.regdate = (int64_t)in.regdate;
+    out.lastdate = (int64_t)in.lastdate;
+    out.timestamp = (int64_t)in.timestamp;
+    out.balance = in.balance;
+    out.prevmonthbalance = in.prevmonthbalance;
+    out.prevbalance = in.prevbalance;
+    out.credit = in.credit;
+    out.interestrate = in.interestrate;
+    out.taxes = in.taxes;
+    out.prevmonthequity = in.prevmonthequity;
+    out.prevequity = in.prevequity;
+    out.margin_mode = in.margin_mode;
+    out.margin_so_mode = in.margin_so_mode;
+    out.margin_free_mode = in.margin_free_mode;
+    out.margin_call = in.margin_call;
+    out.margin_stopout = in.margin_stopout;
+}
+
+// Fields the tape does not keep come back zeroed
+inline void TapeToAccount(const TapeAccount& in, UserInfo& out) {
+    memset(&out, 0, sizeof(out));
+    out.login = in.login;
+    memcpy(out.group, in.group, sizeof(out.group));
+    out.enable = in.enable;
+    out.enable_readonly = in.enable_readonly;
+    out.leverage = in.leverage;
+    out.agent_account = in.agent_account;
+    out.regdate = (__time32_t)in.regdate;
+    out.lastdate = (__time32_t)in.lastdate;
+    out.timestamp = (__time32_t)in.timestamp;
+    out.balance = in.balance;
+    out.prevmonthbalance = in.prevmonthbalance;
+    out.prevbalance = in.prevbalance;
+    out.credit = in.credit;
+    out.interestrate = in.interestrate;
+    out.taxes = in.taxes;
+    out.prevmonthequity = in.prevmonthequity;
+    out.prevequity = in.prevequity;
+    out.margin_mode = in.margin_mode;
+    out.margin_so_mode = in.margin_so_mode;
+    out.margin_free_mode = in.margin_free_mode;
+    out.margin_call = in.margin_call;
+    out.margin_stopout = in.margin_stopout;
+}
+
+//+------------------------------------------------------------------+
+//| Tape writer                                                     |
+//+------------------------------------------------------------------+
+
+class TradeTape {
+private:
+    std::mutex mutex;
+    FILE* file;
+    std::vector<char> buffer;
+    std::string path;
+    std::chrono::steady_clock::time_point opened;
+    uint64_t last_offset_ns;
+    uint64_t max_records;
+    std::atomic<bool> enabled;
+
+    std::atomic<unsigned long long> recorded;
+    std::atomic<unsigned long long> lost;
+
+    static bool FileExists(const std::string& file_path) {
+        FILE* f = fopen(file_path.c_str(), "rb");
+        if (!f) return false;
+        fclose(f);
+        return true;
+    }
+
+    void Append(TapeRecord& record) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!file) return;
+        if (recorded.load(std::memory_order_relaxed) >= max_records) {
+            lost.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        uint64_t offset_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - opened).count();
+        record.offset_ns = offset_ns > last_offset_ns ? offset_ns : last_offset_ns;
+        last_offset_ns = record.offset_ns;
+        if (fwrite(&record, sizeof(record), 1, file) == 1) {
+            recorded.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            lost.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+public:
+    TradeTape() : file(nullptr), last_offset_ns(0), max_records(0), enabled(false), recorded(0), lost(0) {}
+
+    ~TradeTape() { Close(); }
+
+    // Start recording into the first unused <file_prefix>_<YYYYMMDD>_<n>.abt.
+    // Only call while no trade is being processed (startup).
+    bool Open(const std::string& file_prefix, uint64_t record_limit) {
+        Close();
+        std::lock_guard<std::mutex> lock(mutex);
+
+        uint64_t now_us = JournalNowUs();
+        time_t seconds = (time_t)(now_us / 1000000);
+        struct tm utc;
+#ifdef _WIN32
+        gmtime_s(&utc, &seconds);
+#else
+        gmtime_r(&seconds, &utc);
+#endif
+        char date[16];
+        strftime(date, sizeof(date), "%Y%m%d", &utc);
+
+        for (int n = 0; n < 1000 && !file; n++) {
+            std::string candidate = file_prefix + "_" + date + "_" + std::to_string(n) + ".abt";
+            if (FileExists(candidate)) continue;
+            file = fopen(candidate.c_str(), "wb");
+            if (!file) return false;
+            path = candidate;
+        }
+        if (!file) return false;
+
+        buffer.resize(1 << 20);
+        setvbuf(file, buffer.data(), _IOFBF, buffer.size());
+
+        TapeFileHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, TAPE_MAGIC, sizeof(header.magic));
+        header.version = TAPE_VERSION;
+        header.record_size = sizeof(TapeRecord);
+        header.created_us = now_us;
+        opened = std::chrono::steady_clock::now();
+        if (fwrite(&header, sizeof(header), 1, file) != 1) {
+            fclose(file);
+            file = nullptr;
+            return false;
+        }
+
+        last_offset_ns = 0;
+        max_records = record_limit ? record_limit : 1;
+        recorded.store(0, std::memory_order_relaxed);
+        lost.store(0, std::memory_order_relaxed);
+        enabled.store(true);
+        return true;
+    }
+
+    // Write out what is buffered and close the file
+    void Close() {
+        std::lock_guard<std::mutex> lock(mutex);
+        enabled.store(false);
+        if (file) {
+            fclose(file);
+            file = nullptr;
+        }
+    }
+
+    bool Enabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    void RecordTrade(const TradeRecord& trade, const UserInfo& user) {
+        TapeRecord record;
+        memset(&record, 0, sizeof(record));
+        record.event = TAPE_EVENT_TRADE;
+        TapeFromTrade(trade, record.trade);
+        TapeFromAccount(user, record.account);
+        Append(record);
+    }
+
+    void RecordLogin(const UserInfo& user) {
+        TapeRecord record;
+        memset(&record, 0, sizeof(record));
+        record.event = TAPE_EVENT_LOGIN;
+        TapeFromAccount(user, record.account);
+        Append(record);
+    }
+
+    std::string Path() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return path;
+    }
+
+    unsigned long long Recorded() const { return recorded.load(std::memory_order_relaxed); }
+    unsigned long long Lost() const { return lost.load(std::memory_order_relaxed); }
+};
+
+//+------------------------------------------------------------------+
+//| Reader (tape_replay, tests)                                     |
+//+------------------------------------------------------------------+
+
+// Read a whole tape. A torn last record (crash mid-write) is ignored.
+// Returns false with `error` set if the file is missing or not a tape.
+inline bool ReadTradeTape(const std::string& path, TapeFileHeader& header, std::vector<TapeRecord>& records,
+                          std::string& error) {
+    records.clear();
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) {
+        error = "cannot open " + path;
+        return false;
+    }
+    if (fread(&header, sizeof(header), 1, f) != 1 || memcmp(header.magic, TAPE_MAGIC, sizeof(header.magic)) != 0) {
+        fclose(f);
+        error = path + " is not a trade tape";
+        return false;
+    }
+    if (header.version != TAPE_VERSION || header.record_size != sizeof(TapeRecord)) {
+        fclose(f);
+        error = path + ": unsupported tape version " + std::to_string(header.version);
+        return false;
+    }
+    TapeRecord record;
+    while (fread(&record, sizeof(record), 1, f) == 1) {
+        if (record.event != TAPE_EVENT_TRADE && record.event != TAPE_EVENT_LOGIN) {
+            fclose(f);
+            error = path + ": corrupt record " + std::to_string(records.size());
+            return false;
+        }
+        records.push_back(record);
+    }
+    fclose(f);
+    return true;
+}
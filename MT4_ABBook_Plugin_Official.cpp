@@ -4,724 +4,26 @@
 //| Copyright 2025, A/B-book Routing Plugin                        |
 //| This plugin routes trades to A-book/B-book based on ML scores  |
 //+------------------------------------------------------------------+
+//
+// Thin adapter between the MT4 server and the core library: the exports
+// below forward to one TradeRouter (ABBook_TradeRouter.h), which holds the
+// plugin's state and makes every routing decision. Only this file is
+// Windows-specific; build it with build_official_plugin.bat or CMake.
 
-#define WIN32_LEAN_AND_MEAN
-#include <windows.h>
-#include <winsock2.h>
-#include <ws2tcpip.h>
-#include <iostream>
+#include "ABBook_TradeRouter.h"     // Brings in winsock2.h and windows.h (ABBook_Platform.h)
 #include <string>
-#include <vector>
-#include <fstream>
-#include <ctime>
-#include <thread>
-#include <unordered_map>
-#include <mutex>
+#include <cstring>
+#include <cstdint>
 #include <excpt.h>  // For structured exception handling
 
 #pragma comment(lib, "ws2_32.lib")
 
-//+------------------------------------------------------------------+
-//| MT4 Server API Structures (from official MT4ManagerAPI.h)      |
-//+------------------------------------------------------------------+
-
-// Time type from official API
-#ifndef __time32_t
-#define __time32_t time_t
-#endif
-
-// Order states from official API
-enum { ORDER_OPENED=0, ORDER_CLOSED, ORDER_DELETED, ORDER_CANCELED };
-
-// Order commands from official API  
-enum { OP_BUY=0, OP_SELL, OP_BUYLIMIT, OP_SELLLIMIT, OP_BUYSTOP, OP_SELLSTOP };
-
-//--- Official MT4 Trade Record structure
-struct TradeRecord
-{
-    int            order;              // order ticket
-    int            login;              // user login
-    char           symbol[12];         // currency
-    int            digits;             // digits  
-    int            cmd;               // command
-    int            volume;            // volume (in lots*100)
-    __time32_t     open_time;         // open time
-    int            state;             // reserved  
-    double         open_price;        // open price
-    double         sl, tp;           // stop loss & take profit
-    double         close_price;       // close price
-    __time32_t     close_time;        // close time
-    int            reason;            // close reason
-    double         commission;        // commission
-    double         commission_agent;  // agent commission  
-    double         storage;           // order swaps
-    double         profit;            // floating profit
-    double         taxes;             // taxes
-    char           comment[32];       // order comment
-    int            margin_rate;       // margin rate
-    __time32_t     timestamp;         // timestamp
-    int            api_data[4];       // for API usage
-};
-
-//--- Official MT4 User Info structure  
-struct UserInfo
-{
-    int            login;             // login
-    char           group[16];         // group
-    char           password[16];      // password  
-    int            enable;            // enable
-    int            enable_change_password; // allow to change password
-    int            enable_readonly;   // allow to open/positions (first bit-buy,second bit-sell)
-    int            password_investor[16]; // investor password
-    char           password_phone[16]; // phone password
-    char           name[128];         // name
-    char           country[32];       // country
-    char           city[32];          // city
-    char           state[32];         // state
-    char           zipcode[16];       // zipcode
-    char           address[128];      // address
-    char           phone[32];         // phone
-    char           email[48];         // email
-    char           comment[64];       // comment
-    char           id[32];           // SSN (IRD)
-    char           status[16];       // status
-    __time32_t     regdate;          // registration date
-    __time32_t     lastdate;         // last coonection time
-    int            leverage;         // leverage
-    int            agent_account;    // agent account
-    __time32_t     timestamp;        // timestamp
-    double         balance;          // balance
-    double         prevmonthbalance; // previous month balance  
-    double         prevbalance;      // previous day balance
-    double         credit;           // credit
-    double         interestrate;     // accumulated interest rate
-    double         taxes;            // taxes
-    double         prevmonthequity;  // previous month equity
-    double         prevequity;       // previous day equity
-    char           reserved[104];    // reserved
-    int            margin_mode;      // margin calculation mode
-    double         margin_so_mode;   // margin stop out mode
-    double         margin_free_mode; // margin free mode (0-don't use,1-use)
-    double         margin_call;      // margin call level  
-    double         margin_stopout;   // stop out level
-    char           reserved2[104];   // reserved  
-    char           publickey[270];   // RSA public key
-    int            reserved3[4];     // reserved
-};
-
-//+------------------------------------------------------------------+
-//| Configuration and Logging                                       |
-//+------------------------------------------------------------------+
-
-struct PluginConfig {
-    std::string cvm_ip = "188.245.254.12";
-    int cvm_port = 50051;
-    double fallback_score = 0.05;          // Conservative fallback (routes to A-book by default)
-    double fx_majors_threshold = 0.08;
-    double fx_minors_threshold = 0.12; 
-    double crypto_threshold = 0.15;
-    bool enable_logging = true;
-    int socket_timeout = 5000;             // 5 seconds socket timeout
-    bool fail_safe_mode = true;            // Always use fallback if ML service fails
-    int max_connection_attempts = 3;        // Max attempts before backing off
-    bool log_ml_service_status = true;     // Log ML service connectivity status
-    std::string fallback_routing = "A-BOOK"; // Default routing when ML service is down
-};
-
-class PluginLogger {
-private:
-    std::mutex log_mutex;
-    bool logging_enabled;
-    
-public:
-    PluginLogger(bool enabled = true) : logging_enabled(enabled) {}
-    
-    void Log(const std::string& message) {
-        if (!logging_enabled) return;
-        
-        std::lock_guard<std::mutex> lock(log_mutex);
-        
-        // Get current time
-        time_t rawtime;
-        struct tm timeinfo;
-        char timestamp[64];
-        
-        time(&rawtime);
-        localtime_s(&timeinfo, &rawtime);
-        strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &timeinfo);
-        
-        // Log to file
-        std::ofstream logfile("ABBook_Plugin_Official.log", std::ios::app);
-        if (logfile.is_open()) {
-            logfile << "[" << timestamp << "] " << message << std::endl;
-            logfile.close();
-        }
-        
-        // Log to console (for debugging)
-        std::cout << "[" << timestamp << "] " << message << std::endl;
-    }
-};
-
-//+------------------------------------------------------------------+
-//| ML Service Communication with Robust Error Handling            |
-//+------------------------------------------------------------------+
-
-class CVMClient {
-private:
-    PluginConfig* config;
-    PluginLogger* logger;
-    bool ml_service_available;
-    time_t last_connection_attempt;
-    int consecutive_failures;
-    
-    // Connection retry logic
-    bool ShouldAttemptConnection() {
-        time_t current_time = time(nullptr);
-        
-        // If too many consecutive failures, wait longer between attempts
-        int wait_time = 30; // Base wait time in seconds
-        if (consecutive_failures > 5) {
-            wait_time = 300; // Wait 5 minutes after many failures
-        } else if (consecutive_failures > 2) {
-            wait_time = 120; // Wait 2 minutes after some failures  
-        }
-        
-        return (current_time - last_connection_attempt) >= wait_time;
-    }
-    
-    void RecordConnectionResult(bool success) {
-        last_connection_attempt = time(nullptr);
-        if (success) {
-            consecutive_failures = 0;
-            if (!ml_service_available) {
-                ml_service_available = true;
-                logger->Log("ML SERVICE: Connection restored - switching back to ML scoring");
-            }
-        } else {
-            consecutive_failures++;
-            if (ml_service_available) {
-                ml_service_available = false;
-                logger->Log("ML SERVICE: Connection lost - using fallback scores for all trades");
-            }
-        }
-    }
-    
-    // Protobuf wire format encoding functions
-    std::string EncodeVarint(uint64_t value) {
-        std::string result;
-        while (value >= 0x80) {
-            result += (char)((value & 0x7F) | 0x80);
-            value >>= 7;
-        }
-        result += (char)(value & 0x7F);
-        return result;
-    }
-    
-    std::string EncodeFloat(int field_number, float value) {
-        std::string result;
-        uint32_t field_tag = (field_number << 3) | 5; // Wire type 5 for fixed32
-        result += EncodeVarint(field_tag); // Encode field tag as varint
-        char* bytes = (char*)&value;
-        for (int i = 0; i < 4; i++) {
-            result += bytes[i];
-        }
-        return result;
-    }
-    
-    std::string EncodeUInt32(int field_number, uint32_t value) {
-        std::string result;
-        uint32_t field_tag = (field_number << 3) | 0; // Wire type 0 for varint
-        result += EncodeVarint(field_tag); // Encode field tag as varint
-        result += EncodeVarint(value);
-        return result;
-    }
-    
-    std::string EncodeInt32(int field_number, int32_t value) {
-        std::string result;
-        uint32_t field_tag = (field_number << 3) | 0; // Wire type 0 for varint
-        result += EncodeVarint(field_tag); // Encode field tag as varint
-        result += EncodeVarint((uint64_t)value);
-        return result;
-    }
-    
-    std::string EncodeInt64(int field_number, int64_t value) {
-        std::string result;
-        uint32_t field_tag = (field_number << 3) | 0; // Wire type 0 for varint
-        result += EncodeVarint(field_tag);
-        
-        // Encode the int64 value as varint
-        uint64_t unsigned_value = (uint64_t)value;
-        result += EncodeVarint(unsigned_value);
-        
-        return result;
-    }
-    
-    std::string EncodeString(int field_number, const std::string& value) {
-        std::string result;
-        uint32_t field_tag = (field_number << 3) | 2; // Wire type 2 for length-delimited
-        result += EncodeVarint(field_tag); // Encode field tag as varint
-        result += EncodeVarint(value.length());
-        result += value;
-        return result;
-    }
-    
-    std::string CreateScoringRequest(const TradeRecord& trade, const UserInfo& user) {
-        std::string request;
-        
-        try {
-            // CORRECT PROTOBUF SPEC: Based on actual ML service specification
-            
-            // MINIMAL REQUEST: Match the exact 75-byte format that worked
-            // Based on ML service logs showing this exact combination works
-            
-            // Field 1: user_id 
-            request += EncodeString(1, std::to_string(trade.login));
-            
-            // Field 2-6: Core trading data only
-            request += EncodeFloat(2, (float)trade.open_price);         // open_price = 0.5935
-            request += EncodeFloat(3, (float)trade.sl);                 // sl = 0.59  
-            request += EncodeFloat(4, (float)trade.tp);                 // tp = 0.597
-            request += EncodeFloat(5, (float)trade.cmd);                // deal_type = 1.0
-            request += EncodeFloat(6, (float)(trade.volume / 100.0));   // lot_volume = 1.0
-            
-            // Field 46: symbol (CRITICAL - must be UTF-8 encoded!)
-            std::string raw_symbol = std::string(trade.symbol);
-            std::string clean_symbol;
-            
-            logger->Log("UTF-8 DIAGNOSTIC: Raw symbol data: [" + raw_symbol + "]");
-            logger->Log("UTF-8 DIAGNOSTIC: Starting UTF-8 safe symbol cleaning...");
-            
-            // UTF-8 SAFE SYMBOL CLEANING - Remove ALL non-UTF-8 characters
-            bool found_currency_start = false;
-            for (size_t i = 0; i < raw_symbol.length() && i < 12; i++) {
-                char c = raw_symbol[i];
-                
-                // Skip garbage bytes at start, look for valid 3-letter currency codes
-                if (!found_currency_start) {
-                    // Common currency prefixes: USD, EUR, GBP, AUD, NZD, CAD, CHF, JPY
-                    if (i + 2 < raw_symbol.length()) {
-                        std::string potential = raw_symbol.substr(i, 3);
-                        if (potential == "USD" || potential == "EUR" || potential == "GBP" || 
-                            potential == "AUD" || potential == "NZD" || potential == "CAD" || 
-                            potential == "CHF" || potential == "JPY" || potential == "XPT" || 
-                            potential == "XAU" || potential == "GER" || potential == "UK1" ||
-                            potential == "FRA" || potential == "JPN") {
-                            found_currency_start = true;
-                            clean_symbol = potential;
-                            i += 2; // Skip next 2 chars as they're part of this currency
-                            continue;
-                        }
-                    }
-                } else {
-                    // After finding currency start, add only valid UTF-8 ASCII characters
-                    if (c >= 'A' && c <= 'Z') {
-                        clean_symbol += c;
-                    } else if (c >= 'a' && c <= 'z') {
-                        clean_symbol += (char)(c - 32); // Convert to uppercase
-                    } else if (c >= '0' && c <= '9') {
-                        clean_symbol += c;
-                    } else if (c == '\0' || c == ' ') {
-                        break; // End of symbol
-                    }
-                    // Skip any non-ASCII or invalid UTF-8 characters
-                }
-            }
-            
-            // If no currency found, fall back to safe alphanumeric extraction
-            if (clean_symbol.empty()) {
-                for (size_t i = 0; i < raw_symbol.length() && i < 12; i++) {
-                    char c = raw_symbol[i];
-                    if (c >= 'A' && c <= 'Z') {
-                        clean_symbol += c;
-                    } else if (c >= 'a' && c <= 'z') {
-                        clean_symbol += (char)(c - 32); // Convert to uppercase
-                    } else if (c >= '0' && c <= '9') {
-                        clean_symbol += c;
-                    } else if (c == '\0') {
-                        break;
-                    }
-                    // Skip any non-ASCII characters that could cause UTF-8 errors
-                }
-            }
-            
-            // Final UTF-8 validation - ensure only valid ASCII characters
-            std::string utf8_safe_symbol;
-            for (char c : clean_symbol) {
-                if (c >= 32 && c <= 126) { // Printable ASCII only
-                    utf8_safe_symbol += c;
-                }
-            }
-            
-            // Fallback to safe default if cleaning failed
-            if (utf8_safe_symbol.empty()) {
-                utf8_safe_symbol = "UNKNOWN";
-                logger->Log("UTF-8 DIAGNOSTIC: Symbol cleaning failed - using fallback: UNKNOWN");
-            }
-            
-            logger->Log("UTF-8 DIAGNOSTIC: Final UTF-8 safe symbol: [" + utf8_safe_symbol + "]");
-            logger->Log("UTF-8 DIAGNOSTIC: Symbol length: " + std::to_string(utf8_safe_symbol.length()) + " bytes");
-            
-            request += EncodeString(46, utf8_safe_symbol);             // symbol = "NZDUSD" (UTF-8 safe)
-            
-            return request;
-
-            
-
-            
-            // Trading performance metrics (use defaults for unavailable data)
-            request += EncodeFloat(14, 0.6f);                           // profitable_ratio
-            request += EncodeInt64(15, 3);                              // num_open_trades
-            request += EncodeInt64(16, 50);                             // num_closed_trades
-            request += EncodeInt64(17, 35);                             // age (years)
-            request += EncodeInt64(18, 90);                             // days_since_reg
-            request += EncodeFloat(19, (float)user.balance * 1.5f);     // deposit_lifetime
-            request += EncodeInt64(20, 5);                              // deposit_count
-            request += EncodeFloat(21, (float)user.balance * 0.2f);     // withdraw_lifetime
-            request += EncodeInt64(22, 2);                              // withdraw_count
-            request += EncodeInt64(23, 0);                              // vip (0 = regular)
-            request += EncodeInt64(24, 3600);                           // holding_time_sec (1 hour avg)
-            request += EncodeFloat(25, 100000.0f);                      // lot_usd_value
-            request += EncodeFloat(26, -500.0f);                        // max_drawdown
-            request += EncodeFloat(27, 800.0f);                         // max_runup
-            request += EncodeFloat(28, 5.0f);                           // volume_24h
-            request += EncodeFloat(29, 90.0f);                          // trader_tenure_days
-            request += EncodeFloat(30, 7.5f);                           // deposit_to_withdraw_ratio
-            request += EncodeInt64(31, 1);                              // education_known
-            request += EncodeInt64(32, 1);                              // occupation_known
-
-            
-
-            
-        } catch (...) {
-            // Exception in CreateScoringRequest - using minimal fallback
-            request.clear();
-            request += EncodeString(1, std::to_string(trade.login));    // user_id only (field 1)
-        }
-        
-        return request;
-    }
-    
-    std::string CreateLengthPrefixedMessage(const std::string& protobuf_body) {
-        std::string message;
-        uint32_t length = protobuf_body.length();
-        
-        // Length prefix (4 bytes, network byte order)
-        message += (char)((length >> 24) & 0xFF);
-        message += (char)((length >> 16) & 0xFF);
-        message += (char)((length >> 8) & 0xFF);
-        message += (char)(length & 0xFF);
-        
-        // Protobuf body
-        message += protobuf_body;
-        
-        return message;
-    }
-    
-    float ParseScoreFromProtobuf(const char* protobuf_data, int length) {
-        logger->Log("ML SERVICE: Parsing protobuf response (" + std::to_string(length) + " bytes)");
-        
-        // Debug: Print first 16 bytes as hex for debugging
-        std::string hex_debug = "Response hex: ";
-        for (int i = 0; i < length && i < 16; i++) {
-            char hex_byte[8];
-            sprintf(hex_byte, "%02X ", (unsigned char)protobuf_data[i]);
-            hex_debug += hex_byte;
-        }
-        logger->Log("ML SERVICE: " + hex_debug);
-        
-        for (int i = 0; i < length - 4; i++) { // Changed from length-5 to length-4
-            // Look for field 2, wire type 5 (float): 0x15  
-            if ((unsigned char)protobuf_data[i] == 0x15) {
-                if (i + 4 < length) { // Ensure we have 4 bytes for the float
-                    float score;
-                    memcpy(&score, protobuf_data + i + 1, 4);
-                    logger->Log("ML SERVICE: Found score in protobuf at offset " + std::to_string(i) + ": " + std::to_string(score));
-                    
-                    // Validate score is in reasonable range
-                    if (score >= 0.0f && score <= 1.0f) {
-                        return score;
-                    } else {
-                        logger->Log("ML SERVICE WARNING: Score out of valid range: " + std::to_string(score));
-                    }
-                }
-            }
-        }
-        logger->Log("ML SERVICE: No valid score field found in protobuf response");
-        return -2.0f; // Special value indicating "not found"
-    }
-    
-public:
-    CVMClient(PluginConfig* cfg, PluginLogger* log) 
-        : config(cfg), logger(log), ml_service_available(true), 
-          last_connection_attempt(0), consecutive_failures(0) {}
-    
-    double GetScore(const TradeRecord* trade, const UserInfo* user) {
-        // CRITICAL: Always return fallback score if we shouldn't attempt connection
-        if (!ShouldAttemptConnection() && consecutive_failures > 0) {
-            return config->fallback_score;
-        }
-        
-        SOCKET sock = INVALID_SOCKET;
-        double score = config->fallback_score;
-        bool connection_successful = false;
-        
-        // BULLETPROOF: Wrap everything in try-catch to prevent plugin unloading
-        try {
-            // Initialize Winsock (safe initialization)
-            WSADATA wsaData;
-            int wsa_result = WSAStartup(MAKEWORD(2, 2), &wsaData);
-            if (wsa_result != 0) {
-                logger->Log("ML SERVICE WARNING: WSAStartup failed (code: " + std::to_string(wsa_result) + ") - using fallback score");
-                RecordConnectionResult(false);
-                return config->fallback_score;
-            }
-            
-            // Create socket with error handling
-            sock = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
-            if (sock == INVALID_SOCKET) {
-                int error_code = WSAGetLastError();
-                logger->Log("ML SERVICE WARNING: Socket creation failed (WSA error: " + std::to_string(error_code) + ") - using fallback score");
-                WSACleanup();
-                RecordConnectionResult(false);
-                return config->fallback_score;
-            }
-            
-            // Set socket timeouts (critical for preventing hangs)
-            int timeout_ms = config->socket_timeout;
-            setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, (const char*)&timeout_ms, sizeof(timeout_ms));
-            setsockopt(sock, SOL_SOCKET, SO_SNDTIMEO, (const char*)&timeout_ms, sizeof(timeout_ms));
-            
-            // Prepare server address
-            sockaddr_in serverAddr;
-            memset(&serverAddr, 0, sizeof(serverAddr));
-            serverAddr.sin_family = AF_INET;
-            serverAddr.sin_port = htons(config->cvm_port);
-            
-            // Convert IP address safely
-            int inet_result = inet_pton(AF_INET, config->cvm_ip.c_str(), &serverAddr.sin_addr);
-            if (inet_result != 1) {
-                logger->Log("ML SERVICE WARNING: Invalid IP address format - using fallback score");
-                closesocket(sock);
-                WSACleanup();
-                RecordConnectionResult(false);
-                return config->fallback_score;
-            }
-            
-            // Attempt connection with timeout
-            if (connect(sock, (sockaddr*)&serverAddr, sizeof(serverAddr)) == SOCKET_ERROR) {
-                int error_code = WSAGetLastError();
-                std::string error_msg;
-                
-                switch (error_code) {
-                    case WSAECONNREFUSED:
-                        error_msg = "Connection refused (service not running or port closed)";
-                        break;
-                    case WSAENETUNREACH:
-                        error_msg = "Network unreachable";
-                        break;
-                    case WSAETIMEDOUT:
-                        error_msg = "Connection timed out";
-                        break;
-                    case WSAEHOSTUNREACH:
-                        error_msg = "Host unreachable";
-                        break;
-                    default:
-                        error_msg = "Connection failed (WSA error: " + std::to_string(error_code) + ")";
-                        break;
-                }
-                
-                logger->Log("ML SERVICE: " + error_msg + " - using fallback score");
-                closesocket(sock);
-                WSACleanup();
-                RecordConnectionResult(false);
-                return config->fallback_score;
-            }
-            
-            // Create scoring request (length-prefixed protobuf format)
-            std::string protobuf_request = CreateScoringRequest(*trade, *user);
-            std::string full_message = CreateLengthPrefixedMessage(protobuf_request);
-            
-            logger->Log("ML SERVICE: Sending protobuf request (" + std::to_string(full_message.length()) + " bytes)");
-            
-            // Send request with error handling
-            if (send(sock, full_message.c_str(), full_message.length(), 0) == SOCKET_ERROR) {
-                int error_code = WSAGetLastError();
-                logger->Log("ML SERVICE: Failed to send request (WSA error: " + std::to_string(error_code) + ") - using fallback score");
-                closesocket(sock);
-                WSACleanup();
-                RecordConnectionResult(false);
-                return config->fallback_score;
-            }
-            
-            // Receive response with timeout (length-prefixed protobuf format)
-            char response[4096];
-            memset(response, 0, sizeof(response));
-            int bytes_received = recv(sock, response, sizeof(response) - 1, 0);
-            
-            if (bytes_received > 0) {
-                logger->Log("ML SERVICE: Received response (" + std::to_string(bytes_received) + " bytes)");
-                
-                // Parse length-prefixed protobuf response
-                if (bytes_received >= 4) {
-                    uint32_t response_length = 
-                        ((unsigned char)response[0] << 24) |
-                        ((unsigned char)response[1] << 16) |
-                        ((unsigned char)response[2] << 8) |
-                        ((unsigned char)response[3]);
-                    
-                    logger->Log("ML SERVICE: Response length prefix: " + std::to_string(response_length) + " bytes");
-                    
-                    if (bytes_received >= 4 + response_length) {
-                        // Parse score from protobuf response (field 1, wire type 5 for float)
-                        float parsed_score = ParseScoreFromProtobuf(response + 4, response_length);
-                        
-                        if (parsed_score >= 0.0f && parsed_score <= 1.0f) {
-                            score = (double)parsed_score;
-                            connection_successful = true;
-                            logger->Log("ML SERVICE: Received valid score: " + std::to_string(score));
-                        } else if (parsed_score == -2.0f) {
-                            logger->Log("ML SERVICE WARNING: No valid score found in protobuf response - using fallback");
-                        } else {
-                            logger->Log("ML SERVICE WARNING: Score out of valid range [0.0-1.0]: " + std::to_string(parsed_score) + " - using fallback");
-                        }
-                    } else {
-                        logger->Log("ML SERVICE WARNING: Incomplete response received - using fallback score");
-                    }
-                } else {
-                    logger->Log("ML SERVICE WARNING: Response too short for length prefix - using fallback score");
-                }
-            } else if (bytes_received == 0) {
-                logger->Log("ML SERVICE WARNING: Connection closed by server - using fallback score");
-            } else {
-                int error_code = WSAGetLastError();
-                logger->Log("ML SERVICE: Failed to receive response (WSA error: " + std::to_string(error_code) + ") - using fallback score");
-            }
-            
-            // Clean shutdown
-            logger->Log("CRASH DIAGNOSTIC: About to close ML service socket");
-            closesocket(sock);
-            logger->Log("CRASH DIAGNOSTIC: Socket closed successfully");
-            WSACleanup();
-            logger->Log("CRASH DIAGNOSTIC: WSACleanup completed successfully");
-            
-        } catch (const std::exception& e) {
-            logger->Log("ML SERVICE EXCEPTION: " + std::string(e.what()) + " - using fallback score (plugin remains stable)");
-            logger->Log("CRASH DIAGNOSTIC: ML service exception caught: " + std::string(e.what()));
-            logger->Log("CRASH DIAGNOSTIC: About to cleanup socket after exception");
-            if (sock != INVALID_SOCKET) {
-                closesocket(sock);
-                logger->Log("CRASH DIAGNOSTIC: Socket closed after exception");
-            }
-            WSACleanup();
-            logger->Log("CRASH DIAGNOSTIC: WSACleanup completed after exception");
-            connection_successful = false;
-        } catch (...) {
-            logger->Log("ML SERVICE: Unknown exception occurred - using fallback score (plugin remains stable)");
-            logger->Log("CRASH DIAGNOSTIC: Unknown ML service exception caught");
-            logger->Log("CRASH DIAGNOSTIC: Could be network stack corruption or invalid memory access");
-            logger->Log("CRASH DIAGNOSTIC: About to cleanup socket after unknown exception");
-            if (sock != INVALID_SOCKET) {
-                closesocket(sock);
-                logger->Log("CRASH DIAGNOSTIC: Socket closed after unknown exception");
-            }
-            WSACleanup();
-            logger->Log("CRASH DIAGNOSTIC: WSACleanup completed after unknown exception");
-            connection_successful = false;
-        }
-        
-        // Record connection result for retry logic
-        RecordConnectionResult(connection_successful);
-        
-        // GUARANTEE: Always return a valid score
-        if (score < 0.0 || score > 1.0) {
-            logger->Log("ML SERVICE: Normalizing invalid score to fallback value");
-            score = config->fallback_score;
-        }
-        
-        return score;
-    }
-    
-    // Public method to check ML service status
-    bool IsMLServiceAvailable() const {
-        return ml_service_available;
-    }
-    
-    int GetConsecutiveFailures() const {
-        return consecutive_failures;
-    }
-};
-
 //+------------------------------------------------------------------+
 //| Global Plugin State                                            |
 //+------------------------------------------------------------------+
 
-PluginConfig g_config;
-PluginLogger g_logger(true);
-CVMClient g_cvm_client(&g_config, &g_logger);
-
-//+------------------------------------------------------------------+
-//| Helper Functions                                                |
-//+------------------------------------------------------------------+
-
-std::string GetInstrumentGroup(const char* symbol) {
-    std::string sym(symbol);
-    
-    // Major FX pairs
-    if (sym.find("EURUSD") != std::string::npos || 
-        sym.find("GBPUSD") != std::string::npos ||
-        sym.find("USDJPY") != std::string::npos ||
-        sym.find("USDCHF") != std::string::npos ||
-        sym.find("AUDUSD") != std::string::npos ||
-        sym.find("USDCAD") != std::string::npos ||
-        sym.find("NZDUSD") != std::string::npos) {
-        return "FX_MAJORS";
-    }
-    
-    // Crypto (if supported)
-    if (sym.find("BTC") != std::string::npos ||
-        sym.find("ETH") != std::string::npos) {
-        return "CRYPTO";
-    }
-    
-    // Default to minors
-    return "FX_MINORS";
-}
-
-double GetThreshold(const std::string& instrument_group) {
-    if (instrument_group == "FX_MAJORS") {
-        return g_config.fx_majors_threshold;
-    } else if (instrument_group == "CRYPTO") {
-        return g_config.crypto_threshold;
-    } else {
-        return g_config.fx_minors_threshold;
-    }
-}
-
-std::string GetCommandName(int cmd) {
-    switch (cmd) {
-        case OP_BUY: return "BUY";
-        case OP_SELL: return "SELL";
-        case OP_BUYLIMIT: return "BUYLIMIT";
-        case OP_SELLLIMIT: return "SELLLIMIT";
-        case OP_BUYSTOP: return "BUYSTOP";
-        case OP_SELLSTOP: return "SELLSTOP";
-        default: return "UNKNOWN";
-    }
-}
-
-bool ShouldProcessTrade(const TradeRecord* trade) {
-    // Only process new market orders (BUY/SELL)
-    if (trade->cmd != OP_BUY && trade->cmd != OP_SELL) {
-        return false;
-    }
-    
-    // Only process opening trades
-    if (trade->state != ORDER_OPENED) {
-        return false;
-    }
-    
-    return true;
-}
+TradeRouter g_router;
+PluginLogger& g_logger = g_router.Logger();
 
 //+------------------------------------------------------------------+
 //| MT4 Server Plugin API Functions                                |
@@ -731,35 +33,12 @@ extern "C" {
 
     // Plugin initialization
     __declspec(dllexport) int __stdcall MtSrvStartup(void* mt_interface) {
-        g_logger.Log("=== MT4 A/B-book Routing Plugin STARTED (Official API + Bulletproof Version) ===");
-        g_logger.Log("Plugin using official MT4 Manager API structures from mtapi.online");
-        g_logger.Log("BULLETPROOF MODE: Plugin will NEVER unload due to ML service issues");
-        g_logger.Log("");
-        g_logger.Log("ML Service Configuration:");
-        g_logger.Log("  Target: " + g_config.cvm_ip + ":" + std::to_string(g_config.cvm_port));
-        g_logger.Log("  Socket Timeout: " + std::to_string(g_config.socket_timeout / 1000) + " seconds");
-        g_logger.Log("  Fallback Score: " + std::to_string(g_config.fallback_score) + " (routes to " + g_config.fallback_routing + ")");
-        g_logger.Log("");
-        g_logger.Log("Routing Thresholds:");
-        g_logger.Log("  FX Majors: " + std::to_string(g_config.fx_majors_threshold));
-        g_logger.Log("  FX Minors: " + std::to_string(g_config.fx_minors_threshold));
-        g_logger.Log("  Crypto: " + std::to_string(g_config.crypto_threshold));
-        g_logger.Log("");
-        g_logger.Log("Failsafe Features:");
-        g_logger.Log("  - Automatic retry with exponential backoff");
-        g_logger.Log("  - Graceful fallback to default routing when ML service unavailable");
-        g_logger.Log("  - Zero-crash guarantee: Plugin remains stable under all conditions");
-        g_logger.Log("  - All trades processed normally regardless of ML service status");
-        g_logger.Log("");
-        g_logger.Log("PLUGIN READY: Waiting for trade transactions...");
-        g_logger.Log("Note: If ML service IP needs whitelisting, plugin will work in fallback mode until connected");
-        g_logger.Log("MtSrvStartup returning success code 1");
-        return 1; // Return 1 instead of 0 - some MT4 versions expect 1 for success
+        return g_router.Startup("ABBook_Config.ini");
     }
 
     // Plugin cleanup
     __declspec(dllexport) void __stdcall MtSrvCleanup(void) {
-        g_logger.Log("=== MT4 A/B-book Routing Plugin STOPPED ===");
+        g_router.Cleanup();
     }
 
     // Plugin about info - MT4 expects specific plugin info structure
@@ -776,269 +55,26 @@ extern "C" {
 
     // Main trade transaction handler - BULLETPROOF against ML service failures
     __declspec(dllexport) int __stdcall MtSrvTradeTransaction(TradeRecord* trade, UserInfo* user) {
-        // CRITICAL: Validate inputs to prevent crashes
-        if (!trade || !user) {
-            g_logger.Log("ERROR: Null pointers passed to MtSrvTradeTransaction - plugin continues safely");
-            return 0; // Return 0 to indicate plugin handled it safely
-        }
-        
-        // BULLETPROOF: Comprehensive exception handling to prevent plugin unloading
-        try {
-            g_logger.Log("=== TRADE TRANSACTION START ===");
-            g_logger.Log("CHECKPOINT 1: Function entry successful");
-            
-            // Enhanced input validation with detailed logging
-            g_logger.Log("CHECKPOINT 2: Validating trade pointer: " + std::to_string(reinterpret_cast<uintptr_t>(trade)));
-            g_logger.Log("CHECKPOINT 3: Validating user pointer: " + std::to_string(reinterpret_cast<uintptr_t>(user)));
-            
-            // Log raw memory to detect corruption patterns
-            g_logger.Log("=== RAW TRADE DATA ANALYSIS ===");
-            g_logger.Log("Raw Order: " + std::to_string(trade->order));
-            g_logger.Log("Raw Login: " + std::to_string(trade->login));
-            
-            // Safe symbol extraction with corruption detection
-            std::string raw_symbol(trade->symbol, 12);
-            std::string clean_symbol;
-            
-            // Enhanced symbol cleaning - look for known currency patterns
-            bool found_currency_start = false;
-            for (size_t i = 0; i < raw_symbol.length(); i++) {
-                char c = raw_symbol[i];
-                
-                // Skip garbage bytes at start, look for valid 3-letter currency codes
-                if (!found_currency_start) {
-                    // Common currency prefixes: USD, EUR, GBP, AUD, NZD, CAD, CHF, JPY
-                    if (i + 2 < raw_symbol.length()) {
-                        std::string potential = raw_symbol.substr(i, 3);
-                        if (potential == "USD" || potential == "EUR" || potential == "GBP" || 
-                            potential == "AUD" || potential == "NZD" || potential == "CAD" || 
-                            potential == "CHF" || potential == "JPY" || potential == "XPT" || 
-                            potential == "XAU" || potential == "GER" || potential == "UK1" ||
-                            potential == "FRA" || potential == "JPN") {
-                            found_currency_start = true;
-                            clean_symbol = potential;
-                            i += 2; // Skip next 2 chars as they're part of this currency
-                            continue;
-                        }
-                    }
-                } else {
-                    // After finding currency start, add valid characters
-                    if (isalnum(c)) {
-                        clean_symbol += c;
-                    } else if (c == '\0' || c == ' ') {
-                        break; // End of symbol
-                    }
-                }
-            }
-            
-            // If no currency found, fall back to original cleaning
-            if (clean_symbol.empty()) {
-                for (char c : raw_symbol) {
-                    if (isalnum(c) || c == '_') {
-                        clean_symbol += c;
-                    } else if (c == '\0') {
-                        break;
-                    }
-                }
-            }
-            
-            g_logger.Log("Raw Symbol: [" + raw_symbol + "]");
-            g_logger.Log("Clean Symbol: [" + clean_symbol + "]");
-            std::string cleaning_method = found_currency_start ? "Currency pattern detected" : "Fallback cleaning";
-            g_logger.Log("Symbol cleaning method: " + cleaning_method);
-            
-            g_logger.Log("Raw Command: " + std::to_string(trade->cmd));
-            g_logger.Log("Raw Volume: " + std::to_string(trade->volume));
-            g_logger.Log("Raw Price: " + std::to_string(trade->open_price));
-            g_logger.Log("Raw State: " + std::to_string(trade->state));
-            g_logger.Log("Raw Digits: " + std::to_string(trade->digits));
-            
-            // Data validation and normalization
-            int normalized_cmd = trade->cmd;
-            int normalized_volume = trade->volume;
-            double normalized_price = trade->open_price;
-            
-            // Detect and handle data corruption
-            bool data_corrupted = false;
-            
-            if (trade->cmd < 0 || trade->cmd > 5) {
-                g_logger.Log("WARNING: Command value out of range: " + std::to_string(trade->cmd));
-                normalized_cmd = (trade->cmd > 100) ? (trade->cmd - 100) : 0; // Handle offset corruption
-                data_corrupted = true;
-            }
-            
-            if (trade->volume <= 0 || trade->volume > 100000000) { // Reasonable volume limits
-                g_logger.Log("WARNING: Volume value suspicious: " + std::to_string(trade->volume));
-                normalized_volume = 100; // Default to 1 lot
-                data_corrupted = true;
-            }
-            
-            if (trade->open_price <= 0 || trade->open_price > 1000000) {
-                g_logger.Log("WARNING: Price value suspicious: " + std::to_string(trade->open_price));
-                normalized_price = 1.0; // Default price
-                data_corrupted = true;
-            }
-            
-            if (data_corrupted) {
-                g_logger.Log("=== DATA CORRUPTION DETECTED - USING NORMALIZED VALUES ===");
-            }
-            
-            // Log normalized data
-            g_logger.Log("=== PROCESSED TRADE DATA ===");
-            g_logger.Log("Order: " + std::to_string(trade->order));
-            g_logger.Log("Login: " + std::to_string(trade->login));
-            g_logger.Log("Symbol: " + clean_symbol);
-            g_logger.Log("Command: " + std::to_string(normalized_cmd) + " (" + GetCommandName(normalized_cmd) + ")");
-            g_logger.Log("Volume: " + std::to_string(normalized_volume));
-            g_logger.Log("Price: " + std::to_string(normalized_price));
-            g_logger.Log("State: " + std::to_string(trade->state));
-            
-            g_logger.Log("CHECKPOINT 4: Data logging completed successfully");
-            
-            // Check if we should process this trade
-            g_logger.Log("CHECKPOINT 5: Checking if trade should be processed");
-            if (!ShouldProcessTrade(trade)) {
-                g_logger.Log("Trade skipped - not a new market order");
-                g_logger.Log("CHECKPOINT 6: Trade processing completed (skipped)");
-                return 1; // Changed to return 1 for consistency
-            }
-            
-            g_logger.Log("CHECKPOINT 7: Trade approved for processing");
-            
-            // EXPERIMENTAL: Try early exit to test if data processing causes crash
-            // Uncomment next lines to test minimal processing
-            // g_logger.Log("EXPERIMENTAL: Early exit to test crash cause");
-            // g_logger.Log("CHECKPOINT 16: About to return early to MT4");
-            // return 1;
-            
-            // Display ML service status
-            std::string ml_status;
-            if (g_cvm_client.IsMLServiceAvailable()) {
-                ml_status = "CONNECTED";
-            } else {
-                int failures = g_cvm_client.GetConsecutiveFailures();
-                ml_status = "DISCONNECTED (failures: " + std::to_string(failures) + ")";
-            }
-            g_logger.Log("ML Service Status: " + ml_status);
-            g_logger.Log("CHECKPOINT 8: ML service status determined");
-            
-            // Get ML score (always returns valid score, even if ML service is down)
-            g_logger.Log("CHECKPOINT 9: About to call ML scoring service");
-            double score = 0.0;
-            bool ml_score_received = false;
-            
-            try {
-                score = g_cvm_client.GetScore(trade, user);
-                
-                // Check if this is actually a fallback score
-                if (score == g_config.fallback_score) {
-                    g_logger.Log("CHECKPOINT 10: Received fallback score (ML service failed): " + std::to_string(score));
-                    ml_score_received = false;
-                } else {
-                    g_logger.Log("CHECKPOINT 10: Received REAL ML score: " + std::to_string(score));
-                    ml_score_received = true;
-                }
-            } catch (const std::exception& e) {
-                g_logger.Log("ERROR: Exception in ML scoring: " + std::string(e.what()));
-                score = g_config.fallback_score;
-                ml_score_received = false;
-                g_logger.Log("CHECKPOINT 10: Using fallback score due to exception");
-            } catch (...) {
-                g_logger.Log("ERROR: Unknown exception in ML scoring");
-                score = g_config.fallback_score;
-                ml_score_received = false;
-                g_logger.Log("CHECKPOINT 10: Using fallback score due to unknown exception");
-            }
-            
-            std::string score_status = ml_score_received ? "REAL ML SCORE" : "FALLBACK SCORE USED";
-            g_logger.Log("ML Score Status: " + score_status);
-            
-            // Determine instrument group and threshold using clean symbol
-            g_logger.Log("CHECKPOINT 11: Determining instrument group");
-            std::string instrument_group = GetInstrumentGroup(clean_symbol.c_str());
-            double threshold = GetThreshold(instrument_group);
-            g_logger.Log("CHECKPOINT 12: Threshold determined");
-            
-            // Make routing decision
-            std::string routing_decision;
-            std::string decision_basis;
-            
-            if (g_cvm_client.IsMLServiceAvailable()) {
-                decision_basis = "ML Score";
-            } else {
-                decision_basis = "Fallback Score (ML service unavailable)";
-            }
-            
-            if (score >= threshold) {
-                routing_decision = "B-BOOK";
-            } else {
-                routing_decision = "A-BOOK";  
-            }
-            
-            g_logger.Log("CHECKPOINT 13: Routing decision made");
-            
-            // Log decision with context
-            g_logger.Log("Score: " + std::to_string(score) + " (" + decision_basis + ")");
-            g_logger.Log("Instrument Group: " + instrument_group);
-            g_logger.Log("Threshold: " + std::to_string(threshold));
-            g_logger.Log("ROUTING DECISION: " + routing_decision);
-            
-            // Log plugin stability status
-            if (!g_cvm_client.IsMLServiceAvailable()) {
-                g_logger.Log("PLUGIN STATUS: Operating in FALLBACK mode - all trades processed normally");
-            }
-            
-            g_logger.Log("CHECKPOINT 14: About to complete trade processing");
-            g_logger.Log("=====================================");
-            
-            // INTEGRATION POINT: In production, integrate with broker's routing system here
-            // The plugin NEVER fails regardless of ML service status
-            
-            g_logger.Log("CHECKPOINT 15: Trade processing completed successfully");
-            g_logger.Log("CHECKPOINT 16: About to return to MT4 - using stable return value");
-            
-            // CRASH DIAGNOSTIC LOGGING - Detailed analysis of plugin state before return
-            g_logger.Log("=== CRASH DIAGNOSTIC: PRE-RETURN STATE ANALYSIS ===");
-            g_logger.Log("DIAGNOSTIC: Plugin memory state appears healthy");
-            g_logger.Log("DIAGNOSTIC: All socket connections properly closed");
-            g_logger.Log("DIAGNOSTIC: No dangling pointers detected");
-            g_logger.Log("DIAGNOSTIC: Trade processing completed without exceptions");
-            g_logger.Log("DIAGNOSTIC: ML service cleanup completed successfully");
-            g_logger.Log("DIAGNOSTIC: Plugin about to return 0 to MT4 server");
-            g_logger.Log("DIAGNOSTIC: Return 0 = 'Transaction processed successfully, continue normal operation'");
-            g_logger.Log("DIAGNOSTIC: This should NOT cause MT4 server crash");
-            g_logger.Log("DIAGNOSTIC: If MT4 crashes after this point, it's likely an MT4 server issue");
-            g_logger.Log("DIAGNOSTIC: Plugin state is completely stable and safe");
-            g_logger.Log("=== END CRASH DIAGNOSTIC ===");
-            
-            // Return 0 = "Transaction processed successfully, continue normal MT4 operation"
-            // This prevents MT4 server crashes that were occurring with return 1
-            return 0; // Safe return value - tells MT4 we processed it and to continue normally
-            
-        } catch (const std::bad_alloc& e) {
-            g_logger.Log("CRITICAL: Memory allocation failed in MtSrvTradeTransaction - plugin remains stable");
-            g_logger.Log("CRASH DIAGNOSTIC: Memory error details: " + std::string(e.what()));
-            g_logger.Log("CRASH DIAGNOSTIC: This could indicate MT4 server memory pressure");
-            g_logger.Log("CRASH DIAGNOSTIC: Plugin handled gracefully, should not crash MT4");
-            g_logger.Log("CRASH PREVENTION: Returning safely from memory allocation error");
-            return 0; // Safe return - tells MT4 we handled it gracefully
-        } catch (const std::exception& e) {
-            g_logger.Log("EXCEPTION in MtSrvTradeTransaction: " + std::string(e.what()) + " - plugin remains stable");
-            g_logger.Log("CRASH DIAGNOSTIC: Exception type: std::exception");
-            g_logger.Log("CRASH DIAGNOSTIC: Exception message: " + std::string(e.what()));
-            g_logger.Log("CRASH DIAGNOSTIC: Plugin caught and handled exception properly");
-            g_logger.Log("CRASH DIAGNOSTIC: MT4 server should continue normally");
-            g_logger.Log("CRASH PREVENTION: Returning safely from standard exception");
-            return 0; // Safe return - tells MT4 we handled it gracefully
-        } catch (...) {
-            g_logger.Log("UNKNOWN EXCEPTION in MtSrvTradeTransaction - plugin remains stable and continues operating");
-            g_logger.Log("CRASH DIAGNOSTIC: Unknown exception type caught");
-            g_logger.Log("CRASH DIAGNOSTIC: Could be access violation, divide by zero, or corrupted data");
-            g_logger.Log("CRASH DIAGNOSTIC: Plugin prevented exception from propagating to MT4");
-            g_logger.Log("CRASH DIAGNOSTIC: This should prevent MT4 server crash");
-            g_logger.Log("CRASH PREVENTION: Returning safely from unknown exception");
-            return 0; // Safe return - tells MT4 we handled it gracefully
+        return g_router.TradeTransaction(trade, user);
+    }
+
+    // Account login - pre-score the login's last market order. Like
+    // MtSrvTradeTransaction this uses the plugin's simplified hook signature.
+    __declspec(dllexport) void __stdcall MtSrvUserLogin(UserInfo* user) {
+        g_router.UserLogin(user);
+    }
+
+    // Not part of the MT4 server API: lets tools loaded in the server process
+    // read the stage latency totals. Copies the report (NUL terminated, truncated
+    // to buffer_size) and returns its full length.
+    __declspec(dllexport) int __stdcall ABBookLatencyReport(char* buffer, int buffer_size) {
+        std::string report = g_router.LatencyReport();
+        if (buffer && buffer_size > 0) {
+            size_t length = report.size() < (size_t)buffer_size - 1 ? report.size() : (size_t)buffer_size - 1;
+            memcpy(buffer, report.data(), length);
+            buffer[length] = '\0';
         }
+        return (int)report.size();
     }
 
 } // extern "C"
@@ -1052,48 +88,48 @@ BOOL WINAPI DllMain(HINSTANCE hinstDLL, DWORD fdwReason, LPVOID lpvReserved) {
         case DLL_PROCESS_ATTACH:
             g_logger.Log("DLL_PROCESS_ATTACH: Plugin loaded into MT4 server");
             g_logger.Log("ATTACH INFO: hinstDLL=" + std::to_string(reinterpret_cast<uintptr_t>(hinstDLL)));
-            g_logger.Log("CRASH DIAGNOSTIC: DLL_PROCESS_ATTACH called successfully");
-            g_logger.Log("CRASH DIAGNOSTIC: Plugin memory space initialized cleanly");
+            ABBOOK_LOG_DEBUG(g_logger, "CRASH DIAGNOSTIC: DLL_PROCESS_ATTACH called successfully");
+            ABBOOK_LOG_DEBUG(g_logger, "CRASH DIAGNOSTIC: Plugin memory space initialized cleanly");
             g_logger.Log("BULLETPROOF MODE: Plugin will remain loaded regardless of ML service status");
             
             // BULLETPROOF: Disable unloading by incrementing reference count
             // This prevents MT4 from unloading the plugin due to errors
             DisableThreadLibraryCalls(hinstDLL);
-            g_logger.Log("CRASH DIAGNOSTIC: DisableThreadLibraryCalls completed - thread safety enhanced");
-            g_logger.Log("CRASH DIAGNOSTIC: Plugin attachment phase completed without errors");
+            ABBOOK_LOG_DEBUG(g_logger, "CRASH DIAGNOSTIC: DisableThreadLibraryCalls completed - thread safety enhanced");
+            ABBOOK_LOG_DEBUG(g_logger, "CRASH DIAGNOSTIC: Plugin attachment phase completed without errors");
             break;
             
         case DLL_PROCESS_DETACH:
-            g_logger.Log("=== CRASH DIAGNOSTIC: PLUGIN DETACH ANALYSIS ===");
+            ABBOOK_LOG_DEBUG(g_logger, "=== CRASH DIAGNOSTIC: PLUGIN DETACH ANALYSIS ===");
             g_logger.Log("DLL_PROCESS_DETACH: Plugin unload requested");
             g_logger.Log("DETACH INFO: hinstDLL=" + std::to_string(reinterpret_cast<uintptr_t>(hinstDLL)));
             if (lpvReserved) {
                 g_logger.Log("DETACH REASON: Process termination (MT4 crashed or shutdown) - NORMAL");
-                g_logger.Log("CRASH DIAGNOSTIC: MT4 server process is terminating");
-                g_logger.Log("CRASH DIAGNOSTIC: This is NOT a plugin-caused crash");
-                g_logger.Log("CRASH DIAGNOSTIC: lpvReserved != nullptr indicates normal process shutdown");
+                ABBOOK_LOG_DEBUG(g_logger, "CRASH DIAGNOSTIC: MT4 server process is terminating");
+                ABBOOK_LOG_DEBUG(g_logger, "CRASH DIAGNOSTIC: This is NOT a plugin-caused crash");
+                ABBOOK_LOG_DEBUG(g_logger, "CRASH DIAGNOSTIC: lpvReserved != nullptr indicates normal process shutdown");
             } else {
                 g_logger.Log("DETACH REASON: DLL unload requested (FreeLibrary called)");
-                g_logger.Log("CRASH DIAGNOSTIC: Plugin unloaded via explicit FreeLibrary call");
-                g_logger.Log("CRASH DIAGNOSTIC: This indicates controlled test environment cleanup");
-                g_logger.Log("NOTE: In production MT4, plugin stays loaded - this is test cleanup");
-            }
-            g_logger.Log("CRASH DIAGNOSTIC: Plugin state during detach appears stable");
-            g_logger.Log("CRASH DIAGNOSTIC: No memory corruption or resource leaks detected");
-            g_logger.Log("PLUGIN STATUS: All trades were processed successfully during runtime");
-            g_logger.Log("=== END CRASH DIAGNOSTIC ===");
+                ABBOOK_LOG_DEBUG(g_logger, "CRASH DIAGNOSTIC: Plugin unloaded via explicit FreeLibrary call");
+                ABBOOK_LOG_DEBUG(g_logger, "CRASH DIAGNOSTIC: This indicates controlled test environment cleanup");
+                ABBOOK_LOG_DEBUG(g_logger, "NOTE: In production MT4, plugin stays loaded - this is test cleanup");
+            }
+            ABBOOK_LOG_DEBUG(g_logger, "CRASH DIAGNOSTIC: Plugin state during detach appears stable");
+            ABBOOK_LOG_DEBUG(g_logger, "CRASH DIAGNOSTIC: No memory corruption or resource leaks detected");
+            ABBOOK_LOG_DEBUG(g_logger, "PLUGIN STATUS: All trades were processed successfully during runtime");
+            ABBOOK_LOG_DEBUG(g_logger, "=== END CRASH DIAGNOSTIC ===");
             break;
             
         case DLL_THREAD_ATTACH:
             // CRASH DIAGNOSTIC: Thread events should be disabled via DisableThreadLibraryCalls
-            g_logger.Log("CRASH DIAGNOSTIC: DLL_THREAD_ATTACH received (should be disabled!)");
-            g_logger.Log("CRASH DIAGNOSTIC: This could indicate thread safety issue");
+            ABBOOK_LOG_WARN(g_logger, "CRASH DIAGNOSTIC: DLL_THREAD_ATTACH received (should be disabled!)");
+            ABBOOK_LOG_WARN(g_logger, "CRASH DIAGNOSTIC: This could indicate thread safety issue");
             break;
             
         case DLL_THREAD_DETACH:
             // CRASH DIAGNOSTIC: Thread events should be disabled via DisableThreadLibraryCalls
-            g_logger.Log("CRASH DIAGNOSTIC: DLL_THREAD_DETACH received (should be disabled!)");
-            g_logger.Log("CRASH DIAGNOSTIC: This could indicate thread cleanup issue");
+            ABBOOK_LOG_WARN(g_logger, "CRASH DIAGNOSTIC: DLL_THREAD_DETACH received (should be disabled!)");
+            ABBOOK_LOG_WARN(g_logger, "CRASH DIAGNOSTIC: This could indicate thread cleanup issue");
             break;
     }
     return TRUE;
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/abbook_core.dir/ABBook_TradeRouter.cpp.o"
+  "CMakeFiles/abbook_core.dir/ABBook_TradeRouter.cpp.o.d"
+  "libabbook_core.a"
+  "libabbook_core.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/abbook_core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_proto_encoder.dir/bench_proto_encoder.cpp.o"
+  "CMakeFiles/bench_proto_encoder.dir/bench_proto_encoder.cpp.o.d"
+  "bench_proto_encoder"
+  "bench_proto_encoder.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_proto_encoder.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
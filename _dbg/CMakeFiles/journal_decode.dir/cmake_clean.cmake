@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/journal_decode.dir/journal_decode.cpp.o"
+  "CMakeFiles/journal_decode.dir/journal_decode.cpp.o.d"
+  "journal_decode"
+  "journal_decode.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/journal_decode.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
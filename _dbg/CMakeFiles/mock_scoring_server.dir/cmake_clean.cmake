@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/mock_scoring_server.dir/mock_scoring_server.cpp.o"
+  "CMakeFiles/mock_scoring_server.dir/mock_scoring_server.cpp.o.d"
+  "mock_scoring_server"
+  "mock_scoring_server.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/mock_scoring_server.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/scoring_schema"
+  "scoring_schema.h"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/scoring_schema.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
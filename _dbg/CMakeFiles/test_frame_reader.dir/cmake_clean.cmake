@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_frame_reader.dir/test_frame_reader.cpp.o"
+  "CMakeFiles/test_frame_reader.dir/test_frame_reader.cpp.o.d"
+  "test_frame_reader"
+  "test_frame_reader.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_frame_reader.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
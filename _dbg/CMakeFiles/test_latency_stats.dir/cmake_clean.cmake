@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_latency_stats.dir/test_latency_stats.cpp.o"
+  "CMakeFiles/test_latency_stats.dir/test_latency_stats.cpp.o.d"
+  "test_latency_stats"
+  "test_latency_stats.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_latency_stats.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
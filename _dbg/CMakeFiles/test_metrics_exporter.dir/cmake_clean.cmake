@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_metrics_exporter.dir/test_metrics_exporter.cpp.o"
+  "CMakeFiles/test_metrics_exporter.dir/test_metrics_exporter.cpp.o.d"
+  "test_metrics_exporter"
+  "test_metrics_exporter.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_metrics_exporter.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_no_alloc.dir/test_no_alloc.cpp.o"
+  "CMakeFiles/test_no_alloc.dir/test_no_alloc.cpp.o.d"
+  "test_no_alloc"
+  "test_no_alloc.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_no_alloc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
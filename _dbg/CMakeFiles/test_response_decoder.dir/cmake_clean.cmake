@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_response_decoder.dir/test_response_decoder.cpp.o"
+  "CMakeFiles/test_response_decoder.dir/test_response_decoder.cpp.o.d"
+  "test_response_decoder"
+  "test_response_decoder.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_response_decoder.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_score_cache.dir/test_score_cache.cpp.o"
+  "CMakeFiles/test_score_cache.dir/test_score_cache.cpp.o.d"
+  "test_score_cache"
+  "test_score_cache.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_score_cache.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
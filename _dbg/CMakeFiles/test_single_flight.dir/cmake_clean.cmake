@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_single_flight.dir/test_single_flight.cpp.o"
+  "CMakeFiles/test_single_flight.dir/test_single_flight.cpp.o.d"
+  "test_single_flight"
+  "test_single_flight.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_single_flight.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
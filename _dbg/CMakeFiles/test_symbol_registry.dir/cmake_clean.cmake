@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_symbol_registry.dir/test_symbol_registry.cpp.o"
+  "CMakeFiles/test_symbol_registry.dir/test_symbol_registry.cpp.o.d"
+  "test_symbol_registry"
+  "test_symbol_registry.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_symbol_registry.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
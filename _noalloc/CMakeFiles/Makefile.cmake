@@ -0,0 +1,75 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/proto_schema_gen.dir/DependInfo.cmake"
+  "CMakeFiles/scoring_schema.dir/DependInfo.cmake"
+  "CMakeFiles/abbook_core.dir/DependInfo.cmake"
+  "CMakeFiles/journal_decode.dir/DependInfo.cmake"
+  "CMakeFiles/tape_replay.dir/DependInfo.cmake"
+  "CMakeFiles/mock_scoring_server.dir/DependInfo.cmake"
+  "CMakeFiles/test_circuit_breaker.dir/DependInfo.cmake"
+  "CMakeFiles/test_connection_pool.dir/DependInfo.cmake"
+  "CMakeFiles/test_decision_journal.dir/DependInfo.cmake"
+  "CMakeFiles/test_frame_reader.dir/DependInfo.cmake"
+  "CMakeFiles/test_latency_stats.dir/DependInfo.cmake"
+  "CMakeFiles/test_metrics_exporter.dir/DependInfo.cmake"
+  "CMakeFiles/test_multiplexed_channel.dir/DependInfo.cmake"
+  "CMakeFiles/test_no_alloc.dir/DependInfo.cmake"
+  "CMakeFiles/test_request_templates.dir/DependInfo.cmake"
+  "CMakeFiles/test_response_decoder.dir/DependInfo.cmake"
+  "CMakeFiles/test_score_cache.dir/DependInfo.cmake"
+  "CMakeFiles/test_scoring_batcher.dir/DependInfo.cmake"
+  "CMakeFiles/test_scoring_engine.dir/DependInfo.cmake"
+  "CMakeFiles/test_single_flight.dir/DependInfo.cmake"
+  "CMakeFiles/test_symbol_registry.dir/DependInfo.cmake"
+  "CMakeFiles/test_trade_tape.dir/DependInfo.cmake"
+  "CMakeFiles/bench_async_logger.dir/DependInfo.cmake"
+  "CMakeFiles/bench_hot_path.dir/DependInfo.cmake"
+  "CMakeFiles/bench_proto_encoder.dir/DependInfo.cmake"
+  "CMakeFiles/bench_scoring_batcher.dir/DependInfo.cmake"
+  )
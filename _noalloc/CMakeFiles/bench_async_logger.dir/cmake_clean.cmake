@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_async_logger.dir/bench_async_logger.cpp.o"
+  "CMakeFiles/bench_async_logger.dir/bench_async_logger.cpp.o.d"
+  "bench_async_logger"
+  "bench_async_logger.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_async_logger.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
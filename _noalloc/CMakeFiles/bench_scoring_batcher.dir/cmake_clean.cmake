@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/bench_scoring_batcher.dir/bench_scoring_batcher.cpp.o"
+  "CMakeFiles/bench_scoring_batcher.dir/bench_scoring_batcher.cpp.o.d"
+  "bench_scoring_batcher"
+  "bench_scoring_batcher.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/bench_scoring_batcher.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/proto_schema_gen.dir/proto_schema_gen.cpp.o"
+  "CMakeFiles/proto_schema_gen.dir/proto_schema_gen.cpp.o.d"
+  "proto_schema_gen"
+  "proto_schema_gen.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/proto_schema_gen.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
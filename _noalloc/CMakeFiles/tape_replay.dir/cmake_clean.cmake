@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tape_replay.dir/tape_replay.cpp.o"
+  "CMakeFiles/tape_replay.dir/tape_replay.cpp.o.d"
+  "tape_replay"
+  "tape_replay.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tape_replay.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_circuit_breaker.dir/test_circuit_breaker.cpp.o"
+  "CMakeFiles/test_circuit_breaker.dir/test_circuit_breaker.cpp.o.d"
+  "test_circuit_breaker"
+  "test_circuit_breaker.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_circuit_breaker.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
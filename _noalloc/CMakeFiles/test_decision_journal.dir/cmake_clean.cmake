@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_decision_journal.dir/test_decision_journal.cpp.o"
+  "CMakeFiles/test_decision_journal.dir/test_decision_journal.cpp.o.d"
+  "test_decision_journal"
+  "test_decision_journal.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_decision_journal.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
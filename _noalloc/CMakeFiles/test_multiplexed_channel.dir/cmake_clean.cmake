@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_multiplexed_channel.dir/test_multiplexed_channel.cpp.o"
+  "CMakeFiles/test_multiplexed_channel.dir/test_multiplexed_channel.cpp.o.d"
+  "test_multiplexed_channel"
+  "test_multiplexed_channel.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_multiplexed_channel.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_request_templates.dir/test_request_templates.cpp.o"
+  "CMakeFiles/test_request_templates.dir/test_request_templates.cpp.o.d"
+  "test_request_templates"
+  "test_request_templates.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_request_templates.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
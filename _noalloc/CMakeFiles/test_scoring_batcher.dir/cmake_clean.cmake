@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_scoring_batcher.dir/test_scoring_batcher.cpp.o"
+  "CMakeFiles/test_scoring_batcher.dir/test_scoring_batcher.cpp.o.d"
+  "test_scoring_batcher"
+  "test_scoring_batcher.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_scoring_batcher.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_scoring_engine.dir/test_scoring_engine.cpp.o"
+  "CMakeFiles/test_scoring_engine.dir/test_scoring_engine.cpp.o.d"
+  "test_scoring_engine"
+  "test_scoring_engine.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_scoring_engine.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
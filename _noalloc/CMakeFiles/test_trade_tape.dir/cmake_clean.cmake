@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/test_trade_tape.dir/test_trade_tape.cpp.o"
+  "CMakeFiles/test_trade_tape.dir/test_trade_tape.cpp.o.d"
+  "test_trade_tape"
+  "test_trade_tape.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/test_trade_tape.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,38 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_noalloc
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(circuit_breaker "/root/repo/_noalloc/test_circuit_breaker")
+set_tests_properties(circuit_breaker PROPERTIES  WORKING_DIRECTORY "/root/repo/_noalloc" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;146;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(connection_pool "/root/repo/_noalloc/test_connection_pool")
+set_tests_properties(connection_pool PROPERTIES  WORKING_DIRECTORY "/root/repo/_noalloc" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;146;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(decision_journal "/root/repo/_noalloc/test_decision_journal")
+set_tests_properties(decision_journal PROPERTIES  WORKING_DIRECTORY "/root/repo/_noalloc" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;146;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(frame_reader "/root/repo/_noalloc/test_frame_reader")
+set_tests_properties(frame_reader PROPERTIES  WORKING_DIRECTORY "/root/repo/_noalloc" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;146;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(latency_stats "/root/repo/_noalloc/test_latency_stats")
+set_tests_properties(latency_stats PROPERTIES  WORKING_DIRECTORY "/root/repo/_noalloc" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;146;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(metrics_exporter "/root/repo/_noalloc/test_metrics_exporter")
+set_tests_properties(metrics_exporter PROPERTIES  WORKING_DIRECTORY "/root/repo/_noalloc" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;146;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(multiplexed_channel "/root/repo/_noalloc/test_multiplexed_channel")
+set_tests_properties(multiplexed_channel PROPERTIES  WORKING_DIRECTORY "/root/repo/_noalloc" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;146;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(no_alloc "/root/repo/_noalloc/test_no_alloc")
+set_tests_properties(no_alloc PROPERTIES  WORKING_DIRECTORY "/root/repo/_noalloc" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;146;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(request_templates "/root/repo/_noalloc/test_request_templates")
+set_tests_properties(request_templates PROPERTIES  WORKING_DIRECTORY "/root/repo/_noalloc" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;146;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(response_decoder "/root/repo/_noalloc/test_response_decoder")
+set_tests_properties(response_decoder PROPERTIES  WORKING_DIRECTORY "/root/repo/_noalloc" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;146;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(score_cache "/root/repo/_noalloc/test_score_cache")
+set_tests_properties(score_cache PROPERTIES  WORKING_DIRECTORY "/root/repo/_noalloc" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;146;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(scoring_batcher "/root/repo/_noalloc/test_scoring_batcher")
+set_tests_properties(scoring_batcher PROPERTIES  WORKING_DIRECTORY "/root/repo/_noalloc" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;146;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(scoring_engine "/root/repo/_noalloc/test_scoring_engine")
+set_tests_properties(scoring_engine PROPERTIES  WORKING_DIRECTORY "/root/repo/_noalloc" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;146;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(single_flight "/root/repo/_noalloc/test_single_flight")
+set_tests_properties(single_flight PROPERTIES  WORKING_DIRECTORY "/root/repo/_noalloc" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;146;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(symbol_registry "/root/repo/_noalloc/test_symbol_registry")
+set_tests_properties(symbol_registry PROPERTIES  WORKING_DIRECTORY "/root/repo/_noalloc" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;146;add_test;/root/repo/CMakeLists.txt;0;")
+add_test(trade_tape "/root/repo/_noalloc/test_trade_tape")
+set_tests_properties(trade_tape PROPERTIES  WORKING_DIRECTORY "/root/repo/_noalloc" _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;146;add_test;/root/repo/CMakeLists.txt;0;")
@@ -0,0 +1,478 @@
+//+------------------------------------------------------------------+
+//| GENERATED by proto_schema_gen from scoring.proto - do not edit
+//+------------------------------------------------------------------+
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+
+#include "ABBook_ProtoWriter.h"
+
+namespace scoring {
+
+namespace ScoringRequest {
+
+    // float open_price = 1;
+    constexpr int open_price_field = 1;
+    constexpr int open_price_wire_type = 5;
+    constexpr ProtoTag open_price_tag = { { 0x0D, 0x00, 0x00 }, 1 };
+    inline void open_price(ProtoWriter& out, float value) { out.Tag(open_price_tag); out.Fixed32(value); }
+    template <typename T> void open_price(ProtoWriter&, T) = delete; // float only
+
+    // float sl = 2;
+    constexpr int sl_field = 2;
+    constexpr int sl_wire_type = 5;
+    constexpr ProtoTag sl_tag = { { 0x15, 0x00, 0x00 }, 1 };
+    inline void sl(ProtoWriter& out, float value) { out.Tag(sl_tag); out.Fixed32(value); }
+    template <typename T> void sl(ProtoWriter&, T) = delete; // float only
+
+    // float tp = 3;
+    constexpr int tp_field = 3;
+    constexpr int tp_wire_type = 5;
+    constexpr ProtoTag tp_tag = { { 0x1D, 0x00, 0x00 }, 1 };
+    inline void tp(ProtoWriter& out, float value) { out.Tag(tp_tag); out.Fixed32(value); }
+    template <typename T> void tp(ProtoWriter&, T) = delete; // float only
+
+    // int64 deal_type = 4;
+    constexpr int deal_type_field = 4;
+    constexpr int deal_type_wire_type = 0;
+    constexpr ProtoTag deal_type_tag = { { 0x20, 0x00, 0x00 }, 1 };
+    inline void deal_type(ProtoWriter& out, int64_t value) { out.Tag(deal_type_tag); out.Varint((uint64_t)value); }
+    template <typename T> void deal_type(ProtoWriter&, T) = delete; // int64 only
+
+    // float lot_volume = 5;
+    constexpr int lot_volume_field = 5;
+    constexpr int lot_volume_wire_type = 5;
+    constexpr ProtoTag lot_volume_tag = { { 0x2D, 0x00, 0x00 }, 1 };
+    inline void lot_volume(ProtoWriter& out, float value) { out.Tag(lot_volume_tag); out.Fixed32(value); }
+    template <typename T> void lot_volume(ProtoWriter&, T) = delete; // float only
+
+    // int64 is_bonus = 6;
+    constexpr int is_bonus_field = 6;
+    constexpr int is_bonus_wire_type = 0;
+    constexpr ProtoTag is_bonus_tag = { { 0x30, 0x00, 0x00 }, 1 };
+    inline void is_bonus(ProtoWriter& out, int64_t value) { out.Tag(is_bonus_tag); out.Varint((uint64_t)value); }
+    template <typename T> void is_bonus(ProtoWriter&, T) = delete; // int64 only
+
+    // float turnover_usd = 7;
+    constexpr int turnover_usd_field = 7;
+    constexpr int turnover_usd_wire_type = 5;
+    constexpr ProtoTag turnover_usd_tag = { { 0x3D, 0x00, 0x00 }, 1 };
+    inline void turnover_usd(ProtoWriter& out, float value) { out.Tag(turnover_usd_tag); out.Fixed32(value); }
+    template <typename T> void turnover_usd(ProtoWriter&, T) = delete; // float only
+
+    // float opening_balance = 8;
+    constexpr int opening_balance_field = 8;
+    constexpr int opening_balance_wire_type = 5;
+    constexpr ProtoTag opening_balance_tag = { { 0x45, 0x00, 0x00 }, 1 };
+    inline void opening_balance(ProtoWriter& out, float value) { out.Tag(opening_balance_tag); out.Fixed32(value); }
+    template <typename T> void opening_balance(ProtoWriter&, T) = delete; // float only
+
+    // int64 concurrent_positions = 9;
+    constexpr int concurrent_positions_field = 9;
+    constexpr int concurrent_positions_wire_type = 0;
+    constexpr ProtoTag concurrent_positions_tag = { { 0x48, 0x00, 0x00 }, 1 };
+    inline void concurrent_positions(ProtoWriter& out, int64_t value) { out.Tag(concurrent_positions_tag); out.Varint((uint64_t)value); }
+    template <typename T> void concurrent_positions(ProtoWriter&, T) = delete; // int64 only
+
+    // float sl_perc = 10;
+    constexpr int sl_perc_field = 10;
+    constexpr int sl_perc_wire_type = 5;
+    constexpr ProtoTag sl_perc_tag = { { 0x55, 0x00, 0x00 }, 1 };
+    inline void sl_perc(ProtoWriter& out, float value) { out.Tag(sl_perc_tag); out.Fixed32(value); }
+    template <typename T> void sl_perc(ProtoWriter&, T) = delete; // float only
+
+    // float tp_perc = 11;
+    constexpr int tp_perc_field = 11;
+    constexpr int tp_perc_wire_type = 5;
+    constexpr ProtoTag tp_perc_tag = { { 0x5D, 0x00, 0x00 }, 1 };
+    inline void tp_perc(ProtoWriter& out, float value) { out.Tag(tp_perc_tag); out.Fixed32(value); }
+    template <typename T> void tp_perc(ProtoWriter&, T) = delete; // float only
+
+    // int64 has_sl = 12;
+    constexpr int has_sl_field = 12;
+    constexpr int has_sl_wire_type = 0;
+    constexpr ProtoTag has_sl_tag = { { 0x60, 0x00, 0x00 }, 1 };
+    inline void has_sl(ProtoWriter& out, int64_t value) { out.Tag(has_sl_tag); out.Varint((uint64_t)value); }
+    template <typename T> void has_sl(ProtoWriter&, T) = delete; // int64 only
+
+    // int64 has_tp = 13;
+    constexpr int has_tp_field = 13;
+    constexpr int has_tp_wire_type = 0;
+    constexpr ProtoTag has_tp_tag = { { 0x68, 0x00, 0x00 }, 1 };
+    inline void has_tp(ProtoWriter& out, int64_t value) { out.Tag(has_tp_tag); out.Varint((uint64_t)value); }
+    template <typename T> void has_tp(ProtoWriter&, T) = delete; // int64 only
+
+    // float profitable_ratio = 14;
+    constexpr int profitable_ratio_field = 14;
+    constexpr int profitable_ratio_wire_type = 5;
+    constexpr ProtoTag profitable_ratio_tag = { { 0x75, 0x00, 0x00 }, 1 };
+    inline void profitable_ratio(ProtoWriter& out, float value) { out.Tag(profitable_ratio_tag); out.Fixed32(value); }
+    template <typename T> void profitable_ratio(ProtoWriter&, T) = delete; // float only
+
+    // int64 num_open_trades = 15;
+    constexpr int num_open_trades_field = 15;
+    constexpr int num_open_trades_wire_type = 0;
+    constexpr ProtoTag num_open_trades_tag = { { 0x78, 0x00, 0x00 }, 1 };
+    inline void num_open_trades(ProtoWriter& out, int64_t value) { out.Tag(num_open_trades_tag); out.Varint((uint64_t)value); }
+    template <typename T> void num_open_trades(ProtoWriter&, T) = delete; // int64 only
+
+    // int64 num_closed_trades = 16;
+    constexpr int num_closed_trades_field = 16;
+    constexpr int num_closed_trades_wire_type = 0;
+    constexpr ProtoTag num_closed_trades_tag = { { 0x80, 0x01, 0x00 }, 2 };
+    inline void num_closed_trades(ProtoWriter& out, int64_t value) { out.Tag(num_closed_trades_tag); out.Varint((uint64_t)value); }
+    template <typename T> void num_closed_trades(ProtoWriter&, T) = delete; // int64 only
+
+    // int64 age = 17;
+    constexpr int age_field = 17;
+    constexpr int age_wire_type = 0;
+    constexpr ProtoTag age_tag = { { 0x88, 0x01, 0x00 }, 2 };
+    inline void age(ProtoWriter& out, int64_t value) { out.Tag(age_tag); out.Varint((uint64_t)value); }
+    template <typename T> void age(ProtoWriter&, T) = delete; // int64 only
+
+    // int64 days_since_reg = 18;
+    constexpr int days_since_reg_field = 18;
+    constexpr int days_since_reg_wire_type = 0;
+    constexpr ProtoTag days_since_reg_tag = { { 0x90, 0x01, 0x00 }, 2 };
+    inline void days_since_reg(ProtoWriter& out, int64_t value) { out.Tag(days_since_reg_tag); out.Varint((uint64_t)value); }
+    template <typename T> void days_since_reg(ProtoWriter&, T) = delete; // int64 only
+
+    // float deposit_lifetime = 19;
+    constexpr int deposit_lifetime_field = 19;
+    constexpr int deposit_lifetime_wire_type = 5;
+    constexpr ProtoTag deposit_lifetime_tag = { { 0x9D, 0x01, 0x00 }, 2 };
+    inline void deposit_lifetime(ProtoWriter& out, float value) { out.Tag(deposit_lifetime_tag); out.Fixed32(value); }
+    template <typename T> void deposit_lifetime(ProtoWriter&, T) = delete; // float only
+
+    // int64 deposit_count = 20;
+    constexpr int deposit_count_field = 20;
+    constexpr int deposit_count_wire_type = 0;
+    constexpr ProtoTag deposit_count_tag = { { 0xA0, 0x01, 0x00 }, 2 };
+    inline void deposit_count(ProtoWriter& out, int64_t value) { out.Tag(deposit_count_tag); out.Varint((uint64_t)value); }
+    template <typename T> void deposit_count(ProtoWriter&, T) = delete; // int64 only
+
+    // float withdraw_lifetime = 21;
+    constexpr int withdraw_lifetime_field = 21;
+    constexpr int withdraw_lifetime_wire_type = 5;
+    constexpr ProtoTag withdraw_lifetime_tag = { { 0xAD, 0x01, 0x00 }, 2 };
+    inline void withdraw_lifetime(ProtoWriter& out, float value) { out.Tag(withdraw_lifetime_tag); out.Fixed32(value); }
+    template <typename T> void withdraw_lifetime(ProtoWriter&, T) = delete; // float only
+
+    // int64 withdraw_count = 22;
+    constexpr int withdraw_count_field = 22;
+    constexpr int withdraw_count_wire_type = 0;
+    constexpr ProtoTag withdraw_count_tag = { { 0xB0, 0x01, 0x00 }, 2 };
+    inline void withdraw_count(ProtoWriter& out, int64_t value) { out.Tag(withdraw_count_tag); out.Varint((uint64_t)value); }
+    template <typename T> void withdraw_count(ProtoWriter&, T) = delete; // int64 only
+
+    // int64 vip = 23;
+    constexpr int vip_field = 23;
+    constexpr int vip_wire_type = 0;
+    constexpr ProtoTag vip_tag = { { 0xB8, 0x01, 0x00 }, 2 };
+    inline void vip(ProtoWriter& out, int64_t value) { out.Tag(vip_tag); out.Varint((uint64_t)value); }
+    template <typename T> void vip(ProtoWriter&, T) = delete; // int64 only
+
+    // int64 holding_time_sec = 24;
+    constexpr int holding_time_sec_field = 24;
+    constexpr int holding_time_sec_wire_type = 0;
+    constexpr ProtoTag holding_time_sec_tag = { { 0xC0, 0x01, 0x00 }, 2 };
+    inline void holding_time_sec(ProtoWriter& out, int64_t value) { out.Tag(holding_time_sec_tag); out.Varint((uint64_t)value); }
+    template <typename T> void holding_time_sec(ProtoWriter&, T) = delete; // int64 only
+
+    // float lot_usd_value = 25;
+    constexpr int lot_usd_value_field = 25;
+    constexpr int lot_usd_value_wire_type = 5;
+    constexpr ProtoTag lot_usd_value_tag = { { 0xCD, 0x01, 0x00 }, 2 };
+    inline void lot_usd_value(ProtoWriter& out, float value) { out.Tag(lot_usd_value_tag); out.Fixed32(value); }
+    template <typename T> void lot_usd_value(ProtoWriter&, T) = delete; // float only
+
+    // float max_drawdown = 26;
+    constexpr int max_drawdown_field = 26;
+    constexpr int max_drawdown_wire_type = 5;
+    constexpr ProtoTag max_drawdown_tag = { { 0xD5, 0x01, 0x00 }, 2 };
+    inline void max_drawdown(ProtoWriter& out, float value) { out.Tag(max_drawdown_tag); out.Fixed32(value); }
+    template <typename T> void max_drawdown(ProtoWriter&, T) = delete; // float only
+
+    // float max_runup = 27;
+    constexpr int max_runup_field = 27;
+    constexpr int max_runup_wire_type = 5;
+    constexpr ProtoTag max_runup_tag = { { 0xDD, 0x01, 0x00 }, 2 };
+    inline void max_runup(ProtoWriter& out, float value) { out.Tag(max_runup_tag); out.Fixed32(value); }
+    template <typename T> void max_runup(ProtoWriter&, T) = delete; // float only
+
+    // float volume_24h = 28;
+    constexpr int volume_24h_field = 28;
+    constexpr int volume_24h_wire_type = 5;
+    constexpr ProtoTag volume_24h_tag = { { 0xE5, 0x01, 0x00 }, 2 };
+    inline void volume_24h(ProtoWriter& out, float value) { out.Tag(volume_24h_tag); out.Fixed32(value); }
+    template <typename T> void volume_24h(ProtoWriter&, T) = delete; // float only
+
+    // float trader_tenure_days = 29;
+    constexpr int trader_tenure_days_field = 29;
+    constexpr int trader_tenure_days_wire_type = 5;
+    constexpr ProtoTag trader_tenure_days_tag = { { 0xED, 0x01, 0x00 }, 2 };
+    inline void trader_tenure_days(ProtoWriter& out, float value) { out.Tag(trader_tenure_days_tag); out.Fixed32(value); }
+    template <typename T> void trader_tenure_days(ProtoWriter&, T) = delete; // float only
+
+    // float deposit_to_withdraw_ratio = 30;
+    constexpr int deposit_to_withdraw_ratio_field = 30;
+    constexpr int deposit_to_withdraw_ratio_wire_type = 5;
+    constexpr ProtoTag deposit_to_withdraw_ratio_tag = { { 0xF5, 0x01, 0x00 }, 2 };
+    inline void deposit_to_withdraw_ratio(ProtoWriter& out, float value) { out.Tag(deposit_to_withdraw_ratio_tag); out.Fixed32(value); }
+    template <typename T> void deposit_to_withdraw_ratio(ProtoWriter&, T) = delete; // float only
+
+    // int64 education_known = 31;
+    constexpr int education_known_field = 31;
+    constexpr int education_known_wire_type = 0;
+    constexpr ProtoTag education_known_tag = { { 0xF8, 0x01, 0x00 }, 2 };
+    inline void education_known(ProtoWriter& out, int64_t value) { out.Tag(education_known_tag); out.Varint((uint64_t)value); }
+    template <typename T> void education_known(ProtoWriter&, T) = delete; // int64 only
+
+    // int64 occupation_known = 32;
+    constexpr int occupation_known_field = 32;
+    constexpr int occupation_known_wire_type = 0;
+    constexpr ProtoTag occupation_known_tag = { { 0x80, 0x02, 0x00 }, 2 };
+    inline void occupation_known(ProtoWriter& out, int64_t value) { out.Tag(occupation_known_tag); out.Varint((uint64_t)value); }
+    template <typename T> void occupation_known(ProtoWriter&, T) = delete; // int64 only
+
+    // float lot_to_balance_ratio = 33;
+    constexpr int lot_to_balance_ratio_field = 33;
+    constexpr int lot_to_balance_ratio_wire_type = 5;
+    constexpr ProtoTag lot_to_balance_ratio_tag = { { 0x8D, 0x02, 0x00 }, 2 };
+    inline void lot_to_balance_ratio(ProtoWriter& out, float value) { out.Tag(lot_to_balance_ratio_tag); out.Fixed32(value); }
+    template <typename T> void lot_to_balance_ratio(ProtoWriter&, T) = delete; // float only
+
+    // float deposit_density = 34;
+    constexpr int deposit_density_field = 34;
+    constexpr int deposit_density_wire_type = 5;
+    constexpr ProtoTag deposit_density_tag = { { 0x95, 0x02, 0x00 }, 2 };
+    inline void deposit_density(ProtoWriter& out, float value) { out.Tag(deposit_density_tag); out.Fixed32(value); }
+    template <typename T> void deposit_density(ProtoWriter&, T) = delete; // float only
+
+    // float withdrawal_density = 35;
+    constexpr int withdrawal_density_field = 35;
+    constexpr int withdrawal_density_wire_type = 5;
+    constexpr ProtoTag withdrawal_density_tag = { { 0x9D, 0x02, 0x00 }, 2 };
+    inline void withdrawal_density(ProtoWriter& out, float value) { out.Tag(withdrawal_density_tag); out.Fixed32(value); }
+    template <typename T> void withdrawal_density(ProtoWriter&, T) = delete; // float only
+
+    // float turnover_per_trade = 36;
+    constexpr int turnover_per_trade_field = 36;
+    constexpr int turnover_per_trade_wire_type = 5;
+    constexpr ProtoTag turnover_per_trade_tag = { { 0xA5, 0x02, 0x00 }, 2 };
+    inline void turnover_per_trade(ProtoWriter& out, float value) { out.Tag(turnover_per_trade_tag); out.Fixed32(value); }
+    template <typename T> void turnover_per_trade(ProtoWriter&, T) = delete; // float only
+
+    // float profitable_ratio_24h = 37;
+    constexpr int profitable_ratio_24h_field = 37;
+    constexpr int profitable_ratio_24h_wire_type = 5;
+    constexpr ProtoTag profitable_ratio_24h_tag = { { 0xAD, 0x02, 0x00 }, 2 };
+    inline void profitable_ratio_24h(ProtoWriter& out, float value) { out.Tag(profitable_ratio_24h_tag); out.Fixed32(value); }
+    template <typename T> void profitable_ratio_24h(ProtoWriter&, T) = delete; // float only
+
+    // float profitable_ratio_48h = 38;
+    constexpr int profitable_ratio_48h_field = 38;
+    constexpr int profitable_ratio_48h_wire_type = 5;
+    constexpr ProtoTag profitable_ratio_48h_tag = { { 0xB5, 0x02, 0x00 }, 2 };
+    inline void profitable_ratio_48h(ProtoWriter& out, float value) { out.Tag(profitable_ratio_48h_tag); out.Fixed32(value); }
+    template <typename T> void profitable_ratio_48h(ProtoWriter&, T) = delete; // float only
+
+    // float profitable_ratio_72h = 39;
+    constexpr int profitable_ratio_72h_field = 39;
+    constexpr int profitable_ratio_72h_wire_type = 5;
+    constexpr ProtoTag profitable_ratio_72h_tag = { { 0xBD, 0x02, 0x00 }, 2 };
+    inline void profitable_ratio_72h(ProtoWriter& out, float value) { out.Tag(profitable_ratio_72h_tag); out.Fixed32(value); }
+    template <typename T> void profitable_ratio_72h(ProtoWriter&, T) = delete; // float only
+
+    // int64 trades_count_24h = 40;
+    constexpr int trades_count_24h_field = 40;
+    constexpr int trades_count_24h_wire_type = 0;
+    constexpr ProtoTag trades_count_24h_tag = { { 0xC0, 0x02, 0x00 }, 2 };
+    inline void trades_count_24h(ProtoWriter& out, int64_t value) { out.Tag(trades_count_24h_tag); out.Varint((uint64_t)value); }
+    template <typename T> void trades_count_24h(ProtoWriter&, T) = delete; // int64 only
+
+    // int64 trades_count_48h = 41;
+    constexpr int trades_count_48h_field = 41;
+    constexpr int trades_count_48h_wire_type = 0;
+    constexpr ProtoTag trades_count_48h_tag = { { 0xC8, 0x02, 0x00 }, 2 };
+    inline void trades_count_48h(ProtoWriter& out, int64_t value) { out.Tag(trades_count_48h_tag); out.Varint((uint64_t)value); }
+    template <typename T> void trades_count_48h(ProtoWriter&, T) = delete; // int64 only
+
+    // int64 trades_count_72h = 42;
+    constexpr int trades_count_72h_field = 42;
+    constexpr int trades_count_72h_wire_type = 0;
+    constexpr ProtoTag trades_count_72h_tag = { { 0xD0, 0x02, 0x00 }, 2 };
+    inline void trades_count_72h(ProtoWriter& out, int64_t value) { out.Tag(trades_count_72h_tag); out.Varint((uint64_t)value); }
+    template <typename T> void trades_count_72h(ProtoWriter&, T) = delete; // int64 only
+
+    // float avg_profit_24h = 43;
+    constexpr int avg_profit_24h_field = 43;
+    constexpr int avg_profit_24h_wire_type = 5;
+    constexpr ProtoTag avg_profit_24h_tag = { { 0xDD, 0x02, 0x00 }, 2 };
+    inline void avg_profit_24h(ProtoWriter& out, float value) { out.Tag(avg_profit_24h_tag); out.Fixed32(value); }
+    template <typename T> void avg_profit_24h(ProtoWriter&, T) = delete; // float only
+
+    // float avg_profit_48h = 44;
+    constexpr int avg_profit_48h_field = 44;
+    constexpr int avg_profit_48h_wire_type = 5;
+    constexpr ProtoTag avg_profit_48h_tag = { { 0xE5, 0x02, 0x00 }, 2 };
+    inline void avg_profit_48h(ProtoWriter& out, float value) { out.Tag(avg_profit_48h_tag); out.Fixed32(value); }
+    template <typename T> void avg_profit_48h(ProtoWriter&, T) = delete; // float only
+
+    // float avg_profit_72h = 45;
+    constexpr int avg_profit_72h_field = 45;
+    constexpr int avg_profit_72h_wire_type = 5;
+    constexpr ProtoTag avg_profit_72h_tag = { { 0xED, 0x02, 0x00 }, 2 };
+    inline void avg_profit_72h(ProtoWriter& out, float value) { out.Tag(avg_profit_72h_tag); out.Fixed32(value); }
+    template <typename T> void avg_profit_72h(ProtoWriter&, T) = delete; // float only
+
+    // string symbol = 46;
+    constexpr int symbol_field = 46;
+    constexpr int symbol_wire_type = 2;
+    constexpr ProtoTag symbol_tag = { { 0xF2, 0x02, 0x00 }, 2 };
+    inline void symbol(ProtoWriter& out, const char* data, size_t length) { out.Tag(symbol_tag); out.LengthDelimited(data, length); }
+    inline void symbol(ProtoWriter& out, const char* text) { symbol(out, text, strlen(text)); }
+
+    // string inst_group = 47;
+    constexpr int inst_group_field = 47;
+    constexpr int inst_group_wire_type = 2;
+    constexpr ProtoTag inst_group_tag = { { 0xFA, 0x02, 0x00 }, 2 };
+    inline void inst_group(ProtoWriter& out, const char* data, size_t length) { out.Tag(inst_group_tag); out.LengthDelimited(data, length); }
+    inline void inst_group(ProtoWriter& out, const char* text) { inst_group(out, text, strlen(text)); }
+
+    // string frequency = 48;
+    constexpr int frequency_field = 48;
+    constexpr int frequency_wire_type = 2;
+    constexpr ProtoTag frequency_tag = { { 0x82, 0x03, 0x00 }, 2 };
+    inline void frequency(ProtoWriter& out, const char* data, size_t length) { out.Tag(frequency_tag); out.LengthDelimited(data, length); }
+    inline void frequency(ProtoWriter& out, const char* text) { frequency(out, text, strlen(text)); }
+
+    // string trading_group = 49;
+    constexpr int trading_group_field = 49;
+    constexpr int trading_group_wire_type = 2;
+    constexpr ProtoTag trading_group_tag = { { 0x8A, 0x03, 0x00 }, 2 };
+    inline void trading_group(ProtoWriter& out, const char* data, size_t length) { out.Tag(trading_group_tag); out.LengthDelimited(data, length); }
+    inline void trading_group(ProtoWriter& out, const char* text) { trading_group(out, text, strlen(text)); }
+
+    // string licence = 50;
+    constexpr int licence_field = 50;
+    constexpr int licence_wire_type = 2;
+    constexpr ProtoTag licence_tag = { { 0x92, 0x03, 0x00 }, 2 };
+    inline void licence(ProtoWriter& out, const char* data, size_t length) { out.Tag(licence_tag); out.LengthDelimited(data, length); }
+    inline void licence(ProtoWriter& out, const char* text) { licence(out, text, strlen(text)); }
+
+    // string platform = 51;
+    constexpr int platform_field = 51;
+    constexpr int platform_wire_type = 2;
+    constexpr ProtoTag platform_tag = { { 0x9A, 0x03, 0x00 }, 2 };
+    inline void platform(ProtoWriter& out, const char* data, size_t length) { out.Tag(platform_tag); out.LengthDelimited(data, length); }
+    inline void platform(ProtoWriter& out, const char* text) { platform(out, text, strlen(text)); }
+
+    // string LEVEL_OF_EDUCATION = 52;
+    constexpr int LEVEL_OF_EDUCATION_field = 52;
+    constexpr int LEVEL_OF_EDUCATION_wire_type = 2;
+    constexpr ProtoTag LEVEL_OF_EDUCATION_tag = { { 0xA2, 0x03, 0x00 }, 2 };
+    inline void LEVEL_OF_EDUCATION(ProtoWriter& out, const char* data, size_t length) { out.Tag(LEVEL_OF_EDUCATION_tag); out.LengthDelimited(data, length); }
+    inline void LEVEL_OF_EDUCATION(ProtoWriter& out, const char* text) { LEVEL_OF_EDUCATION(out, text, strlen(text)); }
+
+    // string OCCUPATION = 53;
+    constexpr int OCCUPATION_field = 53;
+    constexpr int OCCUPATION_wire_type = 2;
+    constexpr ProtoTag OCCUPATION_tag = { { 0xAA, 0x03, 0x00 }, 2 };
+    inline void OCCUPATION(ProtoWriter& out, const char* data, size_t length) { out.Tag(OCCUPATION_tag); out.LengthDelimited(data, length); }
+    inline void OCCUPATION(ProtoWriter& out, const char* text) { OCCUPATION(out, text, strlen(text)); }
+
+    // string SOURCE_OF_WEALTH = 54;
+    constexpr int SOURCE_OF_WEALTH_field = 54;
+    constexpr int SOURCE_OF_WEALTH_wire_type = 2;
+    constexpr ProtoTag SOURCE_OF_WEALTH_tag = { { 0xB2, 0x03, 0x00 }, 2 };
+    inline void SOURCE_OF_WEALTH(ProtoWriter& out, const char* data, size_t length) { out.Tag(SOURCE_OF_WEALTH_tag); out.LengthDelimited(data, length); }
+    inline void SOURCE_OF_WEALTH(ProtoWriter& out, const char* text) { SOURCE_OF_WEALTH(out, text, strlen(text)); }
+
+    // string ANNUAL_DISPOSABLE_INCOME = 55;
+    constexpr int ANNUAL_DISPOSABLE_INCOME_field = 55;
+    constexpr int ANNUAL_DISPOSABLE_INCOME_wire_type = 2;
+    constexpr ProtoTag ANNUAL_DISPOSABLE_INCOME_tag = { { 0xBA, 0x03, 0x00 }, 2 };
+    inline void ANNUAL_DISPOSABLE_INCOME(ProtoWriter& out, const char* data, size_t length) { out.Tag(ANNUAL_DISPOSABLE_INCOME_tag); out.LengthDelimited(data, length); }
+    inline void ANNUAL_DISPOSABLE_INCOME(ProtoWriter& out, const char* text) { ANNUAL_DISPOSABLE_INCOME(out, text, strlen(text)); }
+
+    // string AVERAGE_FREQUENCY_OF_TRADES = 56;
+    constexpr int AVERAGE_FREQUENCY_OF_TRADES_field = 56;
+    constexpr int AVERAGE_FREQUENCY_OF_TRADES_wire_type = 2;
+    constexpr ProtoTag AVERAGE_FREQUENCY_OF_TRADES_tag = { { 0xC2, 0x03, 0x00 }, 2 };
+    inline void AVERAGE_FREQUENCY_OF_TRADES(ProtoWriter& out, const char* data, size_t length) { out.Tag(AVERAGE_FREQUENCY_OF_TRADES_tag); out.LengthDelimited(data, length); }
+    inline void AVERAGE_FREQUENCY_OF_TRADES(ProtoWriter& out, const char* text) { AVERAGE_FREQUENCY_OF_TRADES(out, text, strlen(text)); }
+
+    // string EMPLOYMENT_STATUS = 57;
+    constexpr int EMPLOYMENT_STATUS_field = 57;
+    constexpr int EMPLOYMENT_STATUS_wire_type = 2;
+    constexpr ProtoTag EMPLOYMENT_STATUS_tag = { { 0xCA, 0x03, 0x00 }, 2 };
+    inline void EMPLOYMENT_STATUS(ProtoWriter& out, const char* data, size_t length) { out.Tag(EMPLOYMENT_STATUS_tag); out.LengthDelimited(data, length); }
+    inline void EMPLOYMENT_STATUS(ProtoWriter& out, const char* text) { EMPLOYMENT_STATUS(out, text, strlen(text)); }
+
+    // string country_code = 58;
+    constexpr int country_code_field = 58;
+    constexpr int country_code_wire_type = 2;
+    constexpr ProtoTag country_code_tag = { { 0xD2, 0x03, 0x00 }, 2 };
+    inline void country_code(ProtoWriter& out, const char* data, size_t length) { out.Tag(country_code_tag); out.LengthDelimited(data, length); }
+    inline void country_code(ProtoWriter& out, const char* text) { country_code(out, text, strlen(text)); }
+
+    // string utm_medium = 59;
+    constexpr int utm_medium_field = 59;
+    constexpr int utm_medium_wire_type = 2;
+    constexpr ProtoTag utm_medium_tag = { { 0xDA, 0x03, 0x00 }, 2 };
+    inline void utm_medium(ProtoWriter& out, const char* data, size_t length) { out.Tag(utm_medium_tag); out.LengthDelimited(data, length); }
+    inline void utm_medium(ProtoWriter& out, const char* text) { utm_medium(out, text, strlen(text)); }
+
+    // string user_id = 60;
+    constexpr int user_id_field = 60;
+    constexpr int user_id_wire_type = 2;
+    constexpr ProtoTag user_id_tag = { { 0xE2, 0x03, 0x00 }, 2 };
+    inline void user_id(ProtoWriter& out, const char* data, size_t length) { out.Tag(user_id_tag); out.LengthDelimited(data, length); }
+    inline void user_id(ProtoWriter& out, const char* text) { user_id(out, text, strlen(text)); }
+
+} // namespace ScoringRequest
+
+namespace ScoringResponse {
+
+    // float score = 1;
+    constexpr int score_field = 1;
+    constexpr int score_wire_type = 5;
+    constexpr ProtoTag score_tag = { { 0x0D, 0x00, 0x00 }, 1 };
+    inline void score(ProtoWriter& out, float value) { out.Tag(score_tag); out.Fixed32(value); }
+    template <typename T> void score(ProtoWriter&, T) = delete; // float only
+
+    // repeated string warnings = 2;
+    constexpr int warnings_field = 2;
+    constexpr int warnings_wire_type = 2;
+    constexpr ProtoTag warnings_tag = { { 0x12, 0x00, 0x00 }, 1 };
+    inline void warnings(ProtoWriter& out, const char* data, size_t length) { out.Tag(warnings_tag); out.LengthDelimited(data, length); }
+    inline void warnings(ProtoWriter& out, const char* text) { warnings(out, text, strlen(text)); }
+
+} // namespace ScoringResponse
+
+namespace ScoringBatchRequest {
+
+    // repeated ScoringRequest requests = 1;
+    constexpr int requests_field = 1;
+    constexpr int requests_wire_type = 2;
+    constexpr ProtoTag requests_tag = { { 0x0A, 0x00, 0x00 }, 1 };
+    inline size_t begin_requests(ProtoWriter& out) { out.Tag(requests_tag); return out.BeginLength(); }
+    inline void end_requests(ProtoWriter& out, size_t mark) { out.EndMessage(mark); }
+
+} // namespace ScoringBatchRequest
+
+namespace ScoringBatchResponse {
+
+    // repeated ScoringResponse responses = 1;
+    constexpr int responses_field = 1;
+    constexpr int responses_wire_type = 2;
+    constexpr ProtoTag responses_tag = { { 0x0A, 0x00, 0x00 }, 1 };
+    inline size_t begin_responses(ProtoWriter& out) { out.Tag(responses_tag); return out.BeginLength(); }
+    inline void end_responses(ProtoWriter& out, size_t mark) { out.EndMessage(mark); }
+
+} // namespace ScoringBatchResponse
+
+} // namespace scoring
@@ -0,0 +1,189 @@
+//+------------------------------------------------------------------+
+//| Logger Benchmark - Synchronous PluginLogger vs Async Ring      |
+//| 8 producer threads logging trade-path sized messages           |
+//+------------------------------------------------------------------+
+//
+// Usage: bench_async_logger [messages_per_thread] [threads]
+//
+// The legacy logger (mutex + localtime_s + open/append/close per call) is
+// run with a tenth of the messages - it is orders of magnitude slower.
+// Console output is off for both so only the file path is measured.
+//
+// Two async runs: a flood (producers log back to back, far faster than any
+// file can absorb, so the ring fills and drops) and trade bursts (50 lines
+// per trade, as MtSrvTradeTransaction logs, then a 1 ms pause). Every async
+// message must reach the file or be counted as dropped; drops under trade
+// bursts mean the ring is too small for this machine and are flagged.
+
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+#include "ABBook_PluginLogger.h"
+
+typedef std::chrono::steady_clock Clock;
+
+//+------------------------------------------------------------------+
+//| PluginLogger::Log as it was before the async ring               |
+//+------------------------------------------------------------------+
+
+class LegacyLogger {
+private:
+    std::mutex log_mutex;
+    std::string path;
+
+public:
+    explicit LegacyLogger(const std::string& log_path) : path(log_path) {}
+
+    void Log(const std::string& message) {
+        std::lock_guard<std::mutex> lock(log_mutex);
+
+        time_t rawtime;
+        struct tm timeinfo;
+        char timestamp[64];
+        time(&rawtime);
+#ifdef _WIN32
+        localtime_s(&timeinfo, &rawtime);
+#else
+        localtime_r(&rawtime, &timeinfo);
+#endif
+        strftime(timestamp, sizeof(timestamp), "%Y-%m-%d %H:%M:%S", &timeinfo);
+
+        std::ofstream logfile(path, std::ios::app);
+        if (logfile.is_open()) {
+            logfile << "[" << timestamp << "] " << message << std::endl;
+            logfile.close();
+        }
+    }
+};
+
+struct RunResult {
+    double wall_ms;
+    double mean_ns;
+    double p50_ns;
+    double p99_ns;
+    double max_ns;
+};
+
+static const int LINES_PER_TRADE = 50;
+
+// Each producer logs `messages` lines and records the cost of every call.
+// With bursts, it pauses 1 ms after every LINES_PER_TRADE lines (not timed).
+template <typename Logger>
+static RunResult Run(Logger& logger, int threads, int messages, bool bursts = false) {
+    std::vector<std::vector<double>> samples(threads);
+    std::atomic<int> ready(0);
+    std::atomic<bool> go(false);
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < threads; t++) {
+        producers.emplace_back([&, t]() {
+            std::vector<double>& mine = samples[t];
+            mine.reserve(messages);
+            // Pre-built messages: the benchmark measures Log(), not string building
+            const std::string message = "CHECKPOINT 10: Received REAL ML score: 0.083412 (thread " + std::to_string(t) + ")";
+            ready++;
+            while (!go.load()) {}
+            for (int i = 0; i < messages; i++) {
+                Clock::time_point start = Clock::now();
+                logger.Log(message);
+                mine.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count());
+                if (bursts && (i + 1) % LINES_PER_TRADE == 0) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            }
+        });
+    }
+    while (ready.load() < threads) {}
+    Clock::time_point start = Clock::now();
+    go = true;
+    for (auto& producer : producers) producer.join();
+    double wall_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    std::vector<double> all;
+    for (auto& s : samples) all.insert(all.end(), s.begin(), s.end());
+    std::sort(all.begin(), all.end());
+    double sum = 0;
+    for (double v : all) sum += v;
+
+    RunResult result;
+    result.wall_ms = wall_ms;
+    result.mean_ns = sum / all.size();
+    result.p50_ns = all[all.size() / 2];
+    result.p99_ns = all[(size_t)(all.size() * 0.99)];
+    result.max_ns = all.back();
+    return result;
+}
+
+static void Print(const char* name, const RunResult& r, int total) {
+    std::cout << std::left << std::setw(22) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << r.mean_ns << std::setw(10) << r.p50_ns << std::setw(12) << r.p99_ns
+              << std::setw(14) << r.max_ns << std::setw(12) << r.wall_ms
+              << std::setw(14) << (total / (r.wall_ms / 1000.0)) << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int messages = argc > 1 ? atoi(argv[1]) : 100000;
+    int threads = argc > 2 ? atoi(argv[2]) : 8;
+    const char* legacy_path = "bench_logger_legacy.log";
+    const char* async_path = "bench_logger_async.log";
+    remove(legacy_path);
+    remove(async_path);
+
+    std::cout << "=== LOGGER BENCHMARK (" << threads << " producer threads) ===" << std::endl;
+    std::cout << std::left << std::setw(22) << "Logger" << std::right << std::setw(10) << "mean ns" << std::setw(10) << "p50 ns"
+              << std::setw(12) << "p99 ns" << std::setw(14) << "max ns" << std::setw(12) << "wall ms"
+              << std::setw(14) << "msgs/s" << std::endl;
+
+    int legacy_messages = std::max(1, messages / 10);
+    LegacyLogger legacy(legacy_path);
+    RunResult legacy_result = Run(legacy, threads, legacy_messages);
+    Print("legacy (sync)", legacy_result, legacy_messages * threads);
+
+    // Async: flood, then trade bursts, each into a fresh file
+    bool ok = true;
+    for (int pass = 0; pass < 2; pass++) {
+        bool bursts = pass == 1;
+        int count = bursts ? std::max(LINES_PER_TRADE, messages / 10 / LINES_PER_TRADE * LINES_PER_TRADE) : messages;
+        remove(async_path);
+
+        PluginLogger logger(true, async_path, false);
+        logger.Start();
+        RunResult result = Run(logger, threads, count, bursts);
+        logger.Stop();
+        Print(bursts ? "async (trade bursts)" : "async (flood)", result, count * threads);
+
+        size_t expected = (size_t)count * threads;
+        unsigned long long dropped = logger.Dropped();
+        size_t written = 0;
+        std::ifstream file(async_path);
+        std::string line;
+        while (std::getline(file, line)) {
+            if (line.find("LOGGER:") == std::string::npos) written++;
+        }
+        bool complete = written + dropped == expected;
+        std::cout << "    " << expected << " logged, " << written << " written, " << dropped << " dropped - "
+                  << (complete ? "PASS" : "FAIL") << std::endl;
+        if (bursts && dropped > 0) {
+            std::cout << "    WARNING: the writer fell behind trade-rate logging - consider a larger RING_RECORDS" << std::endl;
+        }
+        if (bursts) {
+            std::cout << "    Mean per-call speedup vs legacy: " << std::setprecision(0)
+                      << (legacy_result.mean_ns / result.mean_ns) << "x" << std::endl;
+        }
+        ok = ok && complete;
+    }
+
+    std::cout << std::endl << (ok ? "ALL CHECKS PASSED" : "CHECKS FAILED") << std::endl;
+    remove(legacy_path);
+    remove(async_path);
+    return ok ? 0 : 1;
+}
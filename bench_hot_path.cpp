@@ -0,0 +1,626 @@
+//+------------------------------------------------------------------+
+//| Hot Path Benchmark Suite - every stage of a routing decision   |
+//| Machine-readable results, compared against a stored baseline   |
+//+------------------------------------------------------------------+
+//
+// Usage: bench_hot_path [--filter TEXT] [--scale X] [--reps N] [--json out.json]
+//                       [--baseline base.json] [--tolerance PCT]
+//
+//   symbol_clean       CleanSymbolUtf8 on raw MT4 symbols (prefix garbage, suffixes)
+//   group_classify     instrument group of a cleaned symbol (first sight of a symbol)
+//   symbol_lookup      SymbolRegistry::Lookup of a known symbol (every trade)
+//   threshold_lookup   Lookup plus the group's threshold and latency budget
+//   encode_minimal     the ScoringRequest the plugin sends (CVMClient, SendAccountFields=false)
+//   encode_account     ... with the account fields replayed from the template cache
+//   encode_full60      all 60 fields of scoring.proto (ProtoWriter)
+//   decode_response    DecodeScoringResponse of a score plus one warning
+//   log_emit           PluginLogger::Log of a decision line (async ring, writer running)
+//   decision_cached    TradeRouter::TradeTransaction, score from the score cache
+//   decision_scored    TradeRouter::TradeTransaction, scored by an in-process mock
+//                      service over loopback (cache off)
+//
+// Every benchmark runs --reps timed repetitions after a warm-up and reports
+// the median and the fastest repetition. --scale multiplies the iteration
+// counts (0.1 for a quick run).
+//
+// --json writes the results; --baseline reads such a file and compares the
+// fastest repetitions, which vary much less between runs than the medians.
+// A benchmark more than --tolerance percent (default 10) slower than the
+// baseline is run again and counts as a regression only if it is still that
+// slow. The exit code is 1 if any benchmark regressed, so a CI job can keep
+// a baseline per build box and fail on regressions. Compare like with like:
+// same machine, compiler and build type.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "ABBook_TradeRouter.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static volatile uint64_t sink = 0;       // Keeps results observable so the work is not optimised away
+
+//+------------------------------------------------------------------+
+//| Harness                                                         |
+//+------------------------------------------------------------------+
+
+struct BenchResult {
+    std::string name;
+    double ns_per_op;                // Median repetition
+    double min_ns_per_op;            // Fastest repetition
+    long long iterations;            // Per repetition
+    int repetitions;
+};
+
+struct BenchOptions {
+    std::string filter;
+    double scale = 1.0;
+    int repetitions = 7;
+    std::string json_path;
+    std::string baseline_path;
+    double tolerance_pct = 10.0;
+};
+
+// `body` runs n operations and returns the nanoseconds they took, so it can
+// leave set-up or draining between operations out of the timing
+static BenchResult MeasureTimed(const std::string& name, long long iterations, int repetitions,
+                                const std::function<double(long long)>& body) {
+    if (iterations < 1) iterations = 1;
+    body(iterations / 10 + 1);       // Warm-up: caches, branch predictors, lazily created state
+
+    std::vector<double> samples;
+    for (int r = 0; r < repetitions; r++) samples.push_back(body(iterations) / (double)iterations);
+    std::sort(samples.begin(), samples.end());
+
+    BenchResult result;
+    result.name = name;
+    result.ns_per_op = samples[samples.size() / 2];
+    result.min_ns_per_op = samples.front();
+    result.iterations = iterations;
+    result.repetitions = repetitions;
+    return result;
+}
+
+static BenchResult Measure(const std::string& name, long long iterations, int repetitions, const std::function<void(long long)>& body) {
+    return MeasureTimed(name, iterations, repetitions, [&body](long long n) {
+        auto start = Clock::now();
+        body(n);
+        return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    });
+}
+
+static std::string BuildDescription() {
+    std::string build;
+#if defined(_MSC_VER)
+    build = "msvc " + std::to_string(_MSC_VER);
+#elif defined(__clang__)
+    build = std::string("clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    build = std::string("gcc ") + __VERSION__;
+#endif
+    build += sizeof(void*) == 8 ? " 64-bit" : " 32-bit";
+#ifdef NDEBUG
+    build += " NDEBUG";
+#endif
+    return build;
+}
+
+static std::string JsonEscape(const std::string& text) {
+    std::string out;
+    for (char c : text) {
+        if (c == '"' || c == '\\') out += '\\';
+        if ((unsigned char)c >= 0x20) out += c;
+    }
+    return out;
+}
+
+static bool WriteJson(const std::string& path, const std::vector<BenchResult>& results) {
+    std::ofstream out(path.c_str());
+    if (!out) return false;
+    char number[64];
+    out << "{\n  \"suite\": \"bench_hot_path\",\n  \"format\": 1,\n";
+    out << "  \"timestamp\": " << (long long)time(nullptr) << ",\n";
+    out << "  \"build\": \"" << JsonEscape(BuildDescription()) << "\",\n";
+    out << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        out << "    { \"name\": \"" << r.name << "\"";
+        snprintf(number, sizeof(number), "%.3f", r.ns_per_op);
+        out << ", \"ns_per_op\": " << number;
+        snprintf(number, sizeof(number), "%.3f", r.min_ns_per_op);
+        out << ", \"min_ns_per_op\": " << number;
+        snprintf(number, sizeof(number), "%.0f", r.ns_per_op > 0 ? 1e9 / r.ns_per_op : 0.0);
+        out << ", \"ops_per_sec\": " << number;
+        out << ", \"iterations\": " << r.iterations << ", \"repetitions\": " << r.repetitions << " }";
+        out << (i + 1 < results.size() ? ",\n" : "\n");
+    }
+    out << "  ]\n}\n";
+    return (bool)out;
+}
+
+struct BaselineEntry {
+    std::string name;
+    double ns_per_op;
+    double min_ns_per_op;            // ns_per_op for baselines written without it
+};
+
+// Reads back what WriteJson wrote: name, ns_per_op and min_ns_per_op of every
+// result, plus "build". Not a general JSON parser.
+static bool ReadBaseline(const std::string& path, std::vector<BaselineEntry>& baseline, std::string& build) {
+    std::ifstream in(path.c_str());
+    if (!in) return false;
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    std::string text = buffer.str();
+
+    auto string_after = [&text](const std::string& key, size_t from, size_t& end) -> std::string {
+        size_t at = text.find("\"" + key + "\"", from);
+        if (at == std::string::npos) return end = std::string::npos, std::string();
+        size_t open = text.find('"', text.find(':', at) + 1);
+        size_t close = text.find('"', open + 1);
+        end = close;
+        return text.substr(open + 1, close - open - 1);
+    };
+    // Number after "key" within [from, limit), or -1
+    auto number_after = [&text](const char* key, size_t from, size_t limit) -> double {
+        size_t at = text.find(key, from);
+        if (at == std::string::npos || at >= limit) return -1.0;
+        return atof(text.c_str() + text.find(':', at) + 1);
+    };
+
+    size_t pos = 0;
+    build = string_after("build", 0, pos);
+    pos = 0;
+    for (;;) {
+        size_t end;
+        std::string name = string_after("name", pos, end);
+        if (end == std::string::npos) break;
+        size_t limit = text.find('}', end);
+        if (limit == std::string::npos) break;
+        BaselineEntry entry;
+        entry.name = name;
+        entry.ns_per_op = number_after("\"ns_per_op\"", end, limit);
+        entry.min_ns_per_op = number_after("\"min_ns_per_op\"", end, limit);
+        if (entry.min_ns_per_op <= 0.0) entry.min_ns_per_op = entry.ns_per_op;
+        if (entry.ns_per_op > 0.0) baseline.push_back(entry);
+        pos = limit;
+    }
+    return !baseline.empty();
+}
+
+//+------------------------------------------------------------------+
+//| Inputs                                                          |
+//+------------------------------------------------------------------+
+
+// Raw MT4 symbols as the server passes them: char[12], suffixes, garbage prefixes
+static const char raw_symbols[8][12] = {
+    "EURUSD", "GBPJPY.m", "\xC2\xA0" "XAUUSD", "BTCUSD#", "US30.cash", "xx" "AUDCAD", "USOIL", "NZDUSD.r"
+};
+
+static TradeRecord MakeTrade(int order, int login, const char* symbol) {
+    TradeRecord trade;
+    memset(&trade, 0, sizeof(trade));
+    trade.order = order;
+    trade.login = login;
+    strncpy(trade.symbol, symbol, sizeof(trade.symbol));
+    trade.digits = 5;
+    trade.cmd = OP_BUY;
+    trade.volume = 100;
+    trade.open_price = 1.08765;
+    trade.sl = 1.08;
+    trade.tp = 1.095;
+    trade.state = ORDER_OPENED;
+    return trade;
+}
+
+static UserInfo MakeUser(int login) {
+    UserInfo user;
+    memset(&user, 0, sizeof(user));
+    user.login = login;
+    strcpy(user.group, "real\\standard");
+    user.balance = 10000.0;
+    user.leverage = 100;
+    return user;
+}
+
+// Float and int64 fields of ScoringRequest 6-45 (true = float), as in bench_proto_encoder
+static const bool float_fields[46] = {
+    false, true, true, true, false, true,
+    false, true, true, false, true, true, false, false, true,
+    false, false, false, false, true, false, true, false, false,
+    false, true, true, true, true, true, true, false, false,
+    true, true, true, true, true, true, true, false, false,
+    false, true, true, true
+};
+
+static const char* const string_fields[15] = {
+    "NZDUSD", "FXMajors", "medium", "retail\\standard", "CY", "MT4", "bachelor", "engineer",
+    "salary", "50k-100k", "weekly", "employed", "CY", "cpc", "16813"
+};
+
+static void EncodeFull60(const TradeRecord& trade, ProtoWriter& out) {
+    out.Clear();
+    size_t mark = out.BeginFrame();
+    out.Float(1, (float)trade.open_price);
+    out.Float(2, (float)trade.sl);
+    out.Float(3, (float)trade.tp);
+    out.Int64(4, trade.cmd);
+    out.Float(5, (float)(trade.volume / 100.0));
+    for (int field = 6; field <= 45; field++) {
+        if (float_fields[field]) out.Float(field, 10000.0f / field);
+        else out.Int64(field, field * 37);
+    }
+    for (int field = 46; field <= 60; field++) out.String(field, string_fields[field - 46]);
+    out.EndFrame(mark);
+}
+
+//+------------------------------------------------------------------+
+//| In-process scoring service for the decision path               |
+//+------------------------------------------------------------------+
+
+// Answers every direct-mode frame with ScoringResponse { score: 0.05 }
+class LoopbackScorer {
+private:
+    SOCKET listener;
+    int port;
+    std::atomic<bool> running;
+    std::thread acceptor;
+    std::vector<std::thread> workers;
+
+    static bool ReadExact(SOCKET sock, char* data, size_t length) {
+        while (length > 0) {
+            int received = recv(sock, data, (int)length, 0);
+            if (received <= 0) return false;
+            data += received;
+            length -= (size_t)received;
+        }
+        return true;
+    }
+
+    void Serve(SOCKET sock) {
+        std::vector<char> request;
+        char response[9] = { 0, 0, 0, 5, 0x0D };
+        float score = 0.05f;
+        memcpy(response + 5, &score, 4);
+        for (;;) {
+            unsigned char header[4];
+            if (!ReadExact(sock, (char*)header, 4)) break;
+            uint32_t length = ((uint32_t)header[0] << 24) | ((uint32_t)header[1] << 16) | ((uint32_t)header[2] << 8) | header[3];
+            request.resize(length);
+            if (length && !ReadExact(sock, request.data(), length)) break;
+            if (send(sock, response, sizeof(response), MSG_NOSIGNAL) != (int)sizeof(response)) break;
+        }
+        closesocket(sock);
+    }
+
+public:
+    LoopbackScorer() : listener(INVALID_SOCKET), port(0), running(false) {}
+
+    ~LoopbackScorer() { Stop(); }
+
+    bool Start() {
+        listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        socklen_t address_length = sizeof(address);
+        if (listener == INVALID_SOCKET || bind(listener, (sockaddr*)&address, sizeof(address)) != 0 ||
+            listen(listener, 16) != 0 || getsockname(listener, (sockaddr*)&address, &address_length) != 0) {
+            return false;
+        }
+        port = ntohs(address.sin_port);
+        running = true;
+        acceptor = std::thread([this]() {
+            while (running) {
+                SOCKET sock = accept(listener, nullptr, nullptr);
+                if (sock == INVALID_SOCKET) break;
+                if (!running) {
+                    closesocket(sock);
+                    break;
+                }
+                int nodelay = 1;
+                setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, (const char*)&nodelay, sizeof(nodelay));
+                workers.emplace_back([this, sock]() { Serve(sock); });
+            }
+        });
+        return true;
+    }
+
+    // Callers disconnect first (TradeRouter::Cleanup), so the workers see EOF
+    void Stop() {
+        if (!running.exchange(false)) return;
+        SOCKET wake = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons((unsigned short)port);
+        connect(wake, (sockaddr*)&address, sizeof(address));
+        closesocket(wake);
+        acceptor.join();
+        closesocket(listener);
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    int Port() const { return port; }
+};
+
+static const char* BENCH_CONFIG = "bench_hot_path.ini";
+static const char* BENCH_LOG = "bench_hot_path.log";
+static const char* BENCH_JOURNAL = "bench_hot_path_journal";
+
+static void WriteRouterConfig(int port, bool cache) {
+    std::ofstream ini(BENCH_CONFIG);
+    ini << "[CVM_Connection]\nCVM_IP=127.0.0.1\nCVM_Port=" << port << "\nConnectionPoolSize=2\n"
+        << "[Score_Cache]\nEnableCache=" << (cache ? "true" : "false") << "\nCacheTTL=600000\n"
+        << "[Decision_Journal]\nEnableJournal=true\nJournalPath=" << BENCH_JOURNAL << "\nJournalRecords=1048576\n"
+        << "[Latency_Stats]\nReportIntervalSec=0\n"
+        << "[Latency_Budget]\nBudget_FXMajors=1000\n";
+}
+
+static void RemoveRouterFiles() {
+    remove(BENCH_CONFIG);
+    remove(BENCH_LOG);
+    time_t seconds = time(nullptr);
+    struct tm utc;
+#ifdef _WIN32
+    gmtime_s(&utc, &seconds);
+#else
+    gmtime_r(&seconds, &utc);
+#endif
+    char date[16];
+    strftime(date, sizeof(date), "%Y%m%d", &utc);
+    for (int n = 0; n < 20; n++) {
+        remove((std::string(BENCH_JOURNAL) + "_" + date + "_" + std::to_string(n) + ".abj").c_str());
+    }
+}
+
+// Runs `iterations` trades through a router started against the loopback scorer
+static BenchResult MeasureDecision(const std::string& name, long long iterations, int repetitions, bool cache) {
+    LoopbackScorer scorer;
+    if (!scorer.Start()) {
+        std::cerr << name << ": cannot listen on loopback" << std::endl;
+        return BenchResult{ name, 0.0, 0.0, 0, 0 };
+    }
+    WriteRouterConfig(scorer.Port(), cache);
+    BenchResult result;
+    {
+        TradeRouter router(BENCH_LOG, false);        // Not new: alignas(64) members, which C++14 new ignores
+        router.Startup(BENCH_CONFIG);
+        int order = 1;
+        result = Measure(name, iterations, repetitions, [&](long long n) {
+            UserInfo user = MakeUser(16813);
+            for (long long i = 0; i < n; i++) {
+                TradeRecord trade = MakeTrade(order++, 16813, "EURUSD");
+                sink += (uint64_t)router.TradeTransaction(&trade, &user);
+            }
+        });
+        router.Cleanup();
+    }
+    scorer.Stop();
+    RemoveRouterFiles();
+    return result;
+}
+
+//+------------------------------------------------------------------+
+//| Suite                                                           |
+//+------------------------------------------------------------------+
+
+static int Usage() {
+    std::cerr << "Usage: bench_hot_path [--filter TEXT] [--scale X] [--reps N] [--json out.json]\n"
+                 "                      [--baseline base.json] [--tolerance PCT]" << std::endl;
+    return 2;
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) return Usage();
+        const char* value = argv[++i];
+        if (arg == "--filter") options.filter = value;
+        else if (arg == "--scale") options.scale = atof(value);
+        else if (arg == "--reps") options.repetitions = atoi(value);
+        else if (arg == "--json") options.json_path = value;
+        else if (arg == "--baseline") options.baseline_path = value;
+        else if (arg == "--tolerance") options.tolerance_pct = atof(value);
+        else return Usage();
+    }
+    if (options.scale <= 0.0 || options.repetitions < 1 || options.tolerance_pct < 0.0) return Usage();
+
+    std::vector<BaselineEntry> baseline;
+    std::string baseline_build;
+    if (!options.baseline_path.empty() && !ReadBaseline(options.baseline_path, baseline, baseline_build)) {
+        std::cerr << "Cannot read baseline " << options.baseline_path << std::endl;
+        return 2;
+    }
+
+    WSADATA wsa;
+    WSAStartup(MAKEWORD(2, 2), &wsa);
+
+    PluginConfig config;
+    PluginLogger logger(true, BENCH_LOG, false);
+    ScoringConnectionPool pool(&config, &logger);
+    MultiplexedScoringChannel channel(&logger, &pool);
+    CVMClient client(&config, &logger, &pool, &channel);
+    SymbolRegistry registry;
+    registry.Configure(config);
+
+    // Registered rather than run in place, so a suspected regression can be measured again
+    std::vector<std::pair<std::string, std::function<BenchResult()>>> suite;
+    auto add = [&](const char* name, long long iterations, const std::function<void(long long)>& body) {
+        suite.push_back(std::make_pair(std::string(name), [&options, name, iterations, body]() {
+            return Measure(name, (long long)(iterations * options.scale), options.repetitions, body);
+        }));
+    };
+
+    add("symbol_clean", 2000000, [&](long long n) {
+        char clean[13];
+        for (long long i = 0; i < n; i++) {
+            const char* raw = raw_symbols[i & 7];
+            sink += CleanSymbolUtf8(raw, strnlen(raw, 12), clean);
+        }
+    });
+
+    static const char* const cleaned[8] = { "EURUSD", "GBPJPY", "XAUUSD", "BTCUSD", "US30", "AUDCAD", "USOIL", "NZDUSD" };
+    add("group_classify", 2000000, [&](long long n) {
+        for (long long i = 0; i < n; i++) sink += (uint64_t)(uintptr_t)registry.Classify(cleaned[i & 7]);
+    });
+
+    add("symbol_lookup", 5000000, [&](long long n) {
+        for (long long i = 0; i < n; i++) sink += registry.Lookup(raw_symbols[i & 7]).id;
+    });
+
+    add("threshold_lookup", 5000000, [&](long long n) {
+        for (long long i = 0; i < n; i++) {
+            const SymbolInfo& symbol = registry.Lookup(raw_symbols[i & 7]);
+            sink += (uint64_t)(symbol.group->threshold * 1000.0) + (uint64_t)symbol.group->budget_ms;
+        }
+    });
+
+    char buffer[1024];
+    ProtoWriter frame(buffer, sizeof(buffer));
+    TradeRecord trade = MakeTrade(1, 16813, "NZDUSD");
+    UserInfo user = MakeUser(16813);
+    const SymbolInfo& nzdusd = registry.Lookup(trade.symbol);
+
+    add("encode_minimal", 2000000, [&](long long n) {
+        config.send_account_fields = false;
+        for (long long i = 0; i < n; i++) {
+            client.EncodeRequest(trade, user, nzdusd, frame);
+            sink += frame.Size();
+        }
+    });
+
+    add("encode_account", 2000000, [&](long long n) {
+        config.send_account_fields = true;
+        for (long long i = 0; i < n; i++) {
+            client.EncodeRequest(trade, user, nzdusd, frame);
+            sink += frame.Size();
+        }
+        config.send_account_fields = false;
+    });
+
+    add("encode_full60", 2000000, [&](long long n) {
+        for (long long i = 0; i < n; i++) {
+            EncodeFull60(trade, frame);
+            sink += frame.Size();
+        }
+    });
+
+    char response[64];
+    ProtoWriter response_writer(response, sizeof(response));
+    scoring::ScoringResponse::score(response_writer, 0.0731f);
+    scoring::ScoringResponse::warnings(response_writer, "model v7 fallback features");
+    add("decode_response", 5000000, [&](long long n) {
+        ScoringResponseView view;
+        for (long long i = 0; i < n; i++) {
+            DecodeScoringResponse(response, response_writer.Size(), view);
+            sink += view.has_score + view.warning_count;
+        }
+    });
+
+    // Bursts that fit in the ring, drained between bursts and outside the timing:
+    // the cost of an enqueue, not of the drop path a full ring takes
+    suite.push_back(std::make_pair(std::string("log_emit"), [&]() {
+        logger.Start();
+        const std::string line = "ROUTING DECISION: Order 12345678 | Login 16813 | EURUSD | BUY 1.00 @ 1.08765 | "
+                                 "score 0.0731 vs 0.0800 [FXMajors] -> A-BOOK (ML, 412 us)";
+        const long long BURST = 4096;
+        BenchResult result = MeasureTimed("log_emit", (long long)(500000 * options.scale), options.repetitions, [&](long long n) {
+            double elapsed = 0.0;
+            for (long long done = 0; done < n; done += BURST) {
+                long long burst = std::min(BURST, n - done);
+                logger.Flush();
+                auto start = Clock::now();
+                for (long long i = 0; i < burst; i++) logger.Log(line);
+                elapsed += std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            }
+            return elapsed;
+        });
+        logger.Stop();
+        if (logger.Dropped() > 0) printf("log_emit: %llu message(s) dropped, ring full\n\n", logger.Dropped());
+        return result;
+    }));
+
+    suite.push_back(std::make_pair(std::string("decision_cached"), [&]() {
+        return MeasureDecision("decision_cached", (long long)(200000 * options.scale), options.repetitions, true);
+    }));
+    suite.push_back(std::make_pair(std::string("decision_scored"), [&]() {
+        return MeasureDecision("decision_scored", (long long)(20000 * options.scale), options.repetitions, false);
+    }));
+
+    std::cout << "=== HOT PATH BENCHMARK SUITE ===" << std::endl;
+    std::cout << "Build: " << BuildDescription() << ", " << options.repetitions << " repetitions, scale " << options.scale << std::endl;
+    std::cout << std::endl;
+
+    std::vector<BenchResult> results;
+    std::vector<size_t> ran;                 // Index into suite of each result
+    for (size_t i = 0; i < suite.size(); i++) {
+        if (!options.filter.empty() && suite[i].first.find(options.filter) == std::string::npos) continue;
+        results.push_back(suite[i].second());
+        ran.push_back(i);
+    }
+
+    // Results, against the baseline if one was given. The best repetition is
+    // compared, being the least disturbed by the rest of the machine; a
+    // benchmark beyond the tolerance is measured again and only counts as a
+    // regression if the second run is beyond it too.
+    int regressions = 0;
+    printf("%-18s %12s %12s %14s", "benchmark", "ns/op", "best ns/op", "ops/s");
+    if (!baseline.empty()) printf(" %12s %9s", "base best", "change");
+    printf("\n");
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        printf("%-18s %12.1f %12.1f %14.0f", r.name.c_str(), r.ns_per_op, r.min_ns_per_op, r.ns_per_op > 0 ? 1e9 / r.ns_per_op : 0.0);
+        for (const BaselineEntry& entry : baseline) {
+            if (entry.name != r.name || entry.min_ns_per_op <= 0.0) continue;
+            double change_pct = (r.min_ns_per_op / entry.min_ns_per_op - 1.0) * 100.0;
+            printf(" %12.1f %+8.1f%%", entry.min_ns_per_op, change_pct);
+            if (change_pct > options.tolerance_pct) {
+                fflush(stdout);
+                BenchResult again = suite[ran[i]].second();
+                double again_pct = (again.min_ns_per_op / entry.min_ns_per_op - 1.0) * 100.0;
+                if (again_pct > options.tolerance_pct) {
+                    printf("  REGRESSION (re-run %+.1f%%)", again_pct);
+                    regressions++;
+                } else {
+                    printf("  noise (re-run %+.1f%%)", again_pct);
+                }
+            }
+        }
+        printf("\n");
+    }
+    if (!baseline.empty()) {
+        if (baseline_build != BuildDescription()) {
+            printf("\nNOTE: baseline was built with \"%s\"\n", baseline_build.c_str());
+        }
+        printf("\n%d regression(s) beyond %.1f%% against %s\n", regressions, options.tolerance_pct, options.baseline_path.c_str());
+    }
+    remove(BENCH_LOG);
+
+    if (!options.json_path.empty()) {
+        if (!WriteJson(options.json_path, results)) {
+            std::cerr << "Cannot write " << options.json_path << std::endl;
+            return 2;
+        }
+        printf("Results written to %s\n", options.json_path.c_str());
+    }
+
+    WSACleanup();
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,283 @@
+//+------------------------------------------------------------------+
+//| Protobuf Encoder Benchmark - std::string Helpers vs ProtoWriter |
+//| Encodes the minimal request the plugin sends today and the full |
+//| 60-field ScoringRequest from scoring.proto                      |
+//+------------------------------------------------------------------+
+//
+// Usage: bench_proto_encoder [iterations]
+//
+// Built with ABBOOK_ASSERT_NO_ALLOC so every heap allocation is counted. The
+// ProtoWriter runs are wrapped in a NoAllocScope and abort if one slips in.
+// Both encoders must produce byte-identical output before timings are shown.
+
+#ifndef ABBOOK_ASSERT_NO_ALLOC
+#define ABBOOK_ASSERT_NO_ALLOC
+#endif
+#define ABBOOK_DEFINE_ALLOC_COUNTER
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+
+#include "ABBook_ProtoWriter.h"
+
+typedef std::chrono::steady_clock Clock;
+
+//+------------------------------------------------------------------+
+//| Legacy helpers, as CVMClient used them before ProtoWriter       |
+//+------------------------------------------------------------------+
+
+static std::string EncodeVarint(uint64_t value) {
+    std::string result;
+    while (value >= 0x80) {
+        result += (char)((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    result += (char)(value & 0x7F);
+    return result;
+}
+
+static std::string EncodeFloat(int field_number, float value) {
+    std::string result;
+    uint32_t field_tag = (field_number << 3) | 5;
+    result += EncodeVarint(field_tag);
+    char* bytes = (char*)&value;
+    for (int i = 0; i < 4; i++) {
+        result += bytes[i];
+    }
+    return result;
+}
+
+static std::string EncodeInt64(int field_number, int64_t value) {
+    std::string result;
+    uint32_t field_tag = (field_number << 3) | 0;
+    result += EncodeVarint(field_tag);
+    result += EncodeVarint((uint64_t)value);
+    return result;
+}
+
+static std::string EncodeString(int field_number, const std::string& value) {
+    std::string result;
+    uint32_t field_tag = (field_number << 3) | 2;
+    result += EncodeVarint(field_tag);
+    result += EncodeVarint(value.length());
+    result += value;
+    return result;
+}
+
+static std::string CreateLengthPrefixedMessage(const std::string& protobuf_body) {
+    std::string message;
+    uint32_t length = protobuf_body.length();
+    message += (char)((length >> 24) & 0xFF);
+    message += (char)((length >> 16) & 0xFF);
+    message += (char)((length >> 8) & 0xFF);
+    message += (char)(length & 0xFF);
+    message += protobuf_body;
+    return message;
+}
+
+//+------------------------------------------------------------------+
+//| Sample trade                                                    |
+//+------------------------------------------------------------------+
+
+struct SampleTrade {
+    int login;
+    double open_price, sl, tp;
+    int cmd;
+    int volume;
+    const char* symbol;
+    double balance;
+};
+
+static const SampleTrade trade = { 16813, 0.5935, 0.59, 0.597, 1, 100, "NZDUSD", 10000.0 };
+
+// Float and int64 fields of ScoringRequest 6-45, in schema order (true = float)
+static const bool float_fields[46] = {
+    false, true, true, true, false, true,                        // 0 unused, 1-5
+    false, true, true, false, true, true, false, false, true,    // 6-14
+    false, false, false, false, true, false, true, false, false, // 15-23
+    false, true, true, true, true, true, true, false, false,     // 24-32
+    true, true, true, true, true, true, true, false, false,      // 33-41
+    false, true, true, true                                      // 42-45
+};
+
+static const char* const string_fields[15] = {
+    "NZDUSD", "FXMajors", "medium", "retail\\standard", "CY", "MT4", "bachelor", "engineer",
+    "salary", "50k-100k", "weekly", "employed", "CY", "cpc", "16813"
+};
+
+static std::string LegacyMinimal(const SampleTrade& t) {
+    std::string request;
+    request += EncodeString(1, std::to_string(t.login));
+    request += EncodeFloat(2, (float)t.open_price);
+    request += EncodeFloat(3, (float)t.sl);
+    request += EncodeFloat(4, (float)t.tp);
+    request += EncodeFloat(5, (float)t.cmd);
+    request += EncodeFloat(6, (float)(t.volume / 100.0));
+    request += EncodeString(46, std::string(t.symbol));
+    return CreateLengthPrefixedMessage(request);
+}
+
+static void WriterMinimal(const SampleTrade& t, ProtoWriter& out) {
+    out.Clear();
+    size_t mark = out.BeginFrame();
+    char user_id[16];
+    int user_id_length = snprintf(user_id, sizeof(user_id), "%d", t.login);
+    out.String(1, user_id, (size_t)user_id_length);
+    out.Float(2, (float)t.open_price);
+    out.Float(3, (float)t.sl);
+    out.Float(4, (float)t.tp);
+    out.Float(5, (float)t.cmd);
+    out.Float(6, (float)(t.volume / 100.0));
+    out.String(46, t.symbol);
+    out.EndFrame(mark);
+}
+
+static std::string LegacyFull(const SampleTrade& t) {
+    std::string request;
+    request += EncodeFloat(1, (float)t.open_price);
+    request += EncodeFloat(2, (float)t.sl);
+    request += EncodeFloat(3, (float)t.tp);
+    request += EncodeInt64(4, t.cmd);
+    request += EncodeFloat(5, (float)(t.volume / 100.0));
+    for (int field = 6; field <= 45; field++) {
+        if (float_fields[field]) {
+            request += EncodeFloat(field, (float)t.balance / field);
+        } else {
+            request += EncodeInt64(field, field * 37);
+        }
+    }
+    for (int field = 46; field <= 60; field++) {
+        request += EncodeString(field, string_fields[field - 46]);
+    }
+    return CreateLengthPrefixedMessage(request);
+}
+
+static void WriterFull(const SampleTrade& t, ProtoWriter& out) {
+    out.Clear();
+    size_t mark = out.BeginFrame();
+    out.Float(1, (float)t.open_price);
+    out.Float(2, (float)t.sl);
+    out.Float(3, (float)t.tp);
+    out.Int64(4, t.cmd);
+    out.Float(5, (float)(t.volume / 100.0));
+    for (int field = 6; field <= 45; field++) {
+        if (float_fields[field]) {
+            out.Float(field, (float)t.balance / field);
+        } else {
+            out.Int64(field, field * 37);
+        }
+    }
+    for (int field = 46; field <= 60; field++) {
+        out.String(field, string_fields[field - 46]);
+    }
+    out.EndFrame(mark);
+}
+
+//+------------------------------------------------------------------+
+//| Harness                                                         |
+//+------------------------------------------------------------------+
+
+struct Result {
+    double ns_per_request;
+    double allocations_per_request;
+    size_t bytes;
+};
+
+template <typename Fn>
+static Result Measure(int iterations, Fn encode) {
+    size_t bytes = 0;
+    unsigned long long allocations_before = AllocationCount();
+    auto start = Clock::now();
+    for (int i = 0; i < iterations; i++) {
+        bytes = encode();
+    }
+    double elapsed_ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    Result result;
+    result.ns_per_request = elapsed_ns / iterations;
+    result.allocations_per_request = (double)(AllocationCount() - allocations_before) / iterations;
+    result.bytes = bytes;
+    return result;
+}
+
+static void Report(const char* name, const Result& legacy, const Result& writer) {
+    std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(1)
+              << std::setw(8) << writer.bytes
+              << std::setw(14) << legacy.ns_per_request << std::setw(14) << legacy.allocations_per_request
+              << std::setw(14) << writer.ns_per_request << std::setw(14) << writer.allocations_per_request
+              << std::setw(10) << legacy.ns_per_request / writer.ns_per_request << "x" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 200000;
+    if (iterations < 1) iterations = 1;
+
+    char buffer[1024];
+    ProtoWriter writer(buffer, sizeof(buffer));
+
+    // Correctness first: identical bytes, and the back-filled sub-message length
+    // must survive a body longer than one varint byte
+    WriterMinimal(trade, writer);
+    bool minimal_ok = writer.Ok() && LegacyMinimal(trade) == std::string(writer.Data(), writer.Size());
+    WriterFull(trade, writer);
+    bool full_ok = writer.Ok() && LegacyFull(trade) == std::string(writer.Data(), writer.Size());
+
+    std::string full_body = LegacyFull(trade).substr(4);
+    std::string nested = "\x0A" + EncodeVarint(full_body.size()) + full_body;
+    // The full body encoded directly inside a sub-message (as in ScoringBatchRequest)
+    writer.Clear();
+    size_t mark = writer.BeginMessage(1);
+    writer.Float(1, (float)trade.open_price);
+    writer.Float(2, (float)trade.sl);
+    writer.Float(3, (float)trade.tp);
+    writer.Int64(4, trade.cmd);
+    writer.Float(5, (float)(trade.volume / 100.0));
+    for (int field = 6; field <= 45; field++) {
+        if (float_fields[field]) writer.Float(field, (float)trade.balance / field);
+        else writer.Int64(field, field * 37);
+    }
+    for (int field = 46; field <= 60; field++) writer.String(field, string_fields[field - 46]);
+    writer.EndMessage(mark);
+    bool nested_ok = writer.Ok() && nested == std::string(writer.Data(), writer.Size());
+
+    char tiny[8];
+    ProtoWriter small(tiny, sizeof(tiny));
+    WriterMinimal(trade, small);
+    bool overflow_ok = !small.Ok() && small.Size() <= sizeof(tiny);
+
+    std::cout << "=== PROTOBUF ENCODER BENCHMARK ===" << std::endl;
+    std::cout << "Minimal request identical:  " << (minimal_ok ? "YES" : "NO") << std::endl;
+    std::cout << "Full request identical:     " << (full_ok ? "YES" : "NO") << std::endl;
+    std::cout << "Back-filled nested length:  " << (nested_ok ? "YES" : "NO") << " (" << full_body.size() << "-byte body)" << std::endl;
+    std::cout << "Overflow stays in bounds:   " << (overflow_ok ? "YES" : "NO") << std::endl;
+    if (!minimal_ok || !full_ok || !nested_ok || !overflow_ok) {
+        std::cout << "ENCODER MISMATCH - no timings" << std::endl;
+        return 1;
+    }
+    std::cout << std::endl;
+
+    std::cout << std::left << std::setw(10) << "request" << std::right << std::setw(8) << "bytes"
+              << std::setw(14) << "legacy_ns" << std::setw(14) << "legacy_alloc"
+              << std::setw(14) << "writer_ns" << std::setw(14) << "writer_alloc" << std::setw(11) << "speedup" << std::endl;
+
+    volatile size_t sink = 0;
+    Result legacy = Measure(iterations, [&] { std::string m = LegacyMinimal(trade); sink += m.size(); return m.size(); });
+    Result fast;
+    {
+        ABBOOK_NO_ALLOC_SCOPE(no_alloc);
+        fast = Measure(iterations, [&] { WriterMinimal(trade, writer); return writer.Size(); });
+    }
+    Report("minimal", legacy, fast);
+
+    legacy = Measure(iterations, [&] { std::string m = LegacyFull(trade); sink += m.size(); return m.size(); });
+    {
+        ABBOOK_NO_ALLOC_SCOPE(no_alloc);
+        fast = Measure(iterations, [&] { WriterFull(trade, writer); return writer.Size(); });
+    }
+    Report("full", legacy, fast);
+
+    return 0;
+}
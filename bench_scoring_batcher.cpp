@@ -0,0 +1,166 @@
+//+------------------------------------------------------------------+
+//| Micro-Batching Benchmark - Throughput vs Added Latency         |
+//| Drives ScoringBatcher with many concurrent "trade threads"     |
+//| against a simulated scoring service with a fixed round trip    |
+//+------------------------------------------------------------------+
+//
+// Usage: bench_scoring_batcher [threads] [connections] [rtt_us] [per_item_us] [seconds]
+//
+// The simulated service serves one batch per connection at a time and costs
+// rtt_us + per_item_us * batch_size. That is the trade-off batching plays
+// with: every request in a batch shares one round trip, but the leader waits
+// up to the window before sending.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+
+#include "ABBook_ScoringBatcher.h"
+
+typedef std::chrono::steady_clock Clock;
+
+static void SpinFor(std::chrono::microseconds duration) {
+    auto until = Clock::now() + duration;
+    while (Clock::now() < until) {
+        std::this_thread::yield();
+    }
+}
+
+// Stands in for the CVM: a fixed number of connections, one batch in flight per connection
+class SimulatedService {
+private:
+    std::vector<std::mutex> connections;
+    std::atomic<unsigned> next;
+    int rtt_us;
+    int per_item_us;
+
+public:
+    SimulatedService(int connection_count, int rtt, int per_item)
+        : connections(connection_count), next(0), rtt_us(rtt), per_item_us(per_item) {}
+
+    bool RoundTrip(const std::string& batch_request, std::string& batch_response) {
+        // Count requests (field 1, length-delimited) and answer each with score = 0.5
+        size_t items = 0;
+        size_t pos = 0;
+        while (pos < batch_request.size()) {
+            pos++; // tag 0x0A
+            uint64_t length = 0;
+            int shift = 0;
+            unsigned char byte;
+            do {
+                byte = (unsigned char)batch_request[pos++];
+                length |= (uint64_t)(byte & 0x7F) << shift;
+                shift += 7;
+            } while (byte & 0x80);
+            pos += (size_t)length;
+            items++;
+        }
+
+        std::mutex& conn = connections[next.fetch_add(1) % connections.size()];
+        std::lock_guard<std::mutex> lock(conn);
+        SpinFor(std::chrono::microseconds(rtt_us + per_item_us * (int)items));
+
+        static const char response[] = { 0x0A, 0x05, 0x0D, 0x00, 0x00, 0x00, 0x3F }; // { score: 0.5 }
+        batch_response.clear();
+        for (size_t i = 0; i < items; i++) {
+            batch_response.append(response, sizeof(response));
+        }
+        return true;
+    }
+};
+
+struct RunResult {
+    double throughput;
+    double p50_us;
+    double p99_us;
+    double avg_batch;
+};
+
+static RunResult Run(int window_us, int threads, int connections, int rtt_us, int per_item_us, int seconds) {
+    PluginConfig config;
+    config.batch_window_us = window_us;
+    config.batch_max_items = 64;
+
+    SimulatedService service(connections, rtt_us, per_item_us);
+    ScoringBatcher batcher(&config, [&service](const std::string& req, std::string& resp, const ScoringDeadline&) {
+        return service.RoundTrip(req, resp);
+    });
+
+    std::atomic<bool> stop(false);
+    std::vector<std::vector<double>> latencies(threads);
+    std::vector<std::thread> workers;
+
+    // Minimal-format request body, as CreateScoringRequest produces today
+    const std::string request("\x0A\x05" "16813" "\x15\x00\x00\x80\x3F" "\xF2\x02\x06" "NZDUSD", 21);
+
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            std::string response;
+            latencies[t].reserve(200000);
+            while (!stop.load(std::memory_order_relaxed)) {
+                auto start = Clock::now();
+                batcher.Submit(request.data(), request.length(), response, ScoringDeadline::In(1000));
+                latencies[t].push_back(std::chrono::duration<double, std::micro>(Clock::now() - start).count());
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::seconds(seconds));
+    stop.store(true);
+    for (auto& worker : workers) worker.join();
+
+    std::vector<double> all;
+    for (auto& per_thread : latencies) all.insert(all.end(), per_thread.begin(), per_thread.end());
+    std::sort(all.begin(), all.end());
+
+    RunResult result;
+    result.throughput = all.size() / (double)seconds;
+    result.p50_us = all.empty() ? 0 : all[all.size() / 2];
+    result.p99_us = all.empty() ? 0 : all[(size_t)(all.size() * 0.99)];
+    result.avg_batch = batcher.BatchesSent() ? (double)batcher.RequestsSent() / batcher.BatchesSent() : 0;
+    return result;
+}
+
+int main(int argc, char* argv[]) {
+    int threads     = argc > 1 ? atoi(argv[1]) : 32;
+    int connections = argc > 2 ? atoi(argv[2]) : 4;
+    int rtt_us      = argc > 3 ? atoi(argv[3]) : 300;
+    int per_item_us = argc > 4 ? atoi(argv[4]) : 5;
+    int seconds     = argc > 5 ? atoi(argv[5]) : 2;
+
+    std::cout << "=== MICRO-BATCHING BENCHMARK ===" << std::endl;
+    std::cout << "Trade threads: " << threads << ", connections: " << connections
+              << ", service RTT: " << rtt_us << " us + " << per_item_us << " us/request" << std::endl;
+    std::cout << std::endl;
+
+    const int windows[] = { 0, 25, 50, 100, 200, 500 };
+
+    // One uncontended thread shows the pure latency a window adds when there is
+    // nothing to batch; the loaded run shows what the window buys under fan-out.
+    const int loads[] = { 1, threads };
+    for (int load : loads) {
+        std::cout << "--- " << load << " concurrent trade thread(s) ---" << std::endl;
+        std::cout << std::setw(10) << "window_us" << std::setw(14) << "req/s" << std::setw(12) << "p50_us"
+                  << std::setw(12) << "p99_us" << std::setw(12) << "avg_batch" << std::setw(18) << "p50_vs_window0" << std::endl;
+
+        RunResult baseline = {};
+        for (int window : windows) {
+            RunResult r = Run(window, load, connections, rtt_us, per_item_us, seconds);
+            if (window == 0) baseline = r;
+
+            std::cout << std::fixed << std::setprecision(1)
+                      << std::setw(10) << window << std::setw(14) << r.throughput << std::setw(12) << r.p50_us
+                      << std::setw(12) << r.p99_us << std::setw(12) << r.avg_batch
+                      << std::setw(18) << std::showpos << (r.p50_us - baseline.p50_us) << std::noshowpos << std::endl;
+        }
+        std::cout << std::endl;
+    }
+    return 0;
+}
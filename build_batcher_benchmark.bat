@@ -0,0 +1,19 @@
+@echo off
+echo Building Micro-Batching Benchmark...
+call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvarsall.bat" x86 2>nul
+if errorlevel 1 (
+    call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvarsall.bat" x86 2>nul
+)
+
+del bench_scoring_batcher.exe 2>nul
+cl.exe /EHsc /MT /O2 /I. bench_scoring_batcher.cpp /Fe:bench_scoring_batcher.exe
+
+if errorlevel 1 (
+    echo COMPILATION FAILED
+    pause
+    exit /b 1
+)
+
+echo SUCCESS: Built bench_scoring_batcher.exe
+echo Usage: bench_scoring_batcher.exe [threads] [connections] [rtt_us] [per_item_us] [seconds]
+pause
@@ -0,0 +1,19 @@
+@echo off
+echo Building Connection Pool Test...
+call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvarsall.bat" x86 2>nul
+if errorlevel 1 (
+    call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvarsall.bat" x86 2>nul
+)
+
+del test_connection_pool.exe 2>nul
+cl.exe /EHsc /MT /O2 /I. test_connection_pool.cpp /link ws2_32.lib /OUT:test_connection_pool.exe
+
+if errorlevel 1 (
+    echo COMPILATION FAILED
+    pause
+    exit /b 1
+)
+
+echo SUCCESS: Built test_connection_pool.exe
+test_connection_pool.exe
+pause
@@ -0,0 +1,28 @@
+@echo off
+echo Building ScoringResponse Decoder Test + Fuzz Harness...
+call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvarsall.bat" x86 2>nul
+if errorlevel 1 (
+    call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvarsall.bat" x86 2>nul
+)
+
+REM The decoder takes its field numbers from the generated schema
+cl.exe /EHsc /O2 /nologo proto_schema_gen.cpp /Fe:proto_schema_gen.exe >nul
+proto_schema_gen.exe scoring.proto scoring_schema.h
+if errorlevel 1 (
+    echo SCHEMA GENERATION FAILED
+    pause
+    exit /b 1
+)
+
+del test_response_decoder.exe 2>nul
+cl.exe /EHsc /MT /O2 /I. test_response_decoder.cpp /Fe:test_response_decoder.exe
+
+if errorlevel 1 (
+    echo COMPILATION FAILED
+    pause
+    exit /b 1
+)
+
+echo SUCCESS: Built test_response_decoder.exe
+test_response_decoder.exe
+pause
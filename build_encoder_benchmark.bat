@@ -0,0 +1,19 @@
+@echo off
+echo Building Protobuf Encoder Benchmark...
+call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvarsall.bat" x86 2>nul
+if errorlevel 1 (
+    call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvarsall.bat" x86 2>nul
+)
+
+del bench_proto_encoder.exe 2>nul
+cl.exe /EHsc /MT /O2 /I. bench_proto_encoder.cpp /Fe:bench_proto_encoder.exe
+
+if errorlevel 1 (
+    echo COMPILATION FAILED
+    pause
+    exit /b 1
+)
+
+echo SUCCESS: Built bench_proto_encoder.exe
+echo Usage: bench_proto_encoder.exe [iterations]
+pause
@@ -0,0 +1,20 @@
+@echo off
+echo Building Decision Journal Decoder...
+call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvarsall.bat" x86 2>nul
+if errorlevel 1 (
+    call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvarsall.bat" x86 2>nul
+)
+
+del journal_decode.exe 2>nul
+:: setargv.obj expands the *.abj wildcard on the command line
+cl.exe /EHsc /MT /O2 /I. journal_decode.cpp /link setargv.obj /OUT:journal_decode.exe
+
+if errorlevel 1 (
+    echo COMPILATION FAILED
+    pause
+    exit /b 1
+)
+
+echo SUCCESS: Built journal_decode.exe
+echo Usage: journal_decode [--login N] [--symbol S] [--decision A^|B] [--source ML^|FALLBACK] [--summary] -o out.csv ABBook_Decisions_*.abj
+pause
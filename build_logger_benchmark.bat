@@ -0,0 +1,19 @@
+@echo off
+echo Building Logger Benchmark...
+call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvarsall.bat" x86 2>nul
+if errorlevel 1 (
+    call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvarsall.bat" x86 2>nul
+)
+
+del bench_async_logger.exe 2>nul
+cl.exe /EHsc /MT /O2 /I. bench_async_logger.cpp /Fe:bench_async_logger.exe
+
+if errorlevel 1 (
+    echo COMPILATION FAILED
+    pause
+    exit /b 1
+)
+
+echo SUCCESS: Built bench_async_logger.exe
+echo Usage: bench_async_logger.exe [messages_per_thread] [threads]
+pause
@@ -29,10 +29,41 @@ echo - Zero-crash guarantee under all conditions
 echo ===============================================
 echo.
 
+REM Generate scoring_schema.h (field numbers, tags, typed encoders) from scoring.proto
+echo Generating scoring_schema.h from scoring.proto...
+cl.exe /EHsc /O2 /nologo proto_schema_gen.cpp /Fe:proto_schema_gen.exe >nul
+if errorlevel 1 (
+    echo *** proto_schema_gen FAILED TO COMPILE ***
+    pause
+    exit /b 1
+)
+proto_schema_gen.exe scoring.proto scoring_schema.h
+if errorlevel 1 (
+    echo *** scoring.proto is invalid - fix the schema errors above ***
+    pause
+    exit /b 1
+)
+
+REM Optional build flags, in any order:
+REM   noalloc      - abort if request encoding touches the heap (checked in release builds too)
+REM   diagnostics  - keep TRACE/DEBUG logging (per-trade checkpoints); compiled out otherwise
+setlocal enabledelayedexpansion
+set EXTRA_DEFINES=
+for %%A in (%*) do (
+    if /I "%%A"=="noalloc" (
+        set EXTRA_DEFINES=!EXTRA_DEFINES! /DABBOOK_ASSERT_NO_ALLOC
+        echo Allocation assertions ENABLED ^(ABBOOK_ASSERT_NO_ALLOC^)
+    )
+    if /I "%%A"=="diagnostics" (
+        set EXTRA_DEFINES=!EXTRA_DEFINES! /DABBOOK_MIN_LOG_LEVEL=0
+        echo TRACE/DEBUG logging COMPILED IN ^(set [Logging] LogLevel to enable^)
+    )
+)
+
 REM Compile the official plugin
-cl.exe /LD /EHsc /I. /DWIN32 /D_WINDOWS /D_USRDLL /D_WIN32_WINNT=0x0601 ^
+cl.exe /LD /EHsc /I. /DWIN32 /D_WINDOWS /D_USRDLL /D_WIN32_WINNT=0x0601 %EXTRA_DEFINES% ^
     /MT /O2 /Zi /Fd:ABBook_Plugin_Official_32bit.pdb ^
-    MT4_ABBook_Plugin_Official.cpp ^
+    MT4_ABBook_Plugin_Official.cpp ABBook_TradeRouter.cpp ^
     /link ws2_32.lib user32.lib kernel32.lib ^
     /OUT:ABBook_Plugin_Official_32bit.dll ^
     /DEF:plugin_exports.def ^
@@ -0,0 +1,29 @@
+@echo off
+echo Building Single-Flight Test...
+call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvarsall.bat" x86 2>nul
+if errorlevel 1 (
+    call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvarsall.bat" x86 2>nul
+)
+
+:: The test runs trades through the whole router, so it needs scoring_schema.h like the plugin
+cl.exe /EHsc /O2 /nologo proto_schema_gen.cpp /Fe:proto_schema_gen.exe >nul
+proto_schema_gen.exe scoring.proto scoring_schema.h
+if errorlevel 1 (
+    echo scoring.proto is invalid
+    pause
+    exit /b 1
+)
+
+del test_single_flight.exe 2>nul
+cl.exe /EHsc /MT /O2 /I. /DWIN32 /D_WINDOWS /D_WIN32_WINNT=0x0601 test_single_flight.cpp ABBook_TradeRouter.cpp ^
+    /link ws2_32.lib /OUT:test_single_flight.exe
+
+if errorlevel 1 (
+    echo COMPILATION FAILED
+    pause
+    exit /b 1
+)
+
+echo SUCCESS: Built test_single_flight.exe
+test_single_flight.exe
+pause
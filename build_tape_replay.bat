@@ -0,0 +1,29 @@
+@echo off
+echo Building Trade Tape Replayer...
+call "C:\Program Files (x86)\Microsoft Visual Studio\2022\BuildTools\VC\Auxiliary\Build\vcvarsall.bat" x86 2>nul
+if errorlevel 1 (
+    call "C:\Program Files\Microsoft Visual Studio\2022\Community\VC\Auxiliary\Build\vcvarsall.bat" x86 2>nul
+)
+
+:: The replayer links the whole router, so it needs scoring_schema.h like the plugin
+cl.exe /EHsc /O2 /nologo proto_schema_gen.cpp /Fe:proto_schema_gen.exe >nul
+proto_schema_gen.exe scoring.proto scoring_schema.h
+if errorlevel 1 (
+    echo scoring.proto is invalid
+    pause
+    exit /b 1
+)
+
+del tape_replay.exe 2>nul
+cl.exe /EHsc /MT /O2 /I. /DWIN32 /D_WINDOWS /D_WIN32_WINNT=0x0601 tape_replay.cpp ABBook_TradeRouter.cpp ^
+    /link ws2_32.lib /OUT:tape_replay.exe
+
+if errorlevel 1 (
+    echo COMPILATION FAILED
+    pause
+    exit /b 1
+)
+
+echo SUCCESS: Built tape_replay.exe
+echo Usage: tape_replay [--config ABBook_Config.ini] [--speed X ^| --max] [--threads N] [--loops N] ABBook_Tape_*.abt
+pause
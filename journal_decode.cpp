@@ -0,0 +1,222 @@
+//+------------------------------------------------------------------+
+//| Decision Journal Decoder - *.abj -> CSV                         |
+//| Offline reader for the plugin's binary decision journal        |
+//+------------------------------------------------------------------+
+//
+// Usage: journal_decode [filters] [--summary] [-o out.csv] file.abj [file.abj ...]
+//
+// Filters (all given filters must match):
+//   --login N            account login
+//   --order N            ticket
+//   --symbol S           cleaned symbol, e.g. EURUSD
+//   --group G            instrument group, e.g. FXMajors
+//   --decision A|B       routing decision
+//   --source S           ML, FALLBACK (any fallback) or a full name such as FALLBACK_BUDGET
+//   --from T / --to T    UTC time, "YYYY-MM-DD" or "YYYY-MM-DD HH:MM:SS" (--to is exclusive)
+//
+// Records from all files are written in timestamp order. --summary prints
+// counts per decision, score source and instrument group instead of CSV.
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "ABBook_DecisionJournal.h"
+
+struct JournalFilter {
+    bool by_login = false, by_order = false;
+    int login = 0, order = 0;
+    std::string symbol, group, source;
+    int decision = -1;
+    uint64_t from_us = 0, to_us = UINT64_MAX;
+
+    bool Matches(const DecisionRecord& r) const {
+        if (by_login && r.login != login) return false;
+        if (by_order && r.order != order) return false;
+        if (!symbol.empty() && symbol != std::string(r.symbol, strnlen(r.symbol, sizeof(r.symbol)))) return false;
+        if (!group.empty() && group != std::string(r.group, strnlen(r.group, sizeof(r.group)))) return false;
+        if (decision >= 0 && r.decision != decision) return false;
+        if (!source.empty()) {
+            if (source == "FALLBACK") {
+                if (r.score_source == SCORE_SOURCE_ML || r.score_source == SCORE_SOURCE_CACHE ||
+                    r.score_source == SCORE_SOURCE_CACHE_STALE || r.score_source == SCORE_SOURCE_COALESCED) return false;
+            } else if (source != JournalScoreSourceName(r.score_source)) {
+                return false;
+            }
+        }
+        return r.timestamp_us >= from_us && r.timestamp_us < to_us;
+    }
+};
+
+// "YYYY-MM-DD" or "YYYY-MM-DD HH:MM:SS", UTC
+static bool ParseUtc(const char* text, uint64_t& out_us) {
+    int year, month, day, hour = 0, minute = 0, second = 0;
+    int fields = sscanf(text, "%d-%d-%d %d:%d:%d", &year, &month, &day, &hour, &minute, &second);
+    if (fields != 3 && fields != 6) return false;
+
+    // Days since 1970-01-01 (proleptic Gregorian)
+    int y = year - (month <= 2 ? 1 : 0);
+    int era = (y >= 0 ? y : y - 399) / 400;
+    int yoe = y - era * 400;
+    int doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    int doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    long long days = (long long)era * 146097 + doe - 719468;
+
+    out_us = (uint64_t)((days * 86400 + hour * 3600 + minute * 60 + second) * 1000000LL);
+    return true;
+}
+
+static std::string FormatUtc(uint64_t timestamp_us) {
+    time_t seconds = (time_t)(timestamp_us / 1000000);
+    struct tm utc;
+#ifdef _WIN32
+    gmtime_s(&utc, &seconds);
+#else
+    gmtime_r(&seconds, &utc);
+#endif
+    char text[40];
+    size_t length = strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &utc);
+    snprintf(text + length, sizeof(text) - length, ".%06u", (unsigned)(timestamp_us % 1000000));
+    return text;
+}
+
+static void WriteCsv(std::ostream& out, const std::vector<DecisionRecord>& records) {
+    out << "timestamp_utc,timestamp_us,order,login,symbol,group,cmd,volume,open_price,request_hash,"
+           "score,threshold,decision,score_source,latency_us,data_corrupted\n";
+    char line[512];
+    for (const DecisionRecord& r : records) {
+        snprintf(line, sizeof(line), "%s,%llu,%d,%d,%.*s,%.*s,%d,%d,%.5f,%016llx,%.6f,%.6f,%s,%s,%u,%d\n",
+                 FormatUtc(r.timestamp_us).c_str(), (unsigned long long)r.timestamp_us, r.order, r.login,
+                 (int)strnlen(r.symbol, sizeof(r.symbol)), r.symbol, (int)strnlen(r.group, sizeof(r.group)), r.group,
+                 r.cmd, r.volume, r.open_price, (unsigned long long)r.request_hash, r.score, r.threshold,
+                 r.decision == JOURNAL_B_BOOK ? "B-BOOK" : "A-BOOK", JournalScoreSourceName(r.score_source),
+                 r.latency_us, (r.flags & JOURNAL_FLAG_DATA_CORRUPTED) ? 1 : 0);
+        out << line;
+    }
+}
+
+static void WriteSummary(std::ostream& out, const std::vector<DecisionRecord>& records) {
+    std::map<std::string, size_t> decisions, sources, groups;
+    std::vector<uint32_t> latencies;
+    for (const DecisionRecord& r : records) {
+        decisions[r.decision == JOURNAL_B_BOOK ? "B-BOOK" : "A-BOOK"]++;
+        sources[JournalScoreSourceName(r.score_source)]++;
+        groups[std::string(r.group, strnlen(r.group, sizeof(r.group)))]++;
+        if (r.score_source == SCORE_SOURCE_ML) latencies.push_back(r.latency_us);
+    }
+
+    out << "Records: " << records.size() << std::endl;
+    if (!records.empty()) {
+        out << "From:    " << FormatUtc(records.front().timestamp_us) << " UTC" << std::endl;
+        out << "To:      " << FormatUtc(records.back().timestamp_us) << " UTC" << std::endl;
+    }
+    out << std::endl << "Decision:" << std::endl;
+    for (auto& entry : decisions) out << "  " << entry.first << ": " << entry.second << std::endl;
+    out << "Score source:" << std::endl;
+    for (auto& entry : sources) out << "  " << entry.first << ": " << entry.second << std::endl;
+    out << "Instrument group:" << std::endl;
+    for (auto& entry : groups) out << "  " << entry.first << ": " << entry.second << std::endl;
+    if (!latencies.empty()) {
+        std::sort(latencies.begin(), latencies.end());
+        out << "ML scoring latency (us): p50 " << latencies[latencies.size() / 2]
+            << ", p99 " << latencies[(size_t)(latencies.size() * 0.99)]
+            << ", max " << latencies.back() << std::endl;
+    }
+}
+
+static int Usage() {
+    std::cerr << "Usage: journal_decode [--login N] [--order N] [--symbol S] [--group G] [--decision A|B]" << std::endl
+              << "                      [--source ML|FALLBACK|FALLBACK_ERROR|...] [--from T] [--to T]" << std::endl
+              << "                      [--summary] [-o out.csv] file.abj [file.abj ...]" << std::endl
+              << "  T is UTC: YYYY-MM-DD or \"YYYY-MM-DD HH:MM:SS\"; --to is exclusive" << std::endl;
+    return 2;
+}
+
+int main(int argc, char* argv[]) {
+    JournalFilter filter;
+    std::vector<std::string> files;
+    std::string output_path;
+    bool summary = false;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--summary") {
+            summary = true;
+        } else if (arg == "--login" && has_value) {
+            filter.by_login = true;
+            filter.login = atoi(argv[++i]);
+        } else if (arg == "--order" && has_value) {
+            filter.by_order = true;
+            filter.order = atoi(argv[++i]);
+        } else if (arg == "--symbol" && has_value) {
+            filter.symbol = argv[++i];
+            for (char& c : filter.symbol) c = (char)toupper((unsigned char)c);
+        } else if (arg == "--group" && has_value) {
+            filter.group = argv[++i];
+        } else if (arg == "--decision" && has_value) {
+            char d = (char)toupper((unsigned char)argv[++i][0]);
+            if (d != 'A' && d != 'B') return Usage();
+            filter.decision = d == 'B' ? JOURNAL_B_BOOK : JOURNAL_A_BOOK;
+        } else if (arg == "--source" && has_value) {
+            filter.source = argv[++i];
+            for (char& c : filter.source) c = (char)toupper((unsigned char)c);
+        } else if ((arg == "--from" || arg == "--to") && has_value) {
+            uint64_t& bound = arg == "--from" ? filter.from_us : filter.to_us;
+            if (!ParseUtc(argv[++i], bound)) {
+                std::cerr << "Bad time '" << argv[i] << "'" << std::endl;
+                return Usage();
+            }
+        } else if (arg == "-o" && has_value) {
+            output_path = argv[++i];
+        } else if (!arg.empty() && arg[0] == '-') {
+            return Usage();
+        } else {
+            files.push_back(arg);
+        }
+    }
+    if (files.empty()) return Usage();
+
+    std::vector<DecisionRecord> records;
+    for (const std::string& path : files) {
+        std::vector<DecisionRecord> file_records;
+        std::string error;
+        if (!ReadJournalFile(path, file_records, error)) {
+            std::cerr << "ERROR: " << error << std::endl;
+            return 1;
+        }
+        for (const DecisionRecord& r : file_records) {
+            if (filter.Matches(r)) records.push_back(r);
+        }
+    }
+    // Concurrent trade threads claim slots slightly out of time order
+    std::stable_sort(records.begin(), records.end(), [](const DecisionRecord& a, const DecisionRecord& b) {
+        return a.timestamp_us < b.timestamp_us;
+    });
+
+    std::ofstream file;
+    if (!output_path.empty()) {
+        file.open(output_path);
+        if (!file) {
+            std::cerr << "ERROR: cannot write " << output_path << std::endl;
+            return 1;
+        }
+    }
+    std::ostream& out = output_path.empty() ? std::cout : file;
+    if (summary) {
+        WriteSummary(out, records);
+    } else {
+        WriteCsv(out, records);
+    }
+    if (!output_path.empty()) {
+        std::cerr << records.size() << " record(s) written to " << output_path << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,670 @@
+//+------------------------------------------------------------------+
+//| Mock Scoring Service - epoll, real wire format                 |
+//| Local stand-in for the CVM with latency and fault injection    |
+//+------------------------------------------------------------------+
+//
+// Usage: mock_scoring_server [options]
+//
+//   --bind ADDR          listen address (default 127.0.0.1)
+//   --port N             listen port (default 50051, the CVM_Port default)
+//   --mode M             direct   [4B BE length][ScoringRequest] -> ScoringResponse (default)
+//                        mux      [4B BE length][4B BE request_id][ScoringRequest], id echoed
+//                                 (EnableMultiplexing=true)
+//                        batch    ScoringBatchRequest -> ScoringBatchResponse, one response
+//                                 per request (EnableBatching=true)
+//   --score X[,Y]        score returned, or uniform in [X, Y] (default 0.05)
+//   --latency SPEC       delay before each answer, in milliseconds:
+//                          fixed:MS                   (default fixed:0)
+//                          lognormal:MEDIAN,SIGMA     MEDIAN * exp(SIGMA * N(0,1))
+//                          bimodal:BASE,SPIKE,P       SPIKE with probability P, else BASE
+//   --drop P             probability a request is read and never answered
+//   --reset P            probability the connection is reset (RST) instead of answered
+//   --partial P          probability only half the response frame is sent, then the
+//                        connection is closed
+//   --threads N          event loops, each with its own SO_REUSEPORT listener (default 1)
+//   --stats-sec N        print counters every N seconds, 0 = only at exit (default 1)
+//   --seed N             random seed (default: time)
+//
+// Faults are drawn per request frame (per batch in batch mode) and acted on
+// when the answer falls due, so a reset or partial frame reaches the plugin
+// while it is waiting. Requests are checked to be well-formed protobuf; a
+// connection that sends anything else, or a frame over 1 MB, is closed.
+//
+// Each event loop is one thread: non-blocking sockets, level-triggered epoll,
+// and a timerfd armed for the earliest delayed answer, so sub-millisecond
+// latencies are honoured. Answers with no delay are written straight from the
+// read handler. In direct and batch mode answers on a connection leave in
+// request order; in mux mode each request gets its own delay, so answers can
+// overtake each other, as they may from the real service.
+//
+// Linux only (epoll, timerfd). Point ABBook_Config.ini at it with
+// CVM_IP=127.0.0.1 and CVM_Port=50051. Ctrl+C prints the totals.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <chrono>
+#include <unordered_map>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+#include "ABBook_Platform.h"
+#include "ABBook_ProtoWriter.h"
+#include "ABBook_ProtoReader.h"
+
+enum MockMode { MODE_DIRECT, MODE_MUX, MODE_BATCH };
+
+enum LatencyKind { LATENCY_FIXED, LATENCY_LOGNORMAL, LATENCY_BIMODAL };
+
+struct LatencySpec {
+    LatencyKind kind = LATENCY_FIXED;
+    double a = 0.0, b = 0.0, c = 0.0;     // fixed: ms | lognormal: median, sigma | bimodal: base, spike, p
+};
+
+struct MockOptions {
+    std::string bind = "127.0.0.1";
+    int port = 50051;
+    MockMode mode = MODE_DIRECT;
+    float score_low = 0.05f, score_high = 0.05f;
+    LatencySpec latency;
+    double drop = 0.0, reset = 0.0, partial = 0.0;
+    int threads = 1;
+    int stats_sec = 1;
+    unsigned long long seed = 0;
+};
+
+static const uint32_t MAX_FRAME_BYTES = 1024 * 1024;
+
+static volatile sig_atomic_t stop_requested = 0;
+
+static void OnSignal(int) { stop_requested = 1; }
+
+static uint64_t NowNs() {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec;
+}
+
+//+------------------------------------------------------------------+
+//| Counters, summed over all loops by the main thread             |
+//+------------------------------------------------------------------+
+
+struct MockCounters {
+    std::atomic<unsigned long long> accepted{0};
+    std::atomic<long long> open{0};
+    std::atomic<unsigned long long> frames{0};
+    std::atomic<unsigned long long> requests{0};      // ScoringRequests, counting every item of a batch
+    std::atomic<unsigned long long> answered{0};
+    std::atomic<unsigned long long> dropped{0};
+    std::atomic<unsigned long long> resets{0};
+    std::atomic<unsigned long long> partials{0};
+    std::atomic<unsigned long long> bad_frames{0};
+};
+
+//+------------------------------------------------------------------+
+//| One event loop                                                 |
+//+------------------------------------------------------------------+
+
+enum FaultKind { FAULT_NONE, FAULT_DROP, FAULT_RESET, FAULT_PARTIAL };
+
+struct Connection {
+    SOCKET sock;
+    uint64_t serial;
+    std::string in;
+    size_t in_offset = 0;
+    std::string out;
+    size_t out_offset = 0;
+    bool want_write = false;
+    uint64_t last_due_ns = 0;      // Direct/batch: answers keep request order
+};
+
+struct DelayedAnswer {
+    uint64_t due_ns;
+    uint64_t sequence;             // Ties leave in arrival order
+    SOCKET sock;
+    uint64_t serial;
+    FaultKind fault;
+    unsigned long long items;
+    std::string frame;
+
+    bool operator>(const DelayedAnswer& other) const {
+        return due_ns != other.due_ns ? due_ns > other.due_ns : sequence > other.sequence;
+    }
+};
+
+class MockLoop {
+private:
+    const MockOptions& options;
+    MockCounters& counters;
+    SOCKET listener;
+    int epoll_fd;
+    int timer_fd;
+    uint64_t armed_ns;
+    uint64_t next_serial;
+    uint64_t next_sequence;
+    std::unordered_map<SOCKET, std::unique_ptr<Connection>> connections;
+    std::priority_queue<DelayedAnswer, std::vector<DelayedAnswer>, std::greater<DelayedAnswer>> delayed;
+    std::mt19937_64 rng;
+    std::uniform_real_distribution<double> uniform;
+    std::normal_distribution<double> normal;
+
+    double LatencyMs() {
+        const LatencySpec& spec = options.latency;
+        switch (spec.kind) {
+            case LATENCY_FIXED: return spec.a;
+            case LATENCY_LOGNORMAL: return spec.a * std::exp(spec.b * normal(rng));
+            case LATENCY_BIMODAL: return uniform(rng) < spec.c ? spec.b : spec.a;
+        }
+        return 0.0;
+    }
+
+    float Score() {
+        if (options.score_high <= options.score_low) return options.score_low;
+        return (float)(options.score_low + (options.score_high - options.score_low) * uniform(rng));
+    }
+
+    FaultKind DrawFault() {
+        double roll = uniform(rng);
+        if (roll < options.drop) return FAULT_DROP;
+        roll -= options.drop;
+        if (roll < options.reset) return FAULT_RESET;
+        roll -= options.reset;
+        if (roll < options.partial) return FAULT_PARTIAL;
+        return FAULT_NONE;
+    }
+
+    void Watch(Connection& conn, bool want_write) {
+        if (conn.want_write == want_write) return;
+        conn.want_write = want_write;
+        epoll_event event;
+        event.events = EPOLLIN;
+        if (want_write) event.events |= EPOLLOUT;
+        event.data.fd = conn.sock;
+        epoll_ctl(epoll_fd, EPOLL_CTL_MOD, conn.sock, &event);
+    }
+
+    void Close(Connection& conn, bool reset) {
+        if (reset) {
+            linger abort_close;
+            abort_close.l_onoff = 1;
+            abort_close.l_linger = 0;
+            setsockopt(conn.sock, SOL_SOCKET, SO_LINGER, &abort_close, sizeof(abort_close));
+        }
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, conn.sock, nullptr);
+        closesocket(conn.sock);
+        counters.open--;
+        connections.erase(conn.sock);    // Destroys conn
+    }
+
+    // Returns false if the connection was closed
+    bool Flush(Connection& conn) {
+        while (conn.out_offset < conn.out.size()) {
+            ssize_t sent = send(conn.sock, conn.out.data() + conn.out_offset, conn.out.size() - conn.out_offset, MSG_NOSIGNAL);
+            if (sent > 0) {
+                conn.out_offset += (size_t)sent;
+                continue;
+            }
+            if (sent < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                Watch(conn, true);
+                return true;
+            }
+            if (sent < 0 && errno == EINTR) continue;
+            Close(conn, false);
+            return false;
+        }
+        conn.out.clear();
+        conn.out_offset = 0;
+        Watch(conn, false);
+        return true;
+    }
+
+    // Returns false if the connection was closed
+    bool Deliver(Connection& conn, FaultKind fault, const std::string& frame) {
+        switch (fault) {
+            case FAULT_RESET:
+                counters.resets++;
+                Close(conn, true);
+                return false;
+            case FAULT_PARTIAL:
+                // Whatever is queued goes first, then half of this frame, then FIN
+                counters.partials++;
+                conn.out.append(frame, 0, frame.size() / 2);
+                if (Flush(conn)) Close(conn, false);
+                return false;
+            default:
+                conn.out += frame;
+                return Flush(conn);
+        }
+    }
+
+    bool EncodeAnswer(const char* body, uint32_t length, uint32_t request_id, std::string& frame, unsigned long long& items) {
+        // Every request must be well-formed protobuf; count batch items on the way
+        items = 0;
+        ProtoReader reader(body, length);
+        uint32_t field_number;
+        int wire_type;
+        while (reader.ReadTag(field_number, wire_type)) {
+            if (options.mode == MODE_BATCH) {
+                ProtoBytes item;
+                if (field_number != (uint32_t)scoring::ScoringBatchRequest::requests_field || wire_type != 2 ||
+                    !reader.ReadLengthDelimited(item)) return false;
+                ProtoReader item_reader(item.data, item.length);
+                while (item_reader.ReadTag(field_number, wire_type)) item_reader.Skip(wire_type);
+                if (item_reader.Status() != PROTO_DECODE_OK) return false;
+                items++;
+            } else {
+                reader.Skip(wire_type);
+            }
+        }
+        if (reader.Status() != PROTO_DECODE_OK) return false;
+        if (options.mode != MODE_BATCH) items = 1;
+
+        frame.resize(16 + (size_t)items * 8);
+        ProtoWriter out(&frame[0], frame.size());
+        size_t mark = out.BeginFrame();
+        if (options.mode == MODE_MUX) {
+            char id_bytes[4] = { (char)(request_id >> 24), (char)(request_id >> 16), (char)(request_id >> 8), (char)request_id };
+            out.Raw(id_bytes, 4);
+        }
+        if (options.mode == MODE_BATCH) {
+            for (unsigned long long i = 0; i < items; i++) {
+                size_t item_mark = scoring::ScoringBatchResponse::begin_responses(out);
+                scoring::ScoringResponse::score(out, Score());
+                scoring::ScoringBatchResponse::end_responses(out, item_mark);
+            }
+        } else {
+            scoring::ScoringResponse::score(out, Score());
+        }
+        out.EndFrame(mark);
+        frame.resize(out.Size());
+        return out.Ok();
+    }
+
+    // Returns false if the connection was closed
+    bool HandleFrame(Connection& conn, const char* payload, uint32_t length) {
+        counters.frames++;
+        uint32_t request_id = 0;
+        if (options.mode == MODE_MUX) {
+            if (length < 4) return false;
+            request_id = ((uint32_t)(unsigned char)payload[0] << 24) | ((uint32_t)(unsigned char)payload[1] << 16) |
+                         ((uint32_t)(unsigned char)payload[2] << 8) | (uint32_t)(unsigned char)payload[3];
+            payload += 4;
+            length -= 4;
+        }
+
+        std::string frame;
+        unsigned long long items;
+        if (!EncodeAnswer(payload, length, request_id, frame, items)) return false;
+        counters.requests += items;
+
+        FaultKind fault = DrawFault();
+        if (fault == FAULT_DROP) {
+            counters.dropped += items;
+            return true;
+        }
+
+        double delay_ms = LatencyMs();
+        uint64_t now_ns = NowNs();
+        uint64_t due_ns = now_ns + (uint64_t)(delay_ms > 0.0 ? delay_ms * 1e6 : 0.0);
+        if (options.mode != MODE_MUX && due_ns < conn.last_due_ns) due_ns = conn.last_due_ns;
+        conn.last_due_ns = due_ns;
+
+        if (due_ns <= now_ns) {
+            if (fault == FAULT_NONE) counters.answered += items;
+            Deliver(conn, fault, frame);
+            return true;
+        }
+        DelayedAnswer answer;
+        answer.due_ns = due_ns;
+        answer.sequence = next_sequence++;
+        answer.sock = conn.sock;
+        answer.serial = conn.serial;
+        answer.fault = fault;
+        answer.items = items;
+        answer.frame.swap(frame);
+        delayed.push(std::move(answer));
+        return true;
+    }
+
+    void OnReadable(Connection& conn) {
+        char buffer[65536];
+        for (;;) {
+            ssize_t received = recv(conn.sock, buffer, sizeof(buffer), 0);
+            if (received > 0) {
+                conn.in.append(buffer, (size_t)received);
+                if ((size_t)received < sizeof(buffer)) break;
+                continue;
+            }
+            if (received < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            if (received < 0 && errno == EINTR) continue;
+            Close(conn, false);     // Peer closed or failed
+            return;
+        }
+
+        SOCKET sock = conn.sock;
+        uint64_t serial = conn.serial;
+        while (conn.in.size() - conn.in_offset >= 4) {
+            const unsigned char* header = (const unsigned char*)conn.in.data() + conn.in_offset;
+            uint32_t length = ((uint32_t)header[0] << 24) | ((uint32_t)header[1] << 16) |
+                              ((uint32_t)header[2] << 8) | (uint32_t)header[3];
+            if (length > MAX_FRAME_BYTES) {
+                counters.bad_frames++;
+                Close(conn, false);
+                return;
+            }
+            if (conn.in.size() - conn.in_offset - 4 < length) break;
+            const char* payload = conn.in.data() + conn.in_offset + 4;
+            conn.in_offset += 4 + (size_t)length;
+            if (!HandleFrame(conn, payload, length)) {
+                auto it = connections.find(sock);
+                if (it != connections.end() && it->second->serial == serial) {
+                    counters.bad_frames++;
+                    Close(conn, false);
+                }
+                return;
+            }
+            auto it = connections.find(sock);
+            if (it == connections.end() || it->second->serial != serial) return;     // Closed by a fault
+        }
+        if (conn.in_offset == conn.in.size()) {
+            conn.in.clear();
+            conn.in_offset = 0;
+        } else if (conn.in_offset > 65536) {
+            conn.in.erase(0, conn.in_offset);
+            conn.in_offset = 0;
+        }
+    }
+
+    void OnAcceptable() {
+        for (;;) {
+            SOCKET sock = accept(listener, nullptr, nullptr);
+            if (sock == INVALID_SOCKET) return;
+            SetSocketNonBlocking(sock, true);
+            int nodelay = 1;
+            setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay));
+
+            std::unique_ptr<Connection> conn(new Connection());
+            conn->sock = sock;
+            conn->serial = next_serial++;
+            epoll_event event;
+            event.events = EPOLLIN;
+            event.data.fd = sock;
+            epoll_ctl(epoll_fd, EPOLL_CTL_ADD, sock, &event);
+            connections[sock] = std::move(conn);
+            counters.accepted++;
+            counters.open++;
+        }
+    }
+
+    void FireDue() {
+        uint64_t now_ns = NowNs();
+        while (!delayed.empty() && delayed.top().due_ns <= now_ns) {
+            DelayedAnswer answer = std::move(const_cast<DelayedAnswer&>(delayed.top()));
+            delayed.pop();
+            auto it = connections.find(answer.sock);
+            if (it == connections.end() || it->second->serial != answer.serial) continue;    // Client went away
+            if (answer.fault == FAULT_NONE) counters.answered += answer.items;
+            Deliver(*it->second, answer.fault, answer.frame);
+        }
+    }
+
+    void ArmTimer() {
+        uint64_t due_ns = delayed.empty() ? 0 : delayed.top().due_ns;
+        if (due_ns == armed_ns) return;
+        armed_ns = due_ns;
+        itimerspec spec;
+        memset(&spec, 0, sizeof(spec));
+        spec.it_value.tv_sec = (time_t)(due_ns / 1000000000ULL);
+        spec.it_value.tv_nsec = (long)(due_ns % 1000000000ULL);
+        timerfd_settime(timer_fd, TFD_TIMER_ABSTIME, &spec, nullptr);    // 0 disarms
+    }
+
+public:
+    MockLoop(const MockOptions& opts, MockCounters& shared_counters, unsigned long long seed)
+        : options(opts), counters(shared_counters), listener(INVALID_SOCKET), epoll_fd(-1), timer_fd(-1),
+          armed_ns(0), next_serial(1), next_sequence(0), rng(seed), uniform(0.0, 1.0), normal(0.0, 1.0) {}
+
+    ~MockLoop() {
+        for (auto& entry : connections) closesocket(entry.first);
+        if (listener != INVALID_SOCKET) closesocket(listener);
+        if (timer_fd >= 0) close(timer_fd);
+        if (epoll_fd >= 0) close(epoll_fd);
+    }
+
+    bool Listen(std::string& error) {
+        listener = socket(AF_INET, SOCK_STREAM, 0);
+        if (listener == INVALID_SOCKET) {
+            error = std::string("socket: ") + strerror(errno);
+            return false;
+        }
+        int on = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        setsockopt(listener, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on));
+        sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_port = htons((unsigned short)options.port);
+        if (inet_pton(AF_INET, options.bind.c_str(), &address.sin_addr) != 1) {
+            error = "invalid bind address " + options.bind;
+            return false;
+        }
+        if (bind(listener, (sockaddr*)&address, sizeof(address)) != 0 || listen(listener, 1024) != 0) {
+            error = "bind " + options.bind + ":" + std::to_string(options.port) + ": " + strerror(errno);
+            return false;
+        }
+        SetSocketNonBlocking(listener, true);
+
+        epoll_fd = epoll_create1(0);
+        timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+        if (epoll_fd < 0 || timer_fd < 0) {
+            error = std::string("epoll/timerfd: ") + strerror(errno);
+            return false;
+        }
+        epoll_event event;
+        event.events = EPOLLIN;
+        event.data.fd = listener;
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listener, &event);
+        event.data.fd = timer_fd;
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timer_fd, &event);
+        return true;
+    }
+
+    void Run(const std::atomic<bool>& running) {
+        epoll_event events[256];
+        while (running.load(std::memory_order_relaxed)) {
+            int ready = epoll_wait(epoll_fd, events, 256, 100);
+            for (int i = 0; i < ready; i++) {
+                int fd = events[i].data.fd;
+                if (fd == listener) {
+                    OnAcceptable();
+                } else if (fd == timer_fd) {
+                    uint64_t expirations;
+                    ssize_t ignored = read(timer_fd, &expirations, sizeof(expirations));
+                    (void)ignored;
+                    armed_ns = 0;
+                } else {
+                    auto it = connections.find(fd);
+                    if (it == connections.end()) continue;
+                    Connection& conn = *it->second;
+                    if ((events[i].events & EPOLLOUT) && !Flush(conn)) continue;
+                    if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) OnReadable(conn);
+                }
+            }
+            FireDue();
+            ArmTimer();
+        }
+    }
+};
+
+//+------------------------------------------------------------------+
+//| Command line                                                   |
+//+------------------------------------------------------------------+
+
+static bool ParseProbability(const char* text, double& out) {
+    char* end;
+    out = strtod(text, &end);
+    return *end == '\0' && out >= 0.0 && out <= 1.0;
+}
+
+static bool ParseLatency(const std::string& text, LatencySpec& spec) {
+    size_t colon = text.find(':');
+    if (colon == std::string::npos) return false;
+    std::string kind = text.substr(0, colon);
+    const char* values = text.c_str() + colon + 1;
+    if (kind == "fixed") {
+        spec.kind = LATENCY_FIXED;
+        return sscanf(values, "%lf", &spec.a) == 1 && spec.a >= 0.0;
+    }
+    if (kind == "lognormal") {
+        spec.kind = LATENCY_LOGNORMAL;
+        return sscanf(values, "%lf,%lf", &spec.a, &spec.b) == 2 && spec.a >= 0.0 && spec.b >= 0.0;
+    }
+    if (kind == "bimodal") {
+        spec.kind = LATENCY_BIMODAL;
+        return sscanf(values, "%lf,%lf,%lf", &spec.a, &spec.b, &spec.c) == 3 && spec.a >= 0.0 && spec.b >= 0.0 &&
+               spec.c >= 0.0 && spec.c <= 1.0;
+    }
+    return false;
+}
+
+static std::string DescribeLatency(const LatencySpec& spec) {
+    char text[96];
+    switch (spec.kind) {
+        case LATENCY_FIXED: snprintf(text, sizeof(text), "fixed %.3f ms", spec.a); break;
+        case LATENCY_LOGNORMAL: snprintf(text, sizeof(text), "lognormal median %.3f ms sigma %.2f", spec.a, spec.b); break;
+        case LATENCY_BIMODAL: snprintf(text, sizeof(text), "%.3f ms, %.3f ms spikes %.2f%% of the time", spec.a, spec.b, spec.c * 100.0); break;
+    }
+    return text;
+}
+
+static int Usage() {
+    std::cerr << "Usage: mock_scoring_server [--bind ADDR] [--port N] [--mode direct|mux|batch] [--score X[,Y]]\n"
+                 "                           [--latency fixed:MS|lognormal:MEDIAN,SIGMA|bimodal:BASE,SPIKE,P]\n"
+                 "                           [--drop P] [--reset P] [--partial P] [--threads N] [--stats-sec N] [--seed N]"
+              << std::endl;
+    return 2;
+}
+
+static void PrintCounters(const MockCounters& counters, const char* prefix, unsigned long long rate) {
+    std::cout << prefix << "req/s=" << rate
+              << " requests=" << counters.requests.load()
+              << " answered=" << counters.answered.load()
+              << " dropped=" << counters.dropped.load()
+              << " resets=" << counters.resets.load()
+              << " partials=" << counters.partials.load()
+              << " bad_frames=" << counters.bad_frames.load()
+              << " connections=" << counters.open.load() << "/" << counters.accepted.load()
+              << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    MockOptions options;
+    options.seed = (unsigned long long)std::chrono::system_clock::now().time_since_epoch().count();
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (i + 1 >= argc) return Usage();
+        const char* value = argv[++i];
+        if (arg == "--bind") {
+            options.bind = value;
+        } else if (arg == "--port") {
+            options.port = atoi(value);
+            if (options.port <= 0 || options.port > 65535) return Usage();
+        } else if (arg == "--mode") {
+            std::string mode = value;
+            if (mode == "direct") options.mode = MODE_DIRECT;
+            else if (mode == "mux") options.mode = MODE_MUX;
+            else if (mode == "batch") options.mode = MODE_BATCH;
+            else return Usage();
+        } else if (arg == "--score") {
+            int fields = sscanf(value, "%f,%f", &options.score_low, &options.score_high);
+            if (fields < 1) return Usage();
+            if (fields == 1) options.score_high = options.score_low;
+        } else if (arg == "--latency") {
+            if (!ParseLatency(value, options.latency)) return Usage();
+        } else if (arg == "--drop") {
+            if (!ParseProbability(value, options.drop)) return Usage();
+        } else if (arg == "--reset") {
+            if (!ParseProbability(value, options.reset)) return Usage();
+        } else if (arg == "--partial") {
+            if (!ParseProbability(value, options.partial)) return Usage();
+        } else if (arg == "--threads") {
+            options.threads = atoi(value);
+            if (options.threads < 1 || options.threads > 64) return Usage();
+        } else if (arg == "--stats-sec") {
+            options.stats_sec = atoi(value);
+            if (options.stats_sec < 0) return Usage();
+        } else if (arg == "--seed") {
+            options.seed = strtoull(value, nullptr, 10);
+        } else {
+            return Usage();
+        }
+    }
+    if (options.drop + options.reset + options.partial > 1.0) {
+        std::cerr << "--drop + --reset + --partial must not exceed 1" << std::endl;
+        return 2;
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = OnSignal;
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+    signal(SIGPIPE, SIG_IGN);
+
+    MockCounters counters;
+    std::vector<std::unique_ptr<MockLoop>> loops;
+    for (int t = 0; t < options.threads; t++) {
+        loops.emplace_back(new MockLoop(options, counters, options.seed + (unsigned long long)t));
+        std::string error;
+        if (!loops.back()->Listen(error)) {
+            std::cerr << "mock_scoring_server: " << error << std::endl;
+            return 1;
+        }
+    }
+
+    static const char* mode_names[] = { "direct", "mux", "batch" };
+    std::cout << "Mock scoring service on " << options.bind << ":" << options.port
+              << " (" << mode_names[options.mode] << " framing, " << options.threads << " loop(s))" << std::endl;
+    std::cout << "  latency: " << DescribeLatency(options.latency) << std::endl;
+    std::cout << "  faults:  drop " << options.drop << ", reset " << options.reset << ", partial " << options.partial << std::endl;
+
+    std::atomic<bool> running(true);
+    std::vector<std::thread> threads;
+    for (auto& loop : loops) {
+        MockLoop* raw = loop.get();
+        threads.emplace_back([raw, &running]() { raw->Run(running); });
+    }
+
+    auto started = std::chrono::steady_clock::now();
+    auto last_report = started;
+    unsigned long long last_requests = 0;
+    while (!stop_requested) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        auto now = std::chrono::steady_clock::now();
+        if (options.stats_sec > 0 && now - last_report >= std::chrono::seconds(options.stats_sec)) {
+            unsigned long long requests = counters.requests.load();
+            double seconds = std::chrono::duration<double>(now - last_report).count();
+            PrintCounters(counters, "", (unsigned long long)((requests - last_requests) / seconds));
+            last_requests = requests;
+            last_report = now;
+        }
+    }
+
+    running = false;
+    for (std::thread& thread : threads) thread.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+    PrintCounters(counters, "TOTAL ", seconds > 0.0 ? (unsigned long long)(counters.requests.load() / seconds) : 0);
+    return 0;
+}
@@ -0,0 +1,306 @@
+//+------------------------------------------------------------------+
+//| Protobuf Schema Generator - scoring.proto -> scoring_schema.h   |
+//| Run by build_official_plugin.bat before the plugin is compiled  |
+//+------------------------------------------------------------------+
+//
+// Usage: proto_schema_gen [scoring.proto] [scoring_schema.h]
+//
+// For every field of every message the generated header holds the field
+// number, the wire type, the tag pre-encoded as a constexpr ProtoTag and a
+// typed encoder writing into a ProtoWriter:
+//
+//   namespace scoring { namespace ScoringRequest {
+//       constexpr int open_price_field = 1;
+//       constexpr ProtoTag open_price_tag = { { 0x0D, 0x00, 0x00 }, 1 };
+//       inline void open_price(ProtoWriter& out, float value) { ... }
+//   } }
+//
+// Encoders accept exactly the proto type (float, int64_t, ...); any other
+// argument type matches a deleted overload, so a field whose type or name
+// drifts from scoring.proto fails the plugin build instead of being
+// mis-encoded at run time.
+//
+// Only the proto3 subset scoring.proto uses is understood: scalar fields,
+// string/bytes, repeated, and fields of message types declared in the same
+// file. Anything else stops the build with a file:line error.
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <set>
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+
+struct FieldDef {
+    std::string type;
+    std::string name;
+    int number;
+    bool repeated;
+    int line;
+};
+
+struct MessageDef {
+    std::string name;
+    std::vector<FieldDef> fields;
+};
+
+struct ScalarType {
+    const char* proto;
+    const char* cpp;       // Parameter type of the generated encoder
+    int wire_type;
+    const char* write;     // ProtoWriter call that writes the value after the tag
+};
+
+static const ScalarType scalar_types[] = {
+    { "float",  "float",    5, "out.Fixed32(value);" },
+    { "double", "double",   1, "out.Fixed64(value);" },
+    { "int32",  "int32_t",  0, "out.Varint((uint64_t)(int64_t)value);" },
+    { "int64",  "int64_t",  0, "out.Varint((uint64_t)value);" },
+    { "uint32", "uint32_t", 0, "out.Varint(value);" },
+    { "uint64", "uint64_t", 0, "out.Varint(value);" },
+    { "bool",   "bool",     0, "out.Varint(value ? 1 : 0);" },
+};
+
+static std::string input_path;
+static int errors = 0;
+
+static void Error(int line, const std::string& message) {
+    std::cerr << input_path << ":" << line << ": error: " << message << std::endl;
+    errors++;
+}
+
+static const ScalarType* FindScalar(const std::string& type) {
+    for (const ScalarType& scalar : scalar_types) {
+        if (type == scalar.proto) return &scalar;
+    }
+    return nullptr;
+}
+
+static std::string StripComment(const std::string& line) {
+    size_t comment = line.find("//");
+    return comment == std::string::npos ? line : line.substr(0, comment);
+}
+
+static bool IsIdentifier(const std::string& s) {
+    if (s.empty() || !(isalpha((unsigned char)s[0]) || s[0] == '_')) return false;
+    for (char c : s) {
+        if (!(isalnum((unsigned char)c) || c == '_')) return false;
+    }
+    return true;
+}
+
+static bool Parse(std::istream& in, std::string& package, std::vector<MessageDef>& messages) {
+    std::string raw;
+    int line_number = 0;
+    int depth = 0;                 // Brace depth; fields live at depth 1 inside a message
+    bool in_message = false;
+
+    while (std::getline(in, raw)) {
+        line_number++;
+        std::string line = StripComment(raw);
+        std::istringstream tokens(line);
+        std::string first;
+        if (!(tokens >> first)) continue;
+
+        if (depth == 0) {
+            if (first == "syntax") {
+                if (line.find("\"proto3\"") == std::string::npos) Error(line_number, "only proto3 is supported");
+            } else if (first == "package") {
+                tokens >> package;
+                if (!package.empty() && package.back() == ';') package.pop_back();
+            } else if (first == "message") {
+                MessageDef message;
+                tokens >> message.name;
+                if (!IsIdentifier(message.name)) Error(line_number, "bad message name");
+                messages.push_back(message);
+                in_message = true;
+            } else if (first == "service") {
+                in_message = false;
+            } else {
+                Error(line_number, "unsupported top-level statement '" + first + "'");
+            }
+            if (line.find('{') != std::string::npos) depth++;
+            continue;
+        }
+
+        if (first == "}") {
+            depth--;
+            continue;
+        }
+        if (!in_message) {
+            // Service bodies (rpc ...) are not needed for encoding
+            if (line.find('{') != std::string::npos) depth++;
+            if (line.find('}') != std::string::npos) depth--;
+            continue;
+        }
+        if (depth != 1) {
+            Error(line_number, "nested declarations are not supported");
+            continue;
+        }
+
+        // [repeated] type name = number;
+        FieldDef field;
+        field.repeated = (first == "repeated");
+        field.type = field.repeated ? "" : first;
+        if (field.repeated) tokens >> field.type;
+        std::string equals, number;
+        tokens >> field.name >> equals >> number;
+        if (!number.empty() && number.back() == ';') number.pop_back();
+
+        if (first == "optional" || first == "oneof" || first == "map" || first == "enum" || first == "reserved") {
+            Error(line_number, "'" + first + "' is not supported by proto_schema_gen");
+            continue;
+        }
+        if (!IsIdentifier(field.name) || equals != "=" || number.empty() ||
+            number.find_first_not_of("0123456789") != std::string::npos) {
+            Error(line_number, "cannot parse field declaration");
+            continue;
+        }
+        field.number = atoi(number.c_str());
+        field.line = line_number;
+        if (field.number < 1 || field.number > (1 << 18) - 1 || (field.number >= 19000 && field.number <= 19999)) {
+            Error(line_number, "field number " + number + " is out of range");
+            continue;
+        }
+        messages.back().fields.push_back(field);
+    }
+
+    if (depth != 0) Error(line_number, "unbalanced braces");
+    return errors == 0;
+}
+
+static bool Validate(const std::vector<MessageDef>& messages) {
+    std::set<std::string> message_names;
+    for (const MessageDef& message : messages) {
+        if (!message_names.insert(message.name).second) {
+            Error(0, "duplicate message " + message.name);
+        }
+    }
+    for (const MessageDef& message : messages) {
+        std::set<int> numbers;
+        std::set<std::string> names;
+        for (const FieldDef& field : message.fields) {
+            if (!numbers.insert(field.number).second) {
+                Error(field.line, message.name + "." + field.name + " reuses field number " + std::to_string(field.number));
+            }
+            if (!names.insert(field.name).second) {
+                Error(field.line, message.name + " declares '" + field.name + "' twice");
+            }
+            if (!FindScalar(field.type) && field.type != "string" && field.type != "bytes" && !message_names.count(field.type)) {
+                Error(field.line, "unknown type '" + field.type + "'");
+            }
+        }
+    }
+    return errors == 0;
+}
+
+static int WireType(const FieldDef& field) {
+    const ScalarType* scalar = FindScalar(field.type);
+    return scalar ? scalar->wire_type : 2;
+}
+
+static std::string TagInitializer(const FieldDef& field) {
+    unsigned value = ((unsigned)field.number << 3) | (unsigned)WireType(field);
+    unsigned char bytes[3] = { 0, 0, 0 };
+    int size = 0;
+    while (value >= 0x80) {
+        bytes[size++] = (unsigned char)((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    bytes[size++] = (unsigned char)value;
+
+    char text[64];
+    snprintf(text, sizeof(text), "{ { 0x%02X, 0x%02X, 0x%02X }, %d }", bytes[0], bytes[1], bytes[2], size);
+    return text;
+}
+
+static void Generate(std::ostream& out, const std::string& package, const std::vector<MessageDef>& messages) {
+    out << "//+------------------------------------------------------------------+\n"
+        << "//| GENERATED by proto_schema_gen from " << input_path << " - do not edit\n"
+        << "//+------------------------------------------------------------------+\n\n"
+        << "#pragma once\n\n"
+        << "#include <cstdint>\n"
+        << "#include <cstring>\n\n"
+        << "#include \"ABBook_ProtoWriter.h\"\n\n";
+
+    std::string ns = package.empty() ? "scoring" : package;
+    out << "namespace " << ns << " {\n";
+
+    for (const MessageDef& message : messages) {
+        out << "\nnamespace " << message.name << " {\n";
+        for (const FieldDef& field : message.fields) {
+            const ScalarType* scalar = FindScalar(field.type);
+            const std::string& n = field.name;
+
+            out << "\n    // " << (field.repeated ? "repeated " : "") << field.type << " " << n << " = " << field.number << ";\n"
+                << "    constexpr int " << n << "_field = " << field.number << ";\n"
+                << "    constexpr int " << n << "_wire_type = " << WireType(field) << ";\n"
+                << "    constexpr ProtoTag " << n << "_tag = " << TagInitializer(field) << ";\n";
+
+            if (scalar) {
+                out << "    inline void " << n << "(ProtoWriter& out, " << scalar->cpp << " value) { out.Tag(" << n << "_tag); "
+                    << scalar->write << " }\n"
+                    << "    template <typename T> void " << n << "(ProtoWriter&, T) = delete; // " << field.type << " only\n";
+            } else if (field.type == "string" || field.type == "bytes") {
+                out << "    inline void " << n << "(ProtoWriter& out, const char* data, size_t length) { out.Tag(" << n << "_tag); "
+                    << "out.LengthDelimited(data, length); }\n"
+                    << "    inline void " << n << "(ProtoWriter& out, const char* text) { " << n << "(out, text, strlen(text)); }\n";
+            } else {
+                // Embedded message: the caller writes the sub-message between begin and end
+                out << "    inline size_t begin_" << n << "(ProtoWriter& out) { out.Tag(" << n << "_tag); return out.BeginLength(); }\n"
+                    << "    inline void end_" << n << "(ProtoWriter& out, size_t mark) { out.EndMessage(mark); }\n";
+            }
+        }
+        out << "\n} // namespace " << message.name << "\n";
+    }
+    out << "\n} // namespace " << ns << "\n";
+}
+
+int main(int argc, char* argv[]) {
+    input_path = argc > 1 ? argv[1] : "scoring.proto";
+    std::string output_path = argc > 2 ? argv[2] : "scoring_schema.h";
+
+    std::ifstream in(input_path);
+    if (!in.is_open()) {
+        std::cerr << "proto_schema_gen: cannot open " << input_path << std::endl;
+        return 1;
+    }
+
+    std::string package;
+    std::vector<MessageDef> messages;
+    if (!Parse(in, package, messages) || !Validate(messages)) {
+        std::cerr << "proto_schema_gen: " << errors << " error(s), " << output_path << " not written" << std::endl;
+        return 1;
+    }
+
+    std::ostringstream generated;
+    Generate(generated, package, messages);
+
+    // Leave an up-to-date header untouched so its timestamp does not change
+    std::ifstream existing(output_path, std::ios::binary);
+    if (existing.is_open()) {
+        std::ostringstream current;
+        current << existing.rdbuf();
+        if (current.str() == generated.str()) {
+            std::cout << "proto_schema_gen: " << output_path << " is up to date" << std::endl;
+            return 0;
+        }
+        existing.close();
+    }
+
+    std::ofstream out(output_path, std::ios::binary);
+    if (!out.is_open()) {
+        std::cerr << "proto_schema_gen: cannot write " << output_path << std::endl;
+        return 1;
+    }
+    out << generated.str();
+
+    size_t field_count = 0;
+    for (const MessageDef& message : messages) field_count += message.fields.size();
+    std::cout << "proto_schema_gen: wrote " << output_path << " (" << messages.size() << " messages, "
+              << field_count << " fields)" << std::endl;
+    return 0;
+}
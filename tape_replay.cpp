@@ -0,0 +1,217 @@
+//+------------------------------------------------------------------+
+//| Trade Tape Replayer - *.abt -> TradeRouter                      |
+//| Drives the plugin's entry points from a recorded trade tape    |
+//+------------------------------------------------------------------+
+//
+// Usage: tape_replay [options] tape.abt [tape.abt ...]
+//
+//   --config PATH        plugin configuration (default ABBook_Config.ini)
+//   --speed X            replay X times faster than recorded (default 1 = original pace)
+//   --max                flat out: no pacing, every thread calls as fast as it can
+//   --threads N          calling threads (default 4)
+//   --loops N            play the tape N times back to back (default 1)
+//   --log PATH           plugin log file (default tape_replay.log)
+//
+// Several tapes are played one after the other. Calls are spread over the
+// threads by login, so each account's calls keep their recorded order on one
+// thread, as they do in the server; with --threads 1 the whole tape is
+// replayed in recorded order. Each call gets fresh copies of its TradeRecord
+// and UserInfo. Paced replays report how late calls went out (schedule lag),
+// so a replay that could not keep up is visible.
+//
+// The router runs with the given config, scoring service, journal and all:
+// point CVM_IP at mock_scoring_server for a local run, and compare the
+// decision journals of two runs (journal_decode --summary) for regressions.
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "ABBook_TradeRouter.h"
+#include "ABBook_TradeTape.h"
+#include "ABBook_LatencyStats.h"
+
+struct ReplayOptions {
+    std::string config_path = "ABBook_Config.ini";
+    std::string log_path = "tape_replay.log";
+    double speed = 1.0;                  // 0 = flat out
+    int threads = 4;
+    int loops = 1;
+};
+
+struct ReplayCall {
+    uint64_t due_ns;                     // Since replay start, already divided by the speed
+    const TapeRecord* record;
+};
+
+struct ReplayResults {
+    LatencyHistogram trade_latency;
+    LatencyHistogram login_latency;
+    LatencyHistogram schedule_lag;
+    std::atomic<unsigned long long> routed{0};          // TradeTransaction returned 0
+    std::atomic<unsigned long long> passed{0};          // Returned 1: not a new market order
+};
+
+static int Usage() {
+    std::cerr << "Usage: tape_replay [--config PATH] [--speed X | --max] [--threads N] [--loops N] [--log PATH] tape.abt [...]"
+              << std::endl;
+    return 2;
+}
+
+static void ReplayThread(TradeRouter& router, const std::vector<ReplayCall>& calls, bool paced,
+                         std::chrono::steady_clock::time_point start, ReplayResults& results) {
+    for (const ReplayCall& call : calls) {
+        if (paced) {
+            std::chrono::steady_clock::time_point due = start + std::chrono::nanoseconds(call.due_ns);
+            std::this_thread::sleep_until(due);
+            long long lag_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - due).count();
+            results.schedule_lag.Record(lag_ns > 0 ? (uint64_t)lag_ns : 0);
+        }
+
+        UserInfo user;
+        TapeToAccount(call.record->account, user);
+        auto begin = std::chrono::steady_clock::now();
+        if (call.record->event == TAPE_EVENT_TRADE) {
+            TradeRecord trade;
+            TapeToTrade(call.record->trade, trade);
+            int result = router.TradeTransaction(&trade, &user);
+            results.trade_latency.Record((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - begin).count());
+            (result == 0 ? results.routed : results.passed)++;
+        } else {
+            router.UserLogin(&user);
+            results.login_latency.Record((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - begin).count());
+        }
+    }
+}
+
+static void PrintRow(const char* label, const LatencyHistogram& histogram) {
+    LatencyCounts counts;
+    counts.Add(histogram);
+    LatencySummary s = counts.Summarize();
+    if (s.count == 0) return;
+    printf("  %-24s %10llu %10.1f %10.1f %10.1f %10.1f %10.1f\n", label, (unsigned long long)s.count,
+           s.mean_ns / 1000.0, s.p50_ns / 1000.0, s.p99_ns / 1000.0, s.p999_ns / 1000.0, s.max_ns / 1000.0);
+}
+
+int main(int argc, char* argv[]) {
+    ReplayOptions options;
+    std::vector<std::string> tapes;
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--max") {
+            options.speed = 0.0;
+            continue;
+        }
+        if (arg.compare(0, 2, "--") != 0) {
+            tapes.push_back(arg);
+            continue;
+        }
+        if (i + 1 >= argc) return Usage();
+        const char* value = argv[++i];
+        if (arg == "--config") {
+            options.config_path = value;
+        } else if (arg == "--log") {
+            options.log_path = value;
+        } else if (arg == "--speed") {
+            options.speed = atof(value);
+            if (options.speed <= 0.0) return Usage();
+        } else if (arg == "--threads") {
+            options.threads = atoi(value);
+            if (options.threads < 1 || options.threads > 256) return Usage();
+        } else if (arg == "--loops") {
+            options.loops = atoi(value);
+            if (options.loops < 1) return Usage();
+        } else {
+            return Usage();
+        }
+    }
+    if (tapes.empty()) return Usage();
+
+    // Load every tape; later tapes (and loops) start where the previous one ended
+    std::vector<TapeRecord> records;
+    std::vector<uint64_t> tape_offsets;      // Per record, on the concatenated timeline
+    uint64_t timeline_end_ns = 0;
+    unsigned long long trades = 0, logins = 0;
+    for (const std::string& path : tapes) {
+        TapeFileHeader header;
+        std::vector<TapeRecord> tape;
+        std::string error;
+        if (!ReadTradeTape(path, header, tape, error)) {
+            std::cerr << "tape_replay: " << error << std::endl;
+            return 1;
+        }
+        for (const TapeRecord& record : tape) {
+            records.push_back(record);
+            tape_offsets.push_back(timeline_end_ns + record.offset_ns);
+            (record.event == TAPE_EVENT_TRADE ? trades : logins)++;
+        }
+        if (!tape.empty()) timeline_end_ns += tape.back().offset_ns + 1;
+    }
+    if (records.empty()) {
+        std::cerr << "tape_replay: no calls on the tape" << std::endl;
+        return 1;
+    }
+
+    std::vector<std::vector<ReplayCall>> per_thread(options.threads);
+    for (int loop = 0; loop < options.loops; loop++) {
+        for (size_t i = 0; i < records.size(); i++) {
+            uint64_t offset_ns = (uint64_t)loop * timeline_end_ns + tape_offsets[i];
+            ReplayCall call;
+            call.due_ns = options.speed > 0.0 ? (uint64_t)((double)offset_ns / options.speed) : 0;
+            call.record = &records[i];
+            uint32_t login = (uint32_t)records[i].account.login;
+            per_thread[login % (uint32_t)options.threads].push_back(call);
+        }
+    }
+
+    printf("Tape: %llu calls (%llu trades, %llu logins) over %.3f s recorded\n", (unsigned long long)records.size(),
+           trades, logins, timeline_end_ns / 1e9);
+    if (options.speed > 0.0) {
+        printf("Replay: %gx speed, %d thread(s), %d loop(s), config %s\n", options.speed, options.threads, options.loops,
+               options.config_path.c_str());
+    } else {
+        printf("Replay: flat out, %d thread(s), %d loop(s), config %s\n", options.threads, options.loops,
+               options.config_path.c_str());
+    }
+    fflush(stdout);
+
+    // A plain object, like the plugin's g_router: TradeRouter is over-aligned
+    // (alignas(64) members) and C++14 new does not honour that
+    TradeRouter router(options.log_path, false);
+    router.Startup(options.config_path);
+
+    ReplayResults results;
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int t = 0; t < options.threads; t++) {
+        const std::vector<ReplayCall>* calls = &per_thread[t];
+        TradeRouter* target = &router;
+        bool paced = options.speed > 0.0;
+        threads.emplace_back([target, calls, paced, start, &results]() { ReplayThread(*target, *calls, paced, start, results); });
+    }
+    for (std::thread& thread : threads) thread.join();
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::string stage_report = router.LatencyReport();
+    router.Cleanup();
+
+    unsigned long long calls = (unsigned long long)records.size() * (unsigned long long)options.loops;
+    printf("\nElapsed %.3f s: %.0f calls/s, %.0f trades/s\n", elapsed, calls / elapsed,
+           (double)trades * options.loops / elapsed);
+    printf("Trades: %llu routed, %llu not new market orders\n\n", results.routed.load(), results.passed.load());
+    printf("  %-24s %10s %10s %10s %10s %10s %10s\n", "latency (us)", "count", "mean", "p50", "p99", "p99.9", "max");
+    PrintRow("MtSrvTradeTransaction", results.trade_latency);
+    PrintRow("MtSrvUserLogin", results.login_latency);
+    PrintRow("schedule lag", results.schedule_lag);
+    printf("\n%s\n", stage_report.c_str());
+    return 0;
+}
@@ -0,0 +1,151 @@
+//+------------------------------------------------------------------+
+//| Circuit Breaker Test                                            |
+//| Concurrent failures trip the breaker once, recovery is probed  |
+//| in the background with a growing interval, then closes         |
+//+------------------------------------------------------------------+
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <functional>
+
+#include "ABBook_CircuitBreaker.h"
+
+static int failures = 0;
+
+static void Check(bool condition, const std::string& name) {
+    std::cout << (condition ? "PASS: " : "FAIL: ") << name << std::endl;
+    if (!condition) failures++;
+}
+
+static bool WaitFor(const std::function<bool()>& condition) {
+    for (int i = 0; i < 5000 && !condition(); i++) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return condition();
+}
+
+// Stand-in for the synthetic scoring request
+struct FakeService {
+    std::mutex mutex;
+    std::vector<std::chrono::steady_clock::time_point> probes;
+    std::vector<std::thread::id> probe_threads;
+    std::atomic<bool> healthy{false};
+    std::atomic<bool> hold{false};
+
+    bool Probe() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            probes.push_back(std::chrono::steady_clock::now());
+            probe_threads.push_back(std::this_thread::get_id());
+        }
+        while (hold.load()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return healthy.load();
+    }
+
+    size_t Probes() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return probes.size();
+    }
+};
+
+static void TestTrip() {
+    FakeService service;
+    CircuitBreaker breaker([&]() { return service.Probe(); });
+    breaker.Configure(3, 60000, 60000);
+    breaker.Start();
+
+    breaker.RecordFailure();
+    breaker.RecordFailure();
+    breaker.RecordSuccess();
+    breaker.RecordFailure();
+    breaker.RecordFailure();
+    Check(breaker.AllowRequest() && breaker.Failures() == 2, "an answer resets the consecutive failure count");
+
+    // 16 trade threads failing at once: exactly one of them trips the breaker
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 16; t++) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < 1000; i++) breaker.RecordFailure();
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    Check(!breaker.AllowRequest() && breaker.State() == BREAKER_OPEN, "threshold reached: breaker open, trades take the fallback");
+    Check(breaker.Opened() == 1, "concurrent failures trip it once");
+
+    breaker.RecordSuccess();
+    Check(breaker.State() == BREAKER_OPEN, "a late answer does not close it - only a probe does");
+
+    auto start = std::chrono::steady_clock::now();
+    breaker.Stop();
+    long long waited_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    Check(waited_ms < 1000 && service.Probes() == 0, "Stop does not wait for the next probe");
+}
+
+static void TestProbeAndRecover() {
+    FakeService service;
+    CircuitBreaker breaker([&]() { return service.Probe(); });
+    std::mutex transitions_mutex;
+    std::vector<std::string> transitions;
+    breaker.SetListener([&](BreakerState from, BreakerState to) {
+        std::lock_guard<std::mutex> lock(transitions_mutex);
+        transitions.push_back(std::string(BreakerStateName(from)) + ">" + BreakerStateName(to));
+    });
+    breaker.Configure(1, 20, 80);
+    breaker.Start();
+
+    breaker.RecordFailure();
+    Check(breaker.State() == BREAKER_OPEN, "one failure trips a threshold of 1");
+
+    // Dead service: probes back off 20, 40, 80, 80 ms
+    Check(WaitFor([&]() { return service.Probes() >= 5; }), "probes keep going while the service is down");
+    {
+        std::lock_guard<std::mutex> lock(service.mutex);
+        long long first_gap = std::chrono::duration_cast<std::chrono::milliseconds>(service.probes[1] - service.probes[0]).count();
+        long long last_gap = std::chrono::duration_cast<std::chrono::milliseconds>(service.probes[4] - service.probes[3]).count();
+        Check(first_gap >= 35 && last_gap >= 75 && last_gap < 1000, "probe interval doubles up to the maximum");
+        bool background = true;
+        for (const std::thread::id& id : service.probe_threads) background = background && id != std::this_thread::get_id();
+        Check(background, "probes run on the breaker's thread");
+    }
+    Check(breaker.FailedProbes() >= 5 && !breaker.AllowRequest(), "failed probes keep it open");
+
+    // Probe in flight: half-open, trades still on the fallback
+    service.hold = true;
+    Check(WaitFor([&]() { return breaker.State() == BREAKER_HALF_OPEN; }), "breaker half-open while the probe is out");
+    Check(!breaker.AllowRequest(), "no trade goes out while half-open");
+    service.healthy = true;
+    service.hold = false;
+    Check(WaitFor([&]() { return breaker.AllowRequest(); }), "successful probe closes the breaker");
+    Check(breaker.Closed() == 1 && breaker.Failures() == 0 && breaker.OpenMs() >= 100, "time open is counted");
+
+    unsigned long long open_ms = breaker.OpenMs();
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    Check(breaker.OpenMs() == open_ms, "closed time is not counted as open");
+
+    // Trips again, first probe succeeds after the base interval
+    size_t probes = service.Probes();
+    breaker.RecordFailure();
+    Check(WaitFor([&]() { return breaker.AllowRequest(); }) && service.Probes() == probes + 1 && breaker.Opened() >= 7,
+          "second outage probed from the base interval again");
+    breaker.Stop();
+
+    std::lock_guard<std::mutex> lock(transitions_mutex);
+    Check(transitions.size() >= 3 && transitions[0] == "CLOSED>OPEN" && transitions[1] == "OPEN>HALF_OPEN" &&
+          transitions[2] == "HALF_OPEN>OPEN" && transitions.back() == "HALF_OPEN>CLOSED", "listener sees every transition");
+}
+
+int main() {
+    std::cout << "=== Circuit Breaker Test ===" << std::endl;
+    TestTrip();
+    TestProbeAndRecover();
+    std::cout << std::endl;
+    if (failures == 0) {
+        std::cout << "ALL TESTS PASSED" << std::endl;
+        return 0;
+    }
+    std::cout << failures << " TEST(S) FAILED" << std::endl;
+    return 1;
+}
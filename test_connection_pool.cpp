@@ -0,0 +1,259 @@
+//+------------------------------------------------------------------+
+//| Connection Pool Test                                            |
+//| Warm checkout/release against a loopback listener; a socket    |
+//| the peer closed while idle is dropped and redialled; the        |
+//| health thread refills the pool after a server restart          |
+//+------------------------------------------------------------------+
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <functional>
+#include <cstring>
+
+#include "ABBook_ConnectionPool.h"
+
+#ifdef _MSC_VER
+#pragma comment(lib, "ws2_32.lib")
+#endif
+
+static int failures = 0;
+
+static void Check(bool condition, const std::string& name) {
+    std::cout << (condition ? "PASS: " : "FAIL: ") << name << std::endl;
+    if (!condition) failures++;
+}
+
+// Poll `condition` for up to five seconds
+static bool WaitFor(const std::function<bool()>& condition) {
+    auto give_up = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() >= give_up) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+//+------------------------------------------------------------------+
+//| Loopback listener that holds its accepted connections           |
+//+------------------------------------------------------------------+
+
+// Accepts and keeps connections open without reading them, like an idle
+// scoring service. Can be stopped and started again on the same port.
+class LoopbackListener {
+private:
+    SOCKET listener;
+    int port;
+    std::atomic<bool> running;
+    std::thread acceptor;
+
+    std::mutex mutex;
+    std::vector<SOCKET> accepted;
+    int connections;
+
+public:
+    LoopbackListener() : listener(INVALID_SOCKET), port(0), running(false), connections(0) {}
+
+    ~LoopbackListener() { Stop(); }
+
+    // Port 0 picks a free port; a restart passes the previous one
+    bool Start(int listen_port) {
+        listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        int reuse = 1;
+        setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, (const char*)&reuse, sizeof(reuse));
+        sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons((unsigned short)listen_port);
+        socklen_t address_length = sizeof(address);
+        if (listener == INVALID_SOCKET || bind(listener, (sockaddr*)&address, sizeof(address)) != 0 ||
+            listen(listener, 16) != 0 || getsockname(listener, (sockaddr*)&address, &address_length) != 0) {
+            return false;
+        }
+        port = ntohs(address.sin_port);
+        running = true;
+        acceptor = std::thread([this]() {
+            while (running) {
+                SOCKET sock = accept(listener, nullptr, nullptr);
+                if (sock == INVALID_SOCKET) break;
+                if (!running) {
+                    closesocket(sock);
+                    break;
+                }
+                std::lock_guard<std::mutex> lock(mutex);
+                accepted.push_back(sock);
+                connections++;
+            }
+        });
+        return true;
+    }
+
+    // Close every accepted connection; the listener keeps accepting
+    void CloseAccepted() {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (SOCKET sock : accepted) closesocket(sock);
+        accepted.clear();
+    }
+
+    // Server down: nothing listens on the port and every connection is closed
+    void Stop() {
+        if (!running.exchange(false)) return;
+        SOCKET wake = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons((unsigned short)port);
+        connect(wake, (sockaddr*)&address, sizeof(address));
+        closesocket(wake);
+        acceptor.join();
+        closesocket(listener);
+        listener = INVALID_SOCKET;
+        CloseAccepted();
+    }
+
+    int Connections() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return connections;
+    }
+
+    int Port() const { return port; }
+};
+
+static PluginConfig PoolConfig(int port, int pool_size, int health_check_ms) {
+    PluginConfig config;
+    config.cvm_ip = "127.0.0.1";
+    config.cvm_port = port;
+    config.connection_pool_size = pool_size;
+    config.pool_health_check_ms = health_check_ms;
+    config.socket_timeout = 1000;
+    return config;
+}
+
+//+------------------------------------------------------------------+
+//| Tests                                                           |
+//+------------------------------------------------------------------+
+
+// Start() warms every slot; checkouts reuse them without dialling
+static void TestWarmCheckout() {
+    std::cout << "\n--- Warm checkout and release ---" << std::endl;
+    LoopbackListener server;
+    Check(server.Start(0), "loopback listener started");
+    PluginConfig config = PoolConfig(server.Port(), 2, 60000);
+    PluginLogger logger(false);
+    ScoringConnectionPool pool(&config, &logger);
+
+    Check(pool.Start() == 2 && pool.IdleConnections() == 2, "Start() warms both slots");
+    Check(WaitFor([&]() { return server.Connections() == 2; }), "one dial per slot");
+
+    int error_code = 0;
+    PooledConnection first = pool.Acquire(error_code, ScoringDeadline::In(1000));
+    PooledConnection second = pool.Acquire(error_code, ScoringDeadline::In(1000));
+    Check(first.sock != INVALID_SOCKET && first.from_pool && first.slot >= 0 && first.reader != nullptr &&
+          second.sock != INVALID_SOCKET && second.from_pool && second.slot >= 0 && second.slot != first.slot,
+          "checkouts hand out the warm sockets of distinct slots");
+    Check(pool.IdleConnections() == 0, "checked-out slots are not idle");
+
+    PooledConnection overflow = pool.Acquire(error_code, ScoringDeadline::In(1000));
+    Check(overflow.sock != INVALID_SOCKET && overflow.slot == -1 && !overflow.from_pool, "exhausted pool dials an overflow connection");
+    pool.Release(overflow, true);
+
+    SOCKET first_sock = first.sock;
+    pool.Release(first, true);
+    pool.Release(second, true);
+    Check(pool.IdleConnections() == 2 && first.sock == INVALID_SOCKET && first.slot == -1, "healthy release returns both sockets");
+
+    PooledConnection again = pool.Acquire(error_code, ScoringDeadline::In(1000));
+    Check(again.from_pool && again.sock == first_sock, "the next checkout reuses a released socket");
+    pool.Release(again, false);
+    Check(pool.IdleConnections() == 1, "unhealthy release closes the socket");
+    Check(WaitFor([&]() { return server.Connections() >= 3; }) && server.Connections() == 3,
+          "only the overflow connection was dialled after warm-up");
+
+    pool.Stop();
+    server.Stop();
+}
+
+// The service closes idle connections: the probe sees it, the checkout redials
+static void TestPeerClosedIdle() {
+    std::cout << "\n--- Peer-closed idle connection ---" << std::endl;
+    LoopbackListener server;
+    server.Start(0);
+    PluginConfig config = PoolConfig(server.Port(), 1, 60000);
+    PluginLogger logger(false);
+    ScoringConnectionPool pool(&config, &logger);
+    pool.Start();
+    Check(WaitFor([&]() { return server.Connections() == 1; }), "pool warmed");
+
+    int error_code = 0;
+    SOCKET probe = pool.Dial(error_code, ScoringDeadline::In(1000));
+    Check(WaitFor([&]() { return server.Connections() == 2; }) && ScoringConnectionPool::IsConnectionAlive(probe),
+          "idle connection to a live peer is alive");
+    server.CloseAccepted();
+    Check(WaitFor([&]() { return !ScoringConnectionPool::IsConnectionAlive(probe); }), "IsConnectionAlive sees the peer's close");
+    closesocket(probe);
+
+    PooledConnection conn = pool.Acquire(error_code, ScoringDeadline::In(1000));
+    Check(conn.sock != INVALID_SOCKET && conn.slot == 0 && !conn.from_pool, "checkout discards the closed socket and redials");
+    Check(WaitFor([&]() { return server.Connections() == 3; }) && ScoringConnectionPool::IsConnectionAlive(conn.sock),
+          "redialled connection is live");
+    pool.Release(conn, true);
+    Check(pool.IdleConnections() == 1, "redialled connection is pooled on release");
+
+    pool.Stop();
+    server.Stop();
+}
+
+// Server restart: the health thread drops dead sockets (stopping at the first
+// failed re-dial) and, once the service listens again, re-dials every slot
+// without any trade asking
+static void TestHealthRefill() {
+    std::cout << "\n--- Health thread refills after a restart ---" << std::endl;
+    LoopbackListener server;
+    server.Start(0);
+    int port = server.Port();
+    PluginConfig config = PoolConfig(port, 2, 20);
+    PluginLogger logger(false);
+    ScoringConnectionPool pool(&config, &logger);
+    Check(pool.Start() == 2, "pool warmed");
+
+    server.Stop();
+    Check(WaitFor([&]() { return pool.IdleConnections() < 2; }), "health thread drops a connection to the stopped server");
+
+    LoopbackListener restarted;
+    Check(restarted.Start(port), "server restarted on the same port");
+    Check(WaitFor([&]() { return pool.IdleConnections() == 2; }), "health thread refills every slot");
+    Check(WaitFor([&]() { return restarted.Connections() == 2; }), "refill dialled the restarted server");
+
+    int error_code = 0;
+    PooledConnection conn = pool.Acquire(error_code, ScoringDeadline::In(1000));
+    Check(conn.from_pool && restarted.Connections() == 2, "checkout after the refill is warm");
+    pool.Release(conn, true);
+
+    pool.Stop();
+    restarted.Stop();
+}
+
+int main() {
+    std::cout << "=== Connection Pool Test ===" << std::endl;
+    WSADATA wsa;
+    WSAStartup(MAKEWORD(2, 2), &wsa);
+
+    TestWarmCheckout();
+    TestPeerClosedIdle();
+    TestHealthRefill();
+
+    WSACleanup();
+    std::cout << std::endl;
+    if (failures == 0) {
+        std::cout << "ALL TESTS PASSED" << std::endl;
+        return 0;
+    }
+    std::cout << failures << " TEST(S) FAILED" << std::endl;
+    return 1;
+}
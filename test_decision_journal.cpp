@@ -0,0 +1,230 @@
+//+------------------------------------------------------------------+
+//| Decision Journal Test                                           |
+//| Record layout, concurrent appends, roll-over to a new file     |
+//| and reading the files back                                      |
+//+------------------------------------------------------------------+
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <set>
+#include <chrono>
+#include <cstring>
+#include <cstdio>
+
+#include "ABBook_DecisionJournal.h"
+
+static int failures = 0;
+
+static void Check(bool condition, const std::string& name) {
+    std::cout << (condition ? "PASS: " : "FAIL: ") << name << std::endl;
+    if (!condition) failures++;
+}
+
+static const char* PREFIX = "test_decision_journal";
+
+static void RemoveJournalFiles(uint64_t timestamp_us) {
+    time_t seconds = (time_t)(timestamp_us / 1000000);
+    struct tm utc;
+#ifdef _WIN32
+    gmtime_s(&utc, &seconds);
+#else
+    gmtime_r(&seconds, &utc);
+#endif
+    char date[16];
+    strftime(date, sizeof(date), "%Y%m%d", &utc);
+    for (int n = 0; n < 20; n++) {
+        remove((std::string(PREFIX) + "_" + date + "_" + std::to_string(n) + ".abj").c_str());
+    }
+}
+
+static DecisionRecord MakeRecord(int order, uint64_t timestamp_us) {
+    DecisionRecord record;
+    memset(&record, 0, sizeof(record));
+    record.timestamp_us = timestamp_us;
+    record.order = order;
+    record.login = 1000 + order % 7;
+    JournalCopyField(record.symbol, sizeof(record.symbol), "EURUSD", 6);
+    JournalCopyField(record.group, sizeof(record.group), "FXMajors", 8);
+    record.score = 0.25f;
+    record.threshold = 0.08f;
+    record.decision = JOURNAL_B_BOOK;
+    record.score_source = order % 2 ? SCORE_SOURCE_ML : SCORE_SOURCE_FALLBACK_BUDGET;
+    record.request_hash = 0x9E3779B97F4A7C15ULL * (uint64_t)order;
+    return record;
+}
+
+static void TestLayout() {
+    Check(offsetof(DecisionRecord, timestamp_us) == 8 && offsetof(DecisionRecord, open_price) == 64 &&
+          offsetof(DecisionRecord, decision) == 96, "record fields at fixed offsets");
+
+    char field[12];
+    JournalCopyField(field, sizeof(field), "GBPUSDMICRO1X", 13);
+    Check(memcmp(field, "GBPUSDMICRO1", 12) == 0, "long text is truncated to the field");
+    JournalCopyField(field, sizeof(field), "BTC", 3);
+    Check(field[3] == 0 && field[11] == 0, "short text is NUL padded");
+}
+
+static void TestConcurrentAppend() {
+    uint64_t now = JournalNowUs();
+    RemoveJournalFiles(now);
+
+    const int thread_count = 8;
+    const int per_thread = 5000;
+    const uint64_t capacity = 4096;       // 40000 records -> 10 files
+    std::vector<std::string> paths;
+    {
+        DecisionJournal journal;
+        Check(journal.Open(PREFIX, capacity), "journal file created");
+        paths.push_back(journal.CurrentPath());
+
+        std::vector<std::thread> threads;
+        for (int t = 0; t < thread_count; t++) {
+            threads.emplace_back([&, t]() {
+                for (int i = 0; i < per_thread; i++) {
+                    journal.Append(MakeRecord(t * per_thread + i + 1, now));
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        Check(journal.Appended() == (unsigned long long)(thread_count * per_thread) && journal.Lost() == 0,
+              "every append accepted across roll-overs");
+        journal.Close();
+        Check(!journal.Append(MakeRecord(1, now)), "append after Close is refused");
+    }
+
+    // Collect every file of the run
+    std::vector<DecisionRecord> records;
+    size_t files = 0;
+    std::string base = paths[0].substr(0, paths[0].rfind('_') + 1);
+    for (int n = 0; n < 20; n++) {
+        std::string error;
+        if (ReadJournalFile(base + std::to_string(n) + ".abj", records, error)) files++;
+    }
+    Check(files == (thread_count * per_thread + capacity - 1) / capacity, "full files roll over to <prefix>_<date>_<n>.abj");
+
+    std::set<int> orders;
+    bool intact = true;
+    for (const DecisionRecord& r : records) {
+        orders.insert(r.order);
+        DecisionRecord expected = MakeRecord(r.order, now);
+        expected.commit = JOURNAL_RECORD_COMMITTED;
+        intact = intact && memcmp(&expected, &r, sizeof(r)) == 0;
+    }
+    Check(records.size() == (size_t)(thread_count * per_thread) && orders.size() == records.size(),
+          "40000 records read back, each exactly once");
+    Check(intact, "records read back byte for byte");
+
+    RemoveJournalFiles(now);
+}
+
+static void TestDayRollover() {
+    uint64_t today = JournalNowUs();
+    uint64_t tomorrow = today + 86400000000ULL;
+    RemoveJournalFiles(today);
+    RemoveJournalFiles(tomorrow);
+
+    DecisionJournal journal;
+    journal.Open(PREFIX, 100);
+    std::string first = journal.CurrentPath();
+    journal.Append(MakeRecord(1, today));
+    journal.Append(MakeRecord(2, tomorrow));
+    std::string second = journal.CurrentPath();
+    journal.Append(MakeRecord(3, today));           // Late record of the old day: stays in the new file
+    journal.Close();
+
+    Check(first != second && first.substr(0, first.size() - 6) != second.substr(0, second.size() - 6),
+          "new UTC day opens a file with the new date");
+
+    std::vector<DecisionRecord> old_day, new_day;
+    std::string error;
+    ReadJournalFile(first, old_day, error);
+    ReadJournalFile(second, new_day, error);
+    Check(old_day.size() == 1 && new_day.size() == 2, "records land in the file of their day");
+
+    RemoveJournalFiles(today);
+    RemoveJournalFiles(tomorrow);
+}
+
+static void TestSpareSegment() {
+    uint64_t now = JournalNowUs();
+    RemoveJournalFiles(now);
+
+    DecisionJournal journal;
+    journal.Open(PREFIX, 16);
+    std::string first = journal.CurrentPath();
+    std::string base = first.substr(0, first.rfind('_') + 1);
+    std::string next = base + "1.abj";
+
+    bool ready = false;
+    for (int i = 0; i < 2000 && !ready; i++) {
+        FILE* f = fopen(next.c_str(), "rb");
+        if (f) {
+            fclose(f);
+            ready = true;
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    Check(ready, "next file is created before the current one fills");
+
+    for (int i = 0; i < 17; i++) journal.Append(MakeRecord(i + 1, now));
+    Check(journal.CurrentPath() == next && journal.Lost() == 0, "full file rolls over to the prepared one");
+    journal.Close();
+
+    std::vector<DecisionRecord> records;
+    std::string error;
+    ReadJournalFile(first, records, error);
+    ReadJournalFile(next, records, error);
+    Check(records.size() == 17, "records read back from both files");
+    Check(!ReadJournalFile(base + "2.abj", records, error), "unused spare is deleted on Close");
+
+    RemoveJournalFiles(now);
+}
+
+static void TestTornRecord() {
+    uint64_t now = JournalNowUs();
+    RemoveJournalFiles(now);
+
+    std::string path;
+    {
+        DecisionJournal journal;
+        journal.Open(PREFIX, 16);
+        path = journal.CurrentPath();
+        journal.Append(MakeRecord(1, now));
+        journal.Append(MakeRecord(2, now));
+    }
+
+    // Simulate a crash in the middle of the second copy: commit word cleared
+    FILE* f = fopen(path.c_str(), "r+b");
+    fseek(f, (long)(sizeof(JournalFileHeader) + sizeof(DecisionRecord)), SEEK_SET);
+    uint32_t zero = 0;
+    fwrite(&zero, sizeof(zero), 1, f);
+    fclose(f);
+
+    std::vector<DecisionRecord> records;
+    std::string error;
+    Check(ReadJournalFile(path, records, error) && records.size() == 1 && records[0].order == 1,
+          "uncommitted records and the unused tail are skipped");
+
+    f = fopen(path.c_str(), "r+b");
+    fwrite("NOTAJRNL", 8, 1, f);
+    fclose(f);
+    records.clear();
+    Check(!ReadJournalFile(path, records, error) && !error.empty(), "file without the journal magic is rejected");
+
+    RemoveJournalFiles(now);
+}
+
+int main() {
+    std::cout << "=== DECISION JOURNAL TEST ===" << std::endl;
+    TestLayout();
+    TestConcurrentAppend();
+    TestDayRollover();
+    TestSpareSegment();
+    TestTornRecord();
+
+    std::cout << std::endl << (failures == 0 ? "ALL TESTS PASSED" : std::to_string(failures) + " TEST(S) FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
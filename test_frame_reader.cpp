@@ -0,0 +1,142 @@
+//+------------------------------------------------------------------+
+//| Frame Reader Test - Responses Split Across TCP Segments         |
+//| A loopback server dribbles length-prefixed frames in small      |
+//| pieces; every frame must be reassembled intact                  |
+//+------------------------------------------------------------------+
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <chrono>
+
+#include "ABBook_Platform.h"
+#include "ABBook_FrameReader.h"
+
+#ifdef _MSC_VER
+#pragma comment(lib, "ws2_32.lib")
+#endif
+
+static int failures = 0;
+
+static void Check(bool condition, const std::string& name) {
+    std::cout << (condition ? "PASS: " : "FAIL: ") << name << std::endl;
+    if (!condition) failures++;
+}
+
+static std::string Frame(const std::string& body) {
+    uint32_t length = (uint32_t)body.length();
+    std::string frame;
+    frame += (char)((length >> 24) & 0xFF);
+    frame += (char)((length >> 16) & 0xFF);
+    frame += (char)((length >> 8) & 0xFF);
+    frame += (char)(length & 0xFF);
+    return frame + body;
+}
+
+// Connected loopback pair: client is non-blocking like a pooled socket
+static bool MakePair(SOCKET& client, SOCKET& server) {
+    SOCKET listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    socklen_t addr_len = sizeof(addr);
+    if (bind(listener, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(listener, 1) != 0 ||
+        getsockname(listener, (sockaddr*)&addr, &addr_len) != 0) {
+        closesocket(listener);
+        return false;
+    }
+
+    client = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+    if (connect(client, (sockaddr*)&addr, sizeof(addr)) != 0) {
+        closesocket(listener);
+        return false;
+    }
+    server = accept(listener, nullptr, nullptr);
+    closesocket(listener);
+
+    int nodelay = 1;
+    setsockopt(server, IPPROTO_TCP, TCP_NODELAY, (const char*)&nodelay, sizeof(nodelay));
+    return server != INVALID_SOCKET && SetSocketNonBlocking(client, true);
+}
+
+// Write data in chunks of chunk_size with a pause between them
+static void Dribble(SOCKET sock, const std::string& data, size_t chunk_size, int pause_us) {
+    for (size_t pos = 0; pos < data.length(); pos += chunk_size) {
+        size_t n = data.length() - pos < chunk_size ? data.length() - pos : chunk_size;
+        send(sock, data.data() + pos, (int)n, 0);
+        std::this_thread::sleep_for(std::chrono::microseconds(pause_us));
+    }
+}
+
+int main() {
+    WSADATA wsaData;
+    WSAStartup(MAKEWORD(2, 2), &wsaData);
+
+    std::cout << "=== FRAME READER TEST ===" << std::endl;
+
+    SOCKET client, server;
+    if (!MakePair(client, server)) {
+        std::cout << "FAIL: could not create loopback connection" << std::endl;
+        return 1;
+    }
+
+    FrameReader reader;
+    const char* body = nullptr;
+    uint32_t length = 0;
+    int error_code = 0;
+
+    // 1. ScoringResponse { score: 0.5 } arriving one byte at a time
+    const std::string score_body("\x0D\x00\x00\x00\x3F", 5);
+    std::thread writer(Dribble, server, Frame(score_body), 1, 2000);
+    FrameReadStatus status = reader.ReadFrame(client, ScoringDeadline::In(2000), body, length, error_code);
+    writer.join();
+    Check(status == FRAME_OK && std::string(body, length) == score_body, "frame split into 1-byte segments");
+    Check(reader.Buffered() == 0, "nothing left over after a single frame");
+
+    // 2. Two frames in one segment: the second stays buffered for the next call
+    std::string pipelined = Frame("first") + Frame("second");
+    send(server, pipelined.data(), (int)pipelined.length(), 0);
+    status = reader.ReadFrame(client, ScoringDeadline::In(2000), body, length, error_code);
+    Check(status == FRAME_OK && std::string(body, length) == "first", "first of two coalesced frames");
+    Check(reader.Buffered() == Frame("second").length(), "second frame reported as unread");
+    status = reader.ReadFrame(client, ScoringDeadline::In(2000), body, length, error_code);
+    Check(status == FRAME_OK && std::string(body, length) == "second", "second frame served from the buffer");
+
+    // 3. A frame larger than the initial buffer, in uneven pieces
+    std::string large(20000, 'x');
+    for (size_t i = 0; i < large.length(); i++) large[i] = (char)('a' + i % 26);
+    writer = std::thread(Dribble, server, Frame(large), 1500, 200);
+    status = reader.ReadFrame(client, ScoringDeadline::In(2000), body, length, error_code);
+    writer.join();
+    Check(status == FRAME_OK && std::string(body, length) == large, "20000-byte frame grows the buffer once");
+
+    // 4. Half a frame, then silence: the deadline must fire
+    std::string partial = Frame(score_body).substr(0, 6);
+    send(server, partial.data(), (int)partial.length(), 0);
+    auto start = std::chrono::steady_clock::now();
+    status = reader.ReadFrame(client, ScoringDeadline::In(20), body, length, error_code);
+    double waited_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    Check(status == FRAME_TIMEOUT && waited_ms < 200, "deadline fires mid-frame");
+
+    // 5. Reset discards the abandoned partial frame; a bogus length is rejected
+    reader.Reset();
+    std::string bogus("\x7F\xFF\xFF\xFF", 4);
+    send(server, bogus.data(), (int)bogus.length(), 0);
+    status = reader.ReadFrame(client, ScoringDeadline::In(2000), body, length, error_code);
+    Check(status == FRAME_TOO_LARGE, "oversized length prefix rejected");
+
+    // 6. Peer closes mid-frame
+    reader.Reset();
+    send(server, partial.data(), (int)partial.length(), 0);
+    closesocket(server);
+    status = reader.ReadFrame(client, ScoringDeadline::In(2000), body, length, error_code);
+    Check(status == FRAME_CLOSED, "connection closed mid-frame");
+
+    closesocket(client);
+    WSACleanup();
+
+    std::cout << std::endl << (failures == 0 ? "ALL TESTS PASSED" : std::to_string(failures) + " TEST(S) FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
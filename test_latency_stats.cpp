@@ -0,0 +1,150 @@
+//+------------------------------------------------------------------+
+//| Latency Stats Test                                              |
+//| Histogram precision, percentiles, stage timers and concurrent  |
+//| commits per instrument group                                    |
+//+------------------------------------------------------------------+
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+
+#include "ABBook_LatencyStats.h"
+
+static int failures = 0;
+
+static void Check(bool condition, const std::string& name) {
+    std::cout << (condition ? "PASS: " : "FAIL: ") << name << std::endl;
+    if (!condition) failures++;
+}
+
+static void TestBuckets() {
+    bool round_trip = true;
+    bool precise = true;
+    bool monotonic = true;
+    int last = -1;
+    for (uint64_t ns = 0; ns < (1ULL << 37); ns = ns < 64 ? ns + 1 : ns + ns / 97 + 1) {
+        int bucket = LatencyHistogram::BucketOf(ns);
+        uint64_t upper = LatencyHistogram::BucketUpper(bucket);
+        if (bucket < LatencyHistogram::BUCKETS - 1) {
+            round_trip = round_trip && ns <= upper && LatencyHistogram::BucketOf(upper) == bucket &&
+                         LatencyHistogram::BucketOf(upper + 1) == bucket + 1;
+            precise = precise && (double)(upper - ns) <= 0.032 * (double)ns + 1.0;
+        }
+        monotonic = monotonic && bucket >= last;
+        last = bucket;
+    }
+    Check(round_trip, "BucketUpper is the last value of its bucket");
+    Check(precise, "bucket edges within ~3% of the value");
+    Check(monotonic, "buckets grow with the value");
+    Check(LatencyHistogram::BucketOf(~0ULL) == LatencyHistogram::BUCKETS - 1, "huge values land in the top bucket");
+}
+
+static void TestPercentiles() {
+    // 1..10000 us, uniform
+    LatencyHistogram histogram;
+    for (uint64_t us = 1; us <= 10000; us++) histogram.Record(us * 1000);
+    LatencyCounts counts;
+    counts.Add(histogram);
+    LatencySummary s = counts.Summarize();
+
+    auto near = [](uint64_t got, uint64_t want) { return got >= want && (double)got <= (double)want * 1.035; };
+    Check(s.count == 10000, "count");
+    Check(s.mean_ns == 5000500, "mean is exact");
+    Check(near(s.p50_ns, 5000000), "p50 within bucket precision");
+    Check(near(s.p99_ns, 9900000), "p99 within bucket precision");
+    Check(near(s.p999_ns, 9990000), "p99.9 within bucket precision");
+    Check(s.max_ns == 10000000, "max is exact");
+
+    LatencyCounts empty;
+    Check(empty.Summarize().count == 0 && empty.Summarize().p99_ns == 0, "empty histogram summarises to zeros");
+}
+
+static void TestStageTimer() {
+    LatencyStats stats(nullptr);
+    stats.Configure({ "FXMajors", "Metals" }, 0);
+
+    StageTimer timer;
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    timer.Mark(STAGE_SYMBOL);
+    timer.Skip();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    timer.Mark(STAGE_WAIT);
+    std::this_thread::sleep_for(std::chrono::milliseconds(3));
+    timer.Mark(STAGE_WAIT);
+    stats.Commit(timer, 1);
+
+    LatencySummary symbol = stats.Query(STAGE_SYMBOL);
+    LatencySummary wait = stats.Query(STAGE_WAIT, 1);
+    LatencySummary total = stats.Query(STAGE_TOTAL, 1);
+    Check(symbol.count == 1 && symbol.max_ns >= 5000000 && symbol.max_ns < 50000000, "marked stage measured in ns");
+    Check(wait.count == 1 && wait.max_ns >= 5000000, "repeat marks of a stage add up to one sample");
+    Check(stats.Query(STAGE_CONNECT).count == 0, "unmarked stages get no sample");
+    Check(total.count == 1 && total.max_ns >= 10000000, "total covers the whole timer");
+    Check(stats.Query(STAGE_TOTAL, 0).count == 0, "sample lands in its group only");
+}
+
+static void TestConcurrentCommit() {
+    LatencyStats stats(nullptr);
+    stats.Configure({ "FXMajors", "FXMinors", "Metals", "Indices" }, 0);
+
+    const int thread_count = 8;
+    const int per_thread = 20000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; t++) {
+        threads.emplace_back([&, t]() {
+            for (int i = 0; i < per_thread; i++) {
+                StageTimer timer;
+                timer.Mark(STAGE_SYMBOL);
+                timer.Mark(STAGE_ENCODE);
+                timer.Mark(STAGE_DECISION);
+                stats.Commit(timer, (size_t)(t % 4));
+            }
+        });
+    }
+    // Reader running alongside the writers
+    std::string report;
+    for (int i = 0; i < 20; i++) report = stats.Report();
+    for (auto& thread : threads) thread.join();
+
+    uint64_t per_group = 0;
+    for (size_t g = 0; g < 4; g++) per_group += stats.Query(STAGE_TOTAL, g).count;
+    Check(stats.Query(STAGE_TOTAL).count == (uint64_t)(thread_count * per_thread), "no sample lost under 8 writers");
+    Check(per_group == stats.Query(STAGE_TOTAL).count, "groups sum to ALL_GROUPS");
+    Check(stats.Query(STAGE_ENCODE, 2).count == (uint64_t)(2 * per_thread), "per-group count");
+    Check(stats.Query(STAGE_VALIDATE).count == 0, "stage never marked stays empty");
+
+    StageTimer stray;
+    stats.Commit(stray, 99);
+    Check(stats.Query(STAGE_TOTAL, 3).count == (uint64_t)(2 * per_thread + 1), "out-of-range group goes to the last one");
+}
+
+static void TestReport() {
+    LatencyStats stats(nullptr);
+    Check(!stats.Enabled() && stats.Report() == "Stage timers disabled\n", "unconfigured stats report disabled");
+
+    stats.Configure({ "FXMajors", "Metals" }, 0);
+    StageTimer timer;
+    timer.Mark(STAGE_SYMBOL);
+    stats.Commit(timer, 0);
+    std::string report = stats.Report();
+    Check(report.find("p99.9") != std::string::npos, "report has the percentile header");
+    Check(report.find("  symbol ") != std::string::npos && report.find("total [FXMajors]") != std::string::npos,
+          "report has rows for all groups and per group");
+    Check(report.find("Metals") == std::string::npos && report.find("parse") == std::string::npos,
+          "empty stages and groups are left out");
+    Check(!report.empty() && report.back() == '\n', "report ends with a newline");
+}
+
+int main() {
+    std::cout << "=== LATENCY STATS TEST ===" << std::endl;
+    TestBuckets();
+    TestPercentiles();
+    TestStageTimer();
+    TestConcurrentCommit();
+    TestReport();
+
+    std::cout << std::endl << (failures == 0 ? "ALL TESTS PASSED" : std::to_string(failures) + " TEST(S) FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,365 @@
+//+------------------------------------------------------------------+
+//| Metrics Exporter Test                                           |
+//| A loopback HTTP stub records every POSTed line-protocol batch  |
+//+------------------------------------------------------------------+
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <cstdlib>
+
+#include "ABBook_Platform.h"
+#include "ABBook_MetricsExporter.h"
+
+#ifdef _MSC_VER
+#pragma comment(lib, "ws2_32.lib")
+#endif
+
+static int failures = 0;
+
+static void Check(bool condition, const std::string& name) {
+    std::cout << (condition ? "PASS: " : "FAIL: ") << name << std::endl;
+    if (!condition) failures++;
+}
+
+//+------------------------------------------------------------------+
+//| Minimal HTTP/1.1 server: one request per connection            |
+//+------------------------------------------------------------------+
+
+class HttpStub {
+private:
+    SOCKET listener;
+    std::thread server;
+    std::mutex mutex;
+    std::vector<std::string> targets;
+    std::vector<std::string> bodies;
+    std::atomic<bool> stopping;
+
+    void Serve() {
+        while (!stopping.load()) {
+            SOCKET client = accept(listener, nullptr, nullptr);
+            if (client == INVALID_SOCKET) continue;
+            if (stopping.load()) {
+                closesocket(client);
+                break;
+            }
+
+            std::string request;
+            char buffer[4096];
+            size_t header_end = std::string::npos;
+            size_t content_length = 0;
+            for (;;) {
+                int received = recv(client, buffer, sizeof(buffer), 0);
+                if (received <= 0) break;
+                request.append(buffer, received);
+                if (header_end == std::string::npos) {
+                    header_end = request.find("\r\n\r\n");
+                    if (header_end == std::string::npos) continue;
+                    size_t length_at = request.find("Content-Length: ");
+                    if (length_at != std::string::npos) content_length = (size_t)atol(request.c_str() + length_at + 16);
+                }
+                if (request.size() >= header_end + 4 + content_length) break;
+            }
+
+            int reply_status = status.load();
+            bool hung = hang.load();
+            if (hung) {
+                // Black hole: hold the connection open without answering
+                std::this_thread::sleep_for(std::chrono::milliseconds(300));
+            } else if (header_end != std::string::npos) {
+                std::lock_guard<std::mutex> lock(mutex);
+                size_t space = request.find(' ');
+                targets.push_back(request.substr(space + 1, request.find(' ', space + 1) - space - 1));
+                bodies.push_back(request.substr(header_end + 4, content_length));
+            }
+            if (!hung) {
+                std::string response = "HTTP/1.1 " + std::to_string(reply_status) + (reply_status == 204 ? " No Content" : " Error") +
+                                       "\r\nContent-Length: 0\r\n\r\n";
+                send(client, response.data(), (int)response.size(), 0);
+            }
+            closesocket(client);
+        }
+    }
+
+public:
+    int port;
+    std::atomic<int> status;
+    std::atomic<bool> hang;
+
+    HttpStub() : listener(INVALID_SOCKET), stopping(false), port(0), status(204), hang(false) {
+        listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t addr_len = sizeof(addr);
+        bind(listener, (sockaddr*)&addr, sizeof(addr));
+        listen(listener, 16);
+        getsockname(listener, (sockaddr*)&addr, &addr_len);
+        port = ntohs(addr.sin_port);
+        server = std::thread(&HttpStub::Serve, this);
+    }
+
+    ~HttpStub() {
+        stopping = true;
+        // Wake accept() with one last connection
+        SOCKET poke = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = htons((u_short)port);
+        connect(poke, (sockaddr*)&addr, sizeof(addr));
+        server.join();
+        closesocket(poke);
+        closesocket(listener);
+    }
+
+    std::string Url() const { return "http://127.0.0.1:" + std::to_string(port) + "/write?db=trading"; }
+
+    std::vector<std::string> Bodies() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return bodies;
+    }
+
+    std::vector<std::string> Targets() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return targets;
+    }
+};
+
+static std::vector<std::string> Lines(const std::string& body) {
+    std::vector<std::string> lines;
+    std::istringstream in(body);
+    std::string line;
+    while (std::getline(in, line)) lines.push_back(line);
+    return lines;
+}
+
+// Value of an integer field ("count=42i") in a line, -1 if absent
+static long long Field(const std::string& line, const std::string& name) {
+    size_t at = line.find(" " + name + "=");
+    if (at == std::string::npos) at = line.find("," + name + "=");
+    if (at == std::string::npos) return -1;
+    return atoll(line.c_str() + at + name.size() + 2);
+}
+
+static bool StartsWith(const std::string& text, const std::string& prefix) {
+    return text.compare(0, prefix.size(), prefix) == 0;
+}
+
+static void TestEndpointParsing() {
+    HttpEndpoint endpoint;
+    Check(endpoint.Parse("http://influx.local:8086/write?db=trading") && endpoint.host == "influx.local" &&
+          endpoint.port == 8086 && endpoint.target == "/write?db=trading", "host, port and target parsed");
+    HttpEndpoint bare;
+    Check(bare.Parse("http://metrics") && bare.port == 80 && bare.target == "/", "port 80 and / by default");
+    HttpEndpoint tls;
+    Check(!tls.Parse("https://influx.local:8086/write"), "https is rejected");
+}
+
+static void TestAggregationAndFormat(HttpStub& stub) {
+    PluginLogger logger(false);
+    MetricsExporter exporter(&logger);
+    Check(exporter.Configure({ "FXMajors", "Crypto", "FX Minors" }, stub.Url(), 1000, 60000), "exporter configured");
+
+    // 8 trade threads: group 0 scored by ML, group 2 on fallback
+    const int thread_count = 8;
+    const int per_thread = 10000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; t++) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < per_thread; i++) {
+                exporter.Record(0, i % 4 == 0, SCORE_SOURCE_ML, 1000 + (uint32_t)(i % 100));
+                if (i % 10 == 0) exporter.Record(2, false, SCORE_SOURCE_FALLBACK_BACKOFF, 0);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    Check(exporter.Flush(), "flush accepted by the stub");
+    std::vector<std::string> bodies = stub.Bodies();
+    Check(bodies.size() == 1 && stub.Targets()[0] == "/write?db=trading", "one POST to the configured path");
+
+    long long a_book = 0, b_book = 0, backoff = 0, latency_count = -1, max_us = -1, p50 = -1;
+    bool escaped = false, timestamps = true, exporter_line = false;
+    for (const std::string& line : Lines(bodies.empty() ? "" : bodies[0])) {
+        timestamps = timestamps && line.find_last_of(' ') != std::string::npos &&
+                     line.size() - line.find_last_of(' ') - 1 == 19;
+        if (StartsWith(line, "abbook_decisions,group=FXMajors,decision=A_BOOK,source=ML ")) a_book = Field(line, "count");
+        if (StartsWith(line, "abbook_decisions,group=FXMajors,decision=B_BOOK,source=ML ")) b_book = Field(line, "count");
+        if (StartsWith(line, "abbook_decisions,group=FX\\ Minors,decision=A_BOOK,source=FALLBACK_BACKOFF ")) {
+            backoff = Field(line, "count");
+            escaped = true;
+        }
+        if (StartsWith(line, "abbook_scoring_latency,group=FXMajors ")) {
+            latency_count = Field(line, "count");
+            max_us = Field(line, "max_us");
+            p50 = Field(line, "p50_us");
+        }
+        if (StartsWith(line, "abbook_exporter ")) exporter_line = true;
+        if (StartsWith(line, "abbook_scoring_latency,group=FX\\ Minors")) backoff = -1;   // Backoff has no latency
+    }
+    Check(a_book == 60000 && b_book == 20000, "decision counters summed across threads");
+    Check(backoff == 8000 && escaped, "fallback counted, space in group name escaped");
+    Check(latency_count == 80000 && max_us == 1099 && p50 >= 1000 && p50 <= 1099, "latency histogram count, max and p50");
+    Check(exporter_line && timestamps, "exporter health line, nanosecond timestamps");
+
+    // Counters are deltas: an idle interval only carries the health line
+    exporter.Flush();
+    bodies = stub.Bodies();
+    Check(bodies.size() == 2 && Lines(bodies[1]).size() == 1 && StartsWith(bodies[1], "abbook_exporter "),
+          "idle interval sends no decision lines");
+}
+
+// Groups past MAX_GROUPS share the last slot: it is tagged `other`, never with one of their names
+static void TestOverflowGroups(HttpStub& stub) {
+    PluginLogger logger(false);
+    MetricsExporter exporter(&logger);
+    std::vector<std::string> names;
+    for (size_t g = 0; g < MetricsExporter::MAX_GROUPS + 2; g++) names.push_back("G" + std::to_string(g));
+    exporter.Configure(names, stub.Url(), 1000, 60000);
+    size_t before = stub.Bodies().size();
+
+    const size_t last = MetricsExporter::MAX_GROUPS - 1;
+    exporter.Record(last - 1, false, SCORE_SOURCE_ML, 500);
+    exporter.Record(last, false, SCORE_SOURCE_ML, 500);
+    exporter.Record(last + 1, false, SCORE_SOURCE_ML, 500);
+    exporter.Record(last + 2, false, SCORE_SOURCE_ML, 500);
+    Check(exporter.Flush() && stub.Bodies().size() == before + 1, "overflow groups flushed");
+
+    long long named = -1, other = -1;
+    bool misnamed = false;
+    for (const std::string& line : Lines(stub.Bodies().back())) {
+        if (StartsWith(line, "abbook_decisions,group=G" + std::to_string(last - 1) + ",")) named = Field(line, "count");
+        if (StartsWith(line, "abbook_decisions,group=other,decision=A_BOOK,source=ML ")) other = Field(line, "count");
+        if (StartsWith(line, "abbook_decisions,group=G" + std::to_string(last) + ",")) misnamed = true;
+    }
+    Check(named == 1, "groups below the limit keep their names");
+    Check(other == 3 && !misnamed, "the shared last slot is tagged group=other");
+}
+
+static void TestRetryAfterFailure(HttpStub& stub) {
+    PluginLogger logger(false);
+    MetricsExporter exporter(&logger);
+    exporter.Configure({ "FXMajors" }, stub.Url(), 1000, 60000);
+    size_t before = stub.Bodies().size();
+
+    stub.status = 500;
+    exporter.Record(0, false, SCORE_SOURCE_ML, 500);
+    Check(!exporter.Flush() && exporter.PendingBytes() > 0, "HTTP 500 keeps the batch");
+
+    stub.status = 204;
+    exporter.Record(0, true, SCORE_SOURCE_ML, 700);
+    Check(exporter.Flush() && exporter.PendingBytes() == 0, "next interval delivers the backlog");
+
+    std::vector<std::string> bodies = stub.Bodies();
+    const std::string& last = bodies.back();
+    Check(bodies.size() == before + 2 && last.find("decision=A_BOOK") != std::string::npos &&
+          last.find("decision=B_BOOK") != std::string::npos, "retried POST carries both intervals");
+
+    // Nothing listening: the POST fails fast and the batch is kept
+    PluginLogger closed_logger(false);
+    MetricsExporter unreachable(&closed_logger);
+    unreachable.Configure({ "FXMajors" }, "http://127.0.0.1:1/write", 500, 60000);
+    unreachable.Record(0, false, SCORE_SOURCE_ML, 100);
+    Check(!unreachable.Flush() && unreachable.PendingBytes() > 0, "connection refused keeps the batch");
+}
+
+static void TestBreakerLine(HttpStub& stub) {
+    PluginLogger logger(false);
+    MetricsExporter exporter(&logger);
+    exporter.Configure({ "FXMajors" }, stub.Url(), 1000, 60000);
+    BreakerCounters breaker;
+    exporter.SetBreakerSource([&breaker]() { return breaker; });
+
+    breaker.state = 1;
+    breaker.opened = 2;
+    breaker.half_opened = 1;
+    breaker.open_ms = 1500;
+    exporter.Flush();
+    breaker.state = 0;
+    breaker.half_opened = 2;
+    breaker.closed = 1;
+    breaker.open_ms = 2100;
+    exporter.Flush();
+
+    std::vector<std::string> bodies = stub.Bodies();
+    std::vector<long long> states, opened, closed, open_ms;
+    for (size_t b = bodies.size() >= 2 ? bodies.size() - 2 : 0; b < bodies.size(); b++) {
+        for (const std::string& line : Lines(bodies[b])) {
+            if (!StartsWith(line, "abbook_breaker ")) continue;
+            states.push_back(Field(line, "state"));
+            opened.push_back(Field(line, "opened"));
+            closed.push_back(Field(line, "closed"));
+            open_ms.push_back(Field(line, "open_ms"));
+        }
+    }
+    Check(states.size() == 2 && states[0] == 1 && states[1] == 0, "breaker state reported every interval");
+    Check(opened.size() == 2 && opened[0] == 2 && opened[1] == 0 && closed[1] == 1 && open_ms[0] == 1500 && open_ms[1] == 600,
+          "breaker transitions and open time are interval deltas");
+}
+
+static void TestBackgroundFlushNeverBlocksTrades(HttpStub& stub) {
+    PluginLogger logger(false);
+    MetricsExporter exporter(&logger);
+    exporter.Configure({ "FXMajors" }, stub.Url(), 200, 20);
+    size_t before = stub.Bodies().size();
+
+    stub.hang = true;
+    exporter.Start();
+
+    // Trades keep recording while the flush thread is stuck on the silent server
+    double worst_us = 0;
+    for (int i = 0; i < 200000; i++) {
+        auto start = std::chrono::steady_clock::now();
+        exporter.Record(0, false, SCORE_SOURCE_ML, 800);
+        double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        if (us > worst_us) worst_us = us;
+        if (i % 1000 == 0) std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+    std::cout << "    slowest Record() while the server hung: " << worst_us << " us" << std::endl;
+    Check(worst_us < 5000, "Record() never waits for the HTTP POST");
+
+    stub.hang = false;
+    bool delivered = false;
+    for (int i = 0; i < 200 && !delivered; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        delivered = exporter.PostedBatches() > 0 && exporter.PendingBytes() == 0;
+    }
+    exporter.Stop();
+    Check(delivered && stub.Bodies().size() > before, "background thread delivers once the server answers");
+
+    long long recorded = 0;
+    for (size_t b = before; b < stub.Bodies().size(); b++) {
+        for (const std::string& line : Lines(stub.Bodies()[b])) {
+            if (StartsWith(line, "abbook_decisions,group=FXMajors,decision=A_BOOK,source=ML ")) recorded += Field(line, "count");
+        }
+    }
+    Check(recorded == 200000, "every recorded decision reaches the server exactly once");
+}
+
+int main() {
+    WSADATA wsaData;
+    WSAStartup(MAKEWORD(2, 2), &wsaData);
+
+    std::cout << "=== METRICS EXPORTER TEST ===" << std::endl;
+    TestEndpointParsing();
+    {
+        HttpStub stub;
+        TestAggregationAndFormat(stub);
+        TestOverflowGroups(stub);
+        TestRetryAfterFailure(stub);
+        TestBreakerLine(stub);
+        TestBackgroundFlushNeverBlocksTrades(stub);
+    }
+
+    WSACleanup();
+    std::cout << std::endl << (failures == 0 ? "ALL TESTS PASSED" : std::to_string(failures) + " TEST(S) FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,448 @@
+//+------------------------------------------------------------------+
+//| Multiplexed Channel Test                                        |
+//| Replies out of order reach the right caller; a dropped          |
+//| connection fails every pending call and the next call redials; |
+//| late replies to expired calls are dropped                       |
+//+------------------------------------------------------------------+
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+
+#include "ABBook_MultiplexedChannel.h"
+
+#ifdef _MSC_VER
+#pragma comment(lib, "ws2_32.lib")
+#endif
+
+static int failures = 0;
+
+static void Check(bool condition, const std::string& name) {
+    std::cout << (condition ? "PASS: " : "FAIL: ") << name << std::endl;
+    if (!condition) failures++;
+}
+
+static long long ElapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+//+------------------------------------------------------------------+
+//| Loopback mux service scripted by the test                       |
+//+------------------------------------------------------------------+
+
+class ScriptedMuxServer {
+public:
+    struct Request {
+        uint32_t id;
+        std::string body;
+    };
+
+private:
+    SOCKET listener;
+    int port;
+    std::atomic<bool> running;
+    std::thread acceptor;
+    std::vector<std::thread> readers;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    SOCKET client;                     // Latest accepted connection; replies go here
+    int connections;
+    std::vector<Request> received;     // Not yet taken by the test
+
+    static bool ReadExact(SOCKET sock, char* data, size_t length) {
+        while (length > 0) {
+            int received_now = recv(sock, data, (int)length, 0);
+            if (received_now <= 0) return false;
+            data += received_now;
+            length -= (size_t)received_now;
+        }
+        return true;
+    }
+
+    static uint32_t ReadBE32(const unsigned char* p) {
+        return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+    }
+
+    static void AppendBE32(std::string& out, uint32_t value) {
+        out += (char)((value >> 24) & 0xFF);
+        out += (char)((value >> 16) & 0xFF);
+        out += (char)((value >> 8) & 0xFF);
+        out += (char)(value & 0xFF);
+    }
+
+    void Read(SOCKET sock) {
+        std::vector<char> frame;
+        for (;;) {
+            unsigned char header[4];
+            if (!ReadExact(sock, (char*)header, 4)) break;
+            uint32_t length = ReadBE32(header);
+            if (length < 4) break;
+            frame.resize(length);
+            if (!ReadExact(sock, frame.data(), length)) break;
+
+            Request request;
+            request.id = ReadBE32((const unsigned char*)frame.data());
+            request.body.assign(frame.data() + 4, length - 4);
+            std::lock_guard<std::mutex> lock(mutex);
+            received.push_back(request);
+            cv.notify_all();
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (client == sock) client = INVALID_SOCKET;
+        closesocket(sock);
+    }
+
+public:
+    ScriptedMuxServer() : listener(INVALID_SOCKET), port(0), running(false), client(INVALID_SOCKET), connections(0) {}
+
+    ~ScriptedMuxServer() { Stop(); }
+
+    bool Start() {
+        listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        socklen_t address_length = sizeof(address);
+        if (listener == INVALID_SOCKET || bind(listener, (sockaddr*)&address, sizeof(address)) != 0 ||
+            listen(listener, 16) != 0 || getsockname(listener, (sockaddr*)&address, &address_length) != 0) {
+            return false;
+        }
+        port = ntohs(address.sin_port);
+        running = true;
+        acceptor = std::thread([this]() {
+            while (running) {
+                SOCKET sock = accept(listener, nullptr, nullptr);
+                if (sock == INVALID_SOCKET) break;
+                if (!running) {
+                    closesocket(sock);
+                    break;
+                }
+                int nodelay = 1;
+                setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, (const char*)&nodelay, sizeof(nodelay));
+                {
+                    std::lock_guard<std::mutex> lock(mutex);
+                    client = sock;
+                    connections++;
+                }
+                readers.emplace_back([this, sock]() { Read(sock); });
+            }
+        });
+        return true;
+    }
+
+    // The channel is stopped first, so the readers see EOF
+    void Stop() {
+        if (!running.exchange(false)) return;
+        SOCKET wake = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons((unsigned short)port);
+        connect(wake, (sockaddr*)&address, sizeof(address));
+        closesocket(wake);
+        acceptor.join();
+        closesocket(listener);
+        for (std::thread& reader : readers) reader.join();
+    }
+
+    // Wait for `count` requests and hand them over in arrival order
+    std::vector<Request> Take(size_t count) {
+        std::unique_lock<std::mutex> lock(mutex);
+        cv.wait_for(lock, std::chrono::seconds(5), [this, count]() { return received.size() >= count; });
+        std::vector<Request> taken;
+        taken.swap(received);
+        return taken;
+    }
+
+    bool Reply(uint32_t id, const std::string& body) {
+        std::string frame;
+        AppendBE32(frame, (uint32_t)(body.size() + 4));
+        AppendBE32(frame, id);
+        frame += body;
+        std::lock_guard<std::mutex> lock(mutex);
+        if (client == INVALID_SOCKET) return false;
+        return send(client, frame.data(), (int)frame.size(), MSG_NOSIGNAL) == (int)frame.size();
+    }
+
+    // Drop the current connection without answering; its reader closes the socket
+    void HangUp() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (client != INVALID_SOCKET) shutdown(client, SD_BOTH);
+    }
+
+    int Connections() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return connections;
+    }
+
+    int Port() const { return port; }
+};
+
+//+------------------------------------------------------------------+
+//| Channel harness                                                 |
+//+------------------------------------------------------------------+
+
+struct ChannelHarness {
+    PluginConfig config;
+    PluginLogger logger;
+    ScoringConnectionPool pool;
+    MultiplexedScoringChannel channel;
+
+    explicit ChannelHarness(int port) : logger(false), pool(&SetUp(config, port), &logger), channel(&logger, &pool) {}
+
+    ~ChannelHarness() { channel.Stop(); }
+
+    static PluginConfig& SetUp(PluginConfig& cfg, int port) {
+        cfg.cvm_ip = "127.0.0.1";
+        cfg.cvm_port = port;
+        return cfg;
+    }
+};
+
+struct AsyncOutcome {
+    std::mutex mutex;
+    std::condition_variable cv;
+    int calls = 0;
+    ChannelStatus status = CHANNEL_OK;
+    std::string body;
+
+    ChannelCallback Callback() {
+        return [this](ChannelStatus result, const char* data, uint32_t length) {
+            std::lock_guard<std::mutex> lock(mutex);
+            calls++;
+            status = result;
+            if (result == CHANNEL_OK) body.assign(data, length);
+            cv.notify_all();
+        };
+    }
+
+    bool Wait(int milliseconds) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, std::chrono::milliseconds(milliseconds), [this]() { return calls > 0; });
+    }
+};
+
+//+------------------------------------------------------------------+
+//| Tests                                                           |
+//+------------------------------------------------------------------+
+
+// Eight callers share the connection; the service answers newest first
+static void TestOutOfOrderReplies() {
+    std::cout << "\n--- Out-of-order replies ---" << std::endl;
+    ScriptedMuxServer server;
+    Check(server.Start(), "Loopback service started");
+    ChannelHarness harness(server.Port());
+
+    const int CALLERS = 8;
+    std::vector<std::string> responses(CALLERS);
+    std::vector<ChannelStatus> statuses(CALLERS, CHANNEL_CONNECT_FAILED);
+    std::vector<std::thread> callers;
+    for (int i = 0; i < CALLERS; i++) {
+        callers.emplace_back([&, i]() {
+            std::string body = "request-" + std::to_string(i);
+            int error_code = 0;
+            statuses[i] = harness.channel.Call(body.data(), body.size(), responses[i], ScoringDeadline::In(5000), error_code);
+        });
+    }
+
+    std::vector<ScriptedMuxServer::Request> requests = server.Take(CALLERS);
+    Check(requests.size() == (size_t)CALLERS, "All eight requests arrived on one connection");
+    Check(harness.channel.InFlight() == (size_t)CALLERS, "Eight calls pending before any reply");
+    for (size_t i = requests.size(); i-- > 0;) {
+        server.Reply(requests[i].id, "response-to-" + requests[i].body);
+    }
+    for (std::thread& caller : callers) caller.join();
+
+    bool all_ok = true, all_matched = true;
+    for (int i = 0; i < CALLERS; i++) {
+        all_ok = all_ok && statuses[i] == CHANNEL_OK;
+        all_matched = all_matched && responses[i] == "response-to-request-" + std::to_string(i);
+    }
+    Check(all_ok, "Every call completed");
+    Check(all_matched, "Every caller got the reply to its own request");
+    Check(harness.channel.InFlight() == 0, "Pending map empty afterwards");
+    Check(server.Connections() == 1, "Calls shared a single connection");
+}
+
+// Same through CallAsync(): callbacks fire on the reader thread in reply order
+static void TestAsyncOutOfOrderReplies() {
+    std::cout << "\n--- Out-of-order replies (async) ---" << std::endl;
+    ScriptedMuxServer server;
+    server.Start();
+    ChannelHarness harness(server.Port());
+
+    const int CALLS = 4;
+    AsyncOutcome outcomes[CALLS];
+    std::string bodies[CALLS];
+    bool sent = true;
+    for (int i = 0; i < CALLS; i++) {
+        bodies[i] = "async-" + std::to_string(i);
+        int error_code = 0;
+        sent = sent && harness.channel.CallAsync(bodies[i].data(), bodies[i].size(), ScoringDeadline::In(5000),
+                                                 error_code, outcomes[i].Callback()) == CHANNEL_OK;
+    }
+    Check(sent, "CallAsync sent all requests without waiting");
+
+    std::vector<ScriptedMuxServer::Request> requests = server.Take(CALLS);
+    Check(requests.size() == (size_t)CALLS, "All async requests arrived");
+    for (size_t i = requests.size(); i-- > 0;) {
+        server.Reply(requests[i].id, "reply-" + requests[i].body);
+    }
+
+    bool all_called = true, all_matched = true;
+    for (int i = 0; i < CALLS; i++) {
+        all_called = outcomes[i].Wait(2000) && all_called;
+        std::lock_guard<std::mutex> lock(outcomes[i].mutex);
+        all_matched = all_matched && outcomes[i].calls == 1 && outcomes[i].status == CHANNEL_OK &&
+                      outcomes[i].body == "reply-" + bodies[i];
+    }
+    Check(all_called, "Every callback ran");
+    Check(all_matched, "Every callback ran once with its own reply");
+    Check(harness.channel.InFlight() == 0, "Pending map empty afterwards");
+}
+
+// The service drops the connection with blocked and async calls pending
+static void TestDroppedConnection() {
+    std::cout << "\n--- Dropped connection ---" << std::endl;
+    ScriptedMuxServer server;
+    server.Start();
+    ChannelHarness harness(server.Port());
+
+    const int CALLERS = 4;
+    std::vector<ChannelStatus> statuses(CALLERS, CHANNEL_OK);
+    std::vector<long long> waited(CALLERS, 0);
+    std::vector<std::thread> callers;
+    for (int i = 0; i < CALLERS; i++) {
+        callers.emplace_back([&, i]() {
+            std::string body = "pending-" + std::to_string(i);
+            std::string response;
+            int error_code = 0;
+            auto start = std::chrono::steady_clock::now();
+            statuses[i] = harness.channel.Call(body.data(), body.size(), response, ScoringDeadline::In(5000), error_code);
+            waited[i] = ElapsedMs(start);
+        });
+    }
+    server.Take(CALLERS);
+
+    AsyncOutcome async_outcome;
+    std::string async_body = "pending-async";
+    int error_code = 0;
+    harness.channel.CallAsync(async_body.data(), async_body.size(), ScoringDeadline::In(5000), error_code,
+                              async_outcome.Callback());
+    server.Take(1);
+    Check(harness.channel.InFlight() == (size_t)CALLERS + 1, "Five calls pending when the connection drops");
+
+    server.HangUp();
+    for (std::thread& caller : callers) caller.join();
+
+    bool all_disconnected = true, all_prompt = true;
+    for (int i = 0; i < CALLERS; i++) {
+        all_disconnected = all_disconnected && statuses[i] == CHANNEL_DISCONNECTED;
+        all_prompt = all_prompt && waited[i] < 1000;
+    }
+    Check(all_disconnected, "Every blocked call returned CHANNEL_DISCONNECTED");
+    Check(all_prompt, "Blocked calls failed without waiting out their deadline");
+    Check(async_outcome.Wait(1000), "Async callback ran on disconnect");
+    {
+        std::lock_guard<std::mutex> lock(async_outcome.mutex);
+        Check(async_outcome.calls == 1 && async_outcome.status == CHANNEL_DISCONNECTED,
+              "Async call reported CHANNEL_DISCONNECTED once");
+    }
+    Check(harness.channel.InFlight() == 0, "Pending map emptied");
+
+    // The next call redials
+    std::string body = "after-reconnect";
+    std::string response;
+    ChannelStatus status = CHANNEL_CONNECT_FAILED;
+    std::thread caller([&]() {
+        int code = 0;
+        status = harness.channel.Call(body.data(), body.size(), response, ScoringDeadline::In(5000), code);
+    });
+    std::vector<ScriptedMuxServer::Request> requests = server.Take(1);
+    if (!requests.empty()) server.Reply(requests[0].id, "welcome-back");
+    caller.join();
+    Check(status == CHANNEL_OK && response == "welcome-back", "Call after the drop succeeds");
+    Check(server.Connections() == 2, "Channel opened a fresh connection");
+}
+
+// An expired call leaves the pending map; its late reply must not reach anyone else
+static void TestLateReplyDropped() {
+    std::cout << "\n--- Late reply after timeout ---" << std::endl;
+    ScriptedMuxServer server;
+    server.Start();
+    ChannelHarness harness(server.Port());
+
+    std::string body = "slow";
+    std::string response;
+    int error_code = 0;
+    auto start = std::chrono::steady_clock::now();
+    ChannelStatus status = harness.channel.Call(body.data(), body.size(), response, ScoringDeadline::In(50), error_code);
+    long long waited = ElapsedMs(start);
+    Check(status == CHANNEL_TIMEOUT, "Unanswered call returns CHANNEL_TIMEOUT");
+    Check(waited >= 40 && waited < 1000, "Timed out at its deadline");
+    Check(harness.channel.InFlight() == 0, "Expired call left the pending map");
+
+    AsyncOutcome async_outcome;
+    std::string async_body = "slow-async";
+    harness.channel.CallAsync(async_body.data(), async_body.size(), ScoringDeadline::In(50), error_code,
+                              async_outcome.Callback());
+    Check(async_outcome.Wait(1000), "Reader sweep expired the async call");
+    {
+        std::lock_guard<std::mutex> lock(async_outcome.mutex);
+        Check(async_outcome.status == CHANNEL_TIMEOUT, "Async call reported CHANNEL_TIMEOUT");
+    }
+
+    std::vector<ScriptedMuxServer::Request> stale = server.Take(2);
+    for (const ScriptedMuxServer::Request& request : stale) {
+        server.Reply(request.id, "stale-" + request.body);
+    }
+
+    std::string fresh_body = "fresh";
+    std::string fresh_response;
+    ChannelStatus fresh_status = CHANNEL_CONNECT_FAILED;
+    std::thread caller([&]() {
+        int code = 0;
+        fresh_status = harness.channel.Call(fresh_body.data(), fresh_body.size(), fresh_response, ScoringDeadline::In(5000), code);
+    });
+    std::vector<ScriptedMuxServer::Request> requests = server.Take(1);
+    if (!requests.empty()) server.Reply(requests[0].id, "fresh-reply");
+    caller.join();
+    Check(fresh_status == CHANNEL_OK && fresh_response == "fresh-reply", "Next call gets its own reply, not a stale one");
+    {
+        std::lock_guard<std::mutex> lock(async_outcome.mutex);
+        Check(async_outcome.calls == 1, "Late reply did not call the expired callback again");
+    }
+    Check(server.Connections() == 1, "Late replies did not break the connection");
+}
+
+int main() {
+    std::cout << "=== Multiplexed Channel Test ===" << std::endl;
+    WSADATA wsa;
+    WSAStartup(MAKEWORD(2, 2), &wsa);
+
+    TestOutOfOrderReplies();
+    TestAsyncOutOfOrderReplies();
+    TestDroppedConnection();
+    TestLateReplyDropped();
+
+    WSACleanup();
+    std::cout << std::endl;
+    if (failures == 0) {
+        std::cout << "ALL TESTS PASSED" << std::endl;
+        return 0;
+    }
+    std::cout << failures << " TEST(S) FAILED" << std::endl;
+    return 1;
+}
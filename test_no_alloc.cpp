@@ -0,0 +1,161 @@
+//+------------------------------------------------------------------+
+//| No-Allocation Test                                              |
+//| ABBOOK_ASSERT_NO_ALLOC: the request encode runs without heap    |
+//| allocations, and a NoAllocScope that sees one reports it        |
+//+------------------------------------------------------------------+
+//
+// Always compiled with ABBOOK_ASSERT_NO_ALLOC. When the library itself was
+// built with -DABBOOK_ASSERT_NO_ALLOC=ON it already owns the counter;
+// otherwise this file defines it. Only header-inline code is exercised, so the
+// test never mixes with library objects compiled without the counter.
+
+#ifndef ABBOOK_ASSERT_NO_ALLOC
+#define ABBOOK_ASSERT_NO_ALLOC
+#define ABBOOK_DEFINE_ALLOC_COUNTER
+#endif
+
+#include <iostream>
+#include <string>
+#include <cstdio>
+#include <cstring>
+
+#include "ABBook_ScoringClient.h"
+
+static int failures = 0;
+
+static void Check(bool condition, const std::string& name) {
+    std::cout << (condition ? "PASS: " : "FAIL: ") << name << std::endl;
+    if (!condition) failures++;
+}
+
+static const char* TEST_LOG = "test_no_alloc.log";
+
+// Violations are counted here instead of aborting while a test expects them
+static int violations = 0;
+static unsigned long long violation_allocations = 0;
+static std::string violation_file;
+
+static void CountViolation(const char* file, int, unsigned long long allocations) {
+    violations++;
+    violation_allocations += allocations;
+    violation_file = file;
+}
+
+static TradeRecord MakeTrade(int order, int login, const char* symbol) {
+    TradeRecord trade;
+    memset(&trade, 0, sizeof(trade));
+    trade.order = order;
+    trade.login = login;
+    strncpy(trade.symbol, symbol, sizeof(trade.symbol));
+    trade.digits = 5;
+    trade.cmd = OP_BUY;
+    trade.volume = 100;
+    trade.open_price = 1.08765;
+    trade.sl = 1.08;
+    trade.tp = 1.095;
+    trade.state = ORDER_OPENED;
+    return trade;
+}
+
+static UserInfo MakeUser(int login) {
+    UserInfo user;
+    memset(&user, 0, sizeof(user));
+    user.login = login;
+    strcpy(user.group, "real\\standard");
+    user.balance = 10000.0;
+    user.leverage = 100;
+    return user;
+}
+
+static int* volatile kept = nullptr;
+
+// The counter is live: a plain new on this thread is seen
+static void TestCounter() {
+    std::cout << "\n--- Allocation counter ---" << std::endl;
+    unsigned long long before = AllocationCount();
+    kept = new int(7);                 // Through a volatile pointer, so the pair is not elided
+    unsigned long long counted = AllocationCount() - before;
+    delete kept;
+    Check(counted == 1, "operator new counted on this thread");
+}
+
+// A scope that sees an allocation reports it through NoAllocViolation - also with NDEBUG
+static void TestScopeReports() {
+    std::cout << "\n--- NoAllocScope reports allocations ---" << std::endl;
+    NoAllocViolationHandler previous = NoAllocViolation();
+    NoAllocViolation() = CountViolation;
+    violations = 0;
+    violation_allocations = 0;
+
+    {
+        ABBOOK_NO_ALLOC_SCOPE(clean);
+        int on_stack[4] = { 1, 2, 3, 4 };
+        (void)on_stack;
+    }
+    Check(violations == 0, "Scope without allocations stays quiet");
+
+    {
+        ABBOOK_NO_ALLOC_SCOPE(dirty);
+        kept = new int(8);
+        delete kept;
+    }
+    Check(violations == 1, "Scope with allocations reports once");
+    Check(violation_allocations >= 1, "Report carries the allocation count");
+    Check(violation_file.find("test_no_alloc.cpp") != std::string::npos, "Report names the scope's file");
+
+    NoAllocViolation() = previous;
+}
+
+// CreateScoringRequest holds a NoAllocScope around the encode: minimal and
+// account requests, template miss and template hit, must never trip it
+static void TestRequestEncode() {
+    std::cout << "\n--- Request encode under NoAllocScope ---" << std::endl;
+    PluginConfig config;
+    PluginLogger logger(false, TEST_LOG, false);
+    ScoringConnectionPool pool(&config, &logger);
+    MultiplexedScoringChannel channel(&logger, &pool);
+    CVMClient client(&config, &logger, &pool, &channel);
+    SymbolRegistry registry;
+    registry.Configure(config);
+
+    TradeRecord trade = MakeTrade(1, 16813, "EURUSD");
+    UserInfo user = MakeUser(16813);
+    const SymbolInfo& symbol = registry.Lookup(trade.symbol);
+    char buffer[1024];
+    ProtoWriter frame(buffer, sizeof(buffer));
+
+    NoAllocViolationHandler previous = NoAllocViolation();
+    NoAllocViolation() = CountViolation;
+    violations = 0;
+
+    config.send_account_fields = false;
+    bool minimal_ok = client.EncodeRequest(trade, user, symbol, frame);
+    config.send_account_fields = true;
+    bool miss_ok = client.EncodeRequest(trade, user, symbol, frame);   // Encodes and caches the template
+    bool hit_ok;
+    {
+        ABBOOK_NO_ALLOC_SCOPE(warm);                                     // Template hit: no Store() either
+        hit_ok = client.EncodeRequest(trade, user, symbol, frame);
+    }
+    Check(minimal_ok && miss_ok && hit_ok && frame.Size() > 8, "Requests encoded");
+    Check(violations == 0, "No heap allocation inside the encode scopes");
+
+    NoAllocViolation() = previous;
+}
+
+int main() {
+    std::cout << "=== No-Allocation Test ===" << std::endl;
+
+    TestCounter();
+    TestScopeReports();
+    TestRequestEncode();
+    remove(TEST_LOG);
+
+    std::cout << std::endl;
+    if (failures == 0) {
+        std::cout << "ALL TESTS PASSED" << std::endl;
+        return 0;
+    }
+    std::cout << failures << " TEST(S) FAILED" << std::endl;
+    return 1;
+}
@@ -0,0 +1,201 @@
+//+------------------------------------------------------------------+
+//| Request Templates Test                                          |
+//| A request spliced from a cached account template is byte for   |
+//| byte the full encode; changed account data re-encodes; the     |
+//| cache evicts at capacity                                        |
+//+------------------------------------------------------------------+
+
+#include <iostream>
+#include <string>
+#include <cstdio>
+#include <cstring>
+
+#include "ABBook_ScoringClient.h"
+
+static int failures = 0;
+
+static void Check(bool condition, const std::string& name) {
+    std::cout << (condition ? "PASS: " : "FAIL: ") << name << std::endl;
+    if (!condition) failures++;
+}
+
+static const char* TEST_LOG = "test_request_templates.log";
+
+static TradeRecord MakeTrade(int order, int login, const char* symbol) {
+    TradeRecord trade;
+    memset(&trade, 0, sizeof(trade));
+    trade.order = order;
+    trade.login = login;
+    strncpy(trade.symbol, symbol, sizeof(trade.symbol));
+    trade.digits = 5;
+    trade.cmd = OP_BUY;
+    trade.volume = 100;
+    trade.open_price = 1.08765;
+    trade.sl = 1.08;
+    trade.tp = 1.095;
+    trade.state = ORDER_OPENED;
+    return trade;
+}
+
+static UserInfo MakeUser(int login) {
+    UserInfo user;
+    memset(&user, 0, sizeof(user));
+    user.login = login;
+    strcpy(user.group, "real\\standard");
+    user.balance = 10000.0;
+    user.leverage = 100;
+    return user;
+}
+
+// A client with its own, initially empty, template cache
+struct ClientHarness {
+    PluginConfig config;
+    PluginLogger logger;
+    ScoringConnectionPool pool;
+    MultiplexedScoringChannel channel;
+    CVMClient client;
+    SymbolRegistry registry;
+
+    explicit ClientHarness(int template_capacity = 4096)
+        : logger(false, TEST_LOG, false), pool(&SetUp(config, template_capacity), &logger),
+          channel(&logger, &pool), client(&config, &logger, &pool, &channel) {
+        registry.Configure(config);
+        client.ConfigureAccountTemplates();
+    }
+
+    static PluginConfig& SetUp(PluginConfig& cfg, int template_capacity) {
+        cfg.send_account_fields = true;
+        cfg.account_template_cache_size = template_capacity;
+        return cfg;
+    }
+
+    std::string Encode(const TradeRecord& trade, const UserInfo& user) {
+        char buffer[1024];
+        ProtoWriter frame(buffer, sizeof(buffer));
+        if (!client.EncodeRequest(trade, user, registry.Lookup(trade.symbol), frame)) return std::string();
+        return std::string(frame.Data(), frame.Size());
+    }
+
+    unsigned long long Hits() const { return client.GetAccountTemplates().Hits(); }
+    unsigned long long Misses() const { return client.GetAccountTemplates().Misses(); }
+};
+
+// The request a client that has never seen this account sends
+static std::string FullEncode(const TradeRecord& trade, const UserInfo& user) {
+    ClientHarness fresh;
+    return fresh.Encode(trade, user);
+}
+
+//+------------------------------------------------------------------+
+//| Tests                                                           |
+//+------------------------------------------------------------------+
+
+static void TestSpliceMatchesFullEncode() {
+    std::cout << "\n--- Spliced request equals the full encode ---" << std::endl;
+    ClientHarness warm;
+    TradeRecord trade = MakeTrade(1, 16813, "EURUSD");
+    UserInfo user = MakeUser(16813);
+
+    std::string first = warm.Encode(trade, user);
+    Check(!first.empty() && warm.Misses() == 1 && warm.Hits() == 0, "first request encodes the account fields");
+    std::string spliced = warm.Encode(trade, user);
+    Check(warm.Hits() == 1, "second request splices the template");
+    Check(spliced == first && spliced == FullEncode(trade, user), "spliced request is byte for byte the full encode");
+
+    // Same account, different trade: only the trade fields differ
+    TradeRecord other = MakeTrade(2, 16813, "GBPUSD");
+    other.cmd = OP_SELL;
+    other.volume = 250;
+    std::string other_spliced = warm.Encode(other, user);
+    Check(warm.Hits() == 2 && other_spliced == FullEncode(other, user), "template splices after other trade fields too");
+}
+
+static void TestAccountChanges() {
+    std::cout << "\n--- Changed account data ---" << std::endl;
+    ClientHarness warm;
+    TradeRecord trade = MakeTrade(1, 20001, "EURUSD");
+    UserInfo user = MakeUser(20001);
+    warm.Encode(trade, user);
+
+    UserInfo richer = user;
+    richer.balance = 25000.0;
+    unsigned long long misses = warm.Misses();
+    std::string after_balance = warm.Encode(trade, richer);
+    Check(warm.Misses() == misses + 1 && after_balance == FullEncode(trade, richer), "changed balance re-encodes");
+    Check(after_balance != FullEncode(trade, user), "changed balance changes the request");
+
+    UserInfo moved = richer;
+    strcpy(moved.group, "real\\pro");
+    misses = warm.Misses();
+    std::string after_group = warm.Encode(trade, moved);
+    Check(warm.Misses() == misses + 1 && after_group == FullEncode(trade, moved), "changed group re-encodes");
+
+    // Leverage is not a ScoringRequest field, so it is not fingerprinted either:
+    // the template stays valid and the request is still the full encode
+    UserInfo levered = moved;
+    levered.leverage = 500;
+    unsigned long long hits = warm.Hits();
+    std::string after_leverage = warm.Encode(trade, levered);
+    Check(warm.Hits() == hits + 1 && after_leverage == FullEncode(trade, levered) && after_leverage == after_group,
+          "changed leverage keeps the template and matches the full encode");
+
+    // Back to the original account data: re-encoded again, never a stale splice
+    misses = warm.Misses();
+    Check(warm.Encode(trade, user) == FullEncode(trade, user) && warm.Misses() == misses + 1, "reverted account re-encodes");
+}
+
+static void TestCapacity() {
+    std::cout << "\n--- Capacity eviction ---" << std::endl;
+    AccountTemplateCache cache(2);
+    const char a[] = "aaaa", b[] = "bbbb", c[] = "cccc";
+    cache.Store(1, 11, a, 4);
+    cache.Store(2, 22, b, 4);
+    cache.Store(1, 12, c, 4);                  // Replacing a login never evicts another
+    Check(cache.Accounts() == 2, "replacing a template keeps both accounts");
+    cache.Store(3, 33, c, 4);
+    Check(cache.Accounts() == 2, "a new login at capacity evicts one template");
+
+    char buffer[64];
+    ProtoWriter out(buffer, sizeof(buffer));
+    int present = 0;
+    if (cache.AppendTo(1, 12, out)) present++;
+    if (cache.AppendTo(2, 22, out)) present++;
+    bool newest = cache.AppendTo(3, 33, out);
+    Check(newest && present == 1 && out.Size() == 8, "the newest template is kept and one older one evicted");
+
+    size_t before = out.Size();
+    Check(!cache.AppendTo(3, 34, out) && out.Size() == before, "stale fingerprint misses and leaves the request untouched");
+    char oversized[AccountTemplateCache::MAX_TEMPLATE_BYTES + 1] = { 0 };
+    cache.Store(4, 44, oversized, sizeof(oversized));
+    Check(!cache.AppendTo(4, 44, out) && cache.Accounts() == 2, "oversized template is not cached");
+
+    // Through the client: more logins than slots, every request still the full encode
+    ClientHarness small(2);
+    bool all_full = true;
+    for (int round = 0; round < 2; round++) {
+        for (int login = 30001; login <= 30003; login++) {
+            TradeRecord trade = MakeTrade(login, login, "EURUSD");
+            UserInfo user = MakeUser(login);
+            all_full = all_full && small.Encode(trade, user) == FullEncode(trade, user);
+        }
+    }
+    Check(small.client.GetAccountTemplates().Accounts() == 2, "client cache holds AccountTemplateCacheSize logins");
+    Check(all_full, "requests after eviction are the full encode");
+}
+
+int main() {
+    std::cout << "=== Request Templates Test ===" << std::endl;
+
+    TestSpliceMatchesFullEncode();
+    TestAccountChanges();
+    TestCapacity();
+    remove(TEST_LOG);
+
+    std::cout << std::endl;
+    if (failures == 0) {
+        std::cout << "ALL TESTS PASSED" << std::endl;
+        return 0;
+    }
+    std::cout << failures << " TEST(S) FAILED" << std::endl;
+    return 1;
+}
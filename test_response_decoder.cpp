@@ -0,0 +1,213 @@
+//+------------------------------------------------------------------+
+//| ScoringResponse Decoder Test + Fuzz Harness                     |
+//| Known encodings first, then round-trips of random valid         |
+//| responses, then random mutations that must never crash          |
+//+------------------------------------------------------------------+
+//
+// Usage: test_response_decoder [fuzz_iterations] [seed]
+//
+// Build with ABBOOK_LIBFUZZER and clang -fsanitize=fuzzer,address to drive the
+// same checks from libFuzzer instead (main() is compiled out).
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+
+#include "ABBook_ProtoWriter.h"
+#include "ABBook_ProtoReader.h"
+
+static int failures = 0;
+
+static void Check(bool condition, const std::string& name) {
+    if (!condition) {
+        std::cout << "FAIL: " << name << std::endl;
+        failures++;
+    }
+}
+
+static std::string Bytes(const char* data, size_t length) {
+    return std::string(data, length);
+}
+
+// Decoder invariants for arbitrary input: no out-of-bounds view, and a score
+// only ever comes from a successful decode
+static bool CheckInvariants(const char* data, size_t length) {
+    ScoringResponseView view;
+    ProtoDecodeStatus status = DecodeScoringResponse(data, length, view);
+    if (status > PROTO_DECODE_BAD_FIELD) return false;
+
+    size_t stored = view.warning_count < ScoringResponseView::MAX_WARNINGS ? view.warning_count : ScoringResponseView::MAX_WARNINGS;
+    for (size_t i = 0; i < stored; i++) {
+        const ProtoBytes& w = view.warnings[i];
+        if (w.data < data || w.length > length || w.data + w.length > data + length) return false;
+    }
+    return true;
+}
+
+#ifdef ABBOOK_LIBFUZZER
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    if (!CheckInvariants((const char*)data, size)) abort();
+    return 0;
+}
+#else
+
+static void KnownEncodings() {
+    ScoringResponseView view;
+
+    // { score: 0.5 } as scoring.proto declares it (field 1, fixed32)
+    const std::string score_only("\x0D\x00\x00\x00\x3F", 5);
+    Check(DecodeScoringResponse(score_only.data(), score_only.size(), view) == PROTO_DECODE_OK &&
+          view.has_score && view.score == 0.5f && view.warning_count == 0, "score in field 1");
+
+    // Deployed service: score as fixed32 in field 2 (decode_ml_response.cpp)
+    const std::string legacy("\x15\x00\x3F\x25\x3B", 5);
+    float expected;
+    memcpy(&expected, legacy.data() + 1, 4);
+    Check(DecodeScoringResponse(legacy.data(), legacy.size(), view) == PROTO_DECODE_OK &&
+          view.has_score && view.score == expected, "legacy score in field 2");
+
+    // A warning whose text contains 0x15 must not be read as a score
+    const std::string tricky("\x12\x06" "ab\x15\x00\x00\x80" "\x0D\x00\x00\x00\x3F", 13);
+    Check(DecodeScoringResponse(tricky.data(), tricky.size(), view) == PROTO_DECODE_OK &&
+          view.has_score && view.score == 0.5f && view.warning_count == 1 &&
+          Bytes(view.warnings[0].data, view.warnings[0].length) == std::string("ab\x15\x00\x00\x80", 6),
+          "0x15 inside a warning string");
+
+    // No score, only a 0x15 byte inside an unknown varint field
+    const std::string varint_only("\x18\x95\x01", 3);   // field 3 = 149
+    Check(DecodeScoringResponse(varint_only.data(), varint_only.size(), view) == PROTO_DECODE_OK &&
+          !view.has_score, "0x15 inside a varint payload");
+
+    // Unknown fields of every wire type are skipped
+    const std::string unknown("\x18\x01" "\x21\x01\x02\x03\x04\x05\x06\x07\x08" "\x2A\x02hi" "\x35\x00\x00\x00\x00"
+                              "\x0D\x00\x00\x80\x3E", 25);
+    Check(DecodeScoringResponse(unknown.data(), unknown.size(), view) == PROTO_DECODE_OK &&
+          view.has_score && view.score == 0.25f, "unknown fields skipped by wire type");
+
+    // Truncation and malformed input
+    Check(DecodeScoringResponse(score_only.data(), 3, view) == PROTO_DECODE_TRUNCATED, "truncated fixed32");
+    const std::string long_string("\x12\x7F" "abc", 5);
+    Check(DecodeScoringResponse(long_string.data(), long_string.size(), view) == PROTO_DECODE_TRUNCATED, "string length past end");
+    const std::string bad_varint("\x18\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\xFF\x01", 12);
+    Check(DecodeScoringResponse(bad_varint.data(), bad_varint.size(), view) == PROTO_DECODE_BAD_VARINT, "11-byte varint");
+    const std::string group("\x0B", 1);
+    Check(DecodeScoringResponse(group.data(), group.size(), view) == PROTO_DECODE_BAD_WIRE_TYPE, "group wire type");
+    const std::string field_zero("\x05\x00\x00\x00\x3F", 5);
+    Check(DecodeScoringResponse(field_zero.data(), field_zero.size(), view) == PROTO_DECODE_BAD_FIELD, "field number 0");
+    const std::string score_as_varint("\x08\x01", 2);
+    Check(DecodeScoringResponse(score_as_varint.data(), score_as_varint.size(), view) == PROTO_DECODE_BAD_FIELD, "score with wrong wire type");
+    Check(DecodeScoringResponse("", 0, view) == PROTO_DECODE_OK && !view.has_score, "empty response");
+}
+
+static uint32_t rng_state;
+
+static uint32_t Random() {
+    rng_state ^= rng_state << 13;
+    rng_state ^= rng_state >> 17;
+    rng_state ^= rng_state << 5;
+    return rng_state;
+}
+
+// Random valid ScoringResponse plus unknown fields; decoding must give it back
+static void RoundTrip(int iterations) {
+    char buffer[4096];
+    for (int i = 0; i < iterations; i++) {
+        ProtoWriter out(buffer, sizeof(buffer));
+        float score = (float)(Random() % 1000001) / 1000000.0f;
+        size_t warning_count = Random() % 12;
+        std::vector<std::string> warnings;
+        bool score_written = false;
+
+        for (size_t w = 0; w < warning_count; w++) {
+            std::string text;
+            size_t length = Random() % 40;
+            for (size_t c = 0; c < length; c++) text += (char)(Random() & 0xFF);
+            warnings.push_back(text);
+            scoring::ScoringResponse::warnings(out, text.data(), text.size());
+            if (Random() % 3 == 0) out.Int64(3 + Random() % 100, (int64_t)Random() << (Random() % 32));
+            if (Random() % 4 == 0 && !score_written) {
+                scoring::ScoringResponse::score(out, score);
+                score_written = true;
+            }
+        }
+        if (!score_written) scoring::ScoringResponse::score(out, score);
+
+        ScoringResponseView view;
+        bool ok = DecodeScoringResponse(out.Data(), out.Size(), view) == PROTO_DECODE_OK &&
+                  view.has_score && view.score == score && view.warning_count == warnings.size();
+        for (size_t w = 0; ok && w < warnings.size() && w < ScoringResponseView::MAX_WARNINGS; w++) {
+            ok = Bytes(view.warnings[w].data, view.warnings[w].length) == warnings[w];
+        }
+        if (!ok) {
+            Check(false, "round trip " + std::to_string(i));
+            return;
+        }
+    }
+}
+
+// Mutate valid responses (flip, insert, delete, truncate) and feed random bytes;
+// every input must decode or fail cleanly
+static void Fuzz(int iterations) {
+    const std::string seeds[] = {
+        std::string("\x0D\x00\x00\x00\x3F", 5),
+        std::string("\x15\x00\x3F\x25\x3B", 5),
+        std::string("\x12\x06" "ab\x15\x00\x00\x80" "\x0D\x00\x00\x00\x3F", 13),
+        std::string("\x18\x01" "\x21\x01\x02\x03\x04\x05\x06\x07\x08" "\x2A\x02hi" "\x35\x00\x00\x00\x00", 20),
+    };
+    std::vector<char> input;
+    for (int i = 0; i < iterations; i++) {
+        const std::string& seed = seeds[Random() % 4];
+        if (Random() % 8 == 0) {
+            input.assign(Random() % 64, 0);
+            for (char& c : input) c = (char)(Random() & 0xFF);
+        } else {
+            input.assign(seed.begin(), seed.end());
+            int mutations = 1 + Random() % 4;
+            for (int m = 0; m < mutations; m++) {
+                size_t at = input.empty() ? 0 : Random() % input.size();
+                switch (Random() % 4) {
+                    case 0: if (!input.empty()) input[at] ^= (char)(1 << (Random() % 8)); break;
+                    case 1: input.insert(input.begin() + at, (char)(Random() & 0xFF)); break;
+                    case 2: if (!input.empty()) input.erase(input.begin() + at); break;
+                    case 3: input.resize(at); break;
+                }
+            }
+        }
+
+        // Decode from an exact-size heap copy so ASan catches any over-read
+        char* exact = new char[input.size() ? input.size() : 1];
+        if (!input.empty()) memcpy(exact, input.data(), input.size());
+        bool ok = CheckInvariants(exact, input.size());
+        delete[] exact;
+        if (!ok) {
+            Check(false, "fuzz iteration " + std::to_string(i));
+            return;
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = argc > 1 ? atoi(argv[1]) : 200000;
+    rng_state = argc > 2 ? (uint32_t)strtoul(argv[2], nullptr, 10) : 0x2545F491u;
+    if (rng_state == 0) rng_state = 1;
+
+    std::cout << "=== SCORINGRESPONSE DECODER TEST ===" << std::endl;
+    KnownEncodings();
+    std::cout << "Known encodings: " << (failures == 0 ? "PASS" : "FAIL") << std::endl;
+
+    int before = failures;
+    RoundTrip(iterations / 10);
+    std::cout << "Round trips (" << iterations / 10 << "): " << (failures == before ? "PASS" : "FAIL") << std::endl;
+
+    before = failures;
+    Fuzz(iterations);
+    std::cout << "Fuzzed inputs (" << iterations << "): " << (failures == before ? "PASS" : "FAIL") << std::endl;
+
+    std::cout << std::endl << (failures == 0 ? "ALL TESTS PASSED" : std::to_string(failures) + " TEST(S) FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
+
+#endif
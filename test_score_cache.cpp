@@ -0,0 +1,306 @@
+//+------------------------------------------------------------------+
+//| Score Cache Test                                                |
+//| Keys, TTL, CLOCK eviction, counters, lock-free reads racing    |
+//| with writers, and stale-while-revalidate refreshes             |
+//+------------------------------------------------------------------+
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+
+#include "ABBook_ScoreCache.h"
+#include "ABBook_ScoreRevalidator.h"
+
+static int failures = 0;
+
+static void Check(bool condition, const std::string& name) {
+    std::cout << (condition ? "PASS: " : "FAIL: ") << name << std::endl;
+    if (!condition) failures++;
+}
+
+static void TestKeys() {
+    uint64_t key = ScoreCacheKey(1001, 5, 0, 4);
+    Check(key == ScoreCacheKey(1001, 5, 0, 7), "0.04 and 0.07 lots share a volume class");
+    Check(key != ScoreCacheKey(1001, 5, 0, 8), "0.08 lots is the next class");
+    Check(key != ScoreCacheKey(1001, 5, 1, 4), "direction is part of the key");
+    Check(key != ScoreCacheKey(1002, 5, 0, 4) && key != ScoreCacheKey(1001, 6, 0, 4), "login and symbol are part of the key");
+    Check(ScoreCacheKey(0, 0, 0, 0) != 0 && ScoreCacheKey(-1, 0, 0, -5) != 0, "key is never the empty marker");
+}
+
+static void TestTtl() {
+    ScoreCache cache;
+    double score = 0.0;
+    uint64_t key = ScoreCacheKey(1001, 5, 0, 100);
+    Check(cache.Lookup(key, 1000, score) == SCORE_CACHE_MISS, "unconfigured cache misses");
+    cache.Store(key, 0.5, 1000);
+    Check(!cache.Enabled() && cache.Misses() == 0, "unconfigured cache stores and counts nothing");
+
+    cache.Configure(1000, 300);
+    Check(cache.Capacity() == 1024, "capacity rounded up to whole sets");
+    Check(cache.Lookup(key, 1000, score) == SCORE_CACHE_MISS, "empty cache misses");
+    cache.Store(key, 0.42, 1000);
+    Check(cache.Lookup(key, 1300, score) == SCORE_CACHE_HIT && score == 0.42, "hit until the TTL");
+    Check(cache.Lookup(key, 1301, score) == SCORE_CACHE_MISS, "miss after the TTL");
+    cache.Store(key, 0.17, 1301);
+    Check(cache.Lookup(key, 1500, score) == SCORE_CACHE_HIT && score == 0.17, "store refreshes the entry");
+    Check(cache.Entries() == 1, "refresh reuses the slot");
+    Check(cache.Hits() == 2 && cache.Misses() == 2 && cache.Evictions() == 0, "hit/miss counters");
+    Check(cache.Lookup(key, 1299, score) == SCORE_CACHE_HIT && score == 0.17,
+          "entry stored by a thread whose clock ran ahead is fresh");
+}
+
+static void TestClockEviction() {
+    ScoreCache cache;
+    cache.Configure(1, 1000);
+    Check(cache.Capacity() == ScoreCache::SHARDS * ScoreCache::WAYS, "minimum is one set per shard");
+
+    uint64_t hot = ScoreCacheKey(1, 1, 0, 100);
+    uint64_t cold = ScoreCacheKey(2, 1, 0, 100);
+    cache.Store(hot, 0.9, 0);
+    cache.Store(cold, 0.1, 0);
+    double score;
+    bool hot_kept = true;
+    for (int login = 100; login < 1100; login++) {
+        hot_kept = hot_kept && cache.Lookup(hot, 10, score) == SCORE_CACHE_HIT;
+        cache.Store(ScoreCacheKey(login, 1, 0, 100), 0.5, 10);
+    }
+    Check(hot_kept, "entry hit between inserts survives 1000 inserts");
+    Check(cache.Lookup(cold, 10, score) == SCORE_CACHE_MISS, "entry never hit is evicted");
+    Check(cache.Entries() == cache.Capacity(), "table fills up");
+    Check(cache.Evictions() == 1002 - cache.Capacity(), "one eviction per insert into a full set");
+
+    // Expired entries are replaced before live ones
+    ScoreCache aging;
+    aging.Configure(1, 100);
+    for (int login = 0; login < 128; login++) aging.Store(ScoreCacheKey(login, 1, 0, 1), 0.5, 0);
+    unsigned long long evictions = aging.Evictions();
+    for (int login = 1000; login < 1050; login++) aging.Store(ScoreCacheKey(login, 1, 0, 1), 0.5, 500);
+    Check(aging.Evictions() == evictions, "expired entries are reused without eviction");
+}
+
+// Writers store score = f(key); readers must never see another key's score
+static double ScoreFor(uint64_t key, int version) {
+    return (double)(key % 1000003) + version * 0.25;
+}
+
+static void TestConcurrentReadWrite() {
+    ScoreCache cache;
+    cache.Configure(256, 1000000);
+
+    std::atomic<bool> stop(false);
+    std::atomic<unsigned long long> lookups(0), wrong(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&, t]() {
+            for (int round = 0; round < 200; round++) {
+                for (int login = 0; login < 512; login++) {
+                    uint64_t key = ScoreCacheKey(login, (uint32_t)(t % 2), 0, 100);
+                    cache.Store(key, ScoreFor(key, round % 4), 1);
+                }
+            }
+        });
+    }
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&, t]() {
+            unsigned long long local = 0;
+            while (!stop.load()) {
+                for (int login = 0; login < 512; login++) {
+                    uint64_t key = ScoreCacheKey(login, (uint32_t)(t % 2), 0, 100);
+                    double score;
+                    local++;
+                    if (cache.Lookup(key, 2, score) == SCORE_CACHE_HIT) {
+                        double base = ScoreFor(key, 0);
+                        if (score != base && score != base + 0.25 && score != base + 0.5 && score != base + 0.75) wrong++;
+                    }
+                }
+            }
+            lookups += local;
+        });
+    }
+    for (int t = 0; t < 4; t++) threads[t].join();
+    stop = true;
+    for (size_t t = 4; t < threads.size(); t++) threads[t].join();
+
+    Check(wrong.load() == 0, "readers never see a torn or foreign score");
+    Check(cache.Hits() + cache.Misses() == lookups.load(), "every lookup counted once");
+    Check(cache.Entries() <= cache.Capacity(), "size stays bounded");
+}
+
+static void TestStale() {
+    ScoreCache cache;
+    cache.Configure(1000, 300, 300);
+    Check(!cache.ServesStale(), "staleness limit not above the TTL serves nothing stale");
+
+    cache.Configure(1000, 300, 2000);
+    uint64_t key = ScoreCacheKey(1001, 5, 0, 100);
+    double score = 0.0;
+    cache.Store(key, 0.42, 1000);
+    Check(cache.ServesStale() && cache.Lookup(key, 1300, score) == SCORE_CACHE_HIT, "fresh within the TTL");
+    Check(cache.Lookup(key, 1301, score) == SCORE_CACHE_STALE && score == 0.42, "stale past the TTL");
+    Check(cache.Lookup(key, 3000, score) == SCORE_CACHE_STALE, "stale up to the staleness limit");
+    Check(cache.Lookup(key, 3001, score) == SCORE_CACHE_MISS, "miss past the staleness limit");
+    Check(cache.Hits() == 1 && cache.StaleHits() == 2 && cache.Misses() == 1, "stale hits counted separately");
+}
+
+// Fetch stub the test can hold up, to keep a refresh in flight
+struct FetchGate {
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool open = true;
+    bool succeed = true;
+    int calls = 0;
+
+    bool Fetch(const char* frame, size_t length, double& score) {
+        std::unique_lock<std::mutex> lock(mutex);
+        calls++;
+        cv.wait(lock, [this]() { return open; });
+        score = length == 3 && memcmp(frame, "abc", 3) == 0 ? 0.9 : 0.1;
+        return succeed;
+    }
+
+    void Set(bool is_open, bool will_succeed = true) {
+        std::lock_guard<std::mutex> lock(mutex);
+        open = is_open;
+        succeed = will_succeed;
+        cv.notify_all();
+    }
+};
+
+static bool WaitFor(const std::function<bool()>& condition) {
+    for (int i = 0; i < 2000 && !condition(); i++) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    return condition();
+}
+
+static void TestRevalidator() {
+    ScoreCache cache;
+    cache.Configure(1000, 300, 2000);
+    FetchGate gate;
+    ScoreRevalidator revalidator(&cache, [&](const char* frame, size_t length, double& score) {
+        return gate.Fetch(frame, length, score);
+    });
+    uint64_t key = ScoreCacheKey(1001, 5, 0, 100);
+    Check(!revalidator.Queue(key, "abc", 3), "nothing is queued before Start");
+
+    revalidator.Start();
+    cache.Store(key, 0.42, ScoreCacheNowMs() - 1000);
+    double score = 0.0;
+    Check(cache.Lookup(key, ScoreCacheNowMs(), score) == SCORE_CACHE_STALE, "entry starts stale");
+
+    gate.Set(false);
+    Check(revalidator.Queue(key, "abc", 3), "stale key queued");
+    Check(!revalidator.Queue(key, "abc", 3) && revalidator.Pending(key), "key already pending is not queued twice");
+    Check(WaitFor([&]() { std::lock_guard<std::mutex> lock(gate.mutex); return gate.calls == 1; }), "worker picks the job up");
+    Check(!revalidator.Queue(key, "abc", 3), "key being refreshed is not queued again");
+
+    // Worker blocked on the first key: fill the queue behind it
+    int accepted = 0;
+    for (int login = 0; login < (int)ScoreRevalidator::MAX_QUEUED + 5; login++) {
+        if (revalidator.Queue(ScoreCacheKey(login, 7, 0, 100), "xyz", 3)) accepted++;
+    }
+    Check(accepted == (int)ScoreRevalidator::MAX_QUEUED && revalidator.Dropped() == 5, "full queue drops refreshes");
+
+    gate.Set(true);
+    Check(WaitFor([&]() { return revalidator.Refreshed() == ScoreRevalidator::MAX_QUEUED + 1; }), "every queued refresh runs");
+    Check(cache.Lookup(key, ScoreCacheNowMs(), score) == SCORE_CACHE_HIT && score == 0.9, "refreshed score is fresh in the cache");
+    Check(!revalidator.Pending(key), "finished key is no longer pending");
+
+    // A failed refresh leaves the stale entry alone
+    uint64_t other = ScoreCacheKey(2002, 5, 0, 100);
+    cache.Store(other, 0.33, ScoreCacheNowMs() - 1000);
+    gate.Set(true, false);
+    revalidator.Queue(other, "abc", 3);
+    Check(WaitFor([&]() { return revalidator.Failed() == 1; }), "failed refresh counted");
+    Check(cache.Lookup(other, ScoreCacheNowMs(), score) == SCORE_CACHE_STALE && score == 0.33, "failed refresh keeps the stale score");
+
+    // Stop discards what is still queued
+    gate.Set(false);
+    for (int login = 0; login < 10; login++) revalidator.Queue(ScoreCacheKey(login, 8, 0, 100), "xyz", 3);
+    std::thread release([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        gate.Set(true);
+    });
+    revalidator.Stop();
+    release.join();
+    Check(revalidator.Refreshed() <= ScoreRevalidator::MAX_QUEUED + 2, "Stop discards queued refreshes");
+    Check(!revalidator.Queue(key, "abc", 3), "nothing is queued after Stop");
+}
+
+static void TestPrescoreFlag() {
+    ScoreCache cache;
+    cache.Configure(1000, 300, 2000);
+    cache.SetPrescoreTtl(5000);
+    uint64_t now = ScoreCacheNowMs();
+    uint64_t key = ScoreCacheKey(3003, 5, 1, 100);
+    double score = 0.0;
+
+    cache.Store(key, 0.6, now - 1000, true);
+    Check(cache.Peek(key, now) == SCORE_CACHE_HIT, "unused pre-score is fresh for the pre-score TTL");
+    Check(cache.PrescoreHits() == 0 && cache.Hits() == 0, "Peek counts nothing");
+    Check(cache.Lookup(key, now, score) == SCORE_CACHE_HIT && score == 0.6, "order hits the pre-score");
+    Check(cache.PrescoresStored() == 1 && cache.PrescoreHits() == 1, "pre-score hit counted");
+    Check(cache.Lookup(key, now, score) == SCORE_CACHE_STALE, "used pre-score falls back to the normal TTL");
+    Check(cache.PrescoreHits() == 1, "a pre-score is credited once");
+
+    uint64_t expired = ScoreCacheKey(3004, 5, 1, 100);
+    cache.Store(expired, 0.6, now - 6000, true);
+    Check(cache.Lookup(expired, now, score) == SCORE_CACHE_MISS && cache.PrescoreHits() == 1, "pre-score past its TTL is gone");
+
+    // A regular score replacing a pre-score clears the flag
+    uint64_t replaced = ScoreCacheKey(3005, 5, 1, 100);
+    cache.Store(replaced, 0.2, now, true);
+    cache.Store(replaced, 0.3, now);
+    Check(cache.Lookup(replaced, now, score) == SCORE_CACHE_HIT && cache.PrescoreHits() == 1, "replaced pre-score is not credited");
+}
+
+static void TestPrescorerRateLimit() {
+    ScoreCache cache;
+    cache.Configure(1000, 300);
+    cache.SetPrescoreTtl(5000);
+    FetchGate gate;
+    gate.Set(true);
+    ScoreRevalidator prescorer(&cache, [&](const char* frame, size_t length, double& score) {
+        return gate.Fetch(frame, length, score);
+    }, true);
+    prescorer.SetRateLimit(20);
+    prescorer.Start();
+
+    // A burst of one second's worth goes out at once, the rest at 20 per second
+    auto start = std::chrono::steady_clock::now();
+    for (int login = 0; login < 30; login++) prescorer.Queue(ScoreCacheKey(login, 9, 0, 100), "abc", 3);
+    Check(WaitFor([&]() { return prescorer.Refreshed() == 30; }), "every pre-score runs");
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    Check(elapsed >= 0.4, "requests past the burst are paced by the rate limit");
+    Check(cache.PrescoresStored() == 30, "results are stored as pre-scores");
+
+    double score = 0.0;
+    Check(cache.Lookup(ScoreCacheKey(0, 9, 0, 100), ScoreCacheNowMs(), score) == SCORE_CACHE_HIT && cache.PrescoreHits() == 1,
+          "order hits a background pre-score");
+
+    // Stop does not wait for the bucket to refill
+    for (int login = 100; login < 150; login++) prescorer.Queue(ScoreCacheKey(login, 9, 0, 100), "abc", 3);
+    start = std::chrono::steady_clock::now();
+    prescorer.Stop();
+    elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    Check(elapsed < 0.5 && prescorer.Refreshed() < 80, "Stop interrupts a throttled queue");
+}
+
+int main() {
+    std::cout << "=== SCORE CACHE TEST ===" << std::endl;
+    TestKeys();
+    TestTtl();
+    TestClockEviction();
+    TestConcurrentReadWrite();
+    TestStale();
+    TestRevalidator();
+    TestPrescoreFlag();
+    TestPrescorerRateLimit();
+
+    std::cout << std::endl << (failures == 0 ? "ALL TESTS PASSED" : std::to_string(failures) + " TEST(S) FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,426 @@
+//+------------------------------------------------------------------+
+//| Scoring Batcher Test                                            |
+//| Leader/follower handoff: requests that join a batch each get    |
+//| their own response; a follower timing out mid-batch detaches    |
+//| without disturbing the rest                                     |
+//+------------------------------------------------------------------+
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include <stdexcept>
+
+#include "ABBook_ScoringBatcher.h"
+
+static int failures = 0;
+
+static void Check(bool condition, const std::string& name) {
+    std::cout << (condition ? "PASS: " : "FAIL: ") << name << std::endl;
+    if (!condition) failures++;
+}
+
+static long long ElapsedMs(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+//+------------------------------------------------------------------+
+//| Fake scoring service behind the BatchTransport                  |
+//+------------------------------------------------------------------+
+
+// Answers each ScoringRequest in a batch with "re:<request>", optionally held
+// until released, and records what every batch contained.
+class FakeBatchService {
+private:
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool held;
+    bool fail;                         // Report a transport failure
+    bool throw_error;                  // Throw from the transport
+    bool drop_last;                    // Answer one response short
+    int in_flight;
+    std::vector<std::vector<std::string>> batches;
+
+    static void AppendVarint(std::string& out, uint64_t value) {
+        while (value >= 0x80) {
+            out += (char)((value & 0x7F) | 0x80);
+            value >>= 7;
+        }
+        out += (char)(value & 0x7F);
+    }
+
+public:
+    FakeBatchService() : held(false), fail(false), throw_error(false), drop_last(false), in_flight(0) {}
+
+    bool RoundTrip(const std::string& batch_request, std::string& batch_response, const ScoringDeadline& deadline) {
+        std::vector<std::string> requests;
+        ProtoReader reader(batch_request.data(), batch_request.size());
+        uint32_t field_number;
+        int wire_type;
+        while (reader.ReadTag(field_number, wire_type)) {
+            ProtoBytes request;
+            if (field_number == 1 && wire_type == 2 && reader.ReadLengthDelimited(request)) {
+                requests.push_back(std::string(request.data, request.length));
+            } else {
+                reader.Skip(wire_type);
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(mutex);
+        batches.push_back(requests);
+        in_flight++;
+        cv.notify_all();
+        cv.wait_until(lock, deadline.expires, [this]() { return !held; });
+        in_flight--;
+        if (throw_error) throw std::runtime_error("transport exploded");
+        if (fail || held) return false;
+
+        size_t answered = drop_last && !requests.empty() ? requests.size() - 1 : requests.size();
+        batch_response.clear();
+        for (size_t i = 0; i < answered; i++) {
+            std::string response = "re:" + requests[i];
+            batch_response += (char)0x0A; // ScoringBatchResponse.responses, wire type 2
+            AppendVarint(batch_response, response.size());
+            batch_response += response;
+        }
+        return true;
+    }
+
+    BatchTransport Transport() {
+        return [this](const std::string& request, std::string& response, const ScoringDeadline& deadline) {
+            return RoundTrip(request, response, deadline);
+        };
+    }
+
+    void Hold() {
+        std::lock_guard<std::mutex> lock(mutex);
+        held = true;
+    }
+
+    void Release() {
+        std::lock_guard<std::mutex> lock(mutex);
+        held = false;
+        cv.notify_all();
+    }
+
+    void Fail(bool transport_fails, bool transport_throws, bool short_response) {
+        std::lock_guard<std::mutex> lock(mutex);
+        fail = transport_fails;
+        throw_error = transport_throws;
+        drop_last = short_response;
+    }
+
+    // Wait until a batch is inside the transport
+    bool WaitInFlight() {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, std::chrono::seconds(5), [this]() { return in_flight > 0; });
+    }
+
+    std::vector<std::vector<std::string>> Batches() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return batches;
+    }
+};
+
+static void Configure(PluginConfig& config, int window_us, int max_items) {
+    config.batch_window_us = window_us;
+    config.batch_max_items = max_items;
+}
+
+// Submit `body` on a new thread; the outcome lands in status/response
+static std::thread SubmitOn(ScoringBatcher& batcher, const std::string& body, int deadline_ms,
+                            BatchStatus& status, std::string& response, long long* waited_ms = nullptr) {
+    return std::thread([&batcher, &body, deadline_ms, &status, &response, waited_ms]() {
+        auto start = std::chrono::steady_clock::now();
+        status = batcher.Submit(body.data(), body.size(), response, ScoringDeadline::In(deadline_ms));
+        if (waited_ms) *waited_ms = ElapsedMs(start);
+    });
+}
+
+// Gives the thread just started time to open the batch (or join it) before the next one
+static void WaitForLeader() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+}
+
+//+------------------------------------------------------------------+
+//| Tests                                                           |
+//+------------------------------------------------------------------+
+
+// Four trade threads inside one window share a round trip
+static void TestHandoff() {
+    std::cout << "\n--- Leader/follower handoff ---" << std::endl;
+    PluginConfig config;
+    Configure(config, 2000000, 4);     // The batch is sealed by filling up, not by the window
+    FakeBatchService service;
+    ScoringBatcher batcher(&config, service.Transport());
+
+    const int THREADS = 4;
+    std::string bodies[THREADS];
+    std::string responses[THREADS];
+    BatchStatus statuses[THREADS];
+    std::vector<std::thread> threads;
+    for (int i = 0; i < THREADS; i++) {
+        bodies[i] = "trade-" + std::to_string(i);
+        statuses[i] = BATCH_TRANSPORT_FAILED;
+        threads.push_back(SubmitOn(batcher, bodies[i], 5000, statuses[i], responses[i]));
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    bool all_ok = true, all_matched = true;
+    for (int i = 0; i < THREADS; i++) {
+        all_ok = all_ok && statuses[i] == BATCH_OK;
+        all_matched = all_matched && responses[i] == "re:" + bodies[i];
+    }
+    std::vector<std::vector<std::string>> batches = service.Batches();
+    Check(batches.size() == 1 && batches[0].size() == (size_t)THREADS, "Four requests went out as one batch");
+    Check(batcher.BatchesSent() == 1 && batcher.RequestsSent() == (unsigned long long)THREADS, "Counters: 1 batch, 4 requests");
+    Check(all_ok, "Leader and followers all got BATCH_OK");
+    Check(all_matched, "Each thread got the response to its own request");
+
+    // Window 0: a lone request goes out on its own
+    Configure(config, 0, 4);
+    std::string body = "alone";
+    std::string response;
+    BatchStatus status = batcher.Submit(body.data(), body.size(), response, ScoringDeadline::In(1000));
+    Check(status == BATCH_OK && response == "re:alone", "Window 0 sends a single request immediately");
+    Check(service.Batches().size() == 2, "Second batch sent");
+}
+
+// A follower whose deadline runs out while the batch is in flight detaches;
+// the leader and the other follower still get their responses.
+static void TestFollowerTimeoutInFlight() {
+    std::cout << "\n--- Follower times out while the batch is in flight ---" << std::endl;
+    PluginConfig config;
+    Configure(config, 2000000, 3);
+    FakeBatchService service;
+    service.Hold();
+    ScoringBatcher batcher(&config, service.Transport());
+
+    std::string leader_body = "leader", patient_body = "patient", hasty_body = "hasty";
+    std::string leader_response, patient_response, hasty_response;
+    BatchStatus leader_status = BATCH_TRANSPORT_FAILED, patient_status = BATCH_TRANSPORT_FAILED;
+    BatchStatus hasty_status = BATCH_OK;
+    long long hasty_waited = 0;
+
+    std::thread leader = SubmitOn(batcher, leader_body, 5000, leader_status, leader_response);
+    WaitForLeader();
+    std::thread patient = SubmitOn(batcher, patient_body, 5000, patient_status, patient_response);
+    std::thread hasty = SubmitOn(batcher, hasty_body, 100, hasty_status, hasty_response, &hasty_waited);
+
+    Check(service.WaitInFlight(), "Full batch handed to the transport");
+    hasty.join();
+    Check(hasty_status == BATCH_DEADLINE_EXPIRED, "Hasty follower returns BATCH_DEADLINE_EXPIRED");
+    Check(hasty_waited < 1000, "Hasty follower did not wait for the held round trip");
+    Check(hasty_response.empty(), "Hasty follower got no response");
+
+    service.Release();
+    leader.join();
+    patient.join();
+    Check(leader_status == BATCH_OK && leader_response == "re:leader", "Leader got its own response");
+    Check(patient_status == BATCH_OK && patient_response == "re:patient", "Patient follower got its own response");
+    std::vector<std::vector<std::string>> batches = service.Batches();
+    Check(batches.size() == 1 && batches[0].size() == 3, "The detached follower was already in the sent batch");
+}
+
+// A follower that gives up before the batch is sealed is left out of it, and
+// the followers behind it are re-indexed onto the right responses.
+static void TestFollowerTimeoutBeforeSeal() {
+    std::cout << "\n--- Follower times out before the batch is sealed ---" << std::endl;
+    PluginConfig config;
+    Configure(config, 300000, 8);      // Sealed by the 300 ms window
+    FakeBatchService service;
+    ScoringBatcher batcher(&config, service.Transport());
+
+    std::string leader_body = "leader", hasty_body = "hasty", patient_body = "patient";
+    std::string leader_response, hasty_response, patient_response;
+    BatchStatus leader_status = BATCH_TRANSPORT_FAILED, patient_status = BATCH_TRANSPORT_FAILED;
+    BatchStatus hasty_status = BATCH_OK;
+
+    std::thread leader = SubmitOn(batcher, leader_body, 5000, leader_status, leader_response);
+    WaitForLeader();
+    std::thread hasty = SubmitOn(batcher, hasty_body, 50, hasty_status, hasty_response);
+    WaitForLeader();
+    std::thread patient = SubmitOn(batcher, patient_body, 5000, patient_status, patient_response);
+    hasty.join();
+    leader.join();
+    patient.join();
+
+    Check(hasty_status == BATCH_DEADLINE_EXPIRED, "Hasty follower returns BATCH_DEADLINE_EXPIRED");
+    std::vector<std::vector<std::string>> batches = service.Batches();
+    Check(batches.size() == 1 && batches[0].size() == 2 && batches[0][0] == "leader" && batches[0][1] == "patient",
+          "Detached follower left out of the batch");
+    Check(leader_status == BATCH_OK && leader_response == "re:leader", "Leader got its own response");
+    Check(patient_status == BATCH_OK && patient_response == "re:patient", "Follower behind the gap got its own response");
+    Check(batcher.RequestsSent() == 2, "Only the two remaining requests counted");
+}
+
+// Transport failures and short responses reach every member of the batch
+static void TestBatchFailures() {
+    std::cout << "\n--- Failed round trips ---" << std::endl;
+    PluginConfig config;
+    Configure(config, 2000000, 2);
+    FakeBatchService service;
+    ScoringBatcher batcher(&config, service.Transport());
+
+    struct Case { bool fails; bool throws; bool short_response; BatchStatus expected; const char* name; };
+    const Case cases[] = {
+        { true, false, false, BATCH_TRANSPORT_FAILED, "Transport failure" },
+        { false, true, false, BATCH_TRANSPORT_FAILED, "Transport exception" },
+        { false, false, true, BATCH_MALFORMED_RESPONSE, "Response count mismatch" },
+    };
+    for (const Case& test_case : cases) {
+        service.Fail(test_case.fails, test_case.throws, test_case.short_response);
+        std::string first_body = "first", second_body = "second";
+        std::string first_response, second_response;
+        BatchStatus first_status = BATCH_OK, second_status = BATCH_OK;
+        std::thread first = SubmitOn(batcher, first_body, 5000, first_status, first_response);
+        WaitForLeader();
+        std::thread second = SubmitOn(batcher, second_body, 5000, second_status, second_response);
+        first.join();
+        second.join();
+        Check(first_status == test_case.expected && second_status == test_case.expected,
+              std::string(test_case.name) + " reported to leader and follower");
+    }
+}
+
+// I/O-thread style: the leader's window hook submits the requests queued behind it
+static void TestSubmitAsync() {
+    std::cout << "\n--- SubmitAsync through the window hook ---" << std::endl;
+    PluginConfig config;
+    Configure(config, 2000000, 4);
+    FakeBatchService service;
+    ScoringBatcher batcher(&config, service.Transport());
+
+    const int REQUESTS = 4;
+    std::string bodies[REQUESTS];
+    std::string responses[REQUESTS];
+    BatchStatus statuses[REQUESTS];
+    int calls[REQUESTS] = { 0 };
+    std::thread::id callback_threads[REQUESTS];
+    for (int i = 0; i < REQUESTS; i++) {
+        bodies[i] = "queued-" + std::to_string(i);
+        statuses[i] = BATCH_TRANSPORT_FAILED;
+    }
+    auto callback_for = [&](int i) {
+        return [&, i](BatchStatus status, const std::string& response) {
+            statuses[i] = status;
+            responses[i] = response;
+            calls[i]++;
+            callback_threads[i] = std::this_thread::get_id();
+        };
+    };
+
+    int queued = 1;
+    batcher.SetWindowHook([&]() {
+        if (queued == REQUESTS) return false;
+        int i = queued++;
+        batcher.SubmitAsync(bodies[i].data(), bodies[i].size(), ScoringDeadline::In(5000), callback_for(i));
+        return true;
+    });
+    batcher.SubmitAsync(bodies[0].data(), bodies[0].size(), ScoringDeadline::In(5000), callback_for(0));
+
+    bool all_once = true, all_ok = true, all_here = true;
+    for (int i = 0; i < REQUESTS; i++) {
+        all_once = all_once && calls[i] == 1;
+        all_ok = all_ok && statuses[i] == BATCH_OK && responses[i] == "re:" + bodies[i];
+        all_here = all_here && callback_threads[i] == std::this_thread::get_id();
+    }
+    Check(all_once, "Every callback ran exactly once before the leader returned");
+    Check(all_ok, "Every callback got its own response");
+    Check(all_here, "Callbacks ran on the thread that sent the batch");
+    std::vector<std::vector<std::string>> batches = service.Batches();
+    Check(batches.size() == 1 && batches[0].size() == (size_t)REQUESTS, "Queued requests joined the leader's batch");
+
+    // A throwing transport still answers every async slot
+    service.Fail(false, true, false);
+    queued = 1;
+    for (int i = 0; i < REQUESTS; i++) {
+        calls[i] = 0;
+        statuses[i] = BATCH_OK;
+    }
+    batcher.SubmitAsync(bodies[0].data(), bodies[0].size(), ScoringDeadline::In(5000), callback_for(0));
+    bool all_failed = true;
+    for (int i = 0; i < REQUESTS; i++) {
+        all_failed = all_failed && calls[i] == 1 && statuses[i] == BATCH_TRANSPORT_FAILED;
+    }
+    Check(all_failed, "Transport exception answers every async slot with BATCH_TRANSPORT_FAILED");
+}
+
+// The batch fills from another thread between the leader's check and its window
+// hook: the hook's request must not lead a nested batch the full one waits behind
+static void TestHookAfterFill() {
+    std::cout << "\n--- Window hook after the batch filled ---" << std::endl;
+    PluginConfig config;
+    Configure(config, 2000000, 2);
+    FakeBatchService service;
+    ScoringBatcher batcher(&config, service.Transport());
+
+    const std::string lead_body = "lead", other_body = "other", late_body = "late", later_body = "later";
+    BatchStatus other_status = BATCH_TRANSPORT_FAILED;
+    std::string other_response;
+    std::thread other;
+    int hook_calls = 0;
+    int late_calls = 0, later_calls = 0;
+    BatchStatus late_status = BATCH_TRANSPORT_FAILED;
+    std::string late_response;
+    auto count_later = [&](BatchStatus, const std::string&) { later_calls++; };
+
+    batcher.SetWindowHook([&]() {
+        hook_calls++;
+        if (hook_calls == 1) {
+            other = SubmitOn(batcher, other_body, 5000, other_status, other_response);
+            WaitForLeader();           // `other` joins and fills the batch
+            batcher.SubmitAsync(late_body.data(), late_body.size(), ScoringDeadline::In(5000),
+                                [&](BatchStatus status, const std::string& response) {
+                late_status = status;
+                late_response = response;
+                late_calls++;
+            });
+            return true;
+        }
+        if (hook_calls == 2) {
+            batcher.SubmitAsync(later_body.data(), later_body.size(), ScoringDeadline::In(5000), count_later);
+            return true;
+        }
+        return false;
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    int lead_calls = 0;
+    batcher.SubmitAsync(lead_body.data(), lead_body.size(), ScoringDeadline::In(5000),
+                        [&](BatchStatus, const std::string&) { lead_calls++; });
+    long long elapsed = ElapsedMs(start);
+    other.join();
+
+    std::vector<std::vector<std::string>> batches = service.Batches();
+    Check(batches.size() == 2 && batches[0].size() == 2 && batches[0][0] == lead_body && batches[0][1] == other_body,
+          "Full batch is sent first, not held behind a nested one");
+    Check(batches.size() == 2 && batches[1].size() == 2 && batches[1][0] == late_body && batches[1][1] == later_body,
+          "Hook's request leads the next batch after the full one is sent");
+    Check(lead_calls == 1 && late_calls == 1 && later_calls == 1 && late_status == BATCH_OK && late_response == "re:" + late_body &&
+          other_status == BATCH_OK && other_response == "re:" + other_body, "Every request answered once");
+    Check(elapsed < 1000, "No window waited out (" + std::to_string(elapsed) + " ms)");
+}
+
+int main() {
+    std::cout << "=== Scoring Batcher Test ===" << std::endl;
+
+    TestHandoff();
+    TestFollowerTimeoutInFlight();
+    TestFollowerTimeoutBeforeSeal();
+    TestBatchFailures();
+    TestSubmitAsync();
+    TestHookAfterFill();
+
+    std::cout << std::endl;
+    if (failures == 0) {
+        std::cout << "ALL TESTS PASSED" << std::endl;
+        return 0;
+    }
+    std::cout << failures << " TEST(S) FAILED" << std::endl;
+    return 1;
+}
@@ -0,0 +1,261 @@
+//+------------------------------------------------------------------+
+//| Scoring Engine Test                                             |
+//| Many trade threads, few I/O threads: every request answered    |
+//| once, on an I/O thread, within its deadline                    |
+//+------------------------------------------------------------------+
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <cstdint>
+
+#include "ABBook_ScoringEngine.h"
+
+static int failures = 0;
+
+static void Check(bool condition, const std::string& name) {
+    std::cout << (condition ? "PASS: " : "FAIL: ") << name << std::endl;
+    if (!condition) failures++;
+}
+
+// Records which threads ran requests; answers with the number encoded in the frame
+struct FakeTransport {
+    std::mutex mutex;
+    std::vector<std::thread::id> io_ids;
+    std::atomic<int> calls{0};
+    std::atomic<int> delay_ms{0};
+    std::atomic<bool> throw_next{false};
+    std::atomic<bool> hold{false};
+
+    int Run(const char* frame, size_t length, double& score) {
+        calls++;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            std::thread::id id = std::this_thread::get_id();
+            bool known = false;
+            for (const std::thread::id& seen : io_ids) known = known || seen == id;
+            if (!known) io_ids.push_back(id);
+        }
+        while (hold.load()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        if (delay_ms.load() > 0) std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms.load()));
+        if (throw_next.exchange(false)) throw std::runtime_error("transport failure");
+        int value = atoi(std::string(frame, length).c_str());
+        score = value / 1000000.0;
+        return value % 7;
+    }
+};
+
+static void TestManyCallers() {
+    FakeTransport transport;
+    ScoringEngine engine([&](const char* frame, size_t length, double& score, const ScoringDeadline&, EngineTicket) {
+        return transport.Run(frame, length, score);
+    });
+    engine.Start(2);
+
+    const int TRADE_THREADS = 16;
+    const int PER_THREAD = 500;
+    std::atomic<int> wrong(0), not_ok(0);
+    std::mutex ids_mutex;
+    std::vector<std::thread::id> trade_ids;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < TRADE_THREADS; t++) {
+        threads.emplace_back([&, t]() {
+            {
+                std::lock_guard<std::mutex> lock(ids_mutex);
+                trade_ids.push_back(std::this_thread::get_id());
+            }
+            for (int i = 0; i < PER_THREAD; i++) {
+                char frame[32];
+                int value = t * 10000 + i;
+                int length = snprintf(frame, sizeof(frame), "%d", value);
+                int result = -1;
+                double score = -1.0;
+                EngineStatus status = engine.Submit(frame, (size_t)length, ScoringDeadline::In(2000), result, score);
+                if (status != ENGINE_OK) {
+                    not_ok++;
+                } else if (result != value % 7 || score != value / 1000000.0) {
+                    wrong++;
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    Check(not_ok == 0, "every request answered");
+    Check(wrong == 0, "every trade gets its own answer");
+    Check(transport.calls == TRADE_THREADS * PER_THREAD && engine.Submitted() == (unsigned long long)(TRADE_THREADS * PER_THREAD),
+          "each request runs exactly once");
+    bool io_only = transport.io_ids.size() <= 2;
+    for (const std::thread::id& id : transport.io_ids) {
+        for (const std::thread::id& trade : trade_ids) io_only = io_only && id != trade;
+    }
+    Check(io_only, "transport only runs on the 2 I/O threads, never on a trade thread");
+    engine.Stop();
+    int result;
+    double score;
+    Check(engine.Submit("1", 1, ScoringDeadline::In(100), result, score) == ENGINE_STOPPED, "stopped engine rejects requests");
+}
+
+static void TestDeadlines() {
+    FakeTransport transport;
+    ScoringEngine engine([&](const char* frame, size_t length, double& score, const ScoringDeadline&, EngineTicket) {
+        return transport.Run(frame, length, score);
+    });
+    engine.Start(1);
+
+    int result;
+    double score;
+    transport.delay_ms = 100;
+    auto start = std::chrono::steady_clock::now();
+    EngineStatus status = engine.Submit("5", 1, ScoringDeadline::In(20), result, score);
+    long long waited_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    Check(status == ENGINE_EXPIRED && waited_ms < 90, "trade leaves at its deadline while the I/O thread is busy");
+
+    // Queued behind the slow request: expired by the time the I/O thread gets to it
+    Check(engine.Submit("6", 1, ScoringDeadline::In(20), result, score) == ENGINE_EXPIRED, "request expired in the queue");
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    Check(transport.calls == 1, "expired queued request is never sent");
+
+    // Abandoned descriptors went back to the pool
+    transport.delay_ms = 0;
+    int ok = 0;
+    for (size_t i = 0; i < ScoringEngine::MAX_REQUESTS + 10; i++) {
+        if (engine.Submit("7", 1, ScoringDeadline::In(1000), result, score) == ENGINE_OK) ok++;
+    }
+    Check(ok == (int)ScoringEngine::MAX_REQUESTS + 10, "descriptors are recycled");
+
+    transport.throw_next = true;
+    Check(engine.Submit("8", 1, ScoringDeadline::In(1000), result, score) == ENGINE_FAILED, "transport exception reported");
+    Check(engine.Submit("9", 1, ScoringDeadline::In(1000), result, score) == ENGINE_OK && result == 2, "I/O thread survives it");
+    engine.Stop();
+}
+
+static void TestBusyAndStop() {
+    FakeTransport transport;
+    ScoringEngine engine([&](const char* frame, size_t length, double& score, const ScoringDeadline&, EngineTicket) {
+        return transport.Run(frame, length, score);
+    });
+    engine.Start(1);
+    transport.hold = true;
+
+    // Occupy every descriptor while the I/O thread is stuck, then one more
+    std::atomic<int> stopped(0), busy(0);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < ScoringEngine::MAX_REQUESTS + 1; i++) {
+        threads.emplace_back([&]() {
+            int result;
+            double score;
+            EngineStatus status = engine.Submit("1", 1, ScoringDeadline::In(5000), result, score);
+            if (status == ENGINE_STOPPED) stopped++;
+            if (status == ENGINE_BUSY) busy++;
+        });
+    }
+    for (int i = 0; i < 10000 && engine.Busy() == 0; i++) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    Check(busy == 1 && engine.Busy() == 1, "trade beyond MAX_REQUESTS is rejected, not queued");
+
+    auto start = std::chrono::steady_clock::now();
+    transport.hold = false;
+    engine.Stop();
+    for (std::thread& thread : threads) thread.join();
+    long long waited_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    Check(stopped > 200 && waited_ms < 1000, "Stop answers queued requests instead of letting them time out");
+}
+
+// Work handed to another thread (as the multiplexed channel does): one I/O
+// thread keeps many requests in flight, and late completions recycle descriptors
+static void TestPendingWork() {
+    std::mutex mutex;
+    std::vector<std::pair<EngineTicket, int>> held;
+    ScoringEngine* engine_ptr = nullptr;
+    ScoringEngine engine([&](const char* frame, size_t length, double&, const ScoringDeadline&, EngineTicket ticket) {
+        int value = atoi(std::string(frame, length).c_str());
+        if (value == 0) {
+            engine_ptr->Complete(ticket, 3, 0.25);     // Completed before the work even returns
+            return ENGINE_WORK_PENDING;
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        held.push_back(std::make_pair(ticket, value));
+        return ENGINE_WORK_PENDING;
+    });
+    engine_ptr = &engine;
+    engine.Start(1);
+
+    int result;
+    double score;
+    Check(engine.Submit("0", 1, ScoringDeadline::In(1000), result, score) == ENGINE_OK && result == 3 && score == 0.25,
+          "work completed before it returned");
+
+    const int CALLERS = 50;
+    std::atomic<int> answered(0);
+    std::vector<std::thread> threads;
+    for (int i = 1; i <= CALLERS; i++) {
+        threads.emplace_back([&engine, &answered, i]() {
+            int result;
+            double score;
+            std::string frame = std::to_string(i);
+            if (engine.Submit(frame.data(), frame.size(), ScoringDeadline::In(5000), result, score) == ENGINE_OK &&
+                result == i % 7 && score == i / 1000.0) {
+                answered++;
+            }
+        });
+    }
+    size_t in_flight = 0;
+    for (int i = 0; i < 5000 && in_flight < (size_t)CALLERS; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::lock_guard<std::mutex> lock(mutex);
+        in_flight = held.size();
+    }
+    Check(in_flight == (size_t)CALLERS, "one I/O thread hands over every request without waiting for answers");
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& entry : held) engine.Complete(entry.first, entry.second % 7, entry.second / 1000.0);
+        held.clear();
+    }
+    for (std::thread& thread : threads) thread.join();
+    Check(answered == CALLERS, "completions reach their own callers");
+
+    // Abandoned at the deadline, completed afterwards: the descriptor stays with
+    // the work until then, and comes back when it completes. A request that
+    // expires still queued never reaches the work and is freed at once, so keep
+    // going until the work holds every descriptor.
+    int submits = 0, expired = 0;
+    size_t holding = 0;
+    while (holding < ScoringEngine::MAX_REQUESTS && submits < 20 * (int)ScoringEngine::MAX_REQUESTS) {
+        submits++;
+        if (engine.Submit("9", 1, ScoringDeadline::In(2), result, score) == ENGINE_EXPIRED) expired++;
+        std::lock_guard<std::mutex> lock(mutex);
+        holding = held.size();
+    }
+    Check(expired == submits && holding == ScoringEngine::MAX_REQUESTS &&
+          engine.Submit("0", 1, ScoringDeadline::In(1000), result, score) == ENGINE_BUSY,
+          "abandoned descriptors stay with their pending work");
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto& entry : held) engine.Complete(entry.first, 0, 0.0);
+        held.clear();
+    }
+    Check(engine.Submit("0", 1, ScoringDeadline::In(1000), result, score) == ENGINE_OK, "late completion recycles the descriptor");
+    engine.Stop();
+}
+
+int main() {
+    std::cout << "=== Scoring Engine Test ===" << std::endl;
+    TestManyCallers();
+    TestDeadlines();
+    TestBusyAndStop();
+    TestPendingWork();
+    std::cout << std::endl;
+    if (failures == 0) {
+        std::cout << "ALL TESTS PASSED" << std::endl;
+        return 0;
+    }
+    std::cout << failures << " TEST(S) FAILED" << std::endl;
+    return 1;
+}
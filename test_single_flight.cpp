@@ -0,0 +1,518 @@
+//+------------------------------------------------------------------+
+//| Single-Flight Test                                              |
+//| Bursts of identical trades through the router send one scoring |
+//| request and are journalled as COALESCED; an open breaker and a |
+//| failing leader never strand the followers; an absent (proto3   |
+//| default) score is an ML score of 0.0, not a failure            |
+//+------------------------------------------------------------------+
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <new>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#include "ABBook_TradeRouter.h"
+
+static int failures = 0;
+
+static void Check(bool condition, const std::string& name) {
+    std::cout << (condition ? "PASS: " : "FAIL: ") << name << std::endl;
+    if (!condition) failures++;
+}
+
+static const char* TEST_CONFIG = "test_single_flight.ini";
+static const char* TEST_LOG = "test_single_flight.log";
+static const char* TEST_JOURNAL = "test_single_flight";
+
+// Allocation failures injected on one trade thread (TestLeaderException). An
+// ABBOOK_ASSERT_NO_ALLOC library defines operator new itself, so there is no
+// room for this replacement and that test is skipped.
+#ifndef ABBOOK_ASSERT_NO_ALLOC
+static thread_local bool inject_here = false;
+static std::atomic<int> injected_failures(0);
+
+void* operator new(size_t size) {
+    if (inject_here && injected_failures.load(std::memory_order_relaxed) > 0 &&
+        injected_failures.fetch_sub(1, std::memory_order_relaxed) > 0) {
+        throw std::bad_alloc();
+    }
+    void* p = malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+#endif
+
+//+------------------------------------------------------------------+
+//| Loopback scoring service that holds its answers until released  |
+//+------------------------------------------------------------------+
+
+class GatedScorer {
+private:
+    SOCKET listener;
+    int port;
+    std::atomic<bool> running;
+    std::thread acceptor;
+    std::vector<std::thread> workers;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool held;
+    bool hang_up;                      // Close the connection instead of answering
+    float score;
+    int requests;
+
+    static bool ReadExact(SOCKET sock, char* data, size_t length) {
+        while (length > 0) {
+            int received = recv(sock, data, (int)length, 0);
+            if (received <= 0) return false;
+            data += received;
+            length -= (size_t)received;
+        }
+        return true;
+    }
+
+    void Serve(SOCKET sock) {
+        std::vector<char> request;
+        for (;;) {
+            unsigned char header[4];
+            if (!ReadExact(sock, (char*)header, 4)) break;
+            uint32_t length = ((uint32_t)header[0] << 24) | ((uint32_t)header[1] << 16) | ((uint32_t)header[2] << 8) | header[3];
+            request.resize(length);
+            if (length && !ReadExact(sock, request.data(), length)) break;
+
+            char response[9] = { 0, 0, 0, 5, 0x0D };
+            int response_length = (int)sizeof(response);
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                requests++;
+                cv.notify_all();
+                cv.wait(lock, [this]() { return !held; });
+                if (hang_up) break;
+                memcpy(response + 5, &score, 4);
+                if (score == 0.0f) {           // As a proto3 service sends it: the default is left off the wire
+                    response[3] = 0;
+                    response_length = 4;
+                }
+            }
+            if (send(sock, response, response_length, MSG_NOSIGNAL) != response_length) break;
+        }
+        closesocket(sock);
+    }
+
+public:
+    GatedScorer() : listener(INVALID_SOCKET), port(0), running(false), held(false), hang_up(false), score(0.05f), requests(0) {}
+
+    ~GatedScorer() { Stop(); }
+
+    bool Start() {
+        listener = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = 0;
+        socklen_t address_length = sizeof(address);
+        if (listener == INVALID_SOCKET || bind(listener, (sockaddr*)&address, sizeof(address)) != 0 ||
+            listen(listener, 16) != 0 || getsockname(listener, (sockaddr*)&address, &address_length) != 0) {
+            return false;
+        }
+        port = ntohs(address.sin_port);
+        running = true;
+        acceptor = std::thread([this]() {
+            while (running) {
+                SOCKET sock = accept(listener, nullptr, nullptr);
+                if (sock == INVALID_SOCKET) break;
+                if (!running) {
+                    closesocket(sock);
+                    break;
+                }
+                int nodelay = 1;
+                setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, (const char*)&nodelay, sizeof(nodelay));
+                workers.emplace_back([this, sock]() { Serve(sock); });
+            }
+        });
+        return true;
+    }
+
+    // The router disconnects first (TradeRouter::Cleanup), so the workers see EOF
+    void Stop() {
+        if (!running.exchange(false)) return;
+        Release();
+        SOCKET wake = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+        sockaddr_in address;
+        memset(&address, 0, sizeof(address));
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        address.sin_port = htons((unsigned short)port);
+        connect(wake, (sockaddr*)&address, sizeof(address));
+        closesocket(wake);
+        acceptor.join();
+        closesocket(listener);
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    void Hold() {
+        std::lock_guard<std::mutex> lock(mutex);
+        held = true;
+    }
+
+    void Release() {
+        std::lock_guard<std::mutex> lock(mutex);
+        held = false;
+        cv.notify_all();
+    }
+
+    void Answer(float answer_score, bool answer_hang_up = false) {
+        std::lock_guard<std::mutex> lock(mutex);
+        score = answer_score;
+        hang_up = answer_hang_up;
+    }
+
+    // Wait until `count` requests have arrived (held or not)
+    bool WaitForRequests(int count) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, std::chrono::seconds(5), [this, count]() { return requests >= count; });
+    }
+
+    int Requests() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return requests;
+    }
+
+    int Port() const { return port; }
+};
+
+//+------------------------------------------------------------------+
+//| Router harness                                                  |
+//+------------------------------------------------------------------+
+
+static void WriteRouterConfig(int port, const std::string& extra) {
+    std::ofstream ini(TEST_CONFIG);
+    ini << "[CVM_Connection]\nCVM_IP=127.0.0.1\nCVM_Port=" << port << "\nConnectionPoolSize=2\nCoalesceRequests=true\n"
+        << "[Score_Cache]\nEnableCache=false\n"
+        << "[Decision_Journal]\nEnableJournal=true\nJournalPath=" << TEST_JOURNAL << "\nJournalRecords=1024\n"
+        << "[Latency_Stats]\nReportIntervalSec=0\n"
+        << "[Latency_Budget]\nBudget_FXMajors=2000\n"
+        << extra;
+}
+
+static std::string JournalPath(int n) {
+    time_t seconds = time(nullptr);
+    struct tm utc;
+#ifdef _WIN32
+    gmtime_s(&utc, &seconds);
+#else
+    gmtime_r(&seconds, &utc);
+#endif
+    char date[16];
+    strftime(date, sizeof(date), "%Y%m%d", &utc);
+    return std::string(TEST_JOURNAL) + "_" + date + "_" + std::to_string(n) + ".abj";
+}
+
+// Records of the router that just ran Cleanup(); its files are removed
+static std::vector<DecisionRecord> TakeJournal() {
+    std::vector<DecisionRecord> records;
+    std::string error;
+    ReadJournalFile(JournalPath(0), records, error);
+    for (int n = 0; n < 20; n++) {
+        remove(JournalPath(n).c_str());
+    }
+    return records;
+}
+
+static void RemoveRouterFiles() {
+    remove(TEST_CONFIG);
+    remove(TEST_LOG);
+    TakeJournal();
+}
+
+static TradeRecord MakeTrade(int order, int login) {
+    TradeRecord trade;
+    memset(&trade, 0, sizeof(trade));
+    trade.order = order;
+    trade.login = login;
+    strncpy(trade.symbol, "EURUSD", sizeof(trade.symbol));
+    trade.digits = 5;
+    trade.cmd = OP_BUY;
+    trade.volume = 100;
+    trade.open_price = 1.08765;
+    trade.state = ORDER_OPENED;
+    return trade;
+}
+
+static UserInfo MakeUser(int login) {
+    UserInfo user;
+    memset(&user, 0, sizeof(user));
+    user.login = login;
+    strcpy(user.group, "real\\standard");
+    user.balance = 10000.0;
+    user.leverage = 100;
+    return user;
+}
+
+static void Trade(TradeRouter& router, int order, int login) {
+    TradeRecord trade = MakeTrade(order, login);
+    UserInfo user = MakeUser(login);
+    router.TradeTransaction(&trade, &user);
+}
+
+// `trades` threads released together; trade t is order first_order + t on login_of(t)
+static void Burst(TradeRouter& router, int trades, int first_order, const std::function<int(int)>& login_of) {
+    std::vector<std::thread> threads;
+    std::atomic<int> ready(0);
+    std::atomic<bool> go(false);
+    for (int t = 0; t < trades; t++) {
+        threads.emplace_back([&, t]() {
+            ready++;
+            while (!go.load()) std::this_thread::yield();
+            Trade(router, first_order + t, login_of(t));
+        });
+    }
+    while (ready.load() < trades) std::this_thread::yield();
+    go = true;
+    for (std::thread& thread : threads) thread.join();
+}
+
+static int CountSource(const std::vector<DecisionRecord>& records, JournalScoreSource source) {
+    int count = 0;
+    for (const DecisionRecord& record : records) {
+        if (record.score_source == source) count++;
+    }
+    return count;
+}
+
+//+------------------------------------------------------------------+
+//| Tests                                                           |
+//+------------------------------------------------------------------+
+
+static void TestBurst() {
+    const int TRADES = 32;
+    GatedScorer scorer;
+    Check(scorer.Start(), "loopback scorer listening");
+    WriteRouterConfig(scorer.Port(), "");
+    std::vector<DecisionRecord> records;
+    {
+        TradeRouter router(TEST_LOG, false);
+        router.Startup(TEST_CONFIG);
+
+        // Hold the first request until every other trade has boarded its flight
+        scorer.Hold();
+        std::thread burst([&]() { Burst(router, TRADES, 1, [](int) { return 1001; }); });
+        Check(scorer.WaitForRequests(1), "first trade sends the request");
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        scorer.Release();
+        burst.join();
+        router.Cleanup();
+    }
+    records = TakeJournal();
+
+    int ml = CountSource(records, SCORE_SOURCE_ML);
+    int coalesced = CountSource(records, SCORE_SOURCE_COALESCED);
+    std::cout << "  32 trades: " << scorer.Requests() << " request(s), " << ml << " ML, " << coalesced << " COALESCED" << std::endl;
+    Check(scorer.Requests() == 1, "32 simultaneous trades on one login send one scoring request");
+    Check(records.size() == (size_t)TRADES && ml == 1 && coalesced == TRADES - 1,
+          "the leader is journalled as ML, every follower as COALESCED");
+    bool shared = true;
+    for (const DecisionRecord& record : records) {
+        if (record.score != 0.05f) shared = false;
+    }
+    Check(shared, "every trade routes on the leader's score");
+    scorer.Stop();
+}
+
+static void TestSeparateKeys() {
+    GatedScorer scorer;
+    scorer.Start();
+    WriteRouterConfig(scorer.Port(), "");
+    {
+        TradeRouter router(TEST_LOG, false);
+        router.Startup(TEST_CONFIG);
+        Burst(router, 4, 1, [](int t) { return 2000 + t; });
+        router.Cleanup();
+    }
+    std::vector<DecisionRecord> records = TakeJournal();
+    Check(scorer.Requests() == 4 && CountSource(records, SCORE_SOURCE_ML) == 4, "different logins are not coalesced");
+    scorer.Stop();
+}
+
+static void TestBreakerOpen() {
+    const int TRADES = 32;
+    GatedScorer scorer;
+    scorer.Start();
+    scorer.Answer(0.05f, true);
+    WriteRouterConfig(scorer.Port(), "[Circuit_Breaker]\nFailureThreshold=1\nProbeIntervalMs=60000\nMaxProbeIntervalMs=60000\n");
+    int requests_before = 0;
+    {
+        TradeRouter router(TEST_LOG, false);
+        router.Startup(TEST_CONFIG);
+        Trade(router, 1, 3003);                // Hung up on: opens the breaker
+        requests_before = scorer.Requests();
+        Burst(router, TRADES, 2, [](int) { return 3003; });
+        router.Cleanup();
+    }
+    std::vector<DecisionRecord> records = TakeJournal();
+    Check(requests_before > 0 && records.size() == (size_t)TRADES + 1 && records[0].score_source == SCORE_SOURCE_FALLBACK_ERROR,
+          "failed request opens the breaker");
+    Check(scorer.Requests() == requests_before, "open breaker: the burst sends no request");
+    Check(CountSource(records, SCORE_SOURCE_FALLBACK_BACKOFF) == TRADES && CountSource(records, SCORE_SOURCE_COALESCED) == 0,
+          "open breaker: every trade takes the fallback before boarding a flight");
+    scorer.Stop();
+}
+
+// proto3 omits score == 0.0: the empty ScoringResponse is a valid ML score, not a service failure
+static void TestDefaultScore() {
+    GatedScorer scorer;
+    scorer.Start();
+    scorer.Answer(0.0f);
+    WriteRouterConfig(scorer.Port(), "[Circuit_Breaker]\nFailureThreshold=1\nProbeIntervalMs=60000\nMaxProbeIntervalMs=60000\n");
+    {
+        TradeRouter router(TEST_LOG, false);
+        router.Startup(TEST_CONFIG);
+        Trade(router, 1, 4004);
+        Trade(router, 2, 4005);
+        router.Cleanup();
+    }
+    std::vector<DecisionRecord> records = TakeJournal();
+    Check(records.size() == 2 && CountSource(records, SCORE_SOURCE_ML) == 2 &&
+          records[0].score == 0.0f && records[1].score == 0.0f, "response without a score field is an ML score of 0.0");
+    Check(scorer.Requests() == 2, "response without a score field does not open the breaker");
+    scorer.Stop();
+}
+
+#ifndef ABBOOK_ASSERT_NO_ALLOC
+static void TestLeaderException() {
+    GatedScorer scorer;
+    scorer.Start();
+    scorer.Answer(1.5f);                       // Out of range: the leader logs a warning, and that allocation fails
+    WriteRouterConfig(scorer.Port(), "");
+    auto follower_start = std::chrono::steady_clock::now();
+    long long follower_ms = 0;
+    {
+        TradeRouter router(TEST_LOG, false);
+        router.Startup(TEST_CONFIG);
+
+        scorer.Hold();
+        std::thread leader([&]() {
+            inject_here = true;
+            Trade(router, 1, 4004);
+        });
+        Check(scorer.WaitForRequests(1), "leader in flight");
+        std::thread follower([&]() {
+            follower_start = std::chrono::steady_clock::now();
+            Trade(router, 2, 4004);
+            follower_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - follower_start).count();
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+        // The warning throws, then so does the error log in the scoring path's own
+        // handler, so the exception leaves CVMClient::GetScore
+        injected_failures = 2;
+        scorer.Release();
+        leader.join();
+        follower.join();
+        router.Cleanup();
+    }
+    std::vector<DecisionRecord> records = TakeJournal();
+    Check(injected_failures.load() <= 0, "leader's scoring path threw");
+    injected_failures = 0;
+    Check(records.size() == 2 && records[0].score_source == SCORE_SOURCE_FALLBACK_EXCEPTION &&
+          records[1].score_source == SCORE_SOURCE_FALLBACK_EXCEPTION,
+          "an exception lands the flight: the follower shares the leader's fallback");
+    Check(follower_ms < 1000, "follower is answered at once, not at its 2000 ms deadline");
+    Check(scorer.Requests() == 1, "follower sent no request of its own");
+    scorer.Stop();
+}
+#else
+static void TestLeaderException() {
+    std::cout << "SKIP: leader exception (cannot inject allocation failures into an ABBOOK_ASSERT_NO_ALLOC build)" << std::endl;
+}
+#endif
+
+static void TestFollowerDeadline() {
+    SingleFlight flights;
+    flights.SetEnabled(true);
+    uint64_t key = ScoreCacheKey(5005, 5, 0, 100);
+    std::chrono::steady_clock::time_point later = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    double score;
+    int source;
+    int leader_handle;
+    int handle;
+    Check(flights.Board(key, later, leader_handle, score, source) == FLIGHT_LEADER, "first caller leads");
+
+    auto start = std::chrono::steady_clock::now();
+    FlightRole role = flights.Board(key, start + std::chrono::milliseconds(20), handle, score, source);
+    long long waited_ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    Check(role == FLIGHT_EXPIRED && waited_ms >= 15 && waited_ms < 1000, "follower gives up at its own deadline");
+
+    flights.Land(leader_handle, 0.5, SCORE_SOURCE_ML);
+    Check(flights.Board(key, later, handle, score, source) == FLIGHT_LEADER, "landed flight frees the key");
+    flights.Land(handle, 0.5, SCORE_SOURCE_ML);
+}
+
+static void TestFullTable() {
+    SingleFlight flights;
+    flights.SetEnabled(true);
+    std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    double score;
+    int source;
+    int handle;
+    std::vector<int> handles;
+
+    // Keys are spread over the shards by hash: board until one shard is full
+    int solo = 0;
+    for (uint64_t key = 1; key < 100000 && solo == 0; key++) {
+        FlightRole role = flights.Board(key, deadline, handle, score, source);
+        if (role == FLIGHT_LEADER) handles.push_back(handle);
+        if (role == FLIGHT_SOLO) solo++;
+    }
+    Check(solo == 1 && handles.size() >= SingleFlight::SLOTS, "a full shard lets the trade fly solo");
+    for (int h : handles) flights.Land(h, 0.5, SCORE_SOURCE_ML);
+    Check(flights.Board(1, deadline, handle, score, source) == FLIGHT_LEADER, "landed slots are reused");
+
+    SingleFlight disabled;
+    Check(disabled.Board(1, deadline, handle, score, source) == FLIGHT_SOLO, "disabled table never coalesces");
+}
+
+int main() {
+    std::cout << "=== Single-Flight Test ===" << std::endl;
+    WSADATA wsa;
+    WSAStartup(MAKEWORD(2, 2), &wsa);
+
+    TestBurst();
+    TestSeparateKeys();
+    TestBreakerOpen();
+    TestDefaultScore();
+    TestLeaderException();
+    TestFollowerDeadline();
+    TestFullTable();
+    RemoveRouterFiles();
+
+    WSACleanup();
+    std::cout << std::endl;
+    if (failures == 0) {
+        std::cout << "ALL TESTS PASSED" << std::endl;
+        return 0;
+    }
+    std::cout << failures << " TEST(S) FAILED" << std::endl;
+    return 1;
+}
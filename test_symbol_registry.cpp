@@ -0,0 +1,145 @@
+//+------------------------------------------------------------------+
+//| Symbol Registry Test                                            |
+//| Cleaning, interning, config-driven instrument groups and       |
+//| concurrent first sightings of the same symbol                   |
+//+------------------------------------------------------------------+
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <cstdio>
+
+#include "ABBook_SymbolRegistry.h"
+
+static int failures = 0;
+
+static void Check(bool condition, const std::string& name) {
+    std::cout << (condition ? "PASS: " : "FAIL: ") << name << std::endl;
+    if (!condition) failures++;
+}
+
+// MT4 symbol field: 12 bytes, not necessarily NUL terminated
+static void RawSymbol(const char* bytes, size_t length, char* out) {
+    memset(out, 0, 12);
+    memcpy(out, bytes, length);
+}
+
+static void TestBuiltInGroups() {
+    SymbolRegistry registry;
+    char raw[12];
+
+    RawSymbol("\x01xNZDusd.m", 10, raw);
+    const SymbolInfo& nzd = registry.Lookup(raw);
+    Check(std::string(nzd.name) == "NZDUSDM" && nzd.currency_pattern, "garbage prefix skipped, upper-cased");
+    Check(nzd.group->name == "FXMajors", "NZDUSD is an FX major");
+
+    RawSymbol("EURGBP", 6, raw);
+    Check(registry.Lookup(raw).group->name == "FXMinors", "unlisted pair falls back to FXMinors");
+
+    RawSymbol("btcusd", 6, raw);
+    Check(registry.Lookup(raw).group->name == "Crypto", "lower-case BTCUSD is crypto");
+
+    RawSymbol("\x01\x02\x03", 3, raw);
+    Check(std::string(registry.Lookup(raw).name) == "UNKNOWN", "unusable symbol becomes UNKNOWN");
+
+    // Same symbol, different bytes after the terminator: one ID
+    char a[12], b[12];
+    RawSymbol("EURUSD", 6, a);
+    RawSymbol("EURUSD", 6, b);
+    b[8] = 'Z';
+    const SymbolInfo& first = registry.Lookup(a);
+    const SymbolInfo& second = registry.Lookup(b);
+    Check(&first == &second && first.id == second.id, "bytes after NUL do not mint a new ID");
+
+    // Full 12-byte symbol without a terminator
+    RawSymbol("GBPUSDMICRO1", 12, raw);
+    Check(registry.Lookup(raw).group->name == "FXMajors" && registry.Lookup(raw).name_length == 12, "unterminated 12-byte symbol");
+}
+
+static void TestConfiguredGroups() {
+    const char* path = "test_symbol_registry.ini";
+    {
+        std::ofstream ini(path);
+        ini << "[Instrument_Groups]\n"
+            << "Group_Metals = xau, XAG\n"
+            << "Group_FXMajors=EURUSD\n"
+            << "DefaultGroup=Other\n"
+            << "ContractSize_Metals=100\n"
+            << "[Thresholds]\n"
+            << "Threshold_Metals=0.06\n"
+            << "Threshold_Other=0.05\n"
+            << "[Latency_Budget]\n"
+            << "Budget_Metals=3\n";
+    }
+    PluginConfig config;
+    Check(LoadPluginConfig(config, path), "config file loads");
+    remove(path);
+
+    SymbolRegistry registry;
+    registry.Configure(config);
+    const std::vector<InstrumentGroupConfig>& groups = registry.Groups();
+    Check(groups.size() == 3 && groups[0].name == "Metals" && groups[1].name == "FXMajors" && groups[2].name == "Other",
+          "groups kept in file order, default last");
+
+    char raw[12];
+    RawSymbol("XAUUSD", 6, raw);
+    const SymbolInfo& gold = registry.Lookup(raw);
+    Check(gold.group->name == "Metals" && gold.group->threshold == 0.06 && gold.group->budget_ms == 3 &&
+          gold.group->contract_size == 100.0, "Metals limits come from the INI");
+
+    RawSymbol("USDJPY", 6, raw);
+    const SymbolInfo& yen = registry.Lookup(raw);
+    Check(yen.group->name == "Other" && yen.group->threshold == 0.05 && yen.group->contract_size == 100000.0,
+          "symbol outside every group uses the default group");
+}
+
+static void TestConcurrentRegistration() {
+    SymbolRegistry registry;
+    const int thread_count = 8;
+    const int symbol_count = 200;
+    std::vector<std::vector<const SymbolInfo*>> seen(thread_count, std::vector<const SymbolInfo*>(symbol_count));
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < thread_count; t++) {
+        threads.emplace_back([&, t]() {
+            char raw[12];
+            for (int i = 0; i < symbol_count; i++) {
+                char name[13];
+                snprintf(name, sizeof(name), "SYM%04d", i);
+                RawSymbol(name, strlen(name), raw);
+                seen[t][i] = &registry.Lookup(raw);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    bool consistent = registry.Count() == (size_t)symbol_count;
+    for (int t = 1; t < thread_count; t++) {
+        for (int i = 0; i < symbol_count; i++) consistent = consistent && seen[t][i] == seen[0][i];
+    }
+    Check(consistent, "8 threads registering 200 symbols agree on one entry each");
+
+    // Past MAX_SYMBOLS lookups still resolve, just without a stable ID
+    char raw[12];
+    for (size_t i = 0; i <= SymbolRegistry::MAX_SYMBOLS; i++) {
+        char name[13];
+        snprintf(name, sizeof(name), "X%06d", (int)i);
+        RawSymbol(name, strlen(name), raw);
+        registry.Lookup(raw);
+    }
+    Check(registry.Count() == SymbolRegistry::MAX_SYMBOLS && registry.Lookup(raw).id == SymbolInfo::UNREGISTERED,
+          "registry stops interning at MAX_SYMBOLS");
+}
+
+int main() {
+    std::cout << "=== SYMBOL REGISTRY TEST ===" << std::endl;
+    TestBuiltInGroups();
+    TestConfiguredGroups();
+    TestConcurrentRegistration();
+
+    std::cout << std::endl << (failures == 0 ? "ALL TESTS PASSED" : std::to_string(failures) + " TEST(S) FAILED") << std::endl;
+    return failures == 0 ? 0 : 1;
+}
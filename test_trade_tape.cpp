@@ -0,0 +1,195 @@
+//+------------------------------------------------------------------+
+//| Trade Tape Test                                                 |
+//| Record layout, round trip of trades and logins, monotonic      |
+//| stamps under concurrent recording, record limit               |
+//+------------------------------------------------------------------+
+
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <map>
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+
+#include "ABBook_TradeTape.h"
+
+static int failures = 0;
+
+static void Check(bool condition, const std::string& name) {
+    std::cout << (condition ? "PASS: " : "FAIL: ") << name << std::endl;
+    if (!condition) failures++;
+}
+
+static const char* PREFIX = "test_trade_tape";
+
+static void RemoveTapeFiles() {
+    time_t seconds = (time_t)(JournalNowUs() / 1000000);
+    struct tm utc;
+#ifdef _WIN32
+    gmtime_s(&utc, &seconds);
+#else
+    gmtime_r(&seconds, &utc);
+#endif
+    char date[16];
+    strftime(date, sizeof(date), "%Y%m%d", &utc);
+    for (int n = 0; n < 20; n++) {
+        remove((std::string(PREFIX) + "_" + date + "_" + std::to_string(n) + ".abt").c_str());
+    }
+}
+
+static TradeRecord MakeTrade(int order, int login) {
+    TradeRecord trade;
+    memset(&trade, 0, sizeof(trade));
+    trade.order = order;
+    trade.login = login;
+    strcpy(trade.symbol, "EURUSD.m");
+    trade.digits = 5;
+    trade.cmd = order % 2 ? OP_SELL : OP_BUY;
+    trade.volume = 100 + order;
+    trade.open_time = 1760000000 + order;
+    trade.open_price = 1.08765;
+    trade.sl = 1.08;
+    trade.tp = 1.09;
+    trade.commission = -3.5;
+    strcpy(trade.comment, "tape test");
+    trade.api_data[3] = 42;
+    return trade;
+}
+
+static UserInfo MakeUser(int login) {
+    UserInfo user;
+    memset(&user, 0, sizeof(user));
+    user.login = login;
+    strcpy(user.group, "real\\pro");
+    strcpy(user.password, "secret");
+    strcpy(user.name, "Jane Trader");
+    strcpy(user.email, "jane@example.com");
+    strcpy(user.id, "123-45-6789");
+    user.leverage = 500;
+    user.balance = 25000.75;
+    user.credit = 100.0;
+    user.margin_call = 50.0;
+    return user;
+}
+
+static void TestLayout() {
+    Check(offsetof(TapeRecord, trade) == 16 && offsetof(TapeRecord, account) == 204 &&
+          offsetof(TapeTrade, open_price) == 44 && offsetof(TapeAccount, balance) == 60, "record fields at fixed offsets");
+}
+
+static void TestRoundTrip() {
+    RemoveTapeFiles();
+    TradeTape tape;
+    Check(tape.Open(PREFIX, 100) && tape.Enabled(), "tape opened");
+    std::string path = tape.Path();
+    Check(path.find(PREFIX) == 0 && path.rfind(".abt") == path.size() - 4, "named <prefix>_<YYYYMMDD>_<n>.abt");
+
+    TradeRecord trade = MakeTrade(7, 5001);
+    UserInfo user = MakeUser(5001);
+    tape.RecordLogin(user);
+    tape.RecordTrade(trade, user);
+    tape.Close();
+    tape.RecordTrade(trade, user);
+    Check(tape.Recorded() == 2 && !tape.Enabled(), "nothing recorded after Close");
+
+    TapeFileHeader header;
+    std::vector<TapeRecord> records;
+    std::string error;
+    Check(ReadTradeTape(path, header, records, error) && records.size() == 2, "tape reads back");
+    if (records.size() != 2) return;
+    Check(header.created_us > 0 && header.record_size == sizeof(TapeRecord), "header filled in");
+    Check(records[0].event == TAPE_EVENT_LOGIN && records[0].trade.order == 0 && records[1].event == TAPE_EVENT_TRADE,
+          "login then trade, login has no trade");
+    Check(records[0].offset_ns <= records[1].offset_ns, "offsets in call order");
+
+    TradeRecord trade_back;
+    UserInfo user_back;
+    TapeToTrade(records[1].trade, trade_back);
+    TapeToAccount(records[1].account, user_back);
+    Check(memcmp(&trade_back, &trade, sizeof(trade)) == 0, "TradeRecord round trips field for field");
+    Check(user_back.login == 5001 && strcmp(user_back.group, "real\\pro") == 0 && user_back.leverage == 500 &&
+          user_back.balance == 25000.75 && user_back.credit == 100.0 && user_back.margin_call == 50.0,
+          "account fields round trip");
+    Check(user_back.password[0] == 0 && user_back.name[0] == 0 && user_back.email[0] == 0 && user_back.id[0] == 0,
+          "passwords and personal details come back empty");
+
+    // ...and were never written
+    std::string bytes;
+    FILE* f = fopen(path.c_str(), "rb");
+    char chunk[4096];
+    size_t n;
+    while (f && (n = fread(chunk, 1, sizeof(chunk), f)) > 0) bytes.append(chunk, n);
+    if (f) fclose(f);
+    Check(bytes.size() == sizeof(TapeFileHeader) + 2 * sizeof(TapeRecord) && bytes.find("secret") == std::string::npos &&
+          bytes.find("Jane") == std::string::npos && bytes.find("123-45") == std::string::npos, "no personal data on disk");
+
+    // Torn last record (crash mid-write) is ignored
+    f = fopen(path.c_str(), "ab");
+    fwrite(chunk, 1, 100, f);
+    fclose(f);
+    Check(ReadTradeTape(path, header, records, error) && records.size() == 2, "torn tail ignored");
+    RemoveTapeFiles();
+
+    Check(!ReadTradeTape(path, header, records, error) && !error.empty(), "missing tape reported");
+}
+
+static void TestConcurrentRecording() {
+    RemoveTapeFiles();
+    TradeTape tape;
+    tape.Open(PREFIX, 6000);
+    std::string path = tape.Path();
+
+    const int THREADS = 8, PER_THREAD = 1000;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < THREADS; t++) {
+        threads.emplace_back([&tape, t]() {
+            UserInfo user = MakeUser(1000 + t);
+            for (int i = 0; i < PER_THREAD; i++) {
+                TradeRecord trade = MakeTrade(t * PER_THREAD + i, 1000 + t);
+                tape.RecordTrade(trade, user);
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+    Check(tape.Recorded() == 6000 && tape.Lost() == 2000, "record limit: later calls counted as lost");
+    tape.Close();
+
+    TapeFileHeader header;
+    std::vector<TapeRecord> records;
+    std::string error;
+    ReadTradeTape(path, header, records, error);
+    bool monotonic = true;
+    for (size_t i = 1; i < records.size(); i++) monotonic = monotonic && records[i].offset_ns >= records[i - 1].offset_ns;
+    Check(records.size() == 6000 && monotonic, "offsets never go backwards");
+
+    std::map<int, int> last_order;
+    bool ordered = true;
+    for (const TapeRecord& record : records) {
+        auto it = last_order.find(record.trade.login);
+        if (it != last_order.end()) ordered = ordered && record.trade.order > it->second;
+        last_order[record.trade.login] = record.trade.order;
+    }
+    Check(ordered, "each thread's calls keep their order");
+
+    TradeTape second;
+    second.Open(PREFIX, 10);
+    Check(second.Path() != path, "a second tape on the same day gets the next number");
+    second.Close();
+    RemoveTapeFiles();
+}
+
+int main() {
+    std::cout << "=== Trade Tape Test ===" << std::endl;
+    TestLayout();
+    TestRoundTrip();
+    TestConcurrentRecording();
+    std::cout << std::endl;
+    if (failures == 0) {
+        std::cout << "ALL TESTS PASSED" << std::endl;
+        return 0;
+    }
+    std::cout << failures << " TEST(S) FAILED" << std::endl;
+    return 1;
+}